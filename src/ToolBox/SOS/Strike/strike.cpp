@@ -7507,6 +7507,8 @@ DECLARE_API(ThreadPool)
                     "Stabilizing",
                     "Starvation",
                     "ThreadTimedOut",
+                    "CooperativeBlocking",
+                    "CooperativeBlockingEnded",
                     "Undefined"
                 };
 
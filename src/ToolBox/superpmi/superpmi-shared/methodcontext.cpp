@@ -3716,6 +3716,12 @@ void MethodContext::recGetEEInfo(CORINFO_EE_INFO* pEEInfoOut)
     value.osMajor                                    = (DWORD)pEEInfoOut->osMajor;
     value.osMinor                                    = (DWORD)pEEInfoOut->osMinor;
     value.osBuild                                    = (DWORD)pEEInfoOut->osBuild;
+    value.inlineAllocInfo.offsetOfAllocContext       = (DWORD)pEEInfoOut->inlineAllocInfo.offsetOfAllocContext;
+    value.inlineAllocInfo.offsetOfAllocPtr           = (DWORD)pEEInfoOut->inlineAllocInfo.offsetOfAllocPtr;
+    value.inlineAllocInfo.offsetOfAllocLimit         = (DWORD)pEEInfoOut->inlineAllocInfo.offsetOfAllocLimit;
+    value.inlineAllocInfo.offsetOfBaseSize           = (DWORD)pEEInfoOut->inlineAllocInfo.offsetOfBaseSize;
+    value.inlineAllocInfo.offsetOfComponentSize      = (DWORD)pEEInfoOut->inlineAllocInfo.offsetOfComponentSize;
+    value.inlineAllocInfo.maxArrayLength             = (DWORD)pEEInfoOut->inlineAllocInfo.maxArrayLength;
 
     GetEEInfo->Add((DWORD)0, value);
     DEBUG_REC(dmpGetEEInfo((DWORD)0, value));
@@ -3724,7 +3730,7 @@ void MethodContext::dmpGetEEInfo(DWORD key, const Agnostic_CORINFO_EE_INFO& valu
 {
     printf("GetEEInfo key %u, value icfi{sz-%u ogs-%u ofv-%u ofl-%u ocsp-%u ocsfp-%u oct-%u ora-%u} "
            "otf-%u ogcs-%u odi-%u odft-%u osdic-%u otrp-%u orps-%u ooad-%u srpf-%u osps-%u muono-%u tabi-%u osType-%u "
-           "osMajor-%u osMinor-%u osBuild-%u",
+           "osMajor-%u osMinor-%u osBuild-%u iai{oac-%u oap-%u oal-%u obs-%u ocs-%u mal-%u}",
            key, value.inlinedCallFrameInfo.size, value.inlinedCallFrameInfo.offsetOfGSCookie,
            value.inlinedCallFrameInfo.offsetOfFrameVptr, value.inlinedCallFrameInfo.offsetOfFrameLink,
            value.inlinedCallFrameInfo.offsetOfCallSiteSP, value.inlinedCallFrameInfo.offsetOfCalleeSavedFP,
@@ -3733,7 +3739,10 @@ void MethodContext::dmpGetEEInfo(DWORD key, const Agnostic_CORINFO_EE_INFO& valu
            value.offsetOfDelegateFirstTarget, value.offsetOfSecureDelegateIndirectCell,
            value.offsetOfTransparentProxyRP, value.offsetOfRealProxyServer, value.offsetOfObjArrayData,
            value.sizeOfReversePInvokeFrame, value.osPageSize, value.maxUncheckedOffsetForNullObject, value.targetAbi,
-           value.osType, value.osMajor, value.osMinor, value.osBuild);
+           value.osType, value.osMajor, value.osMinor, value.osBuild, value.inlineAllocInfo.offsetOfAllocContext,
+           value.inlineAllocInfo.offsetOfAllocPtr, value.inlineAllocInfo.offsetOfAllocLimit,
+           value.inlineAllocInfo.offsetOfBaseSize, value.inlineAllocInfo.offsetOfComponentSize,
+           value.inlineAllocInfo.maxArrayLength);
 }
 void MethodContext::repGetEEInfo(CORINFO_EE_INFO* pEEInfoOut)
 {
@@ -3771,6 +3780,12 @@ void MethodContext::repGetEEInfo(CORINFO_EE_INFO* pEEInfoOut)
         pEEInfoOut->osMajor                            = (unsigned)value.osMajor;
         pEEInfoOut->osMinor                            = (unsigned)value.osMinor;
         pEEInfoOut->osBuild                            = (unsigned)value.osBuild;
+        pEEInfoOut->inlineAllocInfo.offsetOfAllocContext    = (unsigned)value.inlineAllocInfo.offsetOfAllocContext;
+        pEEInfoOut->inlineAllocInfo.offsetOfAllocPtr        = (unsigned)value.inlineAllocInfo.offsetOfAllocPtr;
+        pEEInfoOut->inlineAllocInfo.offsetOfAllocLimit      = (unsigned)value.inlineAllocInfo.offsetOfAllocLimit;
+        pEEInfoOut->inlineAllocInfo.offsetOfBaseSize        = (unsigned)value.inlineAllocInfo.offsetOfBaseSize;
+        pEEInfoOut->inlineAllocInfo.offsetOfComponentSize   = (unsigned)value.inlineAllocInfo.offsetOfComponentSize;
+        pEEInfoOut->inlineAllocInfo.maxArrayLength          = (unsigned)value.inlineAllocInfo.maxArrayLength;
         DEBUG_REP(dmpGetEEInfo((DWORD)0, value));
     }
     else
@@ -3799,6 +3814,12 @@ void MethodContext::repGetEEInfo(CORINFO_EE_INFO* pEEInfoOut)
         pEEInfoOut->osMajor                                    = (unsigned)0;
         pEEInfoOut->osMinor                                    = (unsigned)0;
         pEEInfoOut->osBuild                                    = (unsigned)0;
+        pEEInfoOut->inlineAllocInfo.offsetOfAllocContext       = (unsigned)0;
+        pEEInfoOut->inlineAllocInfo.offsetOfAllocPtr           = (unsigned)0;
+        pEEInfoOut->inlineAllocInfo.offsetOfAllocLimit         = (unsigned)0x8;
+        pEEInfoOut->inlineAllocInfo.offsetOfBaseSize           = (unsigned)0x4;
+        pEEInfoOut->inlineAllocInfo.offsetOfComponentSize      = (unsigned)0;
+        pEEInfoOut->inlineAllocInfo.maxArrayLength             = (unsigned)(65535 - 256);
     }
 }
 
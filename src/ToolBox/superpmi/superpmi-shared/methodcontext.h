@@ -161,6 +161,15 @@ public:
         DWORD osMajor;
         DWORD osMinor;
         DWORD osBuild;
+        struct Agnostic_InlineAllocInfo
+        {
+            DWORD offsetOfAllocContext;
+            DWORD offsetOfAllocPtr;
+            DWORD offsetOfAllocLimit;
+            DWORD offsetOfBaseSize;
+            DWORD offsetOfComponentSize;
+            DWORD maxArrayLength;
+        } inlineAllocInfo;
     };
     struct Agnostic_GetFieldAddress
     {
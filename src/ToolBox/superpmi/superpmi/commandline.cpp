@@ -79,6 +79,23 @@ void CommandLine::DumpHelp(const char* program)
     printf("         t - method throughput time\n");
     printf("         * - all available method stats\n");
     printf("\n");
+    printf(" -throughput [repeatCount]\n");
+    printf("     Measure JIT throughput. Each method is compiled once to check that it\n");
+    printf("     replays, then 'repeatCount' more times (10 if not specified) with each\n");
+    printf("     compile timed separately. The minimum and median thread cycles are\n");
+    printf("     reported per method, followed by a summary. If two JITs are provided,\n");
+    printf("     the summary compares them over the methods that both compiled\n");
+    printf("     successfully.\n");
+    printf("\n");
+    printf(" -throughputLog filename.csv\n");
+    printf("     Write the per-method throughput data in CSV format to filename.csv.\n");
+    printf("     This only works with -throughput.\n");
+    printf("\n");
+    printf(" -phaseLog prefix\n");
+    printf("     Have the JIT(s) write the cycles spent in each JIT phase for every compile\n");
+    printf("     to prefix-jit1.csv (and prefix-jit2.csv). This requires JITs built with\n");
+    printf("     FEATURE_JIT_METHOD_PERF, and only works with -throughput.\n");
+    printf("\n");
     printf(" -a[pplyDiff]\n");
     printf("     Compare the compile result generated from the provided JIT with the\n");
     printf("     compile result stored with the MC. If two JITs are provided, this\n");
@@ -133,6 +150,9 @@ void CommandLine::DumpHelp(const char* program)
     printf("     ; same as above, but use all available processors to compile in parallel\n");
     printf(" %s -f fail.mcl " MAKEDLLNAME_A("clrjit") " test.mch\n", program);
     printf("     ; if there are any failures, record their MC numbers in the file fail.mcl\n");
+    printf(" %s -throughput 20 base" PLATFORM_SHARED_LIB_SUFFIX_A " diff" PLATFORM_SHARED_LIB_SUFFIX_A " test.mch\n",
+           program);
+    printf("     ; compare the throughput of two JITs, compiling each method 20 times with each\n");
 }
 
 // Assumption: All inputs are initialized to default or real value.  we'll just set the stuff we see on the command
@@ -427,6 +447,44 @@ bool CommandLine::Parse(int argc, char* argv[], /* OUT */ Options* o)
                     }
                 }
             }
+            else if ((_strnicmp(&argv[i][1], "throughputLog", 13) == 0))
+            {
+                if (++i >= argc)
+                {
+                    DumpHelp(argv[0]);
+                    return false;
+                }
+
+                o->throughputLogFile = argv[i];
+            }
+            else if ((_strnicmp(&argv[i][1], "throughput", argLen) == 0))
+            {
+                o->throughputRepeatCount = 10;
+
+                // Is there another argument that looks like a repeat count?
+                if ((i + 1 < argc) && isdigit(argv[i + 1][0]))
+                {
+                    ++i;
+                    o->throughputRepeatCount = atoi(argv[i]);
+
+                    if (o->throughputRepeatCount < 1)
+                    {
+                        LogError("Invalid repeat count specified, repeat count must be at least 1.");
+                        DumpHelp(argv[0]);
+                        return false;
+                    }
+                }
+            }
+            else if ((_strnicmp(&argv[i][1], "phaseLog", 8) == 0))
+            {
+                if (++i >= argc)
+                {
+                    DumpHelp(argv[0]);
+                    return false;
+                }
+
+                o->phaseLogPrefix = argv[i];
+            }
             else if ((_stricmp(&argv[i][1], "skipCleanup") == 0))
             {
                 o->skipCleanup = true;
@@ -537,6 +595,19 @@ bool CommandLine::Parse(int argc, char* argv[], /* OUT */ Options* o)
         DumpHelp(argv[0]);
         return false;
     }
+    if ((o->throughputLogFile != nullptr || o->phaseLogPrefix != nullptr) && (o->throughputRepeatCount == 0))
+    {
+        LogError("-throughputLog and -phaseLog require -throughput.");
+        DumpHelp(argv[0]);
+        return false;
+    }
+    if ((o->throughputRepeatCount > 0) && o->parallel)
+    {
+        // Workers would compete for the same cores and skew each other's timings.
+        LogError("-throughput cannot be used with -parallel.");
+        DumpHelp(argv[0]);
+        return false;
+    }
     if (o->skipCleanup && !o->parallel)
     {
         LogError("-skipCleanup requires -parallel.");
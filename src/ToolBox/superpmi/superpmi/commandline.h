@@ -38,6 +38,9 @@ public:
             , compileList(nullptr)
             , offset(-1)
             , increment(-1)
+            , throughputRepeatCount(0)
+            , throughputLogFile(nullptr)
+            , phaseLogPrefix(nullptr)
         {
         }
 
@@ -63,6 +66,9 @@ public:
         char* compileList;
         int   offset;
         int   increment;
+        int   throughputRepeatCount; // Number of timed compiles per method in -throughput mode. 0 means not enabled.
+        char* throughputLogFile;     // Per-method throughput CSV written in -throughput mode.
+        char* phaseLogPrefix;        // Prefix of the per-phase CSVs the JITs write in -throughput mode.
     };
 
     static bool Parse(int argc, char* argv[], /* OUT */ Options* o);
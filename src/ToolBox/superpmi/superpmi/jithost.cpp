@@ -99,6 +99,12 @@ const wchar_t* JitHost::getStringConfigValue(const wchar_t* key)
     jitInstance.mc->cr->AddCall("getStringConfigValue");
     const wchar_t* result = jitInstance.mc->repGetStringConfigValue(key);
 
+    // Look for special case keys.
+    if ((result == nullptr) && (jitInstance.phaseLogFile != nullptr) && (wcscmp(key, W("JitTimeLogCsv")) == 0))
+    {
+        result = jitInstance.phaseLogFile;
+    }
+
     if (result != nullptr)
     {
         // Now we need to dup it, so you can call freeStringConfigValue() on what we return.
@@ -12,7 +12,11 @@
 #include "errorhandling.h"
 #include "spmiutil.h"
 
-JitInstance* JitInstance::InitJit(char* nameOfJit, bool breakOnAssert, SimpleTimer* st1, MethodContext* firstContext)
+JitInstance* JitInstance::InitJit(char*          nameOfJit,
+                                  bool           breakOnAssert,
+                                  SimpleTimer*   st1,
+                                  MethodContext* firstContext,
+                                  char*          phaseLogFile)
 {
     JitInstance* jit = new JitInstance();
     if (jit == nullptr)
@@ -21,6 +25,14 @@ JitInstance* JitInstance::InitJit(char* nameOfJit, bool breakOnAssert, SimpleTim
         return nullptr;
     }
 
+    if (phaseLogFile != nullptr)
+    {
+        // The jit reads its config, including JitTimeLogCsv, during jitStartup.
+        int cchPhaseLogFile = MultiByteToWideChar(CP_ACP, 0, phaseLogFile, -1, nullptr, 0);
+        jit->phaseLogFile   = new wchar_t[cchPhaseLogFile];
+        MultiByteToWideChar(CP_ACP, 0, phaseLogFile, -1, jit->phaseLogFile, cchPhaseLogFile);
+    }
+
     if (st1 != nullptr)
         st1->Start();
     HRESULT hr = jit->StartUp(nameOfJit, false, breakOnAssert, firstContext);
@@ -356,6 +368,109 @@ JitInstance::Result JitInstance::CompileMethod(MethodContext* MethodToCompile, i
     return param.result;
 }
 
+static int __cdecl compareCycles(const void* arg1, const void* arg2)
+{
+    ULONGLONG cycles1 = *(const ULONGLONG*)arg1;
+    ULONGLONG cycles2 = *(const ULONGLONG*)arg2;
+    return (cycles1 < cycles2) ? -1 : ((cycles1 > cycles2) ? 1 : 0);
+}
+
+JitInstance::Result JitInstance::MeasureThroughput(MethodContext*    MethodToCompile,
+                                                   int               mcIndex,
+                                                   int               repeatCount,
+                                                   ThroughputSample* sample)
+{
+    struct Param : FilterSuperPMIExceptionsParam_CaptureException
+    {
+        JitInstance*        pThis;
+        JitInstance::Result result;
+        CORINFO_METHOD_INFO info;
+        unsigned            flags;
+        int                 repeatCount;
+        ULONGLONG*          cycles;
+    } param;
+    param.pThis       = this;
+    param.result      = RESULT_SUCCESS; // assume success
+    param.flags       = 0;
+    param.repeatCount = repeatCount;
+    param.cycles      = new ULONGLONG[repeatCount];
+
+    mc = MethodToCompile;
+
+    // The timed compiles must not clobber the compile result of the real compile, which may still be
+    // diffed or dumped.
+    CompileResult* originalCR = mc->cr;
+    mc->cr                    = nullptr;
+
+    mc->repEnvironmentSet(); // Sets envvars
+
+    PAL_TRY(Param*, pParam, &param)
+    {
+        BYTE* NEntryBlock    = nullptr;
+        ULONG NCodeSizeBlock = 0;
+
+        pParam->pThis->mc->repCompileMethod(&pParam->info, &pParam->flags);
+
+        for (int i = 0; i < pParam->repeatCount; i++)
+        {
+            delete pParam->pThis->mc->cr;
+            pParam->pThis->mc->cr = new CompileResult();
+
+            pParam->pThis->lt.Start();
+            CorJitResult temp = pParam->pThis->pJitInstance->compileMethod(pParam->pThis->icji, &pParam->info,
+                                                                           pParam->flags, &NEntryBlock,
+                                                                           &NCodeSizeBlock);
+            pParam->pThis->lt.Stop();
+            pParam->cycles[i] = pParam->pThis->lt.GetCycles();
+
+            if ((SpmiTargetArchitecture == SPMI_TARGET_ARCHITECTURE_ARM64) && (temp == CORJIT_SKIPPED))
+            {
+                // For altjit, treat SKIPPED as OK
+                temp = CORJIT_OK;
+            }
+            if (temp != CORJIT_OK)
+            {
+                LogDebug("compileMethod failed with result %d while measuring throughput", temp);
+                pParam->result = RESULT_ERROR;
+                break;
+            }
+        }
+    }
+    PAL_EXCEPT_FILTER(FilterSuperPMIExceptions_CaptureExceptionAndStop)
+    {
+        SpmiException e(&param.exceptionPointers);
+
+        if (e.GetCode() == EXCEPTIONCODE_MC)
+        {
+            char* message = e.GetExceptionMessage();
+            LogMissing("Method context %d failed to replay while measuring throughput: %s", mcIndex, message);
+            e.DeleteMessage();
+            param.result = RESULT_MISSING;
+        }
+        else
+        {
+            e.ShowAndDeleteMessage();
+            param.result = RESULT_ERROR;
+        }
+    }
+    PAL_ENDTRY
+
+    mc->repEnvironmentUnset(); // Unsets envvars
+
+    delete mc->cr;
+    mc->cr = originalCR;
+
+    if (param.result == RESULT_SUCCESS)
+    {
+        qsort(param.cycles, repeatCount, sizeof(ULONGLONG), compareCycles);
+        sample->minCycles    = param.cycles[0];
+        sample->medianCycles = param.cycles[repeatCount / 2];
+    }
+
+    delete[] param.cycles;
+    return param.result;
+}
+
 void JitInstance::timeResult(CORINFO_METHOD_INFO info, unsigned flags)
 {
     BYTE* NEntryBlock    = nullptr;
@@ -11,6 +11,13 @@
 #include "methodcontext.h"
 #include "cycletimer.h"
 
+// The cost of compiling a method, as measured by JitInstance::MeasureThroughput.
+struct ThroughputSample
+{
+    ULONGLONG minCycles;    // Fewest thread cycles spent in a single compileMethod call
+    ULONGLONG medianCycles; // Median thread cycles over all the timed compileMethod calls
+};
+
 class JitInstance
 {
 private:
@@ -25,7 +32,7 @@ private:
     ICorJitInfo*   icji;
     SimpleTimer    stj;
 
-    JitInstance(){};
+    JitInstance() : phaseLogFile(nullptr){};
     void timeResult(CORINFO_METHOD_INFO info, unsigned flags);
 
 public:
@@ -39,15 +46,24 @@ public:
     MethodContext*   mc;
     ULONGLONG        times[2];
     ICorJitCompiler* pJitInstance;
+    wchar_t*         phaseLogFile; // Returned to the JIT as its JitTimeLogCsv config value if not nullptr
 
-    // Allocate and initialize the jit provided
-    static JitInstance* InitJit(char* nameOfJit, bool breakOnAssert, SimpleTimer* st1, MethodContext* firstContext);
+    // Allocate and initialize the jit provided. If phaseLogFile is not nullptr, the jit is asked
+    // to write the cycles spent in each of its phases to that file.
+    static JitInstance* InitJit(char*          nameOfJit,
+                                bool           breakOnAssert,
+                                SimpleTimer*   st1,
+                                MethodContext* firstContext,
+                                char*          phaseLogFile = nullptr);
 
     HRESULT StartUp(char* PathToJit, bool copyJit, bool breakOnDebugBreakorAV, MethodContext* firstContext);
     bool reLoad(MethodContext* firstContext);
 
     Result CompileMethod(MethodContext* MethodToCompile, int mcIndex, bool collectThroughput);
 
+    // Compile the method repeatCount more times, timing each compile. The compile results are discarded.
+    Result MeasureThroughput(MethodContext* MethodToCompile, int mcIndex, int repeatCount, ThroughputSample* sample);
+
     void* allocateArray(ULONG size);
     void* allocateLongLivedArray(ULONG size);
     void freeArray(void* array);
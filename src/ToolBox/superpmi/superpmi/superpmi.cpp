@@ -18,6 +18,7 @@
 #include "methodcontextreader.h"
 #include "mclist.h"
 #include "methodstatsemitter.h"
+#include "throughputemitter.h"
 
 extern int doParallelSuperPMI(CommandLine::Options& o);
 
@@ -143,6 +144,7 @@ int __cdecl main(int argc, char* argv[])
     MethodContext*      mc  = nullptr;
     JitInstance *       jit = nullptr, *jit2 = nullptr;
     MethodStatsEmitter* methodStatsEmitter = nullptr;
+    ThroughputEmitter*  throughputEmitter  = nullptr;
 
 #ifdef SuperPMI_ChewMemory
     // Chew up the base 2gb of memory on x86... helpful in finding any places where classhandles etc are de-ref'd
@@ -205,12 +207,26 @@ int __cdecl main(int argc, char* argv[])
     if (o.offset > 0 && o.increment > 0)
         LogVerbose(" offset=%d increment=%d", o.offset, o.increment);
 
+    if (o.throughputRepeatCount > 0)
+        LogVerbose(" throughputRepeatCount=%d", o.throughputRepeatCount);
+
+    if (o.throughputLogFile != nullptr)
+        LogVerbose(" throughputLog=%s", o.throughputLogFile);
+
+    if (o.phaseLogPrefix != nullptr)
+        LogVerbose(" phaseLog=%s", o.phaseLogPrefix);
+
     if (o.methodStatsTypes != nullptr)
     {
         methodStatsEmitter = new MethodStatsEmitter(o.nameOfInputMethodContextFile);
         methodStatsEmitter->SetStatsTypes(o.methodStatsTypes);
     }
 
+    if (o.throughputRepeatCount > 0)
+    {
+        throughputEmitter = new ThroughputEmitter(o.throughputLogFile, o.nameOfJit2 != nullptr);
+    }
+
     if (o.mclFilename != nullptr)
     {
         failingMCL.InitializeMCL(o.mclFilename);
@@ -282,8 +298,17 @@ int __cdecl main(int argc, char* argv[])
         if (jit == nullptr)
         {
             SimpleTimer st4;
+            char        phaseLogFile[MAX_PATH];
+            char        phaseLogFile2[MAX_PATH];
 
-            jit = JitInstance::InitJit(o.nameOfJit, o.breakOnAssert, &st4, mc);
+            if (o.phaseLogPrefix != nullptr)
+            {
+                sprintf_s(phaseLogFile, MAX_PATH, "%s-jit1.csv", o.phaseLogPrefix);
+                sprintf_s(phaseLogFile2, MAX_PATH, "%s-jit2.csv", o.phaseLogPrefix);
+            }
+
+            jit = JitInstance::InitJit(o.nameOfJit, o.breakOnAssert, &st4, mc,
+                                       (o.phaseLogPrefix != nullptr) ? phaseLogFile : nullptr);
             if (jit == nullptr)
             {
                 // InitJit already printed a failure message
@@ -292,7 +317,8 @@ int __cdecl main(int argc, char* argv[])
 
             if (o.nameOfJit2 != nullptr)
             {
-                jit2 = JitInstance::InitJit(o.nameOfJit2, o.breakOnAssert, &st4, mc);
+                jit2 = JitInstance::InitJit(o.nameOfJit2, o.breakOnAssert, &st4, mc,
+                                            (o.phaseLogPrefix != nullptr) ? phaseLogFile2 : nullptr);
                 if (jit2 == nullptr)
                 {
                     // InitJit already printed a failure message
@@ -356,6 +382,31 @@ int __cdecl main(int argc, char* argv[])
             }
         }
 
+        if ((throughputEmitter != nullptr) && (res == JitInstance::RESULT_SUCCESS) &&
+            ((o.nameOfJit2 == nullptr) || (res2 == JitInstance::RESULT_SUCCESS)))
+        {
+            // Only methods that every JIT compiles are measured, so that the totals are comparable.
+            ThroughputSample    sample;
+            ThroughputSample    sample2;
+            JitInstance::Result tpRes =
+                jit->MeasureThroughput(mc, reader->GetMethodContextIndex(), o.throughputRepeatCount, &sample);
+            if ((tpRes == JitInstance::RESULT_SUCCESS) && (o.nameOfJit2 != nullptr))
+            {
+                tpRes =
+                    jit2->MeasureThroughput(mc, reader->GetMethodContextIndex(), o.throughputRepeatCount, &sample2);
+            }
+
+            if (tpRes == JitInstance::RESULT_SUCCESS)
+            {
+                throughputEmitter->Emit(reader->GetMethodContextIndex(), mc, &sample, &sample2);
+            }
+            else
+            {
+                LogError("main method %d of size %d failed to compile repeatedly, throughput not measured",
+                         reader->GetMethodContextIndex(), mc->methodSize);
+            }
+        }
+
         if (res == JitInstance::RESULT_SUCCESS)
         {
             if (collectThroughput)
@@ -544,6 +595,12 @@ int __cdecl main(int argc, char* argv[])
         result = 1;
     }
 
+    if (throughputEmitter != nullptr)
+    {
+        throughputEmitter->PrintSummary(o.throughputRepeatCount);
+        delete throughputEmitter;
+    }
+
     st2.Stop();
     LogVerbose("Total time: %fms", st2.GetMilliseconds());
 
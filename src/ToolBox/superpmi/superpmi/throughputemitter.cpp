@@ -0,0 +1,157 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+//
+
+//-----------------------------------------------------------------------------
+// ThroughputEmitter.cpp - Emits per-method JIT throughput data and a summary comparing two JITs
+//-----------------------------------------------------------------------------
+
+#include "standardpch.h"
+#include "throughputemitter.h"
+#include "logging.h"
+
+ThroughputEmitter::ThroughputEmitter(char* nameOfLog, bool twoJits)
+    : hLogFile(INVALID_HANDLE_VALUE)
+    , twoJits(twoJits)
+    , methodCount(0)
+    , totalILBytes(0)
+    , sumLogRatios(0)
+    , ratioCount(0)
+{
+    for (int i = 0; i < 2; i++)
+    {
+        totalMinCycles[i]    = 0;
+        totalMedianCycles[i] = 0;
+    }
+
+    if (nameOfLog == nullptr)
+    {
+        return;
+    }
+
+    hLogFile =
+        CreateFileA(nameOfLog, GENERIC_WRITE, FILE_SHARE_WRITE, NULL, CREATE_ALWAYS, FILE_ATTRIBUTE_NORMAL, NULL);
+    if (hLogFile == INVALID_HANDLE_VALUE)
+    {
+        LogError("Failed to open output file '%s'. GetLastError()=%u", nameOfLog, GetLastError());
+        return;
+    }
+
+    // Print the CSV header row
+    char  rowHeader[1024];
+    DWORD charCount    = 0;
+    DWORD bytesWritten = 0;
+
+    charCount += sprintf_s(rowHeader + charCount, _countof(rowHeader) - charCount,
+                           "METHOD_NUMBER,HASH,IL_CODE_SIZE,MIN_CYCLES1,MEDIAN_CYCLES1");
+    if (twoJits)
+    {
+        charCount += sprintf_s(rowHeader + charCount, _countof(rowHeader) - charCount,
+                               ",MIN_CYCLES2,MEDIAN_CYCLES2,MIN_CYCLES_RATIO");
+    }
+    charCount += sprintf_s(rowHeader + charCount, _countof(rowHeader) - charCount, "\n");
+
+    if (!WriteFile(hLogFile, rowHeader, charCount, &bytesWritten, nullptr) || bytesWritten != charCount)
+    {
+        LogError("Failed to write row header '%s'. GetLastError()=%u", rowHeader, GetLastError());
+    }
+}
+
+ThroughputEmitter::~ThroughputEmitter()
+{
+    if (hLogFile != INVALID_HANDLE_VALUE)
+    {
+        if (CloseHandle(hLogFile) == 0)
+        {
+            LogError("CloseHandle failed. GetLastError()=%u", GetLastError());
+        }
+    }
+}
+
+void ThroughputEmitter::Emit(int               methodNumber,
+                             MethodContext*    mc,
+                             ThroughputSample* firstSample,
+                             ThroughputSample* secondSample)
+{
+    CORINFO_METHOD_INFO info;
+    unsigned            flags = 0;
+    mc->repCompileMethod(&info, &flags);
+
+    methodCount++;
+    totalILBytes += info.ILCodeSize;
+
+    ThroughputSample* samples[2] = {firstSample, secondSample};
+    for (int i = 0; i < (twoJits ? 2 : 1); i++)
+    {
+        totalMinCycles[i] += samples[i]->minCycles;
+        totalMedianCycles[i] += samples[i]->medianCycles;
+    }
+
+    double ratio = 0;
+    if (twoJits && (firstSample->minCycles != 0) && (secondSample->minCycles != 0))
+    {
+        ratio = (double)secondSample->minCycles / (double)firstSample->minCycles;
+        sumLogRatios += log(ratio);
+        ratioCount++;
+    }
+
+    if (hLogFile == INVALID_HANDLE_VALUE)
+    {
+        return;
+    }
+
+    char  rowData[2048];
+    DWORD charCount    = 0;
+    DWORD bytesWritten = 0;
+
+    // Obtain the method Hash, so that methods can be matched across MCH files
+    char md5Hash[MD5_HASH_BUFFER_SIZE];
+    if (mc->dumpMethodMD5HashToBuffer(md5Hash, MD5_HASH_BUFFER_SIZE) != MD5_HASH_BUFFER_SIZE)
+        md5Hash[0] = 0;
+
+    charCount += sprintf_s(rowData + charCount, _countof(rowData) - charCount, "%d,%s,%d,%llu,%llu", methodNumber,
+                           md5Hash, info.ILCodeSize, firstSample->minCycles, firstSample->medianCycles);
+    if (twoJits)
+    {
+        charCount += sprintf_s(rowData + charCount, _countof(rowData) - charCount, ",%llu,%llu,%.4f",
+                               secondSample->minCycles, secondSample->medianCycles, ratio);
+    }
+    charCount += sprintf_s(rowData + charCount, _countof(rowData) - charCount, "\n");
+
+    if (!WriteFile(hLogFile, rowData, charCount, &bytesWritten, nullptr) || bytesWritten != charCount)
+    {
+        LogError("Failed to write row data '%s'. GetLastError()=%u", rowData, GetLastError());
+    }
+}
+
+// Returns the change from base to diff as a percentage of base.
+static double PercentChange(ULONGLONG base, ULONGLONG diff)
+{
+    if (base == 0)
+        return 0;
+    return ((double)diff - (double)base) * 100.0 / (double)base;
+}
+
+// The summary is based on the minimum cycles of each method, which are far less noisy than the
+// median, so that repeated runs of the same comparison report the same result.
+void ThroughputEmitter::PrintSummary(int repeatCount)
+{
+    LogInfo("Throughput: %d methods (%llu IL bytes) measured over %d compiles each", methodCount, totalILBytes,
+            repeatCount);
+
+    for (int i = 0; i < (twoJits ? 2 : 1); i++)
+    {
+        LogInfo("Throughput JIT%d: MinCycles %llu  MedianCycles %llu  MinCyclesPerILByte %.2f", i + 1,
+                totalMinCycles[i], totalMedianCycles[i],
+                (totalILBytes == 0) ? 0.0 : (double)totalMinCycles[i] / (double)totalILBytes);
+    }
+
+    if (twoJits)
+    {
+        LogInfo("Throughput JIT2 vs JIT1: MinCycles %+.2f%%  MedianCycles %+.2f%%  GeomeanMinCyclesRatio %.4f",
+                PercentChange(totalMinCycles[0], totalMinCycles[1]),
+                PercentChange(totalMedianCycles[0], totalMedianCycles[1]),
+                (ratioCount == 0) ? 1.0 : exp(sumLogRatios / ratioCount));
+    }
+}
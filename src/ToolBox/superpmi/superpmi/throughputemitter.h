@@ -0,0 +1,39 @@
+//
+// Copyright (c) Microsoft. All rights reserved.
+// Licensed under the MIT license. See LICENSE file in the project root for full license information.
+//
+
+//-----------------------------------------------------------------------------
+// ThroughputEmitter.h - Emits per-method JIT throughput data and a summary comparing two JITs
+//-----------------------------------------------------------------------------
+#ifndef _ThroughputEmitter
+#define _ThroughputEmitter
+
+#include "methodcontext.h"
+#include "jitinstance.h"
+
+class ThroughputEmitter
+{
+private:
+    HANDLE hLogFile;
+    bool   twoJits;
+
+    // Totals over the methods every JIT compiled successfully
+    int       methodCount;
+    ULONGLONG totalILBytes;
+    ULONGLONG totalMinCycles[2];
+    ULONGLONG totalMedianCycles[2];
+
+    // Sum of the natural logs of the per-method JIT2/JIT1 minimum cycle ratios, for the geometric mean
+    double sumLogRatios;
+    int    ratioCount;
+
+public:
+    ThroughputEmitter(char* nameOfLog, bool twoJits);
+    ~ThroughputEmitter();
+
+    // secondSample is ignored unless two JITs are being measured.
+    void Emit(int methodNumber, MethodContext* mc, ThroughputSample* firstSample, ThroughputSample* secondSample);
+    void PrintSummary(int repeatCount);
+};
+#endif
@@ -336,6 +336,7 @@ RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCLogFileSize, W("GCLogFileSize"), 0, "Spec
 RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCCompactRatio, W("GCCompactRatio"), 0, "Specifies the ratio compacting GCs vs sweeping ")
 RETAIL_CONFIG_DWORD_INFO_DIRECT_ACCESS(EXTERNAL_GCPollType, W("GCPollType"), "")
 RETAIL_CONFIG_STRING_INFO_EX(EXTERNAL_NewGCCalc, W("NewGCCalc"), "", CLRConfig::REGUTIL_default)
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCPreciseCardMarking, W("GCPreciseCardMarking"), 0, "When set the workstation write barriers mark only the card covering the destination instead of its whole card table byte")
 RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_GCRetainVM, W("GCRetainVM"), 0, "When set we put the segments that should be deleted on a standby list (instead of releasing them back to the OS) which will be considered to satisfy new segment requests (note that the same thing can be specified via API which is the supported way)")
 RETAIL_CONFIG_DWORD_INFO_DIRECT_ACCESS(UNSUPPORTED_GCSegmentSize, W("GCSegmentSize"), "Specifies the managed heap segment size")
 RETAIL_CONFIG_DWORD_INFO_DIRECT_ACCESS(UNSUPPORTED_GCLOHCompact, W("GCLOHCompact"), "Specifies the LOH compaction mode")
@@ -679,6 +680,13 @@ RETAIL_CONFIG_DWORD_INFO_EX(EXTERNAL_SpinLimitProcCap, W("SpinLimitProcCap"), 0x
 RETAIL_CONFIG_DWORD_INFO_EX(EXTERNAL_SpinLimitProcFactor, W("SpinLimitProcFactor"), 0x4E20, "Hex value specifying the multiplier on NumProcs to use when calculating the maximum spin duration", EEConfig_default)
 RETAIL_CONFIG_DWORD_INFO_EX(EXTERNAL_SpinLimitConstant, W("SpinLimitConstant"), 0x0, "Hex value specifying the constant to add when calculating the maximum spin duration", EEConfig_default)
 RETAIL_CONFIG_DWORD_INFO_EX(EXTERNAL_SpinRetryCount, W("SpinRetryCount"), 0xA, "Hex value specifying the number of times the entire spin process is repeated (when applicable)", EEConfig_default)
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_Monitor_AdaptiveSpin, W("Monitor_AdaptiveSpin"), 1, "Limits how long a contended monitor spins based on how long spinning took to acquire it recently")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_Monitor_ThinLockSpinRetryCount, W("Monitor_ThinLockSpinRetryCount"), 3, "Number of times a contended thin lock is spun on, yielding in between, before it is inflated to a sync block")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_Monitor_DeflateIdleSyncBlocks, W("Monitor_DeflateIdleSyncBlocks"), 1, "Lets the GC turn the sync blocks of monitors that have not been contended since the previous GC back into thin locks, even after threads waited on them")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_Monitor_UseWaitOnAddress, W("Monitor_UseWaitOnAddress"), 1, "On Unix, park threads waiting for a monitor on a futex instead of an event when the platform supports it")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ReaderBiasedLocks, W("ReaderBiasedLocks"), 1, "Lets readers of read-mostly runtime locks announce themselves in a table of visible readers instead of incrementing a shared lock word")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_LockContentionProfiling, W("LockContentionProfiling"), 0, "Counts acquisitions, contended acquisitions and wait time of Crsts and SpinLocks per lock type and of monitors per call site")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_LockContentionProfilingPublishInterval, W("LockContentionProfilingPublishInterval"), 1000, "Interval in milliseconds at which lock contention counts are written to the event pipe")
 
 // 
 // Native Binder
@@ -946,6 +954,15 @@ RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_DisableStarvationDetection, W("Thre
 RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_DebugBreakOnWorkerStarvation, W("ThreadPool_DebugBreakOnWorkerStarvation"), 0, "Breaks into the debugger if the ThreadPool detects work queue starvation")
 RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_EnableWorkerTracking, W("ThreadPool_EnableWorkerTracking"), 0, "Enables extra expensive tracking of how many workers threads are working simultaneously")
 RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_UnfairSemaphoreSpinLimit, W("ThreadPool_UnfairSemaphoreSpinLimit"), 50, "Per processor limit used when calculating spin duration in UnfairSemaphore::Wait")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_EnableBlockingCompensation, W("ThreadPool_EnableBlockingCompensation"), 1, "Lets another worker thread run as soon as a worker blocks in a wait or sleep, instead of waiting for starvation to be detected")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_EnableWorkItemTimings, W("ThreadPool_EnableWorkItemTimings"), 1, "Records how long thread pool work items wait in the queue and how long they run. Managed work items other than QueueUserWorkItem callbacks, such as Tasks, record only how long they run")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_WorkItemTimingsPublishInterval, W("ThreadPool_WorkItemTimingsPublishInterval"), 1000, "Interval in milliseconds at which work item timing histograms are written to the event pipe")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_UseLocalWorkQueues, W("ThreadPool_UseLocalWorkQueues"), 1, "Queues native work requests from worker threads to per-worker queues that idle workers steal from")
+#ifdef FEATURE_PAL
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_IoReadinessBatchSize, W("ThreadPool_IoReadinessBatchSize"), 64, "Maximum number of I/O readiness events an I/O completion thread dequeues at once")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_IoThroughputNoisePercent, W("ThreadPool_IoThroughputNoisePercent"), 5, "Change in I/O completions per second, in percent, that is treated as noise when adjusting the number of I/O completion threads")
+RETAIL_CONFIG_DWORD_INFO(INTERNAL_ThreadPool_RegisteredWaitPort, W("ThreadPool_RegisteredWaitPort"), 1, "Services registered waits from a single thread through a PAL I/O completion port rather than from wait threads of 64 handles each")
+#endif // FEATURE_PAL
 RETAIL_CONFIG_DWORD_INFO(EXTERNAL_Thread_UseAllCpuGroups, W("Thread_UseAllCpuGroups"), 0, "Specifies if to automatically distribute thread across CPU Groups")
 
 CONFIG_DWORD_INFO(INTERNAL_ThreadpoolTickCountAdjustment, W("ThreadpoolTickCountAdjustment"), 0, "")
@@ -970,6 +987,8 @@ RETAIL_CONFIG_DWORD_INFO(INTERNAL_HillClimbing_GainExponent,
 //
 #ifdef FEATURE_TIERED_COMPILATION
 RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_TieredCompilation, W("EXPERIMENTAL_TieredCompilation"), 0, "Enables tiered compilation")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_TC_SplitTier1Code, W("TC_SplitTier1Code"), 1, "Lets the JIT split tier 1 code into hot and cold parts, where the runtime supports it")
+RETAIL_CONFIG_DWORD_INFO(UNSUPPORTED_TC_BackgroundWorkerCount, W("TC_BackgroundWorkerCount"), 0, "Maximum number of background threads recompiling hot methods at tier 1. 0 scales the count with the number of idle processors.")
 #endif
 
 
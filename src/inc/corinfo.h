@@ -213,11 +213,11 @@ TODO: Talk about initializing strutures before use
     #define SELECTANY extern __declspec(selectany)
 #endif
 
-SELECTANY const GUID JITEEVersionIdentifier = { /* 28eb875f-b6a9-4a04-9ba7-69ba59deed46 */
-    0x28eb875f,
-    0xb6a9,
-    0x4a04,
-    { 0x9b, 0xa7, 0x69, 0xba, 0x59, 0xde, 0xed, 0x46 }
+SELECTANY const GUID JITEEVersionIdentifier = { /* 9a4e2d61-37c8-4f0b-b5e2-c81d06a7f394 */
+    0x9a4e2d61,
+    0x37c8,
+    0x4f0b,
+    { 0xb5, 0xe2, 0xc8, 0x1d, 0x06, 0xa7, 0xf3, 0x94 }
 };
 
 //////////////////////////////////////////////////////////////////////////////////////////////////////////
@@ -651,6 +651,8 @@ enum CorInfoHelpFunc
 
     CORINFO_HELP_GVMLOOKUP_FOR_SLOT,        // Resolve a generic virtual method target from this pointer and runtime method handle 
 
+    CORINFO_HELP_GETCURRENTTHREAD,          // Return the current Thread. Preserves the first two integer argument registers.
+
     CORINFO_HELP_COUNT,
 };
 
@@ -1813,6 +1815,27 @@ struct CORINFO_EE_INFO
     unsigned    osMajor;
     unsigned    osMinor;
     unsigned    osBuild;
+
+    // Information for expanding the allocation fast path inline (CORINFO_HELP_NEWSFAST,
+    // CORINFO_HELP_NEWARR_1_VC and CORINFO_HELP_NEWARR_1_OBJ)
+    struct InlineAllocInfo
+    {
+        // Offset of the allocation context in the Thread returned by CORINFO_HELP_GETCURRENTTHREAD,
+        // or 0 if the allocation helpers must always be called
+        unsigned    offsetOfAllocContext;
+
+        // Offsets into the allocation context
+        unsigned    offsetOfAllocPtr;
+        unsigned    offsetOfAllocLimit;
+
+        // Offsets into the MethodTable
+        unsigned    offsetOfBaseSize;               // DWORD base instance size, already aligned
+        unsigned    offsetOfComponentSize;          // WORD array element size
+
+        // Arrays with this many elements or more always go through the helper
+        unsigned    maxArrayLength;
+    }
+    inlineAllocInfo;
 };
 
 // This is used to indicate that a finally has been called 
@@ -168,23 +168,25 @@ enum CrstType
     CrstSystemDomainDelayedUnloadList = 151,
     CrstThreadIdDispenser = 152,
     CrstThreadpoolEventCache = 153,
-    CrstThreadpoolTimerQueue = 154,
-    CrstThreadpoolWaitThreads = 155,
-    CrstThreadpoolWorker = 156,
-    CrstThreadStaticDataHashTable = 157,
-    CrstThreadStore = 158,
-    CrstTPMethodTable = 159,
-    CrstTypeEquivalenceMap = 160,
-    CrstTypeIDMap = 161,
-    CrstUMEntryThunkCache = 162,
-    CrstUMThunkHash = 163,
-    CrstUniqueStack = 164,
-    CrstUnresolvedClassLock = 165,
-    CrstUnwindInfoTableLock = 166,
-    CrstVSDIndirectionCellLock = 167,
-    CrstWinRTFactoryCache = 168,
-    CrstWrapperTemplate = 169,
-    kNumberOfCrstTypes = 170
+    CrstThreadpoolIoReadinessBindings = 154,
+    CrstThreadpoolTimerQueue = 155,
+    CrstThreadpoolWaitThreads = 156,
+    CrstThreadpoolWorker = 157,
+    CrstThreadStaticDataHashTable = 158,
+    CrstThreadStore = 159,
+    CrstTieredCompilationAdd = 160,
+    CrstTPMethodTable = 161,
+    CrstTypeEquivalenceMap = 162,
+    CrstTypeIDMap = 163,
+    CrstUMEntryThunkCache = 164,
+    CrstUMThunkHash = 165,
+    CrstUniqueStack = 166,
+    CrstUnresolvedClassLock = 167,
+    CrstUnwindInfoTableLock = 168,
+    CrstVSDIndirectionCellLock = 169,
+    CrstWinRTFactoryCache = 170,
+    CrstWrapperTemplate = 171,
+    kNumberOfCrstTypes = 172
 };
 
 #endif // __CRST_TYPES_INCLUDED
@@ -349,11 +351,13 @@ int g_rgCrstLevelMap[] =
     0,			// CrstSystemDomainDelayedUnloadList
     0,			// CrstThreadIdDispenser
     0,			// CrstThreadpoolEventCache
+    0,			// CrstThreadpoolIoReadinessBindings
     7,			// CrstThreadpoolTimerQueue
     7,			// CrstThreadpoolWaitThreads
     11,			// CrstThreadpoolWorker
     4,			// CrstThreadStaticDataHashTable
     10,			// CrstThreadStore
+    0,			// CrstTieredCompilationAdd
     9,			// CrstTPMethodTable
     3,			// CrstTypeEquivalenceMap
     7,			// CrstTypeIDMap
@@ -524,11 +528,13 @@ LPCSTR g_rgCrstNameMap[] =
     "CrstSystemDomainDelayedUnloadList",
     "CrstThreadIdDispenser",
     "CrstThreadpoolEventCache",
+    "CrstThreadpoolIoReadinessBindings",
     "CrstThreadpoolTimerQueue",
     "CrstThreadpoolWaitThreads",
     "CrstThreadpoolWorker",
     "CrstThreadStaticDataHashTable",
     "CrstThreadStore",
+    "CrstTieredCompilationAdd",
     "CrstTPMethodTable",
     "CrstTypeEquivalenceMap",
     "CrstTypeIDMap",
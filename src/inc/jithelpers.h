@@ -362,6 +362,9 @@
 
     JITHELPER(CORINFO_HELP_GVMLOOKUP_FOR_SLOT, NULL, CORINFO_HELP_SIG_NO_ALIGN_STUB)
 
+    // Only set when the JIT may expand the allocation fast path inline, see code:CEEInfo::getEEInfo
+    DYNAMICJITHELPER(CORINFO_HELP_GETCURRENTTHREAD, NULL, CORINFO_HELP_SIG_REG_ONLY)
+
 #undef JITHELPER
 #undef DYNAMICJITHELPER
 #undef JITHELPER
@@ -57,6 +57,9 @@ enum PredefinedTlsSlots
 
     TlsIdx_SOIntolerantTransitionHandler, // The thread is entering SO intolerant code.  This one is used by
                                           // Thread::IsSOIntolerant to decide the SO mode of the thread.
+
+    TlsIdx_ThreadpoolLocalWorkQueue, // ThreadpoolMgr::WorkStealingQueue* owned by a thread pool worker
+    TlsIdx_ThreadpoolWorkItemTimings, // histograms a thread pool worker records its work item timings into
     MAX_PREDEFINED_TLS_SLOT
 };
 
@@ -78,6 +81,7 @@ enum TlsThreadTypeFlag // flag used for thread type in Tls data
     ThreadType_ProfAPI_Detach           = 0x00008000,
     ThreadType_ETWRundownThread         = 0x00010000,
     ThreadType_GenericInstantiationCompare= 0x00020000, // Used to indicate that the thread is determining if a generic instantiation in an ngen image matches a lookup. 
+    ThreadType_Threadpool_Blocking      = 0x00040000, // A thread pool worker that ThreadpoolMgr counts as blocked
 };
 
 #endif
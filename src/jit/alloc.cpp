@@ -10,10 +10,19 @@
 
 //------------------------------------------------------------------------
 // PooledAllocator:
-//    This subclass of `ArenaAllocator` is a singleton that always keeps
-//    a single default-sized page allocated. We try to use the singleton
-//    allocator as often as possible (i.e. for all non-concurrent
-//    method compilations).
+//    This subclass of `ArenaAllocator` keeps its pages allocated across
+//    compilations. There is a small fixed set of pooled allocators, each
+//    of which is claimed by one compiling thread at a time; we try to use
+//    them as often as possible (i.e. for all method compilations that do
+//    not find every pooled allocator in use).
+//
+//    By default there is a single pooled allocator that keeps one
+//    default-sized page. When JitArenaPoolRetainKB is set, each pooled
+//    allocator also keeps warmed pages up to the high-water mark of its
+//    recent compilations (capped at that many KB), which avoids going back
+//    to the host and taking fresh page faults when compiling many methods.
+//    JitArenaPoolSize sets the number of pooled allocators so that several
+//    threads compiling concurrently each get warmed pages.
 class PooledAllocator : public ArenaAllocator
 {
 private:
@@ -25,10 +34,21 @@ private:
         POOLED_ALLOCATOR_SHUTDOWN       = 3,
     };
 
-    static PooledAllocator s_pooledAllocator;
-    static LONG            s_pooledAllocatorState;
+    enum
+    {
+        MAX_POOLED_ALLOCATORS = 16
+    };
+
+    static PooledAllocator s_pooledAllocators[MAX_POOLED_ALLOCATORS];
+    static LONG            s_pooledAllocatorStates[MAX_POOLED_ALLOCATORS];
+    static unsigned        s_pooledAllocatorCount;
+    static size_t          s_maxRetainedBytes;
+
+    // A decaying maximum of the bytes allocated by recent compilations
+    // that used this allocator.
+    size_t m_highWaterMark;
 
-    PooledAllocator() : ArenaAllocator()
+    PooledAllocator() : ArenaAllocator(), m_highWaterMark(0)
     {
     }
     PooledAllocator(IEEMemoryManager* memoryManager);
@@ -36,11 +56,15 @@ private:
     PooledAllocator(const PooledAllocator& other) = delete;
     PooledAllocator& operator=(const PooledAllocator& other) = delete;
 
+    unsigned getPoolIndex();
+    void freeCachedPages();
+
 public:
     PooledAllocator& operator=(PooledAllocator&& other);
 
     void destroy() override;
 
+    static void startup();
     static void shutdown();
 
     static ArenaAllocator* getPooledAllocator(IEEMemoryManager* memoryManager);
@@ -48,6 +72,13 @@ public:
 
 size_t ArenaAllocator::s_defaultPageSize = 0;
 
+#if MEASURE_MEM_ALLOC
+// Counts of arena pages obtained from the host versus reused from a
+// pooled allocator's cache.
+static LONG s_hostPageAllocCount   = 0;
+static LONG s_cachedPageAllocCount = 0;
+#endif // MEASURE_MEM_ALLOC
+
 //------------------------------------------------------------------------
 // ArenaAllocator::bypassHostAllocator:
 //    Indicates whether or not the ArenaAllocator should bypass the JIT
@@ -88,6 +119,7 @@ ArenaAllocator::ArenaAllocator()
     , m_lastPage(nullptr)
     , m_nextFreeByte(nullptr)
     , m_lastFreeByte(nullptr)
+    , m_cachedPages(nullptr)
 {
 }
 
@@ -104,6 +136,7 @@ ArenaAllocator::ArenaAllocator(IEEMemoryManager* memoryManager)
     , m_lastPage(nullptr)
     , m_nextFreeByte(nullptr)
     , m_lastFreeByte(nullptr)
+    , m_cachedPages(nullptr)
 {
     assert(getDefaultPageSize() != 0);
     assert(isInitialized());
@@ -121,12 +154,14 @@ ArenaAllocator& ArenaAllocator::operator=(ArenaAllocator&& other)
     m_lastPage      = other.m_lastPage;
     m_nextFreeByte  = other.m_nextFreeByte;
     m_lastFreeByte  = other.m_lastFreeByte;
+    m_cachedPages   = other.m_cachedPages;
 
     other.m_memoryManager = nullptr;
     other.m_firstPage     = nullptr;
     other.m_lastPage      = nullptr;
     other.m_nextFreeByte  = nullptr;
     other.m_lastFreeByte  = nullptr;
+    other.m_cachedPages   = nullptr;
 
     return *this;
 }
@@ -185,16 +220,28 @@ void* ArenaAllocator::allocateNewPage(size_t size, bool canThrow)
         pageSize = roundUp(pageSize, DEFAULT_PAGE_SIZE);
     }
 
-    // Allocate the new page
-    PageDescriptor* newPage = (PageDescriptor*)allocateHostMemory(pageSize);
-    if (newPage == nullptr)
+    // Reuse a page kept by a pooled allocator if one is large enough, otherwise allocate the new page
+    PageDescriptor* newPage = takeCachedPage(pageSize);
+    if (newPage != nullptr)
     {
-        if (canThrow)
+        pageSize = newPage->m_pageBytes;
+    }
+    else
+    {
+        newPage = (PageDescriptor*)allocateHostMemory(pageSize);
+        if (newPage == nullptr)
         {
-            NOMEM();
+            if (canThrow)
+            {
+                NOMEM();
+            }
+
+            return nullptr;
         }
 
-        return nullptr;
+#if MEASURE_MEM_ALLOC
+        InterlockedIncrement(&s_hostPageAllocCount);
+#endif // MEASURE_MEM_ALLOC
     }
 
     // Append the new page to the end of the list
@@ -224,12 +271,42 @@ void* ArenaAllocator::allocateNewPage(size_t size, bool canThrow)
     return newPage->m_contents;
 }
 
+//------------------------------------------------------------------------
+// ArenaAllocator::takeCachedPage:
+//    Removes the first cached page that is at least the requested size
+//    from the list of cached pages.
+//
+// Arguments:
+//    pageSize - The minimum size of the page, including its descriptor.
+//
+// Return Value:
+//    The cached page, or `nullptr` if no cached page is large enough.
+ArenaAllocator::PageDescriptor* ArenaAllocator::takeCachedPage(size_t pageSize)
+{
+    for (PageDescriptor **link = &m_cachedPages, *page; (page = *link) != nullptr; link = &page->m_next)
+    {
+        if (page->m_pageBytes >= pageSize)
+        {
+            *link = page->m_next;
+
+#if MEASURE_MEM_ALLOC
+            InterlockedIncrement(&s_cachedPageAllocCount);
+#endif // MEASURE_MEM_ALLOC
+
+            return page;
+        }
+    }
+
+    return nullptr;
+}
+
 //------------------------------------------------------------------------
 // ArenaAllocator::destroy:
 //    Performs any necessary teardown for an `ArenaAllocator`.
 void ArenaAllocator::destroy()
 {
     assert(isInitialized());
+    assert(m_cachedPages == nullptr);
 
     // Free all of the allocated pages
     for (PageDescriptor *page = m_firstPage, *next; page != nullptr; page = next)
@@ -422,6 +499,8 @@ size_t ArenaAllocator::getTotalBytesUsed()
 void ArenaAllocator::startup()
 {
     s_defaultPageSize = bypassHostAllocator() ? (size_t)MIN_PAGE_SIZE : (size_t)DEFAULT_PAGE_SIZE;
+
+    PooledAllocator::startup();
 }
 
 //------------------------------------------------------------------------
@@ -432,13 +511,31 @@ void ArenaAllocator::shutdown()
     PooledAllocator::shutdown();
 }
 
-PooledAllocator PooledAllocator::s_pooledAllocator;
-LONG            PooledAllocator::s_pooledAllocatorState = POOLED_ALLOCATOR_NOTINITIALIZED;
+#if MEASURE_MEM_ALLOC
+//------------------------------------------------------------------------
+// ArenaAllocator::dumpPoolStats:
+//    Prints the number of arena pages obtained from the host and reused
+//    from pooled allocators.
+//
+// Arguments:
+//    f - The file to print to.
+void ArenaAllocator::dumpPoolStats(FILE* f)
+{
+    fprintf(f, "Arena pages: %u allocated from the host, %u reused from pooled allocators\n",
+            (unsigned)s_hostPageAllocCount, (unsigned)s_cachedPageAllocCount);
+}
+#endif // MEASURE_MEM_ALLOC
+
+PooledAllocator PooledAllocator::s_pooledAllocators[MAX_POOLED_ALLOCATORS];
+LONG            PooledAllocator::s_pooledAllocatorStates[MAX_POOLED_ALLOCATORS]; // POOLED_ALLOCATOR_NOTINITIALIZED
+unsigned        PooledAllocator::s_pooledAllocatorCount = 1;
+size_t          PooledAllocator::s_maxRetainedBytes     = 0;
 
 //------------------------------------------------------------------------
 // PooledAllocator::PooledAllocator:
 //    Constructs a `PooledAllocator`.
-PooledAllocator::PooledAllocator(IEEMemoryManager* memoryManager) : ArenaAllocator(memoryManager)
+PooledAllocator::PooledAllocator(IEEMemoryManager* memoryManager)
+    : ArenaAllocator(memoryManager), m_highWaterMark(0)
 {
 }
 
@@ -448,107 +545,181 @@ PooledAllocator::PooledAllocator(IEEMemoryManager* memoryManager) : ArenaAllocat
 PooledAllocator& PooledAllocator::operator=(PooledAllocator&& other)
 {
     *((ArenaAllocator*)this) = std::move((ArenaAllocator &&)other);
+    m_highWaterMark          = other.m_highWaterMark;
     return *this;
 }
 
+//------------------------------------------------------------------------
+// PooledAllocator::startup:
+//    Reads the configuration for the pooled allocators.
+void PooledAllocator::startup()
+{
+    unsigned poolSize = JitConfig.JitArenaPoolSize();
+    if (poolSize < 1)
+    {
+        poolSize = 1;
+    }
+    else if (poolSize > MAX_POOLED_ALLOCATORS)
+    {
+        poolSize = MAX_POOLED_ALLOCATORS;
+    }
+
+    s_pooledAllocatorCount = poolSize;
+    s_maxRetainedBytes     = (size_t)JitConfig.JitArenaPoolRetainKB() * 1024;
+}
+
+//------------------------------------------------------------------------
+// PooledAllocator::getPoolIndex:
+//    Returns the index of this allocator in the pool.
+unsigned PooledAllocator::getPoolIndex()
+{
+    assert((this >= &s_pooledAllocators[0]) && (this < &s_pooledAllocators[MAX_POOLED_ALLOCATORS]));
+    return (unsigned)(this - &s_pooledAllocators[0]);
+}
+
+//------------------------------------------------------------------------
+// PooledAllocator::freeCachedPages:
+//    Returns all of the cached pages to the host.
+void PooledAllocator::freeCachedPages()
+{
+    for (PageDescriptor *page = m_cachedPages, *next; page != nullptr; page = next)
+    {
+        next = page->m_next;
+        freeHostMemory(page);
+    }
+
+    m_cachedPages = nullptr;
+}
+
 //------------------------------------------------------------------------
 // PooledAllocator::shutdown:
-//    Performs any necessary teardown for the pooled allocator.
+//    Performs any necessary teardown for the pooled allocators.
 //
 // Notes:
-//    If the allocator has been initialized and is in use when this method is called,
+//    If an allocator has been initialized and is in use when this method is called,
 //    it is up to whatever is using the pooled allocator to call `destroy` in order
 //    to free its memory.
 void PooledAllocator::shutdown()
 {
-    LONG oldState = InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_SHUTDOWN);
-    switch (oldState)
+    for (unsigned i = 0; i < MAX_POOLED_ALLOCATORS; i++)
     {
-        case POOLED_ALLOCATOR_NOTINITIALIZED:
-        case POOLED_ALLOCATOR_SHUTDOWN:
-        case POOLED_ALLOCATOR_IN_USE:
-            return;
-
-        case POOLED_ALLOCATOR_AVAILABLE:
-            // The pooled allocator was initialized and not in use; we must destroy it.
-            s_pooledAllocator.destroy();
-            break;
+        LONG oldState = InterlockedExchange(&s_pooledAllocatorStates[i], POOLED_ALLOCATOR_SHUTDOWN);
+        switch (oldState)
+        {
+            case POOLED_ALLOCATOR_NOTINITIALIZED:
+            case POOLED_ALLOCATOR_SHUTDOWN:
+            case POOLED_ALLOCATOR_IN_USE:
+                break;
+
+            case POOLED_ALLOCATOR_AVAILABLE:
+                // The pooled allocator was initialized and not in use; we must destroy it.
+                s_pooledAllocators[i].freeCachedPages();
+                s_pooledAllocators[i].ArenaAllocator::destroy();
+                break;
+        }
     }
 }
 
 //------------------------------------------------------------------------
 // PooledAllocator::getPooledAllocator:
-//    Returns the pooled allocator if it is not already in use.
+//    Returns a pooled allocator if one is not already in use.
 //
 // Arguments:
 //    memoryManager: The `IEEMemoryManager` instance in use by the caller.
 //
 // Return Value:
-//    A pointer to the pooled allocator if it is available or `nullptr`
-//    if it is already in use.
+//    A pointer to a pooled allocator if one is available or `nullptr`
+//    if they are all already in use.
 //
 // Notes:
 //    Calling `destroy` on the returned allocator will return it to the
 //    pool.
 ArenaAllocator* PooledAllocator::getPooledAllocator(IEEMemoryManager* memoryManager)
 {
-    LONG oldState = InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_IN_USE);
-    switch (oldState)
+    for (unsigned i = 0; i < s_pooledAllocatorCount; i++)
     {
-        case POOLED_ALLOCATOR_IN_USE:
-        case POOLED_ALLOCATOR_SHUTDOWN:
-            // Either the allocator is in use or this call raced with a call to `shutdown`.
-            // Return `nullptr`.
-            return nullptr;
+        LONG* state = &s_pooledAllocatorStates[i];
 
-        case POOLED_ALLOCATOR_AVAILABLE:
-            if (s_pooledAllocator.m_memoryManager != memoryManager)
+        if (InterlockedCompareExchange(state, POOLED_ALLOCATOR_IN_USE, POOLED_ALLOCATOR_AVAILABLE) ==
+            POOLED_ALLOCATOR_AVAILABLE)
+        {
+            if (s_pooledAllocators[i].m_memoryManager != memoryManager)
             {
                 // The allocator is available, but it was initialized with a different
-                // memory manager. Release it and return `nullptr`.
-                InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_AVAILABLE);
-                return nullptr;
+                // memory manager. Release it and try the next one.
+                InterlockedExchange(state, POOLED_ALLOCATOR_AVAILABLE);
+                continue;
             }
 
-            return &s_pooledAllocator;
+            return &s_pooledAllocators[i];
+        }
 
-        case POOLED_ALLOCATOR_NOTINITIALIZED:
+        if (InterlockedCompareExchange(state, POOLED_ALLOCATOR_IN_USE, POOLED_ALLOCATOR_NOTINITIALIZED) ==
+            POOLED_ALLOCATOR_NOTINITIALIZED)
         {
             PooledAllocator allocator(memoryManager);
             if (allocator.allocateNewPage(0, false) == nullptr)
             {
                 // Failed to grab the initial memory page.
-                InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_NOTINITIALIZED);
+                InterlockedExchange(state, POOLED_ALLOCATOR_NOTINITIALIZED);
                 return nullptr;
             }
 
-            s_pooledAllocator = std::move(allocator);
+            s_pooledAllocators[i] = std::move(allocator);
+            return &s_pooledAllocators[i];
         }
 
-            return &s_pooledAllocator;
-
-        default:
-            assert(!"Unknown pooled allocator state");
-            unreached();
+        // Either the allocator is in use or this call raced with a call to `shutdown`.
     }
+
+    return nullptr;
 }
 
 //------------------------------------------------------------------------
 // PooledAllocator::destroy:
 //    Performs any necessary teardown for an `PooledAllocator` and returns the allocator
 //    to the pool.
+//
+// Notes:
+//    The first page is always kept. Further pages are moved to the list of cached
+//    pages until the allocator holds as many bytes as its high-water mark, capped at
+//    JitArenaPoolRetainKB; the rest are returned to the host. The high-water mark
+//    decays by 1/8 per compilation so that one unusually large method does not pin
+//    its memory for the life of the process.
 void PooledAllocator::destroy()
 {
     assert(isInitialized());
-    assert(this == &s_pooledAllocator);
-    assert(s_pooledAllocatorState == POOLED_ALLOCATOR_IN_USE || s_pooledAllocatorState == POOLED_ALLOCATOR_SHUTDOWN);
+
+    LONG* state = &s_pooledAllocatorStates[getPoolIndex()];
+    assert(*state == POOLED_ALLOCATOR_IN_USE || *state == POOLED_ALLOCATOR_SHUTDOWN);
     assert(m_firstPage != nullptr);
+    assert(m_firstPage->m_pageBytes == s_defaultPageSize);
+
+    size_t bytesAllocated = getTotalBytesAllocated();
+    m_highWaterMark       = max(bytesAllocated, m_highWaterMark - m_highWaterMark / 8);
 
-    // Free all but the first allocated page
+    size_t retainLimit   = min(m_highWaterMark, s_maxRetainedBytes);
+    size_t retainedBytes = m_firstPage->m_pageBytes;
+    for (PageDescriptor* page = m_cachedPages; page != nullptr; page = page->m_next)
+    {
+        retainedBytes += page->m_pageBytes;
+    }
+
+    // Cache or free all but the first allocated page
     for (PageDescriptor *page = m_firstPage->m_next, *next; page != nullptr; page = next)
     {
         next = page->m_next;
-        freeHostMemory(page);
+
+        if (retainedBytes + page->m_pageBytes <= retainLimit)
+        {
+            retainedBytes += page->m_pageBytes;
+            page->m_next  = m_cachedPages;
+            m_cachedPages = page;
+        }
+        else
+        {
+            freeHostMemory(page);
+        }
     }
 
     // Reset the relevant state to point back to the first byte of the first page
@@ -559,14 +730,15 @@ void PooledAllocator::destroy()
 
     assert(getTotalBytesAllocated() == s_defaultPageSize);
 
-    // If we've already been shut down, free the first page. Otherwise, return the allocator to the pool.
-    if (s_pooledAllocatorState == POOLED_ALLOCATOR_SHUTDOWN)
+    // If we've already been shut down, free the remaining pages. Otherwise, return the allocator to the pool.
+    if (*state == POOLED_ALLOCATOR_SHUTDOWN)
     {
+        freeCachedPages();
         ArenaAllocator::destroy();
     }
     else
     {
-        InterlockedExchange(&s_pooledAllocatorState, POOLED_ALLOCATOR_AVAILABLE);
+        InterlockedExchange(state, POOLED_ALLOCATOR_AVAILABLE);
     }
 }
 
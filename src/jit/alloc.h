@@ -47,9 +47,15 @@ protected:
     BYTE* m_nextFreeByte;
     BYTE* m_lastFreeByte;
 
+    // Pages kept warm across compilations by a pooled allocator. These are not part of
+    // the m_firstPage list and are handed out again by allocateNewPage. Always null for
+    // allocators that are not pooled.
+    PageDescriptor* m_cachedPages;
+
     bool isInitialized();
 
     void* allocateNewPage(size_t size, bool canThrow);
+    PageDescriptor* takeCachedPage(size_t pageSize);
 
     void* allocateHostMemory(size_t size);
     void freeHostMemory(void* block);
@@ -94,6 +100,10 @@ public:
     static void shutdown();
 
     static ArenaAllocator* getPooledAllocator(IEEMemoryManager* memoryManager);
+
+#if MEASURE_MEM_ALLOC
+    static void dumpPoolStats(FILE* f);
+#endif // MEASURE_MEM_ALLOC
 };
 
 #endif // _ALLOC_H_
@@ -710,6 +710,12 @@ regMaskTP Compiler::compNoGCHelperCallKillSet(CorInfoHelpFunc helper)
             return RBM_CALLEE_TRASH_NOGC;
 #endif // defined(_TARGET_AMD64_)
 
+#if defined(_TARGET_AMD64_)
+        case CORINFO_HELP_GETCURRENTTHREAD:
+            // this helper calls GetThread, but preserves the first two argument registers
+            return RBM_CALLEE_TRASH & ~(RBM_ARG_0 | RBM_ARG_1);
+#endif // defined(_TARGET_AMD64_)
+
         default:
             return RBM_CALLEE_TRASH_NOGC;
     }
@@ -4183,7 +4189,8 @@ void CodeGen::genFnPrologCalleeRegArgs(regNumber xtraReg, bool* pXtraRegClobbere
 
             if (promotionType == Compiler::PROMOTION_TYPE_INDEPENDENT)
             {
-                noway_assert(parentVarDsc->lvFieldCnt == 1); // We only handle one field here
+                // We only handle one field here, or one field per register of a multireg struct
+                noway_assert((parentVarDsc->lvFieldCnt == 1) || parentVarDsc->lvIsMultiRegPromotedParam());
 
                 // For register arguments that are independent promoted structs we put the promoted field varNum in the
                 // regArgTab[]
@@ -261,6 +261,10 @@ void genCodeForArrOffset(GenTreeArrOffs* treeNode);
 instruction genGetInsForOper(genTreeOps oper, var_types type);
 bool genEmitOptimizedGCWriteBarrier(GCInfo::WriteBarrierForm writeBarrierForm, GenTree* addr, GenTree* data);
 void genCallInstruction(GenTreeCall* call);
+#ifdef _TARGET_AMD64_
+bool genCanExpandAllocInline(GenTreeCall* call, CorInfoHelpFunc helper);
+void genInlineAllocFastPath(CorInfoHelpFunc helper, BasicBlock* slowPathLabel, BasicBlock* doneLabel);
+#endif // _TARGET_AMD64_
 void genJmpMethod(GenTreePtr jmp);
 BasicBlock* genCallFinally(BasicBlock* block);
 void genCodeForJumpTrue(GenTreePtr tree);
@@ -4928,6 +4928,152 @@ bool CodeGen::genEmitOptimizedGCWriteBarrier(GCInfo::WriteBarrierForm writeBarri
 #endif // !defined(_TARGET_X86_) || !NOGC_WRITE_BARRIERS
 }
 
+#ifdef _TARGET_AMD64_
+//------------------------------------------------------------------------
+// genCanExpandAllocInline: Check whether the fast path of an allocation helper call
+//    can be expanded inline in front of the call.
+//
+// Arguments:
+//    call   - the helper call
+//    helper - the helper being called
+//
+// Return Value:
+//    true if genInlineAllocFastPath can be used for this call.
+//
+// Notes:
+//    The EE reports where the thread's allocation context lives only when the
+//    allocation helpers themselves are the fast ones, so allocation tracking and
+//    logging still see every allocation. Rarely run and unoptimized code keep the
+//    smaller helper call.
+//
+//    The fast path relies on calls being the only GC safe points in the method
+//    (see genInlineAllocFastPath), so it is not expanded in fully interruptible
+//    methods.
+//
+bool CodeGen::genCanExpandAllocInline(GenTreeCall* call, CorInfoHelpFunc helper)
+{
+    if ((helper != CORINFO_HELP_NEWSFAST) && (helper != CORINFO_HELP_NEWARR_1_VC) &&
+        (helper != CORINFO_HELP_NEWARR_1_OBJ))
+    {
+        return false;
+    }
+
+    if ((JitConfig.JitInlineAllocation() == 0) || compiler->opts.MinOpts() || compiler->opts.compDbgCode ||
+        compiler->opts.jitFlags->IsSet(JitFlags::JIT_FLAG_PREJIT) || compiler->opts.compReloc)
+    {
+        return false;
+    }
+
+    if (genInterruptible || compiler->compCurBB->isRunRarely())
+    {
+        return false;
+    }
+
+    return compiler->eeGetEEInfo()->inlineAllocInfo.offsetOfAllocContext != 0;
+}
+
+//------------------------------------------------------------------------
+// genInlineAllocFastPath: Generate the bump pointer allocation fast path of an
+//    allocation helper, branching to the helper call when it does not apply.
+//
+// Arguments:
+//    helper        - CORINFO_HELP_NEWSFAST, CORINFO_HELP_NEWARR_1_VC or CORINFO_HELP_NEWARR_1_OBJ
+//    slowPathLabel - the label of the helper call
+//    doneLabel     - the label following the helper call
+//
+// Notes:
+//    The arguments are already in their registers (MethodTable in REG_ARG_0, element
+//    count in REG_ARG_1 for arrays) and are preserved for the helper call. The new
+//    object is left in REG_INTRET, as the helper would. Only registers killed by the
+//    call are used. The generated code, for an array, is:
+//
+//        cmp   rsi, maxArrayLength
+//        jae   SLOW
+//        call  CORINFO_HELP_GETCURRENTTHREAD
+//        movzx r11d, word ptr [rdi + componentSize]
+//        imul  r11, rsi
+//        mov   r10d, dword ptr [rdi + baseSize]
+//        lea   r11, [r11 + r10 + 7]
+//        and   r11, -8
+//        mov   r10, qword ptr [rax + allocContext + allocPtr]
+//        add   r11, r10
+//        cmp   r11, qword ptr [rax + allocContext + allocLimit]
+//        ja    SLOW
+//        mov   qword ptr [rax + allocContext + allocPtr], r11
+//        mov   qword ptr [r10], rdi
+//        mov   dword ptr [r10 + length], esi
+//        mov   rax, r10
+//        jmp   DONE
+//
+//    Objects load their size from the MethodTable and skip the length handling.
+//    CORINFO_HELP_GETCURRENTTHREAD preserves rdi and rsi and is a no-GC helper, so
+//    its call is not a GC safe point.
+//
+//    A GC must never see the allocation context bumped past an object that has no
+//    MethodTable yet. The sequence is only expanded in methods that are not fully
+//    interruptible, where calls to helpers that can GC are the only GC safe points,
+//    so no GC can happen in the middle of it. It is not emitted as a no-GC region:
+//    those can't contain jumps.
+//
+void CodeGen::genInlineAllocFastPath(CorInfoHelpFunc helper, BasicBlock* slowPathLabel, BasicBlock* doneLabel)
+{
+    const CORINFO_EE_INFO::InlineAllocInfo& info    = compiler->eeGetEEInfo()->inlineAllocInfo;
+    emitter*                                emit    = getEmitter();
+    const bool                              isArray = (helper != CORINFO_HELP_NEWSFAST);
+
+    const regNumber mtReg      = REG_ARG_0;
+    const regNumber lengthReg  = REG_ARG_1;
+    const regNumber threadReg  = REG_INTRET;
+    const regNumber objReg     = REG_R10;
+    const regNumber sizeReg    = REG_R11;
+
+    const unsigned allocPtrOffset   = info.offsetOfAllocContext + info.offsetOfAllocPtr;
+    const unsigned allocLimitOffset = info.offsetOfAllocContext + info.offsetOfAllocLimit;
+
+    assert((genRegMask(objReg) & (RBM_CALLEE_TRASH & ~RBM_ARG_REGS)) != 0);
+    assert((genRegMask(sizeReg) & (RBM_CALLEE_TRASH & ~RBM_ARG_REGS)) != 0);
+    assert(!genInterruptible);
+
+    if (isArray)
+    {
+        // Negative and large element counts go to the helper, which also keeps the size
+        // computation below from overflowing.
+        emit->emitIns_R_I(INS_cmp, EA_8BYTE, lengthReg, info.maxArrayLength);
+        inst_JMP(EJ_jae, slowPathLabel);
+    }
+
+    // The helper kills the registers used below, but not the arguments.
+    genEmitHelperCall(CORINFO_HELP_GETCURRENTTHREAD, 0, EA_PTRSIZE);
+
+    if (isArray)
+    {
+        emit->emitIns_R_AR(INS_movzx, EA_2BYTE, sizeReg, mtReg, info.offsetOfComponentSize);
+        emit->emitIns_R_R(INS_imul, EA_8BYTE, sizeReg, lengthReg);
+        emit->emitIns_R_AR(INS_mov, EA_4BYTE, objReg, mtReg, info.offsetOfBaseSize);
+        emit->emitIns_R_ARR(INS_lea, EA_8BYTE, sizeReg, sizeReg, objReg, TARGET_POINTER_SIZE - 1);
+        emit->emitIns_R_I(INS_and, EA_8BYTE, sizeReg, ~(ssize_t)(TARGET_POINTER_SIZE - 1));
+    }
+    else
+    {
+        emit->emitIns_R_AR(INS_mov, EA_4BYTE, sizeReg, mtReg, info.offsetOfBaseSize);
+    }
+
+    emit->emitIns_R_AR(INS_mov, EA_8BYTE, objReg, threadReg, allocPtrOffset);
+    emit->emitIns_R_R(INS_add, EA_8BYTE, sizeReg, objReg);
+    emit->emitIns_R_AR(INS_cmp, EA_8BYTE, sizeReg, threadReg, allocLimitOffset);
+    inst_JMP(EJ_ja, slowPathLabel);
+
+    emit->emitIns_AR_R(INS_mov, EA_8BYTE, sizeReg, threadReg, allocPtrOffset);
+    emit->emitIns_AR_R(INS_mov, EA_8BYTE, mtReg, objReg, 0);
+    if (isArray)
+    {
+        emit->emitIns_AR_R(INS_mov, EA_4BYTE, lengthReg, objReg, offsetof(CORINFO_Array, length));
+    }
+    emit->emitIns_R_R(INS_mov, EA_8BYTE, REG_INTRET, objReg);
+    inst_JMP(EJ_jmp, doneLabel);
+}
+#endif // _TARGET_AMD64_
+
 // Produce code for a GT_CALL node
 void CodeGen::genCallInstruction(GenTreeCall* call)
 {
@@ -5160,6 +5306,9 @@ void CodeGen::genCallInstruction(GenTreeCall* call)
 
     bool            fPossibleSyncHelperCall = false;
     CorInfoHelpFunc helperNum               = CORINFO_HELP_UNDEF;
+#ifdef _TARGET_AMD64_
+    BasicBlock* allocDoneLabel = nullptr;
+#endif // _TARGET_AMD64_
 
     // We need to propagate the IL offset information to the call instruction, so we can emit
     // an IL to native mapping record for the call, to support managed return value debugging.
@@ -5347,6 +5496,16 @@ void CodeGen::genCallInstruction(GenTreeCall* call)
             {
                 fPossibleSyncHelperCall = true;
             }
+
+#ifdef _TARGET_AMD64_
+            if (genCanExpandAllocInline(call, helperNum))
+            {
+                BasicBlock* slowPathLabel = genCreateTempLabel();
+                allocDoneLabel            = genCreateTempLabel();
+                genInlineAllocFastPath(helperNum, slowPathLabel, allocDoneLabel);
+                genDefineTempLabel(slowPathLabel);
+            }
+#endif // _TARGET_AMD64_
         }
         else
         {
@@ -5386,6 +5545,19 @@ void CodeGen::genCallInstruction(GenTreeCall* call)
     gcInfo.gcRegGCrefSetCur &= ~RBM_ARG_REGS;
     gcInfo.gcRegByrefSetCur &= ~RBM_ARG_REGS;
 
+#ifdef _TARGET_AMD64_
+    if (allocDoneLabel != nullptr)
+    {
+        // The inline allocation fast path joins here with the new object in RAX, just
+        // as the helper call returns it.
+        assert(call->TypeGet() == TYP_REF);
+        allocDoneLabel->bbEmitCookie = getEmitter()->emitAddLabel(gcInfo.gcVarPtrSetCur,
+                                                                  gcInfo.gcRegGCrefSetCur | RBM_INTRET,
+                                                                  gcInfo.gcRegByrefSetCur);
+        regTracker.rsTrackRegClrPtr();
+    }
+#endif // _TARGET_AMD64_
+
     var_types returnType = call->TypeGet();
     if (returnType != TYP_VOID)
     {
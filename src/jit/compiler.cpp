@@ -1333,6 +1333,9 @@ size_t genFlowNodeCnt;
 unsigned Compiler::s_compMethodsCount = 0; // to produce unique label names
 #endif
 
+/* static */
+LONG Compiler::s_impBoxesRemoved = 0;
+
 #if MEASURE_MEM_ALLOC
 /* static */
 bool Compiler::s_dspMemStats = false;
@@ -1449,6 +1452,11 @@ void Compiler::compShutdown()
     }
 #endif // COUNT_RANGECHECKS
 
+    if (JitConfig.JitReportBoxesRemoved() != 0)
+    {
+        fprintf(fout, "Removed %u boxes\n", (unsigned)s_impBoxesRemoved);
+    }
+
 #if COUNT_AST_OPERS
 
     // Add up all the counts so that we can show percentages of total
@@ -1667,6 +1675,9 @@ void Compiler::compShutdown()
         fprintf(fout, "\nLargest method:\n");
         s_maxCompMemStats.Print(jitstdout);
 
+        fprintf(fout, "\n");
+        ArenaAllocator::dumpPoolStats(fout);
+
         fprintf(fout, "\n");
         fprintf(fout, "---------------------------------------------------\n");
         fprintf(fout, "Distribution of total memory allocated per method (in KB):\n");
@@ -1973,7 +1984,9 @@ void Compiler::compInit(ArenaAllocator* pAlloc, InlineInfo* inlineInfo)
         // Initialize all the per-method statistics gathering data structures.
         //
 
-        optLoopsCloned = 0;
+        optLoopsCloned     = 0;
+        optLoopsVectorized = 0;
+        impBoxesRemoved    = 0;
 
 #if MEASURE_MEM_ALLOC
         genMemStats.Init();
@@ -3531,7 +3544,7 @@ void Compiler::compInitOptions(JitFlags* jitFlags)
 #ifdef DEBUG
         // JitForceProcedureSplitting is used to force procedure splitting on checked assemblies.
         // This is useful for debugging on a checked build.  Note that we still only do procedure
-        // splitting in the zapper.
+        // splitting when the VM asks for it (in the zapper, and for tier 1 code where supported).
         if (JitConfig.JitForceProcedureSplitting().contains(info.compMethodName, info.compClassName,
                                                             &info.compMethodInfo->args))
         {
@@ -4566,6 +4579,12 @@ void Compiler::compCompile(void** methodCodePtr, ULONG* methodCodeSize, JitFlags
         optCloneLoops();
         EndPhase(PHASE_CLONE_LOOPS);
 
+#if defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
+        // Vectorize simple array loops, using the bounds-check-free fast paths created by cloning.
+        optVectorizeLoops();
+        EndPhase(PHASE_VECTORIZE_LOOPS);
+#endif // defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
+
         /* Unroll loops */
         optUnrollLoops();
         EndPhase(PHASE_UNROLL_LOOPS);
@@ -8005,6 +8024,8 @@ void JitTimer::PrintCsvHeader()
             fprintf(fp, "\"Basic Blocks\",");
             fprintf(fp, "\"Min Opts\",");
             fprintf(fp, "\"Loops Cloned\",");
+            fprintf(fp, "\"Loops Vectorized\",");
+            fprintf(fp, "\"Boxes Removed\",");
 
             for (int i = 0; i < PHASE_NUMBER_OF; i++)
             {
@@ -8067,6 +8088,8 @@ void JitTimer::PrintCsvMethodStats(Compiler* comp)
     fprintf(fp, "%u,", comp->fgBBcount);
     fprintf(fp, "%u,", comp->opts.MinOpts());
     fprintf(fp, "%u,", comp->optLoopsCloned);
+    fprintf(fp, "%u,", comp->optLoopsVectorized);
+    fprintf(fp, "%u,", comp->impBoxesRemoved);
     unsigned __int64 totCycles = 0;
     for (int i = 0; i < PHASE_NUMBER_OF; i++)
     {
@@ -8124,13 +8147,14 @@ void Compiler::MemStats::Print(FILE* f)
 
 void Compiler::MemStats::PrintByKind(FILE* f)
 {
-    fprintf(f, "\nAlloc'd bytes by kind:\n  %20s | %10s | %7s\n", "kind", "size", "pct");
-    fprintf(f, "  %20s-+-%10s-+-%7s\n", "--------------------", "----------", "-------");
+    fprintf(f, "\nAlloc'd bytes by kind:\n  %20s | %10s | %10s | %7s\n", "kind", "count", "size", "pct");
+    fprintf(f, "  %20s-+-%10s-+-%10s-+-%7s\n", "--------------------", "----------", "----------", "-------");
     float allocSzF = static_cast<float>(allocSz);
     for (int cmk = 0; cmk < CMK_Count; cmk++)
     {
         float pct = 100.0f * static_cast<float>(allocSzByKind[cmk]) / allocSzF;
-        fprintf(f, "  %20s | %10llu | %6.2f%%\n", s_CompMemKindNames[cmk], allocSzByKind[cmk], pct);
+        fprintf(f, "  %20s | %10u | %10llu | %6.2f%%\n", s_CompMemKindNames[cmk], allocCntByKind[cmk],
+                allocSzByKind[cmk], pct);
     }
     fprintf(f, "\n");
 }
@@ -9316,6 +9340,10 @@ int cTreeFlagsIR(Compiler* comp, GenTree* tree)
                 {
                     chars += printf("[IND_ARR_INDEX]");
                 }
+                if (tree->gtFlags & GTF_IND_FRESH_OBJ)
+                {
+                    chars += printf("[IND_FRESH_OBJ]");
+                }
                 break;
 
             case GT_CLS_VAR:
@@ -692,6 +692,18 @@ public:
 #endif // defined(_TARGET_64BIT_)
     }
 
+    // Is this a struct parameter passed in more than one register that has been promoted
+    // into one field per register? Only System V AMD64 creates these; everywhere else a
+    // promoted parameter has exactly one field.
+    bool lvIsMultiRegPromotedParam()
+    {
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+        return lvPromoted && lvIsParam && lvIsRegArg && (lvFieldCnt > 1);
+#else
+        return false;
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
+    }
+
     unsigned lvSize() const // Size needed for storage representation. Only used for structs or TYP_BLK.
     {
         // TODO-Review: Sometimes we get called on ARM with HFA struct variables that have been promoted,
@@ -2741,6 +2753,9 @@ public:
                                  bool                    sortFields);
     void lvaCanPromoteStructVar(unsigned lclNum, lvaStructPromotionInfo* StructPromotionInfo);
     bool lvaShouldPromoteStructVar(unsigned lclNum, lvaStructPromotionInfo* structPromotionInfo);
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+    bool lvaCanPromoteTwoRegParam(LclVarDsc* varDsc, lvaStructPromotionInfo* structPromotionInfo);
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
     void lvaPromoteStructVar(unsigned lclNum, lvaStructPromotionInfo* StructPromotionInfo);
 #if !defined(_TARGET_64BIT_)
     void lvaPromoteLongVars();
@@ -2906,6 +2921,12 @@ protected:
                                   CORINFO_CALL_INFO*      pCallInfo);
 
     void impImportAndPushBox(CORINFO_RESOLVED_TOKEN* pResolvedToken);
+    bool impBoxPatternMatch(CORINFO_RESOLVED_TOKEN* pResolvedToken,
+                            const BYTE*             codeAddr,
+                            const BYTE*             codeEndp,
+                            unsigned*               pSkip);
+    bool impCanDiscardBoxedValue();
+    void impDiscardBoxedValue();
 
     void impImportNewObjArray(CORINFO_RESOLVED_TOKEN* pResolvedToken, CORINFO_CALL_INFO* pCallInfo);
 
@@ -3623,6 +3644,9 @@ public:
 
     bool     impBoxTempInUse; // the temp below is valid and available
     unsigned impBoxTemp;      // a temporary that is used for boxing
+    unsigned impBoxesRemoved; // number of boxes imported without an allocation in the current method
+
+    static LONG s_impBoxesRemoved; // number of boxes imported without an allocation in all methods
 
 #ifdef DEBUG
     bool jitFallbackCompile; // Are we doing a fallback compile? That is, have we executed a NO_WAY assert,
@@ -5102,6 +5126,18 @@ public:
 
     void optUnrollLoops(); // Unrolls loops (needs to have cost info)
 
+#if defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
+    // Rewrite simple counted loops over primitive arrays to process a SIMD vector of elements per iteration.
+    void optVectorizeLoops();
+
+protected:
+    bool optVectorizeLoop(unsigned loopInd);
+    GenTree* optVectorizableArrayElem(GenTree* tree, unsigned iterVar, var_types elemType);
+    bool optIsVectorizableLoopExpr(GenTree* tree, unsigned iterVar, var_types elemType);
+    GenTree* optVectorizeLoopExpr(
+        GenTree* tree, unsigned iterVar, var_types simdType, var_types baseType, unsigned simdSize);
+#endif // defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
+
 protected:
     // This enumeration describes what is killed by a call.
 
@@ -5138,7 +5174,7 @@ public:
         ALLVARSET_TP lpAsgVars;     // set of vars assigned within the loop (all vars, not just tracked)
         varRefKinds  lpAsgInds : 8; // set of inds modified within the loop
 
-        unsigned short lpFlags; // Mask of the LPFLG_* constants
+        unsigned lpFlags; // Mask of the LPFLG_* constants
 
         unsigned char lpExitCnt; // number of exits from the loop
 
@@ -5174,6 +5210,9 @@ public:
 #define LPFLG_ASGVARS_INC 0x8000 // "lpAsgVars" is incomplete -- vars beyond those representable in an AllVarSet
                                  // type are assigned to.
 
+#define LPFLG_BNDCHKS_REMOVED 0x10000 // loop cloning proved that the iterator stays in bounds of the arrays it
+                                      // indexes, and removed those bounds checks (the fast path of a cloned loop)
+
         bool lpLoopHasMemoryHavoc[MemoryKindCount]; // The loop contains an operation that we assume has arbitrary
                                                     // memory side effects.  If this is set, the fields below
                                                     // may not be accurate (since they become irrelevant.)
@@ -5318,6 +5357,7 @@ protected:
     unsigned optIndirectCallCount; // number of virtual, interface and indirect calls made in the method
     unsigned optNativeCallCount;   // number of Pinvoke/Native calls made in the method
     unsigned optLoopsCloned;       // number of loops cloned in the current method.
+    unsigned optLoopsVectorized;   // number of loops vectorized in the current method.
 
 #ifdef DEBUG
     unsigned optFindLoopNumberFromBeginBlock(BasicBlock* begBlk);
@@ -8518,6 +8558,7 @@ public:
         UINT64   allocSz;                  // total size of those alloc.
         UINT64   allocSzMax;               // Maximum single allocation.
         UINT64   allocSzByKind[CMK_Count]; // Classified by "kind".
+        unsigned allocCntByKind[CMK_Count];
         UINT64   nraTotalSizeAlloc;
         UINT64   nraTotalSizeUsed;
 
@@ -8527,7 +8568,8 @@ public:
         {
             for (int i = 0; i < CMK_Count; i++)
             {
-                allocSzByKind[i] = 0;
+                allocSzByKind[i]  = 0;
+                allocCntByKind[i] = 0;
             }
         }
         MemStats(const MemStats& ms)
@@ -8539,7 +8581,8 @@ public:
         {
             for (int i = 0; i < CMK_Count; i++)
             {
-                allocSzByKind[i] = ms.allocSzByKind[i];
+                allocSzByKind[i]  = ms.allocSzByKind[i];
+                allocCntByKind[i] = ms.allocCntByKind[i];
             }
         }
 
@@ -8558,6 +8601,7 @@ public:
                 allocSzMax = sz;
             }
             allocSzByKind[cmk] += sz;
+            allocCntByKind[cmk] += 1;
         }
 
         void Print(FILE* f);       // Print these stats to f.
@@ -8582,6 +8626,7 @@ public:
             for (int i = 0; i < CMK_Count; i++)
             {
                 allocSzByKind[i] += ms.allocSzByKind[i];
+                allocCntByKind[i] += ms.allocCntByKind[i];
             }
             nraTotalSizeAlloc += ms.nraTotalSizeAlloc;
             nraTotalSizeUsed += ms.nraTotalSizeUsed;
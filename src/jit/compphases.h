@@ -48,6 +48,9 @@ CompPhaseNameMacro(PHASE_OPTIMIZE_LAYOUT,        "Optimize layout",
 CompPhaseNameMacro(PHASE_ALLOCATE_OBJECTS,       "Allocate Objects",               "ALLOC-OBJ",false, -1, false)
 CompPhaseNameMacro(PHASE_OPTIMIZE_LOOPS,         "Optimize loops",                 "LOOP-OPT", false, -1, false)
 CompPhaseNameMacro(PHASE_CLONE_LOOPS,            "Clone loops",                    "LP-CLONE", false, -1, false)
+#if defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
+CompPhaseNameMacro(PHASE_VECTORIZE_LOOPS,        "Vectorize loops",                "LP-VECT",  false, -1, false)
+#endif // defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
 CompPhaseNameMacro(PHASE_UNROLL_LOOPS,           "Unroll loops",                   "UNROLL",   false, -1, false)
 CompPhaseNameMacro(PHASE_HOIST_LOOP_CODE,        "Hoist loop code",                "LP-HOIST", false, -1, false)
 CompPhaseNameMacro(PHASE_MARK_LOCAL_VARS,        "Mark local vars",                "MARK-LCL", false, -1, false)
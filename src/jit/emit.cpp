@@ -2351,6 +2351,8 @@ bool emitter::emitNoGChelper(unsigned IHX)
 
         case CORINFO_HELP_INIT_PINVOKE_FRAME:
 
+        case CORINFO_HELP_GETCURRENTTHREAD:
+
             return true;
     }
 
@@ -271,6 +271,14 @@ GCInfo::WriteBarrierForm GCInfo::gcIsWriteBarrierCandidate(GenTreePtr tgt, GenTr
                 // This case occurs for Span<T>.
                 return WBF_NoBarrier;
             }
+#ifndef LEGACY_BACKEND
+            if ((tgt->gtFlags & GTF_IND_FRESH_OBJ) != 0)
+            {
+                assert(tgt->gtOper == GT_STOREIND);
+                // Lowering proved the target object is freshly allocated and unpublished.
+                return WBF_NoBarrier;
+            }
+#endif // !LEGACY_BACKEND
             return gcWriteBarrierFormFromTargetAddress(tgt->gtOp.gtOp1);
 
         case GT_LEA:
@@ -964,6 +964,9 @@ public:
 #define GTF_IND_ARR_LEN             0x80000000 // GT_IND   -- the indirection represents an array length (of the REF
                                                //             contribution to its argument).
 #define GTF_IND_ARR_INDEX           0x00800000 // GT_IND   -- the indirection represents an (SZ) array index
+#define GTF_IND_FRESH_OBJ           0x00010000 // GT_STOREIND -- the target is in an unpublished gen0 object, so no write
+                                               //                barrier is needed. Every GT_IND specific bit is taken, so
+                                               //                this uses a bit that none of the common flags use.
 
 #define GTF_IND_FLAGS \
     (GTF_IND_VOLATILE | GTF_IND_REFARR_LAYOUT | GTF_IND_TGTANYWHERE | GTF_IND_NONFAULTING | GTF_IND_TLS_REF |          \
@@ -5339,6 +5339,213 @@ void Compiler::impImportAndPushBox(CORINFO_RESOLVED_TOKEN* pResolvedToken)
     impPushOnStack(op1, tiRetVal);
 }
 
+//------------------------------------------------------------------------
+// impBoxPatternMatch: match and import common IL idioms that consume a box
+//   right away, so that the box does not need to be allocated
+//
+// Arguments:
+//    pResolvedToken - resolved token of the box operation
+//    codeAddr       - position in the IL stream just after the box instruction
+//    codeEndp       - end of the IL of the current block
+//    pSkip          - [OUT] number of IL bytes following the box that were imported
+//
+// Return Value:
+//    true if the box was imported, false if it still has to be imported as usual.
+//
+// Notes:
+//    The value on top of the stack is the value being boxed. The patterns are:
+//
+//      box T; unbox.any T            -> the value itself
+//      box T; brtrue/brfalse         -> non-null
+//      box T; isinst C; brtrue/brfalse -> non-null or null, when the cast outcome is known
+//      box T; isinst C               -> box T or null, when the cast outcome is known
+//
+//    The boxed object is consumed by the following instruction in each case, so
+//    it never escapes. Nullable<T> is left alone, as boxing it may produce null.
+//
+//    Constrained calls that need a boxed 'this' are not handled: the callee is
+//    then a method of the boxed type, which the EE only hands out as an
+//    unboxing stub taking the object.
+
+bool Compiler::impBoxPatternMatch(CORINFO_RESOLVED_TOKEN* pResolvedToken,
+                                  const BYTE*             codeAddr,
+                                  const BYTE*             codeEndp,
+                                  unsigned*               pSkip)
+{
+    *pSkip = 0;
+
+    if (codeAddr >= codeEndp)
+    {
+        return false;
+    }
+
+    const BYTE* nextCodeAddr = codeAddr + 1 + sizeof(mdToken);
+
+    if (codeAddr[0] == CEE_UNBOX_ANY)
+    {
+        if (nextCodeAddr > codeEndp)
+        {
+            return false;
+        }
+
+        CORINFO_RESOLVED_TOKEN unboxResolvedToken;
+        impResolveToken(codeAddr + 1, &unboxResolvedToken, CORINFO_TOKENKIND_Class);
+
+        if (unboxResolvedToken.hClass != pResolvedToken->hClass)
+        {
+            return false;
+        }
+
+        // In shared code the handles are canonical, so the types only match at runtime
+        // if both instructions refer to the same type in the same context.
+        DWORD classAttribs = info.compCompHnd->getClassAttribs(pResolvedToken->hClass);
+        if ((classAttribs & CORINFO_FLG_SHAREDINST) != 0)
+        {
+            if ((JitConfig.JitRemoveBoxes() == 0) || (unboxResolvedToken.token != pResolvedToken->token) ||
+                (unboxResolvedToken.tokenScope != pResolvedToken->tokenScope) ||
+                (unboxResolvedToken.tokenContext != pResolvedToken->tokenContext))
+            {
+                return false;
+            }
+        }
+
+        JITDUMP("\n Importing BOX; UNBOX.ANY as NOP\n");
+
+        // Skip the unbox.any instruction
+        *pSkip = 1 + sizeof(mdToken);
+        impInlineRoot()->impBoxesRemoved++;
+        InterlockedIncrement(&s_impBoxesRemoved);
+        return true;
+    }
+
+    // The remaining patterns change control flow or the type on the stack.
+    if ((JitConfig.JitRemoveBoxes() == 0) || opts.compDbgCode || tiVerificationNeeded)
+    {
+        return false;
+    }
+
+    if (info.compCompHnd->getBoxHelper(pResolvedToken->hClass) != CORINFO_HELP_BOX)
+    {
+        return false;
+    }
+
+    switch (codeAddr[0])
+    {
+        case CEE_BRTRUE:
+        case CEE_BRTRUE_S:
+        case CEE_BRFALSE:
+        case CEE_BRFALSE_S:
+            if (!impCanDiscardBoxedValue())
+            {
+                return false;
+            }
+
+            JITDUMP("\n Importing BOX; BR_TRUE/FALSE as constant\n");
+
+            impDiscardBoxedValue();
+            impPushOnStack(gtNewIconNode(1), typeInfo(TI_INT));
+            return true;
+
+        case CEE_ISINST:
+        {
+            if ((nextCodeAddr > codeEndp) || opts.IsReadyToRun() || !impCanDiscardBoxedValue())
+            {
+                return false;
+            }
+
+            CORINFO_RESOLVED_TOKEN isinstResolvedToken;
+            impResolveToken(codeAddr + 1, &isinstResolvedToken, CORINFO_TOKENKIND_Casting);
+
+            // The outcome of the cast is only known when both types are exact. Canonical types
+            // stand for any instantiation over reference types, and would need a runtime lookup.
+            CORINFO_CLASS_HANDLE isinstClass = isinstResolvedToken.hClass;
+            if (((info.compCompHnd->getClassAttribs(pResolvedToken->hClass) & CORINFO_FLG_SHAREDINST) != 0) ||
+                ((info.compCompHnd->getClassAttribs(isinstClass) & CORINFO_FLG_SHAREDINST) != 0))
+            {
+                return false;
+            }
+
+            CORINFO_HELPER_DESC  calloutHelper;
+            if ((info.compCompHnd->getTypeForBox(isinstClass) != isinstClass) ||
+                (info.compCompHnd->canAccessClass(&isinstResolvedToken, info.compMethodHnd, &calloutHelper) !=
+                 CORINFO_ACCESS_ALLOWED))
+            {
+                // Casts to Nullable<T> look at T, and inaccessible types must throw.
+                return false;
+            }
+
+            const bool castSucceeds = info.compCompHnd->canCast(pResolvedToken->hClass, isinstClass) != FALSE;
+            const bool isBranchNext =
+                (nextCodeAddr < codeEndp) && ((nextCodeAddr[0] == CEE_BRTRUE) || (nextCodeAddr[0] == CEE_BRTRUE_S) ||
+                                              (nextCodeAddr[0] == CEE_BRFALSE) || (nextCodeAddr[0] == CEE_BRFALSE_S));
+
+            // Skip the isinst instruction
+            *pSkip = 1 + sizeof(mdToken);
+
+            if (castSucceeds && !isBranchNext)
+            {
+                // The isinst is a no-op, but the box itself is still needed.
+                JITDUMP("\n Importing BOX; ISINST as BOX\n");
+                return false;
+            }
+
+            JITDUMP("\n Importing BOX; ISINST as %s\n", castSucceeds ? "constant" : "null");
+
+            impDiscardBoxedValue();
+            if (castSucceeds)
+            {
+                impPushOnStack(gtNewIconNode(1), typeInfo(TI_INT));
+            }
+            else
+            {
+                impPushNullObjRefOnStack();
+            }
+            return true;
+        }
+
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------
+// impCanDiscardBoxedValue: check whether the value about to be boxed can be
+//   discarded in place of the box
+//
+// Return Value:
+//    false for struct values with side effects, which would have to be spilled
+//    through their address.
+
+bool Compiler::impCanDiscardBoxedValue()
+{
+    GenTreePtr value = impStackTop().val;
+    return !varTypeIsStruct(value) || ((value->gtFlags & GTF_SIDE_EFFECT) == 0);
+}
+
+//------------------------------------------------------------------------
+// impDiscardBoxedValue: pop the value about to be boxed, keeping its side
+//   effects, and count the box as removed
+
+void Compiler::impDiscardBoxedValue()
+{
+    assert(impCanDiscardBoxedValue());
+
+    GenTreePtr value = impPopStack().val;
+
+    if ((value->gtFlags & GTF_SIDE_EFFECT) != 0)
+    {
+        if (value->gtOper != GT_CALL)
+        {
+            value = gtUnusedValNode(value);
+        }
+
+        impAppendTree(value, (unsigned)CHECK_SPILL_ALL, impCurStmtOffs);
+    }
+
+    impInlineRoot()->impBoxesRemoved++;
+    InterlockedIncrement(&s_impBoxesRemoved);
+}
+
 //------------------------------------------------------------------------
 // impImportNewObjArray: Build and import `new` of multi-dimmensional array
 //
@@ -9419,23 +9626,62 @@ GenTreePtr Compiler::impCastClassOrIsInstToTree(GenTreePtr              op1,
 
     CorInfoHelpFunc helper = info.compCompHnd->getCastingHelper(pResolvedToken, isCastClass);
 
+    // When expanding inline, the helper to call if the exact method table check fails,
+    // or CORINFO_HELP_UNDEF if the cast is known to fail then (isinst only).
+    CorInfoHelpFunc fallbackHelper = helper;
+
+    // Exact method table checks in front of helpers other than CHKCASTCLASS only pay off
+    // in optimized code.
+    const bool expandExactCheck = (JitConfig.JitExpandExactCastChecks() != 0) && !opts.MinOpts() && !opts.compDbgCode;
+
     if (isCastClass)
     {
-        // We only want to expand inline the normal CHKCASTCLASS helper;
-        expandInline = (helper == CORINFO_HELP_CHKCASTCLASS);
+        if (helper == CORINFO_HELP_CHKCASTCLASS)
+        {
+            // Use the special helper that skips the cases checked by our inlined cast
+            expandInline   = true;
+            fallbackHelper = CORINFO_HELP_CHKCASTCLASS_SPECIAL;
+        }
+        else if (helper == CORINFO_HELP_CHKCASTANY)
+        {
+            // Casts to sealed types that still need the general helper (e.g. variant
+            // delegates) usually succeed on the exact type.
+            DWORD flags  = info.compCompHnd->getClassAttribs(pResolvedToken->hClass);
+            expandInline = expandExactCheck && ((flags & CORINFO_FLG_FINAL) != 0);
+        }
+        else
+        {
+            expandInline = false;
+        }
     }
     else
     {
-        if (helper == CORINFO_HELP_ISINSTANCEOFCLASS)
+        if ((helper == CORINFO_HELP_ISINSTANCEOFCLASS) || (helper == CORINFO_HELP_ISINSTANCEOFANY))
         {
             // Get the Class Handle abd class attributes for the type we are casting to
             //
             DWORD flags = info.compCompHnd->getClassAttribs(pResolvedToken->hClass);
 
-            //
-            // If the class handle is marked as final we can also expand the IsInst check inline
-            //
-            expandInline = ((flags & CORINFO_FLG_FINAL) != 0);
+            if (helper == CORINFO_HELP_ISINSTANCEOFCLASS)
+            {
+                //
+                // If the class handle is marked as final we can expand the whole IsInst check inline,
+                // otherwise only the exact match is checked inline
+                //
+                if ((flags & CORINFO_FLG_FINAL) != 0)
+                {
+                    expandInline   = true;
+                    fallbackHelper = CORINFO_HELP_UNDEF;
+                }
+                else
+                {
+                    expandInline = expandExactCheck;
+                }
+            }
+            else
+            {
+                expandInline = expandExactCheck && ((flags & CORINFO_FLG_FINAL) != 0);
+            }
 
             //
             // But don't expand inline these two cases
@@ -9504,7 +9750,7 @@ GenTreePtr Compiler::impCastClassOrIsInstToTree(GenTreePtr              op1,
     //
 
     GenTreePtr op2Var = op2;
-    if (isCastClass)
+    if (fallbackHelper != CORINFO_HELP_UNDEF)
     {
         op2Var                                                  = fgInsertCommaFormTemp(&op2);
         lvaTable[op2Var->AsLclVarCommon()->GetLclNum()].lvIsCSE = true;
@@ -9529,14 +9775,9 @@ GenTreePtr Compiler::impCastClassOrIsInstToTree(GenTreePtr              op1,
     //
     GenTreePtr condFalse = gtClone(op1);
     GenTreePtr condTrue;
-    if (isCastClass)
+    if (fallbackHelper != CORINFO_HELP_UNDEF)
     {
-        //
-        // use the special helper that skips the cases checked by our inlined cast
-        //
-        helper = CORINFO_HELP_CHKCASTCLASS_SPECIAL;
-
-        condTrue = gtNewHelperCallNode(helper, TYP_REF, 0, gtNewArgList(op2Var, gtClone(op1)));
+        condTrue = gtNewHelperCallNode(fallbackHelper, TYP_REF, 0, gtNewArgList(op2Var, gtClone(op1)));
     }
     else
     {
@@ -14372,22 +14613,14 @@ void Compiler::impImportBlockCode(BasicBlock* block)
                     break;
                 }
 
-                // Look ahead for unbox.any
-                if (codeAddr + (sz + 1 + sizeof(mdToken)) <= codeEndp && codeAddr[sz] == CEE_UNBOX_ANY)
+                // Look ahead for instructions that consume the box right away
                 {
-                    DWORD classAttribs = info.compCompHnd->getClassAttribs(resolvedToken.hClass);
-                    if (!(classAttribs & CORINFO_FLG_SHAREDINST))
+                    unsigned   skip       = 0;
+                    const bool boxHandled = impBoxPatternMatch(&resolvedToken, codeAddr + sz, codeEndp, &skip);
+                    sz += skip;
+                    if (boxHandled)
                     {
-                        CORINFO_RESOLVED_TOKEN unboxResolvedToken;
-
-                        impResolveToken(codeAddr + (sz + 1), &unboxResolvedToken, CORINFO_TOKENKIND_Class);
-
-                        if (unboxResolvedToken.hClass == resolvedToken.hClass)
-                        {
-                            // Skip the next unbox.any instruction
-                            sz += sizeof(mdToken) + 1;
-                            break;
-                        }
+                        break;
                     }
                 }
 
@@ -17152,6 +17385,24 @@ void Compiler::impMakeDiscretionaryInlineObservations(InlineInfo* pInlineInfo, I
 
     inlineResult->NoteInt(InlineObservation::CALLSITE_FREQUENCY, static_cast<int>(frequency));
     inlineResult->NoteInt(InlineObservation::CALLSITE_WEIGHT, static_cast<int>(weight));
+
+    // If both the call site and the root method entry have profile
+    // data, also note how often the call site runs per call to the
+    // root method, in percent.
+    if ((pInlineInfo != nullptr) && pInlineInfo->iciBlock->hasProfileWeight())
+    {
+        BasicBlock* rootEntry = impInlineRoot()->fgFirstBB;
+
+        if ((rootEntry != nullptr) && rootEntry->hasProfileWeight() && (rootEntry->bbWeight > BB_ZERO_WEIGHT))
+        {
+            const double relativeWeight = (100.0 * pInlineInfo->iciBlock->bbWeight) / rootEntry->bbWeight;
+            const double maxFrequency   = 1000000.0;
+            const int    profileFrequency =
+                static_cast<int>((relativeWeight < maxFrequency) ? relativeWeight : maxFrequency);
+
+            inlineResult->NoteInt(InlineObservation::CALLSITE_PROFILE_FREQUENCY, profileFrequency);
+        }
+    }
 }
 
 /*****************************************************************************
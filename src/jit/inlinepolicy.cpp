@@ -77,6 +77,50 @@ InlinePolicy* InlinePolicy::GetPolicy(Compiler* compiler, bool isPrejitRoot)
 
 #endif // defined(DEBUG) || defined(INLINE_DATA)
 
+    // Optionally install a policy by name.
+    const wchar_t* policyName = JitConfig.JitInlinePolicy();
+
+    if (policyName != nullptr)
+    {
+        if (wcscmp(policyName, W("Learned")) == 0)
+        {
+            return new (compiler, CMK_Inlining) LearnedPolicy(compiler, isPrejitRoot);
+        }
+        else if (wcscmp(policyName, W("Model")) == 0)
+        {
+            return new (compiler, CMK_Inlining) ModelPolicy(compiler, isPrejitRoot);
+        }
+        else if (wcscmp(policyName, W("Legacy")) == 0)
+        {
+            return new (compiler, CMK_Inlining) LegacyPolicy(compiler, isPrejitRoot);
+        }
+        else if (wcscmp(policyName, W("EnhancedLegacy")) == 0)
+        {
+            return new (compiler, CMK_Inlining) EnhancedLegacyPolicy(compiler, isPrejitRoot);
+        }
+
+#if defined(DEBUG) || defined(INLINE_DATA)
+
+        else if (wcscmp(policyName, W("Discretionary")) == 0)
+        {
+            return new (compiler, CMK_Inlining) DiscretionaryPolicy(compiler, isPrejitRoot);
+        }
+        else if (wcscmp(policyName, W("Full")) == 0)
+        {
+            return new (compiler, CMK_Inlining) FullPolicy(compiler, isPrejitRoot);
+        }
+        else if (wcscmp(policyName, W("Size")) == 0)
+        {
+            return new (compiler, CMK_Inlining) SizePolicy(compiler, isPrejitRoot);
+        }
+        else if (wcscmp(policyName, W("Replay")) == 0)
+        {
+            return new (compiler, CMK_Inlining) ReplayPolicy(compiler, isPrejitRoot);
+        }
+
+#endif // defined(DEBUG) || defined(INLINE_DATA)
+    }
+
     // Optionally install the ModelPolicy.
     bool useModelPolicy = JitConfig.JitInlinePolicyModel() != 0;
 
@@ -1198,6 +1242,7 @@ DiscretionaryPolicy::DiscretionaryPolicy(Compiler* compiler, bool isPrejitRoot)
     , m_ReturnCount(0)
     , m_CallCount(0)
     , m_CallSiteWeight(0)
+    , m_ProfileFrequency(-1)
     , m_ModelCodeSizeEstimate(0)
     , m_PerCallInstructionEstimate(0)
     , m_IsClassCtor(false)
@@ -1329,6 +1374,10 @@ void DiscretionaryPolicy::NoteInt(InlineObservation obs, int value)
             m_CallSiteWeight = static_cast<unsigned>(value);
             break;
 
+        case InlineObservation::CALLSITE_PROFILE_FREQUENCY:
+            m_ProfileFrequency = value;
+            break;
+
         default:
             // Delegate remainder to the super class.
             EnhancedLegacyPolicy::NoteInt(obs, value);
@@ -1926,6 +1975,7 @@ void DiscretionaryPolicy::DumpSchema(FILE* file) const
     fprintf(file, ",CallerHasNewObj");
     fprintf(file, ",CalleeDoesNotReturn");
     fprintf(file, ",CalleeHasGCStruct");
+    fprintf(file, ",ProfileFrequency");
 }
 
 //------------------------------------------------------------------------
@@ -2008,6 +2058,7 @@ void DiscretionaryPolicy::DumpData(FILE* file) const
     fprintf(file, ",%u", m_CallerHasNewObj ? 1 : 0);
     fprintf(file, ",%u", m_IsNoReturn ? 1 : 0);
     fprintf(file, ",%u", m_CalleeHasGCStruct ? 1 : 0);
+    fprintf(file, ",%d", m_ProfileFrequency);
 }
 
 #endif // defined(DEBUG) || defined(INLINE_DATA)
@@ -2220,6 +2271,367 @@ void ModelPolicy::DetermineProfitability(CORINFO_METHOD_INFO* methodInfo)
     }
 }
 
+//------------------------------------------------------------------------/
+// LearnedPolicy: construct a new LearnedPolicy
+//
+// Arguments:
+//    compiler -- compiler instance doing the inlining (root compiler)
+//    isPrejitRoot -- true if this compiler is prejitting the root method
+
+LearnedPolicy::LearnedPolicy(Compiler* compiler, bool isPrejitRoot) : ModelPolicy(compiler, isPrejitRoot), m_Score(0.0)
+{
+    // Empty
+}
+
+// Default weights of the model, from inlinefeatures.def
+
+const double LearnedPolicy::s_DefaultWeights[FEATURE_COUNT] = {
+#define LEARNED_FEATURE(name, weight) weight,
+#include "inlinefeatures.def"
+};
+
+#if defined(DEBUG) || defined(INLINE_DATA)
+
+// Feature names, as used in the weights file and the inline data
+
+const char* const LearnedPolicy::s_FeatureNames[FEATURE_COUNT] = {
+#define LEARNED_FEATURE(name, weight) #name,
+#include "inlinefeatures.def"
+};
+
+// Statics to track the weights read from JitInlineModelWeights
+
+double        LearnedPolicy::s_Weights[FEATURE_COUNT];
+bool          LearnedPolicy::s_TriedReadingWeights = false;
+bool          LearnedPolicy::s_HasWeightsFile      = false;
+CritSecObject LearnedPolicy::s_WeightsLock;
+
+//------------------------------------------------------------------------
+// ReadWeights: read the model weights from the JitInlineModelWeights file
+//
+// Notes:
+//    Each line of the file holds a feature name and its weight.
+//    Features that are not listed keep their default weight. Blank
+//    lines and lines starting with '#' are ignored.
+//
+//    Called with s_WeightsLock held.
+
+void LearnedPolicy::ReadWeights()
+{
+    const wchar_t* weightsFileName = JitConfig.JitInlineModelWeights();
+
+    if (weightsFileName == nullptr)
+    {
+        return;
+    }
+
+    FILE* weightsFile = _wfopen(weightsFileName, W("r"));
+
+    // Display banner to stderr, unless we're dumping inline Xml,
+    // in which case the policy name is captured in the Xml.
+    if (JitConfig.JitInlineDumpXml() == 0)
+    {
+        fprintf(stderr, "*** %s inline model weights from %ws\n",
+                weightsFile == nullptr ? "Unable to read" : "Reading", weightsFileName);
+    }
+
+    if (weightsFile == nullptr)
+    {
+        return;
+    }
+
+    for (unsigned i = 0; i < FEATURE_COUNT; i++)
+    {
+        s_Weights[i] = s_DefaultWeights[i];
+    }
+
+    char buffer[256];
+
+    while (fgets(buffer, sizeof(buffer), weightsFile) != nullptr)
+    {
+        if (buffer[0] == '#')
+        {
+            continue;
+        }
+
+        // Split the line into the feature name and its weight.
+        char* name = buffer;
+
+        while (isspace((unsigned char)*name))
+        {
+            name++;
+        }
+
+        char* nameEnd = name;
+
+        while ((*nameEnd != '\0') && !isspace((unsigned char)*nameEnd))
+        {
+            nameEnd++;
+        }
+
+        if ((nameEnd == name) || (*nameEnd == '\0'))
+        {
+            continue;
+        }
+
+        *nameEnd = '\0';
+
+        char*        end    = nullptr;
+        const double weight = strtod(nameEnd + 1, &end);
+
+        if (end == nameEnd + 1)
+        {
+            continue;
+        }
+
+        bool found = false;
+
+        for (unsigned i = 0; i < FEATURE_COUNT; i++)
+        {
+            if (strcmp(name, s_FeatureNames[i]) == 0)
+            {
+                s_Weights[i] = weight;
+                found        = true;
+                break;
+            }
+        }
+
+        if (!found)
+        {
+            fprintf(stderr, "*** Ignoring weight for unknown inline model feature %s\n", name);
+        }
+    }
+
+    fclose(weightsFile);
+    s_HasWeightsFile = true;
+}
+
+#endif // defined(DEBUG) || defined(INLINE_DATA)
+
+//------------------------------------------------------------------------
+// GetWeights: get the weights of the model
+//
+// Return Value:
+//    Array of FEATURE_COUNT weights, indexed by Feature
+
+const double* LearnedPolicy::GetWeights()
+{
+
+#if defined(DEBUG) || defined(INLINE_DATA)
+
+    if (!s_TriedReadingWeights)
+    {
+        CritSecHolder weightsLock(s_WeightsLock);
+
+        if (!s_TriedReadingWeights)
+        {
+            ReadWeights();
+            s_TriedReadingWeights = true;
+        }
+    }
+
+    if (s_HasWeightsFile)
+    {
+        return s_Weights;
+    }
+
+#endif // defined(DEBUG) || defined(INLINE_DATA)
+
+    return s_DefaultWeights;
+}
+
+//------------------------------------------------------------------------
+// ComputeFeatures: compute the model features for this candidate
+//
+// Arguments:
+//    features -- array of FEATURE_COUNT values to fill in
+//
+// Notes:
+//    Requires the code size and performance estimates to have
+//    been computed.
+
+void LearnedPolicy::ComputeFeatures(double* features) const
+{
+    features[FEATURE_BIAS]               = 1.0;
+    features[FEATURE_CODE_SIZE_ESTIMATE] = (double)m_ModelCodeSizeEstimate / SIZE_SCALE;
+    features[FEATURE_PER_CALL_SAVINGS]   = -(double)m_PerCallInstructionEstimate / SIZE_SCALE;
+    features[FEATURE_IL_SIZE]            = (double)m_CodeSize / 10.0;
+
+    features[FEATURE_ARG_COUNT]                      = m_ArgCount;
+    features[FEATURE_BLOCK_COUNT]                    = m_BlockCount;
+    features[FEATURE_CALL_COUNT]                     = m_CallCount;
+    features[FEATURE_THROW_COUNT]                    = m_ThrowCount;
+    features[FEATURE_LOOKS_LIKE_WRAPPER]             = m_LooksLikeWrapperMethod ? 1.0 : 0.0;
+    features[FEATURE_IS_MOSTLY_LOAD_STORE]           = m_MethodIsMostlyLoadStore ? 1.0 : 0.0;
+    features[FEATURE_IS_INSTANCE_CTOR]               = m_IsInstanceCtor ? 1.0 : 0.0;
+    features[FEATURE_IS_FROM_PROMOTABLE_VALUE_CLASS] = m_IsFromPromotableValueClass ? 1.0 : 0.0;
+    features[FEATURE_HAS_SIMD]                       = m_HasSimd ? 1.0 : 0.0;
+    features[FEATURE_HAS_GC_STRUCT]                  = m_CalleeHasGCStruct ? 1.0 : 0.0;
+    features[FEATURE_DOES_NOT_RETURN]                = m_IsNoReturn ? 1.0 : 0.0;
+
+    features[FEATURE_DEPTH]                            = m_Depth;
+    features[FEATURE_ARG_FEEDS_CONSTANT_TEST]          = m_ArgFeedsConstantTest;
+    features[FEATURE_CONSTANT_ARG_FEEDS_CONSTANT_TEST] = m_ConstantArgFeedsConstantTest;
+    features[FEATURE_ARG_FEEDS_RANGE_CHECK]            = m_ArgFeedsRangeCheck;
+    features[FEATURE_IS_SAME_THIS]                     = m_IsSameThis ? 1.0 : 0.0;
+    features[FEATURE_IN_TRY_REGION]                    = m_CallsiteIsInTryRegion ? 1.0 : 0.0;
+    features[FEATURE_FREQUENCY_RARE] = (m_CallsiteFrequency == InlineCallsiteFrequency::RARE) ? 1.0 : 0.0;
+    features[FEATURE_FREQUENCY_WARM] = (m_CallsiteFrequency == InlineCallsiteFrequency::WARM) ? 1.0 : 0.0;
+    features[FEATURE_FREQUENCY_LOOP] = (m_CallsiteFrequency == InlineCallsiteFrequency::LOOP) ? 1.0 : 0.0;
+    features[FEATURE_FREQUENCY_HOT]  = (m_CallsiteFrequency == InlineCallsiteFrequency::HOT) ? 1.0 : 0.0;
+
+    const bool hasProfile               = (m_ProfileFrequency >= 0);
+    features[FEATURE_HAS_PROFILE]       = hasProfile ? 1.0 : 0.0;
+    features[FEATURE_PROFILE_NEVER_RUN] = (m_ProfileFrequency == 0) ? 1.0 : 0.0;
+    features[FEATURE_LOG_PROFILE_FREQUENCY] =
+        hasProfile ? log(1.0 + (double)m_ProfileFrequency / 100.0) / log(2.0) : 0.0;
+}
+
+//------------------------------------------------------------------------
+// ComputeScore: evaluate the model for this candidate
+//
+// Return Value:
+//    Estimated probability, between 0 and 1, that inlining the
+//    candidate is worthwhile.
+
+double LearnedPolicy::ComputeScore() const
+{
+    double features[FEATURE_COUNT];
+    ComputeFeatures(features);
+
+    const double* weights = GetWeights();
+    double        sum     = 0.0;
+
+    for (unsigned i = 0; i < FEATURE_COUNT; i++)
+    {
+        sum += weights[i] * features[i];
+    }
+
+    return 1.0 / (1.0 + exp(-sum));
+}
+
+//------------------------------------------------------------------------
+// DetermineProfitability: determine if this inline is profitable
+//
+// Arguments:
+//    methodInfo -- method info for the callee
+//
+// Notes:
+//    Like the ModelPolicy, inlines that are estimated to decrease
+//    code size are always taken. Other candidates are inlined when
+//    the model score reaches JitInlineLearnedThreshold, which plays
+//    the part of the size/speed tradeoff.
+
+void LearnedPolicy::DetermineProfitability(CORINFO_METHOD_INFO* methodInfo)
+{
+    // Do some homework
+    MethodInfoObservations(methodInfo);
+    EstimateCodeSize();
+    EstimatePerformanceImpact();
+
+    m_Score = ComputeScore();
+
+    if (m_ModelCodeSizeEstimate <= 0)
+    {
+        // Inline will likely decrease code size
+        JITLOG_THIS(m_RootCompiler, (LL_INFO100000, "Inline profitable, will decrease code size by %g bytes\n",
+                                     (double)-m_ModelCodeSizeEstimate / SIZE_SCALE));
+
+        if (m_IsPrejitRoot)
+        {
+            SetCandidate(InlineObservation::CALLEE_IS_SIZE_DECREASING_INLINE);
+        }
+        else
+        {
+            SetCandidate(InlineObservation::CALLSITE_IS_SIZE_DECREASING_INLINE);
+        }
+
+        return;
+    }
+
+    const double threshold    = JitConfig.JitInlineLearnedThreshold() / 100.0;
+    const bool   shouldInline = (m_Score >= threshold);
+
+    JITLOG_THIS(m_RootCompiler,
+                (LL_INFO100000, "Inline %s profitable: score=%g (threshold=%g, percall=%g, size=%g)\n",
+                 shouldInline ? "is" : "is not", m_Score, threshold, (double)m_PerCallInstructionEstimate / SIZE_SCALE,
+                 (double)m_ModelCodeSizeEstimate / SIZE_SCALE));
+
+    if (!shouldInline)
+    {
+        // Fail the inline
+        if (m_IsPrejitRoot)
+        {
+            SetNever(InlineObservation::CALLEE_NOT_PROFITABLE_INLINE);
+        }
+        else
+        {
+            SetFailure(InlineObservation::CALLSITE_NOT_PROFITABLE_INLINE);
+        }
+    }
+    else
+    {
+        // Update candidacy
+        if (m_IsPrejitRoot)
+        {
+            SetCandidate(InlineObservation::CALLEE_IS_PROFITABLE_INLINE);
+        }
+        else
+        {
+            SetCandidate(InlineObservation::CALLSITE_IS_PROFITABLE_INLINE);
+        }
+    }
+}
+
+#if defined(DEBUG) || defined(INLINE_DATA)
+
+//------------------------------------------------------------------------
+// DumpSchema: dump names for all the supporting data for the
+// inline decision in CSV format.
+//
+// Arguments:
+//    file -- file to write to
+//
+// Notes:
+//    Adds the model features and score to the DiscretionaryPolicy
+//    data, so that collected data can be used to refit the weights.
+
+void LearnedPolicy::DumpSchema(FILE* file) const
+{
+    DiscretionaryPolicy::DumpSchema(file);
+
+    for (unsigned i = 0; i < FEATURE_COUNT; i++)
+    {
+        fprintf(file, ",Feature_%s", s_FeatureNames[i]);
+    }
+
+    fprintf(file, ",LearnedScore");
+}
+
+//------------------------------------------------------------------------
+// DumpData: dump all the supporting data for the inline decision
+// in CSV format.
+//
+// Arguments:
+//    file -- file to write to
+
+void LearnedPolicy::DumpData(FILE* file) const
+{
+    DiscretionaryPolicy::DumpData(file);
+
+    double features[FEATURE_COUNT];
+    ComputeFeatures(features);
+
+    for (unsigned i = 0; i < FEATURE_COUNT; i++)
+    {
+        fprintf(file, ",%g", features[i]);
+    }
+
+    fprintf(file, ",%g", m_Score);
+}
+
+#endif // defined(DEBUG) || defined(INLINE_DATA)
+
 #if defined(DEBUG) || defined(INLINE_DATA)
 
 //------------------------------------------------------------------------/
@@ -288,6 +288,7 @@ protected:
     unsigned    m_ReturnCount;
     unsigned    m_CallCount;
     unsigned    m_CallSiteWeight;
+    int         m_ProfileFrequency; // call site runs per 100 root calls, or -1 without profile data
     int         m_ModelCodeSizeEstimate;
     int         m_PerCallInstructionEstimate;
     bool        m_IsClassCtor;
@@ -329,6 +330,63 @@ public:
 #endif // defined(DEBUG) || defined(INLINE_DATA)
 };
 
+// LearnedPolicy is an experimental policy that scores candidates with
+// a logistic model over the observations gathered by the
+// DiscretionaryPolicy, including profile data when available. The
+// model weights are fit offline from inline data collected with
+// SuperPMI, and may be overridden from a file in DEBUG and
+// INLINE_DATA builds.
+
+class LearnedPolicy : public ModelPolicy
+{
+public:
+    // Construct a LearnedPolicy
+    LearnedPolicy(Compiler* compiler, bool isPrejitRoot);
+
+    // Policy determinations
+    void DetermineProfitability(CORINFO_METHOD_INFO* methodInfo) override;
+
+#if defined(DEBUG) || defined(INLINE_DATA)
+
+    // Externalize data
+    void DumpData(FILE* file) const override;
+    void DumpSchema(FILE* file) const override;
+
+    // Miscellaneous
+    const char* GetName() const override
+    {
+        return "LearnedPolicy";
+    }
+
+#endif // defined(DEBUG) || defined(INLINE_DATA)
+
+private:
+    enum Feature
+    {
+#define LEARNED_FEATURE(name, weight) FEATURE_##name,
+#include "inlinefeatures.def"
+        FEATURE_COUNT
+    };
+
+    void ComputeFeatures(double* features) const;
+    double ComputeScore() const;
+    static const double* GetWeights();
+
+    static const double s_DefaultWeights[FEATURE_COUNT];
+
+#if defined(DEBUG) || defined(INLINE_DATA)
+    static void ReadWeights();
+
+    static const char* const s_FeatureNames[FEATURE_COUNT];
+    static double            s_Weights[FEATURE_COUNT];
+    static bool              s_TriedReadingWeights;
+    static bool              s_HasWeightsFile;
+    static CritSecObject     s_WeightsLock;
+#endif // defined(DEBUG) || defined(INLINE_DATA)
+
+    double m_Score;
+};
+
 #if defined(DEBUG) || defined(INLINE_DATA)
 
 // RandomPolicy implements a policy that inlines at random.
@@ -238,6 +238,11 @@ CONFIG_INTEGER(JitMinOptsTrackGCrefs, W("JitMinOptsTrackGCrefs"), JitMinOptsTrac
 // TODO-Cleanup: need to make 'MEASURE_MEM_ALLOC' well-defined here at all times.
 CONFIG_INTEGER(DisplayMemStats, W("JitMemStats"), 0) // Display JIT memory usage statistics
 
+CONFIG_INTEGER(JitArenaPoolSize, W("JitArenaPoolSize"), 1)         // Number of pooled arena allocators reused across
+                                                                   // compilations (at most 16)
+CONFIG_INTEGER(JitArenaPoolRetainKB, W("JitArenaPoolRetainKB"), 0) // KB of warmed pages each pooled arena allocator
+                                                                   // may keep between compilations
+
 CONFIG_INTEGER(JitAggressiveInlining, W("JitAggressiveInlining"), 0) // Aggressive inlining of all methods
 CONFIG_INTEGER(JitELTHookEnabled, W("JitELTHookEnabled"), 0)         // If 1, emit Enter/Leave/TailCall callbacks
 CONFIG_INTEGER(JitInlineSIMDMultiplier, W("JitInlineSIMDMultiplier"), 3)
@@ -264,6 +269,29 @@ CONFIG_INTEGER(JitTelemetry, W("JitTelemetry"), 1)             // If non-zero, g
 CONFIG_INTEGER(JitVNMapSelBudget, W("JitVNMapSelBudget"), 100) // Max # of MapSelect's considered for a particular
                                                                // top-level invocation.
 CONFIG_INTEGER(TailCallLoopOpt, W("TailCallLoopOpt"), 1)       // Convert recursive tail calls to loops
+CONFIG_INTEGER(JitVectorizeLoops, W("JitVectorizeLoops"), 0)   // If non-zero, vectorize simple loops over primitive
+                                                               // arrays using SIMD instructions
+CONFIG_INTEGER(JitLsraFastMinOpts, W("JitLsraFastMinOpts"), 1) // If non-zero, LSRA takes the first suitable free
+                                                               // register rather than the best one when no lclVars
+                                                               // are enregistered (e.g. MinOpts)
+CONFIG_INTEGER(JitLsraBoundedCostLimit, W("JitLsraBoundedCostLimit"), 1000000) // Tracked lclVars * blocks above
+                                                                               // which LSRA bounds its cost; 0
+                                                                               // disables
+CONFIG_INTEGER(JitLsraBoundedMaxCandidates, W("JitLsraBoundedMaxCandidates"), 512) // Max lclVar register candidates
+                                                                                   // when LSRA bounds its cost
+CONFIG_INTEGER(JitInlineAllocation, W("JitInlineAllocation"), 0) // If non-zero, expand the object and small array
+                                                                   // allocation fast path inline where the EE allows it
+CONFIG_INTEGER(JitElideFreshObjectBarriers, W("JitElideFreshObjectBarriers"), 0) // If non-zero, omit write barriers
+                                                                                   // for stores into freshly allocated,
+                                                                                   // unpublished objects
+CONFIG_INTEGER(JitExpandExactCastChecks, W("JitExpandExactCastChecks"), 1) // If non-zero, check for an exact type
+                                                                             // match inline before calling the
+                                                                             // isinst/castclass helpers
+CONFIG_INTEGER(JitRemoveBoxes, W("JitRemoveBoxes"), 1) // If non-zero, import box; isinst/brtrue/brfalse/unbox.any
+                                                       // sequences whose boxed value does not escape without
+                                                       // allocating
+CONFIG_INTEGER(JitReportBoxesRemoved, W("JitReportBoxesRemoved"), 0) // If non-zero, report the number of boxes
+                                                                     // removed at JIT shutdown
 CONFIG_METHODSET(AltJit, W("AltJit")) // Enables AltJit and selectively limits it to the specified methods.
 CONFIG_METHODSET(AltJitNgen,
                  W("AltJitNgen")) // Enables AltJit for NGEN and selectively limits it to the specified methods.
@@ -300,10 +328,17 @@ CONFIG_INTEGER(JitInlinePolicyRandom, W("JitInlinePolicyRandom"), 0) // nozero e
 CONFIG_INTEGER(JitInlinePolicyReplay, W("JitInlinePolicyReplay"), 0)
 CONFIG_STRING(JitNoInlineRange, W("JitNoInlineRange"))
 CONFIG_STRING(JitInlineReplayFile, W("JitInlineReplayFile"))
+CONFIG_STRING(JitInlineModelWeights, W("JitInlineModelWeights")) // File of "FEATURE weight" lines that overrides the
+                                                                 // weights of the LearnedPolicy
 #endif // defined(DEBUG) || defined(INLINE_DATA)
 
 CONFIG_INTEGER(JitInlinePolicyLegacy, W("JitInlinePolicyLegacy"), 0)
 CONFIG_INTEGER(JitInlinePolicyModel, W("JitInlinePolicyModel"), 0)
+CONFIG_STRING(JitInlinePolicy, W("JitInlinePolicy")) // Inline policy by name: Legacy, EnhancedLegacy, Model or Learned
+                                                     // (and Discretionary, Full, Size or Replay in DEBUG and
+                                                     // INLINE_DATA builds)
+CONFIG_INTEGER(JitInlineLearnedThreshold, W("JitInlineLearnedThreshold"), 50) // Minimum LearnedPolicy score, in
+                                                                              // percent, for a candidate to inline
 
 CONFIG_INTEGER(JitEECallTimingInfo, W("JitEECallTimingInfo"), 0)
 
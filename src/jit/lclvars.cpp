@@ -1831,6 +1831,21 @@ bool Compiler::lvaShouldPromoteStructVar(unsigned lclNum, lvaStructPromotionInfo
         else
 #endif // !FEATURE_MULTIREG_STRUCT_PROMOTE
 
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+            // A struct passed in two registers can be promoted into one field per register.
+            if ((structPromotionInfo->fieldCnt == 2) && varDsc->lvIsRegArg)
+        {
+            if (!lvaCanPromoteTwoRegParam(varDsc, structPromotionInfo))
+            {
+                JITDUMP("Not promoting promotable struct local V%02u, because its fields do not match the "
+                        "registers it is passed in.\n",
+                        lclNum);
+                shouldPromote = false;
+            }
+        }
+        else
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
+
             // TODO-PERF - Implement struct promotion for incoming multireg structs
             //             Currently it hits assert(lvFieldCnt==1) in lclvar.cpp line 4417
             //             Also the implementation of jmp uses the 4 byte move to store
@@ -1857,6 +1872,60 @@ bool Compiler::lvaShouldPromoteStructVar(unsigned lclNum, lvaStructPromotionInfo
     return shouldPromote;
 }
 
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+//--------------------------------------------------------------------------------------------
+// lvaCanPromoteTwoRegParam - Can a struct parameter passed in two registers be promoted into
+// one independent field per register?
+//
+// Arguments:
+//   varDsc               -   The struct parameter
+//   structPromotionInfo  -   In Parameter; struct promotion information
+//
+// Returns
+//   true if the struct has exactly two fields, each alone in its own eightbyte, and each
+//   field is of the register class (integer or SSE) its eightbyte is passed in.
+//
+// Notes:
+//   Each field then becomes a register parameter of its own, so the prolog moves the
+//   incoming registers straight into the fields and the struct never needs a stack home.
+//
+bool Compiler::lvaCanPromoteTwoRegParam(LclVarDsc* varDsc, lvaStructPromotionInfo* structPromotionInfo)
+{
+    assert(varDsc->lvIsParam && varDsc->lvIsRegArg);
+
+    // genJmpMethod only knows how to move a parameter back from a single field.
+    if (compJmpOpUsed)
+    {
+        return false;
+    }
+
+    if ((structPromotionInfo->fieldCnt != 2) || structPromotionInfo->customLayout ||
+        (varDsc->lvOtherArgReg == REG_STK))
+    {
+        return false;
+    }
+
+    for (unsigned index = 0; index < 2; ++index)
+    {
+        lvaStructFieldInfo* pFieldInfo = &structPromotionInfo->fields[index];
+        regNumber           argReg     = varDsc->lvRegNumForSlot(index);
+
+        if ((pFieldInfo->fldOffset != index * TARGET_POINTER_SIZE) || (pFieldInfo->fldSize > TARGET_POINTER_SIZE) ||
+            varTypeIsSIMD(pFieldInfo->fldType))
+        {
+            return false;
+        }
+
+        if (varTypeIsFloating(pFieldInfo->fldType) != genIsValidFloatReg(argReg))
+        {
+            return false;
+        }
+    }
+
+    return true;
+}
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
+
 /*****************************************************************************
  * Promote a struct type local */
 
@@ -1936,7 +2005,14 @@ void Compiler::lvaPromoteStructVar(unsigned lclNum, lvaStructPromotionInfo* Stru
         {
             fieldVarDsc->lvIsRegArg = true;
             fieldVarDsc->lvArgReg   = varDsc->lvArgReg;
-            fieldVarDsc->setPrefReg(varDsc->lvArgReg, this); // Set the preferred register
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+            if (varDsc->lvIsMultiRegPromotedParam())
+            {
+                // Each field is passed in the register of its own eightbyte.
+                fieldVarDsc->lvArgReg = varDsc->lvRegNumForSlot(index);
+            }
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
+            fieldVarDsc->setPrefReg(fieldVarDsc->lvArgReg, this); // Set the preferred register
 #if FEATURE_MULTIREG_ARGS && defined(FEATURE_SIMD)
             if (varTypeIsSIMD(fieldVarDsc))
             {
@@ -4732,29 +4808,35 @@ void Compiler::lvaUpdateArgsWithInitialReg()
 
     for (unsigned lclNum = 0; lclNum < info.compArgsCount; lclNum++)
     {
-        LclVarDsc* varDsc = lvaTable + lclNum;
+        LclVarDsc* varDsc   = lvaTable + lclNum;
+        unsigned   argCount = 1;
 
         if (varDsc->lvPromotedStruct())
         {
-            noway_assert(varDsc->lvFieldCnt == 1); // We only handle one field here
+            // We only handle one field here, or one field per register of a multireg struct
+            noway_assert((varDsc->lvFieldCnt == 1) || varDsc->lvIsMultiRegPromotedParam());
 
             unsigned fieldVarNum = varDsc->lvFieldLclStart;
+            argCount             = varDsc->lvFieldCnt;
             varDsc               = lvaTable + fieldVarNum;
         }
 
-        noway_assert(varDsc->lvIsParam);
-
-        if (varDsc->lvIsRegCandidate())
+        for (unsigned argIndex = 0; argIndex < argCount; argIndex++, varDsc++)
         {
-            if (varTypeIsMultiReg(varDsc))
-            {
-                regPairNo initialRegPair = varDsc->lvArgInitRegPair;
-                varDsc->lvRegNum         = genRegPairLo(initialRegPair);
-                varDsc->lvOtherReg       = genRegPairHi(initialRegPair);
-            }
-            else
+            noway_assert(varDsc->lvIsParam);
+
+            if (varDsc->lvIsRegCandidate())
             {
-                varDsc->lvRegNum = varDsc->lvArgInitReg;
+                if (varTypeIsMultiReg(varDsc))
+                {
+                    regPairNo initialRegPair = varDsc->lvArgInitRegPair;
+                    varDsc->lvRegNum         = genRegPairLo(initialRegPair);
+                    varDsc->lvOtherReg       = genRegPairHi(initialRegPair);
+                }
+                else
+                {
+                    varDsc->lvRegNum = varDsc->lvArgInitReg;
+                }
             }
         }
     }
@@ -4981,7 +5063,9 @@ int Compiler::lvaAssignVirtualFrameOffsetToArg(unsigned lclNum,
 
     if (varDsc->lvPromotedStruct())
     {
-        noway_assert(varDsc->lvFieldCnt == 1); // We only handle one field here
+        // A struct passed in two registers may be promoted into one field per register. Its fields
+        // are register args that are homed like locals, so only the first one is looked at here.
+        noway_assert((varDsc->lvFieldCnt == 1) || varDsc->lvIsMultiRegPromotedParam());
         fieldVarNum = varDsc->lvFieldLclStart;
 
         lvaPromotionType promotionType = lvaGetPromotionType(varDsc);
@@ -5048,10 +5132,14 @@ int Compiler::lvaAssignVirtualFrameOffsetToArg(unsigned lclNum,
 
         if (promotionType == PROMOTION_TYPE_DEPENDENT)
         {
-            noway_assert(varDsc->lvFieldCnt == 1); // We only handle one field here
+            noway_assert((varDsc->lvFieldCnt == 1) || varDsc->lvIsMultiRegPromotedParam());
 
             assert(fieldVarNum == varDsc->lvFieldLclStart);
-            lvaTable[fieldVarNum].lvStkOffs = varDsc->lvStkOffs;
+            for (unsigned index = 0; index < varDsc->lvFieldCnt; index++)
+            {
+                LclVarDsc* fieldVarDsc = &lvaTable[fieldVarNum + index];
+                fieldVarDsc->lvStkOffs = varDsc->lvStkOffs + fieldVarDsc->lvFldOffset;
+            }
         }
     }
     // For an independent promoted struct field we also assign the parent struct stack offset
@@ -867,25 +867,31 @@ void Compiler::fgExtendDbgLifetimes()
 
     for (unsigned argNum = 0; argNum < info.compArgsCount; argNum++)
     {
-        LclVarDsc* argDsc = lvaTable + argNum;
+        LclVarDsc* argDsc   = lvaTable + argNum;
+        unsigned   argCount = 1;
         if (argDsc->lvPromoted)
         {
             lvaPromotionType promotionType = lvaGetPromotionType(argDsc);
 
             if (promotionType == PROMOTION_TYPE_INDEPENDENT)
             {
-                noway_assert(argDsc->lvFieldCnt == 1); // We only handle one field here
+                // We only handle one field here, or one field per register of a multireg struct
+                noway_assert((argDsc->lvFieldCnt == 1) || argDsc->lvIsMultiRegPromotedParam());
 
                 unsigned fieldVarNum = argDsc->lvFieldLclStart;
+                argCount             = argDsc->lvFieldCnt;
                 argDsc               = lvaTable + fieldVarNum;
             }
         }
-        noway_assert(argDsc->lvIsParam);
-        if (argDsc->lvTracked)
+        for (unsigned argIndex = 0; argIndex < argCount; argIndex++, argDsc++)
         {
-            noway_assert(!VarSetOps::IsMember(this, trackedArgs, argDsc->lvVarIndex)); // Each arg should define a
-                                                                                       // different bit.
-            VarSetOps::AddElemD(this, trackedArgs, argDsc->lvVarIndex);
+            noway_assert(argDsc->lvIsParam);
+            if (argDsc->lvTracked)
+            {
+                noway_assert(!VarSetOps::IsMember(this, trackedArgs, argDsc->lvVarIndex)); // Each arg should define a
+                                                                                           // different bit.
+                VarSetOps::AddElemD(this, trackedArgs, argDsc->lvVarIndex);
+            }
         }
     }
 
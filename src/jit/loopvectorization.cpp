@@ -0,0 +1,558 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+XX                                                                           XX
+XX                           LoopVectorization                               XX
+XX                                                                           XX
+XX   Rewrites simple counted loops over int/float/double arrays, such as     XX
+XX                                                                           XX
+XX        for (i = start; i < limit; i++) a[i] = b[i] op c[i];               XX
+XX                                                                           XX
+XX   to process Vector<T>.Count elements per iteration. The phase runs right XX
+XX   after loop cloning and only considers loops whose array accesses no     XX
+XX   longer carry bounds checks (i.e. the fast path of a cloned loop), since XX
+XX   that proves every element the vector loop touches is in range.          XX
+XX                                                                           XX
+XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+XXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXXX
+*/
+
+#include "jitpch.h"
+#ifdef _MSC_VER
+#pragma hdrstop
+#endif
+
+#if defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
+
+// The maximum number of array stores we are willing to vectorize in a single loop body.
+// Each one is duplicated in the vector loop, so keep the code growth bounded.
+#define MAX_VECTORIZED_STORES 4
+
+//------------------------------------------------------------------------
+// optVectorizeLoopIntrinsic: Map a scalar arithmetic operator to the SIMD
+//    intrinsic that performs it element-wise.
+//
+// Arguments:
+//    oper     - the scalar operator
+//    baseType - the element type of the arrays being processed
+//
+// Return Value:
+//    The SIMD intrinsic, or SIMDIntrinsicInvalid if the operator can't be
+//    vectorized for this element type.
+//
+static SIMDIntrinsicID optVectorizeLoopIntrinsic(genTreeOps oper, var_types baseType)
+{
+    switch (oper)
+    {
+        case GT_ADD:
+            return SIMDIntrinsicAdd;
+        case GT_SUB:
+            return SIMDIntrinsicSub;
+        case GT_MUL:
+            return SIMDIntrinsicMul;
+        case GT_DIV:
+            // There is no integer vector division on xarch.
+            return varTypeIsFloating(baseType) ? SIMDIntrinsicDiv : SIMDIntrinsicInvalid;
+        case GT_AND:
+            return (baseType == TYP_INT) ? SIMDIntrinsicBitwiseAnd : SIMDIntrinsicInvalid;
+        case GT_OR:
+            return (baseType == TYP_INT) ? SIMDIntrinsicBitwiseOr : SIMDIntrinsicInvalid;
+        case GT_XOR:
+            return (baseType == TYP_INT) ? SIMDIntrinsicBitwiseXor : SIMDIntrinsicInvalid;
+        default:
+            return SIMDIntrinsicInvalid;
+    }
+}
+
+//------------------------------------------------------------------------
+// optVectorizableArrayElem: Check whether "tree" loads or stores element
+//    "iterVar" of a local array, with the bounds check already removed.
+//
+// Arguments:
+//    tree     - the tree to check
+//    iterVar  - the loop iteration variable
+//    elemType - the expected array element type
+//
+// Return Value:
+//    The GT_IND node for the element, or nullptr if the tree has another shape.
+//
+// Notes:
+//    After loop cloning has removed the bounds check, a[i] looks like:
+//
+//      comma     int
+//         nop       void
+//         indir     int
+//            +         byref
+//               +         byref
+//                  lclVar    ref    V01 arg1
+//                  <<        long
+//                     cast      long <- int
+//                        lclVar    int    V04 loc0
+//                     const     long   2
+//               const     long   16 Fseq[#FirstElem]
+//
+//    Only an index of exactly "iterVar" is accepted: every access in the loop
+//    then touches the same element, so there can't be a dependence between
+//    iterations regardless of how the arrays alias.
+//
+GenTree* Compiler::optVectorizableArrayElem(GenTree* tree, unsigned iterVar, var_types elemType)
+{
+    if ((tree->OperGet() == GT_COMMA) && tree->gtGetOp1()->IsNothingNode())
+    {
+        tree = tree->gtGetOp2();
+    }
+    if ((tree->OperGet() != GT_IND) || (tree->TypeGet() != elemType))
+    {
+        return nullptr;
+    }
+    if ((tree->gtFlags & GTF_IND_VOLATILE) != 0)
+    {
+        return nullptr;
+    }
+
+    GenTree* sibo = tree->gtGetOp1();
+    if (sibo->OperGet() != GT_ADD)
+    {
+        return nullptr;
+    }
+    GenTree* sib = sibo->gtGetOp1();
+    GenTree* ofs = sibo->gtGetOp2();
+    if ((sib->OperGet() != GT_ADD) || (ofs->OperGet() != GT_CNS_INT) ||
+        (ofs->gtIntCon.gtIconVal != (ssize_t)eeGetArrayDataOffset(elemType)))
+    {
+        return nullptr;
+    }
+    GenTree* base = sib->gtGetOp1();
+    GenTree* si   = sib->gtGetOp2();
+    if ((base->OperGet() != GT_LCL_VAR) || (base->TypeGet() != TYP_REF) || (si->OperGet() != GT_LSH))
+    {
+        return nullptr;
+    }
+    GenTree* scale = si->gtGetOp2();
+    if ((scale->OperGet() != GT_CNS_INT) ||
+        ((ssize_t)genTypeSize(elemType) != ((ssize_t)1 << scale->gtIntCon.gtIconVal)))
+    {
+        return nullptr;
+    }
+#ifdef _TARGET_64BIT_
+    GenTree* index = si->gtGetOp1();
+    if (index->OperGet() != GT_CAST)
+    {
+        return nullptr;
+    }
+    GenTree* indexVar = index->gtGetOp1();
+#else
+    GenTree* indexVar = si->gtGetOp1();
+#endif
+    if ((indexVar->OperGet() != GT_LCL_VAR) || (indexVar->gtLclVarCommon.gtLclNum != iterVar))
+    {
+        return nullptr;
+    }
+    return tree;
+}
+
+//------------------------------------------------------------------------
+// optIsVectorizableLoopExpr: Check whether the value computed by "tree" in
+//    each iteration can instead be computed for a whole vector of iterations.
+//
+// Arguments:
+//    tree     - the right hand side of an array element store
+//    iterVar  - the loop iteration variable
+//    elemType - the array element type
+//
+// Return Value:
+//    true if every leaf is an element "iterVar" of some array, a constant or
+//    a loop invariant local, and every operator has a SIMD counterpart.
+//
+bool Compiler::optIsVectorizableLoopExpr(GenTree* tree, unsigned iterVar, var_types elemType)
+{
+    if (optVectorizableArrayElem(tree, iterVar, elemType) != nullptr)
+    {
+        return true;
+    }
+
+    switch (tree->OperGet())
+    {
+        case GT_CNS_INT:
+            return (elemType == TYP_INT) && (tree->TypeGet() == TYP_INT) && !tree->IsIconHandle();
+
+        case GT_CNS_DBL:
+            return varTypeIsFloating(elemType) && (tree->TypeGet() == elemType);
+
+        case GT_LCL_VAR:
+            // The only local assigned in the loop body is the iteration variable; everything
+            // else is invariant and gets broadcast to all the vector elements.
+            return (tree->TypeGet() == elemType) && (tree->gtLclVarCommon.gtLclNum != iterVar);
+
+        default:
+            break;
+    }
+
+    if (!tree->OperIsBinary() || (tree->TypeGet() != elemType) || tree->gtOverflowEx())
+    {
+        return false;
+    }
+    if (optVectorizeLoopIntrinsic(tree->OperGet(), elemType) == SIMDIntrinsicInvalid)
+    {
+        return false;
+    }
+    return optIsVectorizableLoopExpr(tree->gtGetOp1(), iterVar, elemType) &&
+           optIsVectorizableLoopExpr(tree->gtGetOp2(), iterVar, elemType);
+}
+
+//------------------------------------------------------------------------
+// optVectorizeLoopExpr: Build the vector counterpart of a scalar expression
+//    that optIsVectorizableLoopExpr has accepted.
+//
+// Arguments:
+//    tree     - the scalar expression
+//    iterVar  - the loop iteration variable
+//    simdType - the SIMD type to produce
+//    baseType - the array element type
+//    simdSize - the size of "simdType" in bytes
+//
+// Return Value:
+//    A new tree of type "simdType". The scalar tree is left untouched.
+//
+GenTree* Compiler::optVectorizeLoopExpr(
+    GenTree* tree, unsigned iterVar, var_types simdType, var_types baseType, unsigned simdSize)
+{
+    GenTree* elem = optVectorizableArrayElem(tree, iterVar, baseType);
+    if (elem != nullptr)
+    {
+        // The element address stays the same: the vector starts at element "iterVar".
+        GenTree* load = gtNewOperNode(GT_IND, simdType, gtCloneExpr(elem->gtGetOp1()));
+        load->gtFlags |= (elem->gtFlags & ~GTF_IND_ARR_INDEX);
+        return load;
+    }
+
+    switch (tree->OperGet())
+    {
+        case GT_CNS_INT:
+        case GT_CNS_DBL:
+        case GT_LCL_VAR:
+            return gtNewSIMDNode(simdType, gtCloneExpr(tree), nullptr, SIMDIntrinsicInit, baseType, simdSize);
+
+        default:
+            break;
+    }
+
+    SIMDIntrinsicID intrinsic = optVectorizeLoopIntrinsic(tree->OperGet(), baseType);
+    assert(intrinsic != SIMDIntrinsicInvalid);
+
+    GenTree* op1 = optVectorizeLoopExpr(tree->gtGetOp1(), iterVar, simdType, baseType, simdSize);
+    GenTree* op2 = optVectorizeLoopExpr(tree->gtGetOp2(), iterVar, simdType, baseType, simdSize);
+    return gtNewSIMDNode(simdType, op1, op2, intrinsic, baseType, simdSize);
+}
+
+//------------------------------------------------------------------------
+// optVectorizeLoops: Vectorize the simple array loops of the method.
+//
+// Notes:
+//    Runs after loop cloning so that the fast path loops, whose array
+//    accesses have had their bounds checks removed, can be considered.
+//    Enabled by COMPlus_JitVectorizeLoops.
+//
+void Compiler::optVectorizeLoops()
+{
+    JITDUMP("\n*************** In optVectorizeLoops()\n");
+
+    if ((optLoopCount == 0) || !featureSIMD || (JitConfig.JitVectorizeLoops() == 0))
+    {
+        return;
+    }
+
+    if (compCodeOpt() == SMALL_CODE)
+    {
+        return;
+    }
+
+    bool changed = false;
+    for (unsigned lnum = 0; lnum < optLoopCount; lnum++)
+    {
+        if (optVectorizeLoop(lnum))
+        {
+            optLoopsVectorized++;
+            changed = true;
+        }
+    }
+
+    if (changed)
+    {
+        fgUpdateChangedFlowGraph();
+
+#ifdef DEBUG
+        if (verbose)
+        {
+            printf("\nAfter loop vectorization:\n");
+            fgDispBasicBlocks(/*dumpTrees*/ true);
+        }
+#endif
+    }
+}
+
+//------------------------------------------------------------------------
+// optVectorizeLoop: Try to vectorize loop "loopInd".
+//
+// Arguments:
+//    loopInd - index of the loop in the loop table
+//
+// Return Value:
+//    true if the loop was vectorized.
+//
+// Notes:
+//    Only single block do-while loops of the form
+//
+//        H:  ...
+//        B:  a[i] = <expr>; ...; i = i + 1; if (i < limit) goto B;
+//        X:
+//
+//    are handled. The loop becomes:
+//
+//        H:  ...
+//        V0: if (i + VF > limit) goto J;
+//        V1: <vector stores>; i = i + VF; if (i + VF <= limit) goto V1;
+//        V2: if (i >= limit) goto X;
+//        J:
+//        B:  a[i] = <expr>; ...; i = i + 1; if (i < limit) goto B;
+//        X:
+//
+//    where VF is the number of elements per vector. B is left as-is and
+//    serves as the scalar epilogue for the remaining elements. V0 branches
+//    straight to the original loop, so a do-while loop whose first iteration
+//    runs unconditionally keeps doing so. After at least one vector iteration
+//    "i" is a valid index (B ran with it in the original loop) so "i + VF"
+//    can't overflow.
+//
+bool Compiler::optVectorizeLoop(unsigned loopInd)
+{
+    LoopDsc& loop = optLoopTable[loopInd];
+
+    // Only the loops whose array bounds checks loop cloning has removed are candidates: the cloning
+    // conditions prove that every index the iterator takes, from its initial value up to the limit,
+    // is in bounds of the arrays it indexes, so the vector loop can't read or write past their end.
+    const unsigned requiredFlags = LPFLG_ITER | LPFLG_DO_WHILE | LPFLG_BNDCHKS_REMOVED;
+    if (((loop.lpFlags & requiredFlags) != requiredFlags) || ((loop.lpFlags & LPFLG_REMOVED) != 0))
+    {
+        return false;
+    }
+    if ((loop.lpFlags & (LPFLG_CONST_LIMIT | LPFLG_VAR_LIMIT | LPFLG_ARRLEN_LIMIT)) == 0)
+    {
+        return false;
+    }
+
+    BasicBlock* head   = loop.lpHead;
+    BasicBlock* block  = loop.lpBottom;
+    BasicBlock* exitBB = block->bbNext;
+
+    if ((loop.lpFirst != block) || (loop.lpTop != block) || (loop.lpEntry != block) || (head->bbNext != block))
+    {
+        return false;
+    }
+    if ((block->bbJumpKind != BBJ_COND) || (block->bbJumpDest != block) || (block->bbRefs != 2))
+    {
+        return false;
+    }
+    if ((head->bbJumpKind != BBJ_NONE) && ((head->bbJumpKind != BBJ_COND) || (head->bbJumpDest == block)))
+    {
+        return false;
+    }
+    if ((exitBB == nullptr) || bbIsHandlerBeg(exitBB) || !BasicBlock::sameEHRegion(head, block) ||
+        !BasicBlock::sameEHRegion(block, exitBB))
+    {
+        return false;
+    }
+    if (block->isRunRarely())
+    {
+        return false;
+    }
+
+    // The iterator must be a plain int local stepped by one and compared with "<".
+    unsigned iterVar = loop.lpIterVar();
+    if ((lvaTable[iterVar].TypeGet() != TYP_INT) || lvaTable[iterVar].lvAddrExposed)
+    {
+        return false;
+    }
+    if (((loop.lpIterOper() != GT_ADD) && (loop.lpIterOper() != GT_ASG_ADD)) || (loop.lpIterConst() != 1))
+    {
+        return false;
+    }
+    if ((loop.lpTestOper() != GT_LT) || ((loop.lpTestTree->gtFlags & GTF_UNSIGNED) != 0))
+    {
+        return false;
+    }
+
+    GenTree* limit = loop.lpLimit();
+    if ((loop.lpFlags & LPFLG_VAR_LIMIT) != 0)
+    {
+        if (optIsVarAssgLoop(loopInd, limit->gtLclVarCommon.gtLclNum))
+        {
+            return false;
+        }
+    }
+    else if ((loop.lpFlags & LPFLG_ARRLEN_LIMIT) != 0)
+    {
+        GenTree* arrRef = limit->gtArrLen.ArrRef();
+        if ((arrRef->OperGet() != GT_LCL_VAR) || optIsVarAssgLoop(loopInd, arrRef->gtLclVarCommon.gtLclNum))
+        {
+            return false;
+        }
+    }
+
+    // Everything but the increment and the test must be a vectorizable array store,
+    // and all of the stores must agree on the element type.
+    var_types    baseType   = TYP_UNDEF;
+    unsigned     storeCount = 0;
+    GenTreeStmt* testStmt   = block->lastStmt();
+    for (GenTreeStmt* stmt = block->firstStmt(); stmt != nullptr; stmt = stmt->gtNextStmt)
+    {
+        GenTree* expr = stmt->gtStmtExpr;
+        if (stmt == testStmt)
+        {
+            if ((expr->OperGet() != GT_JTRUE) || (expr->gtGetOp1() != loop.lpTestTree))
+            {
+                return false;
+            }
+            continue;
+        }
+        if (expr == loop.lpIterTree)
+        {
+            continue;
+        }
+
+        if ((expr->OperGet() == GT_COMMA) && expr->gtGetOp1()->IsNothingNode())
+        {
+            expr = expr->gtGetOp2();
+        }
+        if ((expr->OperGet() != GT_ASG) || (storeCount == MAX_VECTORIZED_STORES))
+        {
+            return false;
+        }
+        storeCount++;
+
+        var_types elemType = expr->gtGetOp1()->TypeGet();
+        if ((elemType != TYP_INT) && (elemType != TYP_FLOAT) && (elemType != TYP_DOUBLE))
+        {
+            return false;
+        }
+        if ((baseType != TYP_UNDEF) && (baseType != elemType))
+        {
+            return false;
+        }
+        baseType = elemType;
+
+        if ((optVectorizableArrayElem(expr->gtGetOp1(), iterVar, baseType) == nullptr) ||
+            !optIsVectorizableLoopExpr(expr->gtGetOp2(), iterVar, baseType))
+        {
+            return false;
+        }
+    }
+
+    if (storeCount == 0)
+    {
+        return false;
+    }
+
+    var_types simdType = getSIMDVectorType();
+    unsigned  simdSize = getSIMDVectorRegisterByteLength();
+    int       vf       = (int)(simdSize / genTypeSize(baseType));
+
+    JITDUMP("Vectorizing loop L%02u (BB%02u) over V%02u, %u store(s) of %s, %d elements per iteration\n", loopInd,
+            block->bbNum, iterVar, storeCount, varTypeName(baseType), vf);
+
+    // Lay out the new blocks: H -> V0 -> V1 -> V2 -> J -> B.
+    BasicBlock* vecGuard = fgNewBBafter(BBJ_COND, head, /*extendRegion*/ true);
+    BasicBlock* vecBody  = fgNewBBafter(BBJ_COND, vecGuard, /*extendRegion*/ true);
+    BasicBlock* vecExit  = fgNewBBafter(BBJ_COND, vecBody, /*extendRegion*/ true);
+    BasicBlock* join     = fgNewBBafter(BBJ_NONE, vecExit, /*extendRegion*/ true);
+
+    vecGuard->inheritWeight(head);
+    vecExit->inheritWeight(head);
+    join->inheritWeight(head);
+    vecBody->inheritWeight(block);
+
+    vecGuard->bbNatLoopNum = loop.lpParent;
+    vecBody->bbNatLoopNum  = loop.lpParent;
+    vecExit->bbNatLoopNum  = loop.lpParent;
+    join->bbNatLoopNum     = loop.lpParent;
+
+    vecGuard->bbJumpDest = join;
+    vecBody->bbJumpDest  = vecBody;
+    vecExit->bbJumpDest  = exitBB;
+
+    vecBody->bbFlags |= BBF_LOOP_HEAD | BBF_JMP_TARGET | BBF_HAS_LABEL;
+    join->bbFlags |= BBF_JMP_TARGET | BBF_HAS_LABEL;
+    exitBB->bbFlags |= BBF_JMP_TARGET | BBF_HAS_LABEL;
+
+    // V0: if (i + VF > limit) goto J;
+    GenTree* iPlusVF = gtNewOperNode(GT_ADD, TYP_INT, gtNewLclvNode(iterVar, TYP_INT), gtNewIconNode(vf));
+    GenTree* cond    = gtNewOperNode(GT_GT, TYP_INT, iPlusVF, gtCloneExpr(limit));
+    GenTreeStmt* stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(vecGuard, stmt);
+    fgMorphBlockStmt(vecGuard, stmt DEBUGARG("Loop vectorization guard"));
+
+    // V1: the vector stores.
+    for (GenTreeStmt* scalarStmt = block->firstStmt(); scalarStmt != testStmt; scalarStmt = scalarStmt->gtNextStmt)
+    {
+        GenTree* expr = scalarStmt->gtStmtExpr;
+        if (expr == loop.lpIterTree)
+        {
+            continue;
+        }
+        if (expr->OperGet() == GT_COMMA)
+        {
+            expr = expr->gtGetOp2();
+        }
+
+        GenTree* dstElem = optVectorizableArrayElem(expr->gtGetOp1(), iterVar, baseType);
+        GenTree* value   = optVectorizeLoopExpr(expr->gtGetOp2(), iterVar, simdType, baseType, simdSize);
+
+        // Same shape as the stores fgMorphCombineSIMDFieldAssignments produces.
+        GenTree* dst = gtNewBlockVal(gtCloneExpr(dstElem->gtGetOp1()), simdSize);
+        dst->gtType  = simdType;
+        dst->gtFlags |= GTF_GLOB_REF;
+        GenTree* asg = gtNewBlkOpNode(dst, value, simdSize,
+                                      false, // not volatile
+                                      true); // copyBlock
+
+        // The phase runs after global morph, so the new statements have to be morphed here.
+        stmt = fgNewStmtFromTree(asg, scalarStmt->gtStmtILoffsx);
+        fgInsertStmtAtEnd(vecBody, stmt);
+        fgMorphBlockStmt(vecBody, stmt DEBUGARG("Loop vectorization store"));
+    }
+
+    // V1: i = i + VF; if (i + VF <= limit) goto V1;
+    GenTree* incr = gtNewAssignNode(gtNewLclvNode(iterVar, TYP_INT),
+                                    gtNewOperNode(GT_ADD, TYP_INT, gtNewLclvNode(iterVar, TYP_INT), gtNewIconNode(vf)));
+    stmt = fgNewStmtFromTree(incr);
+    fgInsertStmtAtEnd(vecBody, stmt);
+    fgMorphBlockStmt(vecBody, stmt DEBUGARG("Loop vectorization increment"));
+
+    iPlusVF = gtNewOperNode(GT_ADD, TYP_INT, gtNewLclvNode(iterVar, TYP_INT), gtNewIconNode(vf));
+    cond    = gtNewOperNode(GT_LE, TYP_INT, iPlusVF, gtCloneExpr(limit));
+    stmt    = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(vecBody, stmt);
+    fgMorphBlockStmt(vecBody, stmt DEBUGARG("Loop vectorization test"));
+
+    // V2: if (i >= limit) goto X;
+    cond = gtNewOperNode(GT_GE, TYP_INT, gtNewLclvNode(iterVar, TYP_INT), gtCloneExpr(limit));
+    stmt = fgNewStmtFromTree(gtNewOperNode(GT_JTRUE, TYP_VOID, cond));
+    fgInsertStmtAtEnd(vecExit, stmt);
+    fgMorphBlockStmt(vecExit, stmt DEBUGARG("Loop vectorization epilogue guard"));
+
+    // The scalar loop is now entered (only) from J.
+    optUpdateLoopHead(loopInd, head, join);
+
+    // The scalar loop is the epilogue now; don't let the unroller duplicate it.
+    loop.lpFlags |= LPFLG_DONT_UNROLL;
+
+    setUsesSIMDTypes(true);
+    compFloatingPointUsed = true;
+
+    return true;
+}
+
+#endif // defined(FEATURE_SIMD) && !defined(LEGACY_BACKEND)
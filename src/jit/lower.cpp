@@ -1711,15 +1711,6 @@ void Lowering::LowerFastTailCall(GenTreeCall* call)
         firstPutArgStk = putargs.Bottom();
     }
 
-    // If we have a putarg_stk node, also count the number of non-standard args the
-    // call node has.  Note that while determining whether a tail call can be fast
-    // tail called, we don't count non-standard args (passed in R10 or R11) since they
-    // don't contribute to outgoing arg space.  These non-standard args are not
-    // accounted in caller's arg count but accounted in callee's arg count after
-    // fgMorphArgs(). Therefore, exclude callee's non-standard args while mapping
-    // callee's stack arg num to corresponding caller's stack arg num.
-    unsigned calleeNonStandardArgCount = call->GetNonStandardAddedArgCount(comp);
-
     // Say Caller(a, b, c, d, e) fast tail calls Callee(e, d, c, b, a)
     // i.e. passes its arguments in reverse to Callee. During call site
     // setup, after computing argument side effects, stack args are setup
@@ -1758,67 +1749,44 @@ void Lowering::LowerFastTailCall(GenTreeCall* call)
         // Callee.
         fgArgTabEntryPtr argTabEntry = comp->gtArgEntryByNode(call, putArgStkNode);
         assert(argTabEntry);
-        unsigned callerArgNum = argTabEntry->argNum - calleeNonStandardArgCount;
-        noway_assert(callerArgNum < comp->info.compArgsCount);
 
-        unsigned   callerArgLclNum = callerArgNum;
-        LclVarDsc* callerArgDsc    = comp->lvaTable + callerArgLclNum;
-        if (callerArgDsc->lvPromoted)
-        {
-            callerArgLclNum =
-                callerArgDsc->lvFieldLclStart; // update the callerArgNum to the promoted struct field's lclNum
-            callerArgDsc = comp->lvaTable + callerArgLclNum;
-        }
-        noway_assert(callerArgDsc->lvIsParam);
-
-        // Start searching in execution order list till we encounter call node
-        unsigned  tmpLclNum = BAD_VAR_NUM;
-        var_types tmpType   = TYP_UNDEF;
-        for (GenTreePtr treeNode = putArgStkNode->gtNext; treeNode != call; treeNode = treeNode->gtNext)
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+        // On System V integer and floating point args are assigned registers independently,
+        // so the callee's stack args do not correspond to the caller's by arg number. Find
+        // the caller's stack args that share stack slots with this arg instead. Note that
+        // fgCanFastTailCall only allows this when the caller's stack args are not structs.
+        unsigned calleeArgOffset = argTabEntry->slotNum * TARGET_POINTER_SIZE;
+        unsigned calleeArgEnd    = calleeArgOffset + argTabEntry->numSlots * TARGET_POINTER_SIZE;
+        unsigned callerArgOffset = 0;
+
+        for (unsigned callerArgNum = 0; callerArgNum < comp->info.compArgsCount; callerArgNum++)
         {
-            if (treeNode->OperIsLocal() || treeNode->OperIsLocalAddr())
+            if (comp->lvaTable[callerArgNum].lvIsRegArg)
             {
-                // This should neither be a GT_REG_VAR nor GT_PHI_ARG.
-                assert((treeNode->OperGet() != GT_REG_VAR) && (treeNode->OperGet() != GT_PHI_ARG));
-
-                GenTreeLclVarCommon* lcl    = treeNode->AsLclVarCommon();
-                LclVarDsc*           lclVar = &comp->lvaTable[lcl->gtLclNum];
-
-                // Fast tail calling criteria permits passing of structs of size 1, 2, 4 and 8 as args.
-                // It is possible that the callerArgLclNum corresponds to such a struct whose stack slot
-                // is getting over-written by setting up of a stack arg and there are further uses of
-                // any of its fields if such a struct is type-dependently promoted.  In this case too
-                // we need to introduce a temp.
-                if ((lcl->gtLclNum == callerArgNum) || (lcl->gtLclNum == callerArgLclNum))
-                {
-                    // Create tmp and use it in place of callerArgDsc
-                    if (tmpLclNum == BAD_VAR_NUM)
-                    {
-                        tmpLclNum = comp->lvaGrabTemp(
-                            true DEBUGARG("Fast tail call lowering is creating a new local variable"));
-                        comp->lvaSortAgain                          = true;
-                        tmpType                                     = genActualType(callerArgDsc->lvaArgType());
-                        comp->lvaTable[tmpLclNum].lvType            = tmpType;
-                        comp->lvaTable[tmpLclNum].lvRefCnt          = 1;
-                        comp->lvaTable[tmpLclNum].lvDoNotEnregister = comp->lvaTable[lcl->gtLclNum].lvDoNotEnregister;
-                    }
+                continue;
+            }
 
-                    lcl->SetLclNum(tmpLclNum);
-                }
+            unsigned callerArgEnd =
+                callerArgOffset + (unsigned)roundUp(comp->lvaLclSize(callerArgNum), TARGET_POINTER_SIZE);
+
+            if ((callerArgOffset < calleeArgEnd) && (calleeArgOffset < callerArgEnd))
+            {
+                LowerFastTailCallCallerArg(call, putArgStkNode, firstPutArgStk, callerArgNum);
             }
-        }
 
-        // If we have created a temp, insert an embedded assignment stmnt before
-        // the first putargStkNode i.e.
-        //     tmpLcl = CallerArg
-        if (tmpLclNum != BAD_VAR_NUM)
-        {
-            assert(tmpType != TYP_UNDEF);
-            GenTreeLclVar* local =
-                new (comp, GT_LCL_VAR) GenTreeLclVar(GT_LCL_VAR, tmpType, callerArgLclNum, BAD_IL_OFFSET);
-            GenTree* assignExpr = comp->gtNewTempAssign(tmpLclNum, local);
-            BlockRange().InsertBefore(firstPutArgStk, LIR::SeqTree(comp, assignExpr));
+            callerArgOffset = callerArgEnd;
         }
+#else  // !FEATURE_UNIX_AMD64_STRUCT_PASSING
+        // Note that while determining whether a tail call can be fast tail called, we
+        // don't count non-standard args (passed in R10 or R11) since they don't contribute
+        // to outgoing arg space.  These non-standard args are not accounted in caller's
+        // arg count but accounted in callee's arg count after fgMorphArgs(). Therefore,
+        // exclude callee's non-standard args while mapping callee's stack arg num to
+        // corresponding caller's stack arg num.
+        unsigned calleeNonStandardArgCount = call->GetNonStandardAddedArgCount(comp);
+        unsigned callerArgNum              = argTabEntry->argNum - calleeNonStandardArgCount;
+        LowerFastTailCallCallerArg(call, putArgStkNode, firstPutArgStk, callerArgNum);
+#endif // !FEATURE_UNIX_AMD64_STRUCT_PASSING
     }
 
     // Insert GT_START_NONGC node before the first GT_PUTARG_STK node.
@@ -1867,6 +1835,90 @@ void Lowering::LowerFastTailCall(GenTreeCall* call)
 #endif
 }
 
+#if FEATURE_FASTTAILCALL
+//------------------------------------------------------------------------
+// LowerFastTailCallCallerArg: Make sure that a caller arg whose stack slot is
+// overwritten by setting up a stack arg of a fast tail call is not used after
+// that.
+//
+// Arguments:
+//    call           - the fast tail call
+//    putArgStkNode  - the GT_PUTARG_STK node that sets up the callee's stack arg
+//    firstPutArgStk - the first GT_PUTARG_STK node of the call
+//    callerArgNum   - the caller arg that shares stack slots with the callee's arg
+//
+// Notes:
+//    Any uses of the caller arg between putArgStkNode and the call are replaced
+//    with uses of a temp that is assigned before the first GT_PUTARG_STK node.
+
+void Lowering::LowerFastTailCallCallerArg(GenTreeCall* call,
+                                          GenTree*     putArgStkNode,
+                                          GenTree*     firstPutArgStk,
+                                          unsigned     callerArgNum)
+{
+    noway_assert(callerArgNum < comp->info.compArgsCount);
+
+    unsigned   callerArgLclNum = callerArgNum;
+    LclVarDsc* callerArgDsc    = comp->lvaTable + callerArgLclNum;
+    if (callerArgDsc->lvPromoted)
+    {
+        callerArgLclNum =
+            callerArgDsc->lvFieldLclStart; // update the callerArgNum to the promoted struct field's lclNum
+        callerArgDsc = comp->lvaTable + callerArgLclNum;
+    }
+    noway_assert(callerArgDsc->lvIsParam);
+
+    // Start searching in execution order list till we encounter call node
+    unsigned  tmpLclNum = BAD_VAR_NUM;
+    var_types tmpType   = TYP_UNDEF;
+    for (GenTreePtr treeNode = putArgStkNode->gtNext; treeNode != call; treeNode = treeNode->gtNext)
+    {
+        if (treeNode->OperIsLocal() || treeNode->OperIsLocalAddr())
+        {
+            // This should neither be a GT_REG_VAR nor GT_PHI_ARG.
+            assert((treeNode->OperGet() != GT_REG_VAR) && (treeNode->OperGet() != GT_PHI_ARG));
+
+            GenTreeLclVarCommon* lcl    = treeNode->AsLclVarCommon();
+            LclVarDsc*           lclVar = &comp->lvaTable[lcl->gtLclNum];
+
+            // Fast tail calling criteria permits passing of structs of size 1, 2, 4 and 8 as args.
+            // It is possible that the callerArgLclNum corresponds to such a struct whose stack slot
+            // is getting over-written by setting up of a stack arg and there are further uses of
+            // any of its fields if such a struct is type-dependently promoted.  In this case too
+            // we need to introduce a temp.
+            if ((lcl->gtLclNum == callerArgNum) || (lcl->gtLclNum == callerArgLclNum))
+            {
+                // Create tmp and use it in place of callerArgDsc
+                if (tmpLclNum == BAD_VAR_NUM)
+                {
+                    tmpLclNum = comp->lvaGrabTemp(
+                        true DEBUGARG("Fast tail call lowering is creating a new local variable"));
+                    comp->lvaSortAgain                          = true;
+                    tmpType                                     = genActualType(callerArgDsc->lvaArgType());
+                    comp->lvaTable[tmpLclNum].lvType            = tmpType;
+                    comp->lvaTable[tmpLclNum].lvRefCnt          = 1;
+                    comp->lvaTable[tmpLclNum].lvDoNotEnregister = comp->lvaTable[lcl->gtLclNum].lvDoNotEnregister;
+                }
+
+                lcl->SetLclNum(tmpLclNum);
+            }
+        }
+    }
+
+    // If we have created a temp, insert an embedded assignment stmnt before
+    // the first putargStkNode i.e.
+    //     tmpLcl = CallerArg
+    if (tmpLclNum != BAD_VAR_NUM)
+    {
+        assert(tmpType != TYP_UNDEF);
+        GenTreeLclVar* local =
+            new (comp, GT_LCL_VAR) GenTreeLclVar(GT_LCL_VAR, tmpType, callerArgLclNum, BAD_IL_OFFSET);
+        GenTree* assignExpr = comp->gtNewTempAssign(tmpLclNum, local);
+        BlockRange().InsertBefore(firstPutArgStk, LIR::SeqTree(comp, assignExpr));
+    }
+}
+#endif // FEATURE_FASTTAILCALL
+
 //------------------------------------------------------------------------
 // LowerTailCallViaHelper: lower a call via the tailcall helper. Morph
 // has already inserted tailcall helper special arguments. This function
@@ -4567,6 +4619,12 @@ void Lowering::DoPhase()
     }
 #endif // !defined(_TARGET_64BIT_)
 
+    // Barrier elision relies on calls being the only GC safe points, so it is
+    // not done for fully interruptible methods.
+    const bool elideFreshObjectBarriers = (JitConfig.JitElideFreshObjectBarriers() != 0) &&
+                                          !comp->opts.MinOpts() && !comp->opts.compDbgCode &&
+                                          !comp->genInterruptible;
+
     for (BasicBlock* block = comp->fgFirstBB; block; block = block->bbNext)
     {
         /* Make the block publicly available */
@@ -4580,6 +4638,11 @@ void Lowering::DoPhase()
 #endif //!_TARGET_64BIT_
 
         LowerBlock(block);
+
+        if (elideFreshObjectBarriers)
+        {
+            MarkFreshObjectStores(block);
+        }
     }
 
 #ifdef DEBUG
@@ -4846,6 +4909,209 @@ void Lowering::LowerBlock(BasicBlock* block)
     assert(CheckBlock(comp, block));
 }
 
+//------------------------------------------------------------------------
+// IsFreshObjectAllocation: Check whether a node is a call to an allocation
+//    helper whose result is known to live in gen0.
+//
+// Arguments:
+//    node - the node to check
+//
+// Return Value:
+//    true if the node is a call to the small object allocator or a call to the
+//    object array allocator with a small constant length; false otherwise.
+//
+// Notes:
+//    The EE only hands out CORINFO_HELP_NEWSFAST for small, non-finalizable
+//    objects, and arrays below the large object threshold are always allocated
+//    in gen0. Value class arrays are not considered since their element size is
+//    not known here.
+//
+bool Lowering::IsFreshObjectAllocation(GenTree* node)
+{
+    if (!node->IsCall() || (node->AsCall()->gtCallType != CT_HELPER))
+    {
+        return false;
+    }
+
+    GenTreeCall* call = node->AsCall();
+
+    switch (comp->eeGetHelperNum(call->gtCallMethHnd))
+    {
+        case CORINFO_HELP_NEWSFAST:
+        case CORINFO_HELP_NEWSFAST_ALIGN8:
+            return true;
+
+        case CORINFO_HELP_NEWARR_1_OBJ:
+        {
+            // Stay well below the 85000 byte large object threshold.
+            const ssize_t maxElements = 8192;
+
+            GenTree* length = comp->gtArgEntryByArgNum(call, 1)->node;
+            if (length->OperGet() == GT_PUTARG_REG)
+            {
+                length = length->gtGetOp1();
+            }
+
+            return length->IsCnsIntOrI() && (length->AsIntCon()->IconValue() >= 0) &&
+                   (length->AsIntCon()->IconValue() <= maxElements);
+        }
+
+        default:
+            return false;
+    }
+}
+
+//------------------------------------------------------------------------
+// MarkFreshObjectStores: Mark GC ref stores into objects that were allocated
+//    earlier in the same block, and have not been published since, as not
+//    needing a write barrier.
+//
+// Arguments:
+//    block - the (already lowered) block to analyze
+//
+// Notes:
+//    A freshly allocated object lives in gen0, so any reference stored into it
+//    points to an object of the same or an older generation and never needs a
+//    card. The barrier also records the store for software write watch, which
+//    a background GC needs for objects it may already have marked; that cannot
+//    be the case for an object no other thread can reach yet. So the store is
+//    safe without a barrier as long as:
+//
+//    - no call (and thus no GC safe point) executes between the allocation and
+//      the store, and the method is not fully interruptible;
+//    - the allocation local is not redefined in between; and
+//    - the object has not escaped in between: the only uses allowed are as the
+//      base address of a load or store (directly, or via a LEA/ADD).
+//
+//    The analysis is linear in the LIR of the block. Uses of an allocation
+//    local (and addresses derived from them) are remembered while the local is
+//    still fresh, so a value read before the local was redefined is never
+//    mistaken for the fresh object.
+//
+void Lowering::MarkFreshObjectStores(BasicBlock* block)
+{
+    ArrayStack<unsigned> freshLocals(comp);
+    ArrayStack<GenTree*> freshAddrs(comp);
+
+    for (GenTree* node : LIR::AsRange(block))
+    {
+        if (node->IsCall())
+        {
+            // A call is a GC safe point; nothing allocated before it is known
+            // to still be in gen0 afterwards.
+            freshLocals.Reset();
+            freshAddrs.Reset();
+            continue;
+        }
+
+        // Any use of a fresh address other than as the address of an
+        // indirection publishes the object.
+        bool escaped = false;
+
+        for (GenTree* operand : node->Operands())
+        {
+            bool isFreshAddr = false;
+            for (int i = 0; i < freshAddrs.Height(); i++)
+            {
+                if (freshAddrs.Index(i) == operand)
+                {
+                    isFreshAddr = true;
+                    break;
+                }
+            }
+
+            if (!isFreshAddr)
+            {
+                continue;
+            }
+
+            bool isAddress = false;
+            switch (node->OperGet())
+            {
+                case GT_IND:
+                case GT_NULLCHECK:
+                case GT_ARR_LENGTH:
+                    isAddress = true;
+                    break;
+
+                case GT_STOREIND:
+                    isAddress = (node->gtGetOp1() == operand) && (node->gtGetOp2() != operand);
+                    break;
+
+                case GT_LEA:
+                    isAddress = (node->AsAddrMode()->Base() == operand) && (node->AsAddrMode()->Index() != operand);
+                    break;
+
+                case GT_ADD:
+                    isAddress = (node->TypeGet() == TYP_BYREF) && (node->gtGetOp1() == operand) &&
+                                node->gtGetOp2()->IsCnsIntOrI();
+                    break;
+
+                default:
+                    break;
+            }
+
+            if (!isAddress)
+            {
+                escaped = true;
+                break;
+            }
+
+            if (node->OperIs(GT_LEA, GT_ADD))
+            {
+                freshAddrs.Push(node);
+            }
+            else if (node->OperIs(GT_STOREIND) && varTypeIsGC(node->TypeGet()))
+            {
+                JITDUMP("STOREIND [%06u] stores into a fresh object, no write barrier needed\n", node->gtTreeID);
+                node->gtFlags |= GTF_IND_FRESH_OBJ;
+            }
+        }
+
+        if (escaped || node->OperIsLocalAddr())
+        {
+            // Rather than tracking which local an escaping (possibly derived)
+            // address came from, give up on everything allocated so far.
+            freshLocals.Reset();
+            freshAddrs.Reset();
+        }
+        else if (node->OperIs(GT_LCL_VAR))
+        {
+            unsigned lclNum = node->AsLclVarCommon()->gtLclNum;
+            for (int i = 0; i < freshLocals.Height(); i++)
+            {
+                if (freshLocals.Index(i) == lclNum)
+                {
+                    freshAddrs.Push(node);
+                    break;
+                }
+            }
+        }
+        else if (node->OperIsLocalStore())
+        {
+            // The local no longer holds the object it was tracking (if any);
+            // values read from it before this point are dropped as well.
+            unsigned lclNum = node->AsLclVarCommon()->gtLclNum;
+            for (int i = 0; i < freshLocals.Height(); i++)
+            {
+                if (freshLocals.Index(i) == lclNum)
+                {
+                    freshLocals.IndexRef(i) = freshLocals.Top();
+                    freshLocals.Pop();
+                    freshAddrs.Reset();
+                    break;
+                }
+            }
+
+            if (node->OperIs(GT_STORE_LCL_VAR) && (node->TypeGet() == TYP_REF) &&
+                !comp->lvaTable[lclNum].lvAddrExposed && IsFreshObjectAllocation(node->gtGetOp1()))
+            {
+                freshLocals.Push(lclNum);
+            }
+        }
+    }
+}
+
 /** Verifies if both of these trees represent the same indirection.
  * Used by Lower to annotate if CodeGen generate an instruction of the
  * form *addrMode BinOp= expr
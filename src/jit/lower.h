@@ -89,6 +89,12 @@ private:
     void LowerBlock(BasicBlock* block);
     GenTree* LowerNode(GenTree* node);
 
+    // ------------------------------
+    // Write barrier elision
+    // ------------------------------
+    bool IsFreshObjectAllocation(GenTree* node);
+    void MarkFreshObjectStores(BasicBlock* block);
+
     void CheckVSQuirkStackPaddingNeeded(GenTreeCall* call);
 
     // ------------------------------
@@ -104,6 +110,10 @@ private:
     GenTree* LowerNonvirtPinvokeCall(GenTreeCall* call);
     GenTree* LowerTailCallViaHelper(GenTreeCall* callNode, GenTree* callTarget);
     void LowerFastTailCall(GenTreeCall* callNode);
+    void LowerFastTailCallCallerArg(GenTreeCall* call,
+                                    GenTree*     putArgStkNode,
+                                    GenTree*     firstPutArgStk,
+                                    unsigned     callerArgNum);
     void InsertProfTailCallHook(GenTreeCall* callNode, GenTree* insertionPoint);
     GenTree* LowerVirtualVtableCall(GenTreeCall* call);
     GenTree* LowerVirtualStubCall(GenTreeCall* call);
@@ -1160,6 +1160,31 @@ LinearScan::LinearScan(Compiler* theCompiler)
 #endif // DEBUG
 
     enregisterLocalVars = ((compiler->opts.compFlags & CLFLG_REGVAR) != 0) && compiler->lvaTrackedCount > 0;
+
+    // Choose the cheaper allocation modes. Neither applies when stressing the allocator, so that
+    // the stress modes continue to exercise the full heuristics.
+    fastRegisterSelection = !enregisterLocalVars && (JitConfig.JitLsraFastMinOpts() != 0);
+    boundedCostAllocation = false;
+    boundedMaxCandidates  = compiler->lvaTrackedCount;
+    if (enregisterLocalVars)
+    {
+        unsigned costLimit = JitConfig.JitLsraBoundedCostLimit();
+        if ((costLimit != 0) && (((UINT64)compiler->lvaTrackedCount * compiler->fgBBcount) > costLimit))
+        {
+            boundedCostAllocation = true;
+            boundedMaxCandidates  = JitConfig.JitLsraBoundedMaxCandidates();
+        }
+    }
+#ifdef DEBUG
+    if (lsraStressMask != 0)
+    {
+        fastRegisterSelection = false;
+        boundedCostAllocation = false;
+        boundedMaxCandidates  = compiler->lvaTrackedCount;
+    }
+#endif // DEBUG
+    JITDUMP("LSRA: fastRegisterSelection=%d, boundedCostAllocation=%d\n", fastRegisterSelection,
+            boundedCostAllocation);
     availableIntRegs    = (RBM_ALLINT & ~compiler->codeGen->regSet.rsMaskResvd);
 
 #if ETW_EBP_FRAMED
@@ -1364,6 +1389,11 @@ void LinearScan::setBlockSequence()
     bool addedInternalBlocks = false;
     verifiedAllBBs           = false;
     hasCriticalEdges         = false;
+
+    // When no lclVars are enregistered the block order doesn't affect the allocation, and for
+    // very large methods the cost of maintaining the ordered worklist isn't worth it.
+    bool useLayoutOrder = isTraversalLayoutOrder() || !enregisterLocalVars || boundedCostAllocation;
+
     BasicBlock* nextBlock;
     for (BasicBlock* block = compiler->fgFirstBB; block != nullptr; block = nextBlock)
     {
@@ -1427,7 +1457,7 @@ void LinearScan::setBlockSequence()
                 checkForCriticalOutEdge = false;
             }
 
-            if (isTraversalLayoutOrder() || isBlockVisited(succ))
+            if (useLayoutOrder || isBlockVisited(succ))
             {
                 continue;
             }
@@ -1443,7 +1473,7 @@ void LinearScan::setBlockSequence()
         }
 
         // For layout order, simply use bbNext
-        if (isTraversalLayoutOrder())
+        if (useLayoutOrder)
         {
             nextBlock = block->bbNext;
             continue;
@@ -2198,6 +2228,14 @@ void LinearScan::identifyCandidates()
             continue;
         }
 
+        // When bounding the cost of allocation, leave the less frequently referenced lclVars on the stack.
+        if (boundedCostAllocation && (varDsc->lvVarIndex >= boundedMaxCandidates))
+        {
+            varDsc->lvLRACandidate                = 0;
+            localVarIntervals[varDsc->lvVarIndex] = nullptr;
+            continue;
+        }
+
         var_types type = genActualType(varDsc->TypeGet());
 
         switch (type)
@@ -4599,19 +4637,25 @@ void LinearScan::buildIntervals()
 
     for (unsigned argNum = 0; argNum < compiler->info.compArgsCount; argNum++, argDsc++)
     {
-        argDsc = &(compiler->lvaTable[argNum]);
+        argDsc            = &(compiler->lvaTable[argNum]);
+        unsigned argCount = 1;
 
         if (argDsc->lvPromotedStruct())
         {
-            noway_assert(argDsc->lvFieldCnt == 1); // We only handle one field here
+            // We only handle one field here, or one field per register of a multireg struct
+            noway_assert((argDsc->lvFieldCnt == 1) || argDsc->lvIsMultiRegPromotedParam());
 
             unsigned fieldVarNum = argDsc->lvFieldLclStart;
+            argCount             = argDsc->lvFieldCnt;
             argDsc               = &(compiler->lvaTable[fieldVarNum]);
         }
-        noway_assert(argDsc->lvIsParam);
-        if (!argDsc->lvTracked && argDsc->lvIsRegArg)
+        for (unsigned argIndex = 0; argIndex < argCount; argIndex++, argDsc++)
         {
-            updateRegStateForArg(argDsc);
+            noway_assert(argDsc->lvIsParam);
+            if (!argDsc->lvTracked && argDsc->lvIsRegArg)
+            {
+                updateRegStateForArg(argDsc);
+            }
         }
     }
 
@@ -5451,6 +5495,10 @@ regNumber LinearScan::tryAllocateFreeReg(Interval* currentInterval, RefPosition*
         bestPossibleScore |= RELATED_PREFERENCE + COVERS_RELATED;
     }
 
+    // With fastRegisterSelection we take the first register that is preferred, covers the
+    // range and is in the right caller/callee-save set, rather than looking for a better one.
+    const int goodEnoughScore = COVERS + OWN_PREFERENCE + CALLER_CALLEE;
+
     LsraLocation bestLocation = MinLocation;
 
     // In non-debug builds, this will simply get optimized away
@@ -5663,6 +5711,11 @@ regNumber LinearScan::tryAllocateFreeReg(Interval* currentInterval, RefPosition*
         {
             break;
         }
+
+        if (fastRegisterSelection && foundBetterCandidate && ((score & goodEnoughScore) == goodEnoughScore))
+        {
+            break;
+        }
     }
 
     if (availablePhysRegInterval != nullptr)
@@ -1171,6 +1171,17 @@ private:
     // True if there are any register candidate lclVars available for allocation.
     bool enregisterLocalVars;
 
+    // True if we should take the first suitable free register for each RefPosition rather than
+    // scoring all of them. This is used when no lclVars are enregistered (i.e. MinOpts), where
+    // only short-lived tree temps are allocated and the selection matters little.
+    bool fastRegisterSelection;
+
+    // True if the method is large enough that we bound the cost of allocation. In this mode
+    // only the first boundedMaxCandidates tracked lclVars (which are sorted by weighted ref count)
+    // are register candidates, and blocks are allocated in layout order.
+    bool     boundedCostAllocation;
+    unsigned boundedMaxCandidates;
+
     virtual bool willEnregisterLocalVars() const
     {
         return enregisterLocalVars;
@@ -6988,21 +6988,33 @@ bool Compiler::fgCanFastTailCall(GenTreeCall* callee)
     //
     // Note that callee being a vararg method is not a problem since we can account the params being passed.
 
-    // Count of caller args including implicit and hidden (i.e. thisPtr, RetBuf, GenericContext, VarargCookie)
-    unsigned nCallerArgs = info.compArgsCount;
-
     // Count the callee args including implicit and hidden.
     // Note that GenericContext and VarargCookie are added by importer while
     // importing the call to gtCallArgs list along with explicit user args.
     unsigned nCalleeArgs = 0;
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+    // On System V integer and floating point args are assigned registers independently, so
+    // also track how many registers of each kind the callee args use, and how many bytes of
+    // stack args are left over.
+    unsigned calleeIntRegArgCount   = 0;
+    unsigned calleeFloatRegArgCount = 0;
+    unsigned calleeStackArgSize     = 0;
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
+
     if (callee->gtCallObjp) // thisPtr
     {
         nCalleeArgs++;
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+        calleeIntRegArgCount++;
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
     }
 
     if (callee->HasRetBufArg()) // RetBuf
     {
         nCalleeArgs++;
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+        calleeIntRegArgCount++;
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
 
         // If callee has RetBuf param, caller too must have it.
         // Otherwise go the slow route.
@@ -7066,6 +7078,43 @@ bool Compiler::fgCanFastTailCall(GenTreeCall* callee)
                 }
 #endif // FEATURE_UNIX_AMD64_STRUCT_PASSING || _TARGET_ARM64_
 
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+                if (!hasMultiByteArgs)
+                {
+                    // A struct is passed in registers only if there are enough registers
+                    // of the right kind left for all of its eightbytes.
+                    SYSTEMV_AMD64_CORINFO_STRUCT_REG_PASSING_DESCRIPTOR structDesc;
+                    eeGetSystemVAmd64PassStructInRegisterDescriptor(objClass, &structDesc);
+
+                    unsigned structIntRegCount   = 0;
+                    unsigned structFloatRegCount = 0;
+
+                    for (unsigned i = 0; i < structDesc.eightByteCount; i++)
+                    {
+                        if (varTypeIsFloating(GetEightByteType(structDesc, i)))
+                        {
+                            structFloatRegCount++;
+                        }
+                        else
+                        {
+                            structIntRegCount++;
+                        }
+                    }
+
+                    if (structDesc.passedInRegisters &&
+                        (calleeIntRegArgCount + structIntRegCount <= MAX_REG_ARG) &&
+                        (calleeFloatRegArgCount + structFloatRegCount <= MAX_FLOAT_REG_ARG))
+                    {
+                        calleeIntRegArgCount += structIntRegCount;
+                        calleeFloatRegArgCount += structFloatRegCount;
+                    }
+                    else
+                    {
+                        calleeStackArgSize += (unsigned)roundUp(typeSize, TARGET_POINTER_SIZE);
+                    }
+                }
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
+
 #else
                 assert(!"Target platform ABI rules regarding passing struct type args in registers");
                 unreached();
@@ -7076,6 +7125,30 @@ bool Compiler::fgCanFastTailCall(GenTreeCall* callee)
                 hasMultiByteArgs = true;
             }
         }
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+        else if (varTypeIsFloating(argx))
+        {
+            if (calleeFloatRegArgCount < MAX_FLOAT_REG_ARG)
+            {
+                calleeFloatRegArgCount++;
+            }
+            else
+            {
+                calleeStackArgSize += TARGET_POINTER_SIZE;
+            }
+        }
+        else
+        {
+            if (calleeIntRegArgCount < MAX_REG_ARG)
+            {
+                calleeIntRegArgCount++;
+            }
+            else
+            {
+                calleeStackArgSize += TARGET_POINTER_SIZE;
+            }
+        }
+#endif // FEATURE_UNIX_AMD64_STRUCT_PASSING
     }
 
     // Go the slow route, if it has multi-byte params
@@ -7084,6 +7157,41 @@ bool Compiler::fgCanFastTailCall(GenTreeCall* callee)
         return false;
     }
 
+#ifdef FEATURE_UNIX_AMD64_STRUCT_PASSING
+    // Counting args is too conservative on System V, where a callee with more args than
+    // the caller may still pass all of them in registers (e.g. when some are floating
+    // point), and a 16 byte struct counts as two args. Instead compare the bytes of stack
+    // args the callee needs with the size of the caller's incoming stack arg area, which
+    // the stack args of the callee are setup in.
+    if (calleeStackArgSize == 0)
+    {
+        return true;
+    }
+
+    unsigned callerStackArgSize = 0;
+
+    for (unsigned lclNum = 0; lclNum < info.compArgsCount; lclNum++)
+    {
+        LclVarDsc* varDsc = &lvaTable[lclNum];
+
+        if (varDsc->lvIsRegArg)
+        {
+            continue;
+        }
+
+        // Fast tail call lowering only knows how to move scalar caller args out of the
+        // way of the callee's stack args.
+        if (varTypeIsStruct(varDsc))
+        {
+            return false;
+        }
+
+        callerStackArgSize += (unsigned)roundUp(lvaLclSize(lclNum), TARGET_POINTER_SIZE);
+    }
+
+    return (calleeStackArgSize <= callerStackArgSize);
+#else  // !FEATURE_UNIX_AMD64_STRUCT_PASSING
+
     // If we reached here means that callee has only those argument types which can be passed in
     // a register and if passed on stack will occupy exactly one stack slot in out-going arg area.
     // If we are passing args on stack for callee and it has more args passed on stack than
@@ -7091,12 +7199,17 @@ bool Compiler::fgCanFastTailCall(GenTreeCall* callee)
     //
     // Note that the GC'ness of on stack args need not match since the arg setup area is marked
     // as non-interruptible for fast tail calls.
+
+    // Count of caller args including implicit and hidden (i.e. thisPtr, RetBuf, GenericContext, VarargCookie)
+    unsigned nCallerArgs = info.compArgsCount;
+
     if ((nCalleeArgs > MAX_REG_ARG) && (nCallerArgs < nCalleeArgs))
     {
         return false;
     }
 
     return true;
+#endif // !FEATURE_UNIX_AMD64_STRUCT_PASSING
 #else
     return false;
 #endif
@@ -57,7 +57,7 @@ int RangeCheck::GetArrLength(ValueNum vn)
 }
 
 // Check if the computed range is within bounds.
-bool RangeCheck::BetweenBounds(Range& range, int lower, GenTreePtr upper)
+bool RangeCheck::BetweenBounds(BasicBlock* block, Range& range, int lower, GenTreePtr upper)
 {
 #ifdef DEBUG
     if (m_pCompiler->verbose)
@@ -109,14 +109,15 @@ bool RangeCheck::BetweenBounds(Range& range, int lower, GenTreePtr upper)
 
     JITDUMP("Array size is: %d\n", arrSize);
 
+    // Upper limit is on some other bound, as in "for (i = 0; i < b.Length; i++) a[i]".
+    if ((range.UpperLimit().IsBinOpArray() || range.UpperLimit().IsArray()) && (range.UpperLimit().vn != uLimitVN))
+    {
+        return BetweenOtherBounds(block, range, uLimitVN, arrSize);
+    }
+
     // Upper limit: len + ucns (upper limit constant).
     if (range.UpperLimit().IsBinOpArray())
     {
-        if (range.UpperLimit().vn != uLimitVN)
-        {
-            return false;
-        }
-
         int ucns = range.UpperLimit().GetConstant();
 
         // Upper limit: Len + [0..n]
@@ -190,6 +191,227 @@ bool RangeCheck::BetweenBounds(Range& range, int lower, GenTreePtr upper)
     return false;
 }
 
+// Check if the computed range, whose upper limit is expressed in terms of a bound other than
+// "uLimitVN", is within <0, uLimitVN>. This is the case when the other bound is known to be
+// at most "uLimitVN + delta", either because both are lengths of arrays allocated with a
+// constant size, or because of a dominating comparison between the two bounds, as in:
+//
+//      if (a.Length < b.Length) return;
+//      for (i = 0; i < b.Length; i++) a[i] = b[i];
+//
+bool RangeCheck::BetweenOtherBounds(BasicBlock* block, Range& range, ValueNum uLimitVN, int arrSize)
+{
+    assert(range.UpperLimit().IsBinOpArray() || range.UpperLimit().IsArray());
+
+    // Only a non-negative constant lower limit is handled.
+    if (!range.LowerLimit().IsConstant() || range.LowerLimit().GetConstant() < 0)
+    {
+        return false;
+    }
+
+    ValueNum otherVN   = range.UpperLimit().vn;
+    int      ucns      = range.UpperLimit().IsBinOpArray() ? range.UpperLimit().GetConstant() : 0;
+    int      otherSize = GetArrLength(otherVN);
+    int      delta     = 0;
+
+    if ((arrSize > 0) && (otherSize > 0))
+    {
+        // Both arrays were allocated with a known size: other.len <= len + (otherSize - arrSize).
+        delta = otherSize - arrSize;
+    }
+    else if (BitVecOps::MayBeUninit(block->bbAssertionIn) ||
+             !GetBoundRelation(block->bbAssertionIn, otherVN, uLimitVN, &delta))
+    {
+        JITDUMP("No relation between bound VN%04X and VN%04X\n", otherVN, uLimitVN);
+        return false;
+    }
+
+    // index <= other.len + ucns <= len + delta + ucns, which is below len if delta + ucns < 0.
+    JITDUMP("Bound VN%04X <= VN%04X + %d, upper limit constant %d\n", otherVN, uLimitVN, delta, ucns);
+    return ((INT64)delta + (INT64)ucns) < 0;
+}
+
+// Check if "assertions" prove that the checked bound "vnBound" is at least "minValue".
+// The assertions handled are the ones assertion prop creates for explicit length checks
+// such as "if (a.Length > 3)", or "(uint)3 < (uint)a.Length" on the no-throw edge.
+bool RangeCheck::IsBoundAtLeast(ASSERT_VALARG_TP assertions, ValueNum vnBound, int minValue)
+{
+    assert(minValue > 0);
+
+    ValueNumStore*  vnStore = m_pCompiler->vnStore;
+    BitVecOps::Iter iter(m_pCompiler->apTraits, assertions);
+    unsigned        index = 0;
+    while (iter.NextElem(&index))
+    {
+        AssertionIndex          assertionIndex = GetAssertionIndex(index);
+        Compiler::AssertionDsc* curAssertion   = m_pCompiler->optGetAssertion(assertionIndex);
+
+        // (uint)cns < (uint)len on the no-throw edge.
+        if (curAssertion->IsBoundsCheckNoThrow())
+        {
+            if ((curAssertion->op1.bnd.vnLen == vnBound) && vnStore->IsVNInt32Constant(curAssertion->op1.bnd.vnIdx) &&
+                (vnStore->GetConstantInt32(curAssertion->op1.bnd.vnIdx) >= minValue - 1))
+            {
+                return true;
+            }
+            continue;
+        }
+
+        if (!curAssertion->IsCheckedBoundBound() && !curAssertion->IsConstantBound())
+        {
+            continue;
+        }
+
+        // Make sure the assertion is of the form != 0 or == 0.
+        if (curAssertion->op2.vn != vnStore->VNZeroForType(TYP_INT))
+        {
+            continue;
+        }
+
+        int        cns;
+        genTreeOps cmpOper;
+
+        if (curAssertion->IsCheckedBoundBound())
+        {
+            // Of the form (cns < len) != 0
+            ValueNumStore::CompareCheckedBoundArithInfo info;
+            vnStore->GetCompareCheckedBound(curAssertion->op1.vn, &info);
+            if ((info.vnBound != vnBound) || !vnStore->IsVNInt32Constant(info.cmpOp))
+            {
+                continue;
+            }
+            cns = vnStore->GetConstantInt32(info.cmpOp);
+            // Express it as "len cmpOper cns".
+            cmpOper = GenTree::SwapRelop((genTreeOps)info.cmpOper);
+        }
+        else
+        {
+            // Of the form (len > cns) != 0
+            ValueNumStore::ConstantBoundInfo info;
+            vnStore->GetConstantBoundInfo(curAssertion->op1.vn, &info);
+            if (info.cmpOpVN != vnBound)
+            {
+                continue;
+            }
+            cns     = info.constVal;
+            cmpOper = (genTreeOps)info.cmpOper;
+        }
+
+        if (curAssertion->assertionKind == Compiler::OAK_EQUAL)
+        {
+            cmpOper = GenTree::ReverseRelop(cmpOper);
+        }
+
+        if (((cmpOper == GT_GT) && (cns >= minValue - 1)) || ((cmpOper == GT_GE) && (cns >= minValue)))
+        {
+#ifdef DEBUG
+            if (m_pCompiler->verbose)
+            {
+                m_pCompiler->optPrintAssertion(curAssertion, assertionIndex);
+            }
+#endif
+            return true;
+        }
+    }
+    return false;
+}
+
+// Look in "assertions" for a comparison between the two checked bounds "vnOther" and "vnBound"
+// that proves "vnOther <= vnBound + *pDelta". Handles "other < len", "other <= len",
+// "len > other", "len >= other" and "other < len +/- cns" and their negations.
+bool RangeCheck::GetBoundRelation(ASSERT_VALARG_TP assertions, ValueNum vnOther, ValueNum vnBound, int* pDelta)
+{
+    ValueNumStore*  vnStore = m_pCompiler->vnStore;
+    BitVecOps::Iter iter(m_pCompiler->apTraits, assertions);
+    unsigned        index = 0;
+    while (iter.NextElem(&index))
+    {
+        AssertionIndex          assertionIndex = GetAssertionIndex(index);
+        Compiler::AssertionDsc* curAssertion   = m_pCompiler->optGetAssertion(assertionIndex);
+
+        if (!curAssertion->IsCheckedBoundBound() && !curAssertion->IsCheckedBoundArithBound())
+        {
+            continue;
+        }
+
+        // Make sure the assertion is of the form != 0 or == 0.
+        if (curAssertion->op2.vn != vnStore->VNZeroForType(TYP_INT))
+        {
+            continue;
+        }
+
+        ValueNumStore::CompareCheckedBoundArithInfo info;
+        int                                         cns = 0;
+
+        if (curAssertion->IsCheckedBoundBound())
+        {
+            vnStore->GetCompareCheckedBound(curAssertion->op1.vn, &info);
+        }
+        else
+        {
+            // (other < len +/- cns) != 0
+            vnStore->GetCompareCheckedBoundArithInfo(curAssertion->op1.vn, &info);
+            if (!vnStore->IsVNInt32Constant(info.arrOp) || ((info.arrOper != GT_ADD) && (info.arrOper != GT_SUB)))
+            {
+                continue;
+            }
+            cns = vnStore->GetConstantInt32(info.arrOp);
+            if (info.arrOper == GT_SUB)
+            {
+                if (cns == INT_MIN)
+                {
+                    continue;
+                }
+                cns = -cns;
+            }
+        }
+
+        genTreeOps cmpOper = (genTreeOps)info.cmpOper;
+        if (curAssertion->assertionKind == Compiler::OAK_EQUAL)
+        {
+            cmpOper = GenTree::ReverseRelop(cmpOper);
+        }
+
+        // Express the assertion as "vnOther cmpOper vnBound + cns".
+        if ((info.cmpOp == vnOther) && (info.vnBound == vnBound))
+        {
+            // Already in that form.
+        }
+        else if ((info.cmpOp == vnBound) && (info.vnBound == vnOther) && (cns == 0))
+        {
+            cmpOper = GenTree::SwapRelop(cmpOper);
+        }
+        else
+        {
+            continue;
+        }
+
+        int delta;
+        if ((cmpOper == GT_LT) && (cns != INT_MIN))
+        {
+            delta = cns - 1;
+        }
+        else if (cmpOper == GT_LE)
+        {
+            delta = cns;
+        }
+        else
+        {
+            continue;
+        }
+
+#ifdef DEBUG
+        if (m_pCompiler->verbose)
+        {
+            m_pCompiler->optPrintAssertion(curAssertion, assertionIndex);
+        }
+#endif
+        *pDelta = (int)delta;
+        return true;
+    }
+    return false;
+}
+
 void RangeCheck::OptimizeRangeCheck(BasicBlock* block, GenTreePtr stmt, GenTreePtr treeParent)
 {
     // Check if we are dealing with a bounds check node.
@@ -251,6 +473,19 @@ void RangeCheck::OptimizeRangeCheck(BasicBlock* block, GenTreePtr stmt, GenTreeP
             return;
         }
     }
+    // Constant index into an array of unknown size, like "if (a.Length > 2) a[2]".
+    else if (m_pCompiler->vnStore->IsVNConstant(idxVn) && !BitVecOps::MayBeUninit(block->bbAssertionIn))
+    {
+        ssize_t  idxVal    = -1;
+        unsigned iconFlags = 0;
+        if (m_pCompiler->optIsTreeKnownIntValue(true, treeIndex, &idxVal, &iconFlags) && (idxVal >= 0) &&
+            (idxVal < INT_MAX) && IsBoundAtLeast(block->bbAssertionIn, arrLenVn, (int)idxVal + 1))
+        {
+            JITDUMP("Removing range check of index %d dominated by a length check\n", (int)idxVal);
+            m_pCompiler->optRemoveRangeCheck(treeParent, stmt, true, GTF_ASG, true /* force remove */);
+            return;
+        }
+    }
 
     GetRangeMap()->RemoveAll();
     GetOverflowMap()->RemoveAll();
@@ -286,7 +521,7 @@ void RangeCheck::OptimizeRangeCheck(BasicBlock* block, GenTreePtr stmt, GenTreeP
     }
 
     // Is the range between the lower and upper bound values.
-    if (BetweenBounds(range, 0, bndsChk->gtArrLen))
+    if (BetweenBounds(block, range, 0, bndsChk->gtArrLen))
     {
         JITDUMP("[RangeCheck::OptimizeRangeCheck] Between bounds\n");
         m_pCompiler->optRemoveRangeCheck(treeParent, stmt, true, GTF_ASG, true /* force remove */);
@@ -501,6 +736,19 @@ void RangeCheck::MergeEdgeAssertions(GenTreePtr tree, ASSERT_VALARG_TP assertion
 
         Compiler::AssertionDsc* curAssertion = m_pCompiler->optGetAssertion(assertionIndex);
 
+        // Current assertion is "(uint)i < (uint)len" on its no-throw edge, so i is at least 0.
+        if (curAssertion->IsBoundsCheckNoThrow())
+        {
+            if ((curAssertion->op1.bnd.vnIdx ==
+                 m_pCompiler->lvaTable[lcl->gtLclNum].GetPerSsaData(lcl->gtSsaNum)->m_vnPair.GetConservative()) &&
+                (!pRange->lLimit.IsConstant() || (pRange->lLimit.GetConstant() < 0)))
+            {
+                JITDUMP("Lower bound from no-throw assertion #%02u is 0\n", assertionIndex);
+                pRange->lLimit = Limit(Limit::keConstant, 0);
+            }
+            continue;
+        }
+
         // Current assertion is about compare against constant or checked bound.
         if (!curAssertion->IsCheckedBoundArithBound() && !curAssertion->IsCheckedBoundBound() &&
             !curAssertion->IsConstantBound())
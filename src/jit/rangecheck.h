@@ -492,7 +492,17 @@ public:
     // assumes that the lower range is resolved and upper range is symbolic as in an
     // increasing loop.
     // TODO-CQ: This is not general enough.
-    bool BetweenBounds(Range& range, int lower, GenTreePtr upper);
+    bool BetweenBounds(BasicBlock* block, Range& range, int lower, GenTreePtr upper);
+
+    // Check whether the range, whose upper limit is on a bound other than "uLimitVN", is within
+    // <0, uLimitVN> given the size of the allocated arrays or dominating assertions in "block."
+    bool BetweenOtherBounds(BasicBlock* block, Range& range, ValueNum uLimitVN, int arrSize);
+
+    // Check whether "assertions" prove that the checked bound "vnBound" is at least "minValue."
+    bool IsBoundAtLeast(ASSERT_VALARG_TP assertions, ValueNum vnBound, int minValue);
+
+    // Find in "assertions" a relation "vnOther <= vnBound + *pDelta" between two checked bounds.
+    bool GetBoundRelation(ASSERT_VALARG_TP assertions, ValueNum vnOther, ValueNum vnBound, int* pDelta);
 
     // Given a statement, check if it is a def and add its locations in a map.
     void MapStmtDefs(const Location& loc);
@@ -0,0 +1,114 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Runtime.CompilerServices;
+using System.Runtime.InteropServices;
+
+namespace System.Threading
+{
+    // The PAL_IO_EVENT_* flags reported for a file descriptor
+    [Flags]
+    internal enum IoReadinessEvents
+    {
+        Read = 0x1,
+        Write = 0x2,
+        Error = 0x4,
+    }
+
+    internal delegate void IoReadinessCallback(IoReadinessEvents events, Object state);
+
+    //
+    // Binds a file descriptor to the thread pool's I/O completion threads, which call back whenever it
+    // becomes readable or writable. Readiness is edge triggered: there is one callback per change, after which
+    // the descriptor has to be read or written until the call would block, and a callback may be spurious.
+    // Once Dispose has returned no new callback starts, but one that already started may still be running.
+    //
+    internal sealed class IoReadinessRegistration : IDisposable
+    {
+        private readonly SafeHandle _handle;
+        private readonly IoReadinessCallback _callback;
+        private readonly Object _state;
+        private readonly ExecutionContext _executionContext;
+        private IntPtr _binding;
+        private static readonly ContextCallback s_contextCallback = new ContextCallback(IoReadinessCallback_Context);
+
+        private IoReadinessRegistration(SafeHandle handle, IoReadinessCallback callback, Object state)
+        {
+            _handle = handle;
+            _callback = callback;
+            _state = state;
+            _executionContext = ExecutionContext.Capture();
+        }
+
+        internal static IoReadinessRegistration Register(SafeHandle handle, IoReadinessEvents events, IoReadinessCallback callback, Object state)
+        {
+            if (handle == null)
+                throw new ArgumentNullException(nameof(handle));
+            if (callback == null)
+                throw new ArgumentNullException(nameof(callback));
+            if (handle.IsClosed || handle.IsInvalid)
+                throw new ArgumentException(SR.Argument_InvalidHandle, nameof(handle));
+
+            IoReadinessRegistration registration = new IoReadinessRegistration(handle, callback, state);
+
+            // The descriptor must not be closed, and its number reused, while it is bound
+            bool addedRef = false;
+            try
+            {
+                handle.DangerousAddRef(ref addedRef);
+                registration._binding = BindIoReadinessNative((int)handle.DangerousGetHandle(), (int)events, registration);
+            }
+            catch
+            {
+                if (addedRef)
+                    handle.DangerousRelease();
+                throw;
+            }
+
+            return registration;
+        }
+
+        public void Dispose()
+        {
+            IntPtr binding = Interlocked.Exchange(ref _binding, IntPtr.Zero);
+            if (binding != IntPtr.Zero)
+            {
+                UnbindIoReadinessNative(binding);
+                _handle.DangerousRelease();
+            }
+        }
+
+        private static void IoReadinessCallback_Context(Object state)
+        {
+            KeyValuePair<IoReadinessRegistration, IoReadinessEvents> args = (KeyValuePair<IoReadinessRegistration, IoReadinessEvents>)state;
+            args.Key._callback(args.Value, args.Key._state);
+        }
+
+        // call back helper, run on an I/O completion thread
+        internal static void PerformIoReadinessCallback(Object state, int events)
+        {
+            IoReadinessRegistration registration = (IoReadinessRegistration)state;
+            Debug.Assert(registration != null, "Null state passed to PerformIoReadinessCallback!");
+
+            // call directly if EC flow is suppressed
+            if (registration._executionContext == null)
+            {
+                registration._callback((IoReadinessEvents)events, registration._state);
+            }
+            else
+            {
+                ExecutionContext.Run(registration._executionContext, s_contextCallback,
+                                     new KeyValuePair<IoReadinessRegistration, IoReadinessEvents>(registration, (IoReadinessEvents)events));
+            }
+        }
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        private static extern IntPtr BindIoReadinessNative(int fd, int events, IoReadinessRegistration registration);
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        private static extern bool UnbindIoReadinessNative(IntPtr binding);
+    }
+}
@@ -35,6 +35,7 @@ namespace System.Threading
 
         public static volatile bool vmTpInitialized;
         public static bool enableWorkerTracking;
+        public static bool enableWorkItemTimings;
 
         public static readonly ThreadPoolWorkQueue workQueue = new ThreadPoolWorkQueue();
     }
@@ -557,6 +558,15 @@ namespace System.Threading
                     //
                     workQueue.EnsureThreadRequested();
 
+                    // Work item timings are recorded in the VM's histograms, along with those of native work requests
+                    long enqueueTimestamp = 0;
+                    long dequeueTimestamp = 0;
+                    if (ThreadPoolGlobals.enableWorkItemTimings)
+                    {
+                        enqueueTimestamp = GetEnqueueTimestamp(workItem);
+                        dequeueTimestamp = ThreadPool.GetWorkItemTimestamp();
+                    }
+
                     //
                     // Execute the workitem outside of any finally blocks, so that it can be aborted if needed.
                     //
@@ -581,6 +591,9 @@ namespace System.Threading
                     }
                     workItem = null;
 
+                    if (dequeueTimestamp != 0)
+                        ThreadPool.ReportWorkItemTimings(enqueueTimestamp, dequeueTimestamp);
+
                     // 
                     // Notify the VM that we executed this workitem.  This is also our opportunity to ask whether Hill Climbing wants
                     // us to return the thread to the pool or not.
@@ -622,6 +635,21 @@ namespace System.Threading
             Debug.Fail("Should never reach this point");
             return true;
         }
+
+        // Returns the time at which the work item was queued, or 0 if it was not recorded. Only the callbacks
+        // of QueueUserWorkItem carry it; Tasks and other work items would need a field of their own.
+        private static long GetEnqueueTimestamp(IThreadPoolWorkItem workItem)
+        {
+            QueueUserWorkItemCallbackDefaultContext defaultContextCallback = workItem as QueueUserWorkItemCallbackDefaultContext;
+            if (defaultContextCallback != null)
+                return defaultContextCallback.enqueueTimestamp;
+
+            QueueUserWorkItemCallback callback = workItem as QueueUserWorkItemCallback;
+            if (callback != null)
+                return callback.enqueueTimestamp;
+
+            return 0;
+        }
     }
 
     // Simple random number generator. We don't need great randomness, we just need a little and for it to be fast.
@@ -902,6 +930,7 @@ namespace System.Threading
         private WaitCallback callback;
         private readonly ExecutionContext context;
         private readonly Object state;
+        internal readonly long enqueueTimestamp;
 
 #if DEBUG
         private volatile int executed;
@@ -927,6 +956,8 @@ namespace System.Threading
             callback = waitCallback;
             state = stateObj;
             context = ec;
+            if (ThreadPoolGlobals.enableWorkItemTimings)
+                enqueueTimestamp = ThreadPool.GetWorkItemTimestamp();
         }
 
         void IThreadPoolWorkItem.ExecuteWorkItem()
@@ -971,6 +1002,7 @@ namespace System.Threading
     {
         private WaitCallback callback;
         private readonly Object state;
+        internal readonly long enqueueTimestamp;
 
 #if DEBUG
         private volatile int executed;
@@ -995,6 +1027,8 @@ namespace System.Threading
         {
             callback = waitCallback;
             state = stateObj;
+            if (ThreadPoolGlobals.enableWorkItemTimings)
+                enqueueTimestamp = ThreadPool.GetWorkItemTimestamp();
         }
 
         void IThreadPoolWorkItem.ExecuteWorkItem()
@@ -1429,7 +1463,7 @@ namespace System.Threading
 
         private static void EnsureVMInitializedCore()
         {
-            ThreadPool.InitializeVMTp(ref ThreadPoolGlobals.enableWorkerTracking);
+            ThreadPool.InitializeVMTp(ref ThreadPoolGlobals.enableWorkerTracking, ref ThreadPoolGlobals.enableWorkItemTimings);
             ThreadPoolGlobals.vmTpInitialized = true;
         }
 
@@ -1456,10 +1490,16 @@ namespace System.Threading
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         internal static extern void ReportThreadStatus(bool isWorking);
 
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal static extern long GetWorkItemTimestamp();
+
+        [MethodImplAttribute(MethodImplOptions.InternalCall)]
+        internal static extern void ReportWorkItemTimings(long enqueueTimestamp, long dequeueTimestamp);
+
         internal static void NotifyWorkItemProgress()
         {
             if (!ThreadPoolGlobals.vmTpInitialized)
-                ThreadPool.InitializeVMTp(ref ThreadPoolGlobals.enableWorkerTracking);
+                ThreadPool.InitializeVMTp(ref ThreadPoolGlobals.enableWorkerTracking, ref ThreadPoolGlobals.enableWorkItemTimings);
             NotifyWorkItemProgressNative();
         }
 
@@ -1468,7 +1508,7 @@ namespace System.Threading
 
         [DllImport(JitHelpers.QCall, CharSet = CharSet.Unicode)]
         [SuppressUnmanagedCodeSecurity]
-        private static extern void InitializeVMTp(ref bool enableWorkerTracking);
+        private static extern void InitializeVMTp(ref bool enableWorkerTracking, ref bool enableWorkItemTimings);
 
         [MethodImplAttribute(MethodImplOptions.InternalCall)]
         private static extern IntPtr RegisterWaitForSingleObjectNative(
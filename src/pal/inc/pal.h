@@ -1719,6 +1719,28 @@ QueueUserAPC(
          IN HANDLE hThread,
          IN ULONG_PTR dwData);
 
+// Blocks while *lpAddress holds lCompareValue, without going through the
+// synchronization manager. Returns WAIT_OBJECT_0 once woken up by
+// PAL_WakeByAddress (wakeups can be spurious, so look at the value again),
+// WAIT_TIMEOUT, or WAIT_IO_COMPLETION after running the APCs queued to the
+// thread during an alertable wait. Fails with ERROR_NOT_SUPPORTED where the
+// platform has no futexes.
+PALIMPORT
+DWORD
+PALAPI
+PAL_WaitOnAddress(
+         IN LONG volatile *lpAddress,
+         IN LONG lCompareValue,
+         IN DWORD dwMilliseconds,
+         IN BOOL bAlertable);
+
+PALIMPORT
+VOID
+PALAPI
+PAL_WakeByAddress(
+         IN LONG volatile *lpAddress,
+         IN BOOL bWakeAll);
+
 #ifdef _X86_
 
 //
@@ -5640,6 +5662,87 @@ PALAPI
 PAL_GetCPUBusyTime(
     IN OUT PAL_IOCP_CPU_INFORMATION *lpPrevCPUInfo);
 
+// Readiness events reported for a file descriptor associated with a PAL
+// I/O completion port. A hang up or an error is reported as
+// PAL_IO_EVENT_ERROR together with both PAL_IO_EVENT_READ and
+// PAL_IO_EVENT_WRITE, so that pending operations get to see the error.
+#define PAL_IO_EVENT_READ   0x00000001
+#define PAL_IO_EVENT_WRITE  0x00000002
+#define PAL_IO_EVENT_ERROR  0x00000004
+
+// Events of the entry posted for a wait registered with
+// PAL_RegisterWaitOnIoCompletionPort once the object is signaled
+#define PAL_IO_EVENT_SIGNALED 0x00000008
+
+typedef struct _PAL_IO_COMPLETION_ENTRY {
+    ULONG_PTR CompletionKey;
+    DWORD     Events;           // PAL_IO_EVENT_* flags, or the value given to PAL_PostIoCompletionPort
+} PAL_IO_COMPLETION_ENTRY;
+
+typedef struct _PAL_IO_COMPLETION_PORT *PAL_IO_COMPLETION_PORT;
+typedef struct _PAL_WAIT_REGISTRATION *PAL_WAIT_REGISTRATION;
+
+PALIMPORT
+PAL_IO_COMPLETION_PORT
+PALAPI
+PAL_CreateIoCompletionPort(VOID);
+
+PALIMPORT
+VOID
+PALAPI
+PAL_CloseIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port);
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_AssociateIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN INT fd,
+    IN DWORD events,
+    IN ULONG_PTR completionKey);
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_DissociateIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN INT fd);
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_PostIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN ULONG_PTR completionKey,
+    IN DWORD events);
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_GetIoCompletionPortEntries(
+    IN PAL_IO_COMPLETION_PORT port,
+    OUT PAL_IO_COMPLETION_ENTRY *lpEntries,
+    IN ULONG ulCount,
+    OUT PULONG ulNumEntriesRemoved,
+    IN DWORD dwMilliseconds);
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_RegisterWaitOnIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN HANDLE hObject,
+    IN ULONG_PTR completionKey,
+    OUT PAL_WAIT_REGISTRATION *pRegistration);
+
+PALIMPORT
+BOOL
+PALAPI
+PAL_UnregisterWaitOnIoCompletionPort(
+    IN PAL_WAIT_REGISTRATION registration,
+    OUT PBOOL pbSatisfied);
+
 /****************PAL Perf functions for PInvoke*********************/
 #if PAL_PERF
 PALIMPORT
@@ -51,6 +51,7 @@ check_include_files(sys/sysctl.h HAVE_SYS_SYSCTL_H)
 check_include_files(gnu/lib-names.h HAVE_GNU_LIBNAMES_H)
 
 check_function_exists(kqueue HAVE_KQUEUE)
+check_function_exists(epoll_create1 HAVE_EPOLL)
 check_function_exists(getpwuid_r HAVE_GETPWUID_R)
 
 check_library_exists(c sched_getaffinity "" HAVE_SCHED_GETAFFINITY)
@@ -160,6 +161,7 @@ set(CMAKE_EXTRA_INCLUDE_FILE)
 check_type_size(off_t SIZEOF_OFF_T)
 
 check_cxx_symbol_exists(SYS_yield sys/syscall.h HAVE_YIELD_SYSCALL)
+check_cxx_symbol_exists(SYS_futex sys/syscall.h HAVE_FUTEX)
 check_cxx_symbol_exists(INFTIM poll.h HAVE_INFTIM)
 check_cxx_symbol_exists(CHAR_BIT limits.h HAVE_CHAR_BIT)
 check_cxx_symbol_exists(_DEBUG sys/user.h USER_H_DEFINES_DEBUG)
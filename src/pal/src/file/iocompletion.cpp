@@ -0,0 +1,639 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*++
+
+
+
+Module Name:
+
+    iocompletion.cpp
+
+Abstract:
+
+    Implementation of the PAL I/O completion port on top of epoll.
+
+    File descriptors are associated with the port in edge triggered mode, so
+    each readiness change is reported once, to a single waiter, and is carried
+    along with the completion key of the descriptor. Entries posted through
+    PAL_PostIoCompletionPort are queued in the port and signaled through an
+    eventfd that is itself registered with epoll, so that waiters block in a
+    single epoll_wait and pick up both kinds of entries in one batch.
+
+
+
+--*/
+
+#include "pal/dbgmsg.h"
+SET_DEFAULT_DEBUG_CHANNEL(FILE); // some headers have code with asserts, so do this first
+
+#include "pal/palinternal.h"
+#include "pal/thread.hpp"
+#include "pal/malloc.hpp"
+#include "pal/file.h"
+#include "pal/file.hpp"
+
+#include <errno.h>
+#include <unistd.h>
+#include <pthread.h>
+#if HAVE_EPOLL
+#include <sys/epoll.h>
+#include <sys/eventfd.h>
+#endif // HAVE_EPOLL
+
+using namespace CorUnix;
+
+struct CorUnix::PostedIoCompletionEntry
+{
+    PostedIoCompletionEntry *next;
+    PAL_IO_COMPLETION_ENTRY entry;
+};
+
+#if HAVE_EPOLL
+
+// Upper bound of the number of epoll events requested by a single wait
+#define IO_COMPLETION_MAX_EVENTS_PER_WAIT 64
+
+struct _PAL_IO_COMPLETION_PORT
+{
+    int epollFd;
+    int eventFd;                            // readable for as long as there are posted entries
+    pthread_mutex_t postedLock;             // protects the posted entry queue and the eventfd counter
+    PostedIoCompletionEntry *postedHead;
+    PostedIoCompletionEntry *postedTail;
+};
+
+/*++
+Function:
+  IOCPGetEpollEvents
+
+Returns the epoll event mask to register for the given PAL_IO_EVENT_* flags
+--*/
+static
+uint32_t
+IOCPGetEpollEvents(DWORD events)
+{
+    uint32_t epollEvents = EPOLLET;
+
+    if (events & PAL_IO_EVENT_READ)
+    {
+        epollEvents |= EPOLLIN | EPOLLRDHUP;
+    }
+    if (events & PAL_IO_EVENT_WRITE)
+    {
+        epollEvents |= EPOLLOUT;
+    }
+
+    return epollEvents;
+}
+
+/*++
+Function:
+  IOCPGetPalEvents
+
+Returns the PAL_IO_EVENT_* flags for an epoll event mask
+--*/
+static
+DWORD
+IOCPGetPalEvents(uint32_t epollEvents)
+{
+    DWORD events = 0;
+
+    if (epollEvents & (EPOLLIN | EPOLLRDHUP | EPOLLPRI))
+    {
+        events |= PAL_IO_EVENT_READ;
+    }
+    if (epollEvents & EPOLLOUT)
+    {
+        events |= PAL_IO_EVENT_WRITE;
+    }
+    if (epollEvents & (EPOLLERR | EPOLLHUP))
+    {
+        events |= PAL_IO_EVENT_ERROR | PAL_IO_EVENT_READ | PAL_IO_EVENT_WRITE;
+    }
+
+    return events;
+}
+
+/*++
+Function:
+  IOCPDequeuePostedEntries
+
+Moves up to ulCount posted entries into lpEntries, and resets the eventfd of
+the port once the queue is empty. Returns the number of entries moved.
+--*/
+static
+ULONG
+IOCPDequeuePostedEntries(
+    PAL_IO_COMPLETION_PORT port,
+    PAL_IO_COMPLETION_ENTRY *lpEntries,
+    ULONG ulCount)
+{
+    ULONG ulRemoved = 0;
+    PostedIoCompletionEntry *pFree = NULL;
+
+    pthread_mutex_lock(&port->postedLock);
+
+    while (ulRemoved < ulCount && port->postedHead != NULL)
+    {
+        PostedIoCompletionEntry *pPosted = port->postedHead;
+        port->postedHead = pPosted->next;
+
+        lpEntries[ulRemoved++] = pPosted->entry;
+
+        pPosted->next = pFree;
+        pFree = pPosted;
+    }
+
+    if (ulRemoved != 0 && port->postedHead == NULL)
+    {
+        port->postedTail = NULL;
+
+        uint64_t counter;
+        if (read(port->eventFd, &counter, sizeof(counter)) != sizeof(counter))
+        {
+            // The eventfd is non blocking and written to whenever the queue
+            // becomes non empty, so this cannot fail.
+            ASSERT("read() on the eventfd failed; errno is %d (%s)\n", errno, strerror(errno));
+        }
+    }
+
+    pthread_mutex_unlock(&port->postedLock);
+
+    while (pFree != NULL)
+    {
+        PostedIoCompletionEntry *pNext = pFree->next;
+        InternalFree(pFree);
+        pFree = pNext;
+    }
+
+    return ulRemoved;
+}
+
+#endif // HAVE_EPOLL
+
+/*++
+Function:
+  InternalAllocateIoCompletionEntry
+
+Allocates an entry with the given completion key and events. Returns NULL if
+out of memory.
+--*/
+PostedIoCompletionEntry *
+CorUnix::InternalAllocateIoCompletionEntry(
+    ULONG_PTR completionKey,
+    DWORD events)
+{
+    PostedIoCompletionEntry *pPosted =
+        (PostedIoCompletionEntry *)InternalMalloc(sizeof(PostedIoCompletionEntry));
+
+    if (pPosted != NULL)
+    {
+        pPosted->next = NULL;
+        pPosted->entry.CompletionKey = completionKey;
+        pPosted->entry.Events = events;
+    }
+
+    return pPosted;
+}
+
+/*++
+Function:
+  InternalFreeIoCompletionEntry
+
+Frees an entry allocated by InternalAllocateIoCompletionEntry that was not
+posted
+--*/
+void
+CorUnix::InternalFreeIoCompletionEntry(
+    PostedIoCompletionEntry *pEntry)
+{
+    InternalFree(pEntry);
+}
+
+/*++
+Function:
+  InternalPostIoCompletionEntry
+
+Appends an entry allocated by InternalAllocateIoCompletionEntry to the posted
+entries of the port. This does not allocate, so it may be called while
+holding the synchronization manager locks.
+--*/
+void
+CorUnix::InternalPostIoCompletionEntry(
+    PAL_IO_COMPLETION_PORT port,
+    PostedIoCompletionEntry *pEntry)
+{
+#if HAVE_EPOLL
+    pEntry->next = NULL;
+
+    pthread_mutex_lock(&port->postedLock);
+
+    if (port->postedTail == NULL)
+    {
+        port->postedHead = pEntry;
+        port->postedTail = pEntry;
+
+        // The queue was empty, so make the eventfd readable
+        uint64_t counter = 1;
+        if (write(port->eventFd, &counter, sizeof(counter)) != sizeof(counter))
+        {
+            ASSERT("write() on the eventfd failed; errno is %d (%s)\n", errno, strerror(errno));
+        }
+    }
+    else
+    {
+        port->postedTail->next = pEntry;
+        port->postedTail = pEntry;
+    }
+
+    pthread_mutex_unlock(&port->postedLock);
+#else // HAVE_EPOLL
+    // Ports cannot be created without epoll
+    ASSERT("Posting to an I/O completion port is not supported\n");
+    InternalFree(pEntry);
+#endif // HAVE_EPOLL
+}
+
+/*++
+Function:
+  PAL_CreateIoCompletionPort
+
+Creates an I/O completion port that reports readiness of file descriptors.
+Returns NULL on failure.
+--*/
+PAL_IO_COMPLETION_PORT
+PALAPI
+PAL_CreateIoCompletionPort(VOID)
+{
+    PAL_IO_COMPLETION_PORT port = NULL;
+
+    ENTRY("PAL_CreateIoCompletionPort()\n");
+
+#if HAVE_EPOLL
+    int epollFd = -1;
+    int eventFd = -1;
+
+    epollFd = epoll_create1(EPOLL_CLOEXEC);
+    if (epollFd == -1)
+    {
+        ERROR("epoll_create1() failed; errno is %d (%s)\n", errno, strerror(errno));
+        SetLastError(FILEGetLastErrorFromErrno());
+        goto done;
+    }
+
+    eventFd = eventfd(0, EFD_CLOEXEC | EFD_NONBLOCK);
+    if (eventFd == -1)
+    {
+        ERROR("eventfd() failed; errno is %d (%s)\n", errno, strerror(errno));
+        SetLastError(FILEGetLastErrorFromErrno());
+        goto done;
+    }
+
+    port = (PAL_IO_COMPLETION_PORT)InternalMalloc(sizeof(struct _PAL_IO_COMPLETION_PORT));
+    if (port == NULL)
+    {
+        SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+        goto done;
+    }
+
+    port->epollFd = epollFd;
+    port->eventFd = eventFd;
+    port->postedHead = NULL;
+    port->postedTail = NULL;
+    pthread_mutex_init(&port->postedLock, NULL);
+
+    {
+        // The eventfd is level triggered, so that every waiter keeps being
+        // woken up until the posted entries have been drained. Its epoll data
+        // is the port itself, which can never be a completion key.
+        struct epoll_event event;
+        event.events = EPOLLIN;
+        event.data.ptr = port;
+
+        if (epoll_ctl(epollFd, EPOLL_CTL_ADD, eventFd, &event) == -1)
+        {
+            ERROR("epoll_ctl() failed; errno is %d (%s)\n", errno, strerror(errno));
+            SetLastError(FILEGetLastErrorFromErrno());
+            pthread_mutex_destroy(&port->postedLock);
+            InternalFree(port);
+            port = NULL;
+            goto done;
+        }
+    }
+
+done:
+    if (port == NULL)
+    {
+        if (eventFd != -1)
+        {
+            close(eventFd);
+        }
+        if (epollFd != -1)
+        {
+            close(epollFd);
+        }
+    }
+#else // HAVE_EPOLL
+    SetLastError(ERROR_NOT_SUPPORTED);
+#endif // HAVE_EPOLL
+
+    LOGEXIT("PAL_CreateIoCompletionPort returns PAL_IO_COMPLETION_PORT %p\n", port);
+    return port;
+}
+
+/*++
+Function:
+  PAL_CloseIoCompletionPort
+
+Closes a port created by PAL_CreateIoCompletionPort. Entries that were posted
+and not dequeued are dropped. No thread may be waiting on the port.
+--*/
+VOID
+PALAPI
+PAL_CloseIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port)
+{
+    ENTRY("PAL_CloseIoCompletionPort(port=%p)\n", port);
+
+#if HAVE_EPOLL
+    if (port != NULL)
+    {
+        close(port->eventFd);
+        close(port->epollFd);
+
+        PostedIoCompletionEntry *pPosted = port->postedHead;
+        while (pPosted != NULL)
+        {
+            PostedIoCompletionEntry *pNext = pPosted->next;
+            InternalFree(pPosted);
+            pPosted = pNext;
+        }
+
+        pthread_mutex_destroy(&port->postedLock);
+        InternalFree(port);
+    }
+#endif // HAVE_EPOLL
+
+    LOGEXIT("PAL_CloseIoCompletionPort returns\n");
+}
+
+/*++
+Function:
+  PAL_AssociateIoCompletionPort
+
+Starts reporting the given PAL_IO_EVENT_READ and PAL_IO_EVENT_WRITE events of
+fd through the port, with the given completion key. Associating a descriptor
+that is already associated replaces its events and key.
+--*/
+BOOL
+PALAPI
+PAL_AssociateIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN INT fd,
+    IN DWORD events,
+    IN ULONG_PTR completionKey)
+{
+    BOOL fResult = FALSE;
+
+    ENTRY("PAL_AssociateIoCompletionPort(port=%p, fd=%d, events=%#x, completionKey=%p)\n",
+          port, fd, events, (void *)completionKey);
+
+#if HAVE_EPOLL
+    if (port == NULL || fd < 0 || (void *)completionKey == (void *)port ||
+        (events & ~(PAL_IO_EVENT_READ | PAL_IO_EVENT_WRITE)) != 0)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        goto done;
+    }
+
+    {
+        struct epoll_event event;
+        event.events = IOCPGetEpollEvents(events);
+        event.data.u64 = (uint64_t)completionKey;
+
+        int result = epoll_ctl(port->epollFd, EPOLL_CTL_ADD, fd, &event);
+        if (result == -1 && errno == EEXIST)
+        {
+            result = epoll_ctl(port->epollFd, EPOLL_CTL_MOD, fd, &event);
+        }
+
+        if (result == -1)
+        {
+            TRACE("epoll_ctl() failed; errno is %d (%s)\n", errno, strerror(errno));
+            SetLastError(FILEGetLastErrorFromErrno());
+            goto done;
+        }
+    }
+
+    fResult = TRUE;
+
+done:
+#else // HAVE_EPOLL
+    SetLastError(ERROR_NOT_SUPPORTED);
+#endif // HAVE_EPOLL
+
+    LOGEXIT("PAL_AssociateIoCompletionPort returns BOOL %d\n", fResult);
+    return fResult;
+}
+
+/*++
+Function:
+  PAL_DissociateIoCompletionPort
+
+Stops reporting the events of fd. Entries for fd that were already dequeued
+by other threads may still be in the process of being handled.
+--*/
+BOOL
+PALAPI
+PAL_DissociateIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN INT fd)
+{
+    BOOL fResult = FALSE;
+
+    ENTRY("PAL_DissociateIoCompletionPort(port=%p, fd=%d)\n", port, fd);
+
+#if HAVE_EPOLL
+    if (port == NULL || fd < 0)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        goto done;
+    }
+
+    {
+        // Kernels before 2.6.9 require a non null event, even though it is ignored
+        struct epoll_event event = {};
+        if (epoll_ctl(port->epollFd, EPOLL_CTL_DEL, fd, &event) == -1)
+        {
+            TRACE("epoll_ctl() failed; errno is %d (%s)\n", errno, strerror(errno));
+            SetLastError(FILEGetLastErrorFromErrno());
+            goto done;
+        }
+    }
+
+    fResult = TRUE;
+
+done:
+#else // HAVE_EPOLL
+    SetLastError(ERROR_NOT_SUPPORTED);
+#endif // HAVE_EPOLL
+
+    LOGEXIT("PAL_DissociateIoCompletionPort returns BOOL %d\n", fResult);
+    return fResult;
+}
+
+/*++
+Function:
+  PAL_PostIoCompletionPort
+
+Queues an entry with the given completion key and events to the port, as
+PostQueuedCompletionStatus does. Posted entries are dequeued in FIFO order,
+ahead of readiness events.
+--*/
+BOOL
+PALAPI
+PAL_PostIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN ULONG_PTR completionKey,
+    IN DWORD events)
+{
+    BOOL fResult = FALSE;
+
+    ENTRY("PAL_PostIoCompletionPort(port=%p, completionKey=%p, events=%#x)\n",
+          port, (void *)completionKey, events);
+
+#if HAVE_EPOLL
+    PostedIoCompletionEntry *pPosted = NULL;
+
+    if (port == NULL)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        goto done;
+    }
+
+    pPosted = InternalAllocateIoCompletionEntry(completionKey, events);
+    if (pPosted == NULL)
+    {
+        SetLastError(ERROR_NOT_ENOUGH_MEMORY);
+        goto done;
+    }
+
+    InternalPostIoCompletionEntry(port, pPosted);
+
+    fResult = TRUE;
+
+done:
+#else // HAVE_EPOLL
+    SetLastError(ERROR_NOT_SUPPORTED);
+#endif // HAVE_EPOLL
+
+    LOGEXIT("PAL_PostIoCompletionPort returns BOOL %d\n", fResult);
+    return fResult;
+}
+
+/*++
+Function:
+  PAL_GetIoCompletionPortEntries
+
+Waits up to dwMilliseconds for entries of the port, and returns as many of
+them as are available at once, up to ulCount, like GetQueuedCompletionStatusEx.
+Returns FALSE with WAIT_TIMEOUT as the last error if nothing was dequeued
+before the timeout.
+--*/
+BOOL
+PALAPI
+PAL_GetIoCompletionPortEntries(
+    IN PAL_IO_COMPLETION_PORT port,
+    OUT PAL_IO_COMPLETION_ENTRY *lpEntries,
+    IN ULONG ulCount,
+    OUT PULONG ulNumEntriesRemoved,
+    IN DWORD dwMilliseconds)
+{
+    BOOL fResult = FALSE;
+
+    ENTRY("PAL_GetIoCompletionPortEntries(port=%p, lpEntries=%p, ulCount=%u, ulNumEntriesRemoved=%p, "
+          "dwMilliseconds=%u)\n", port, lpEntries, ulCount, ulNumEntriesRemoved, dwMilliseconds);
+
+#if HAVE_EPOLL
+    ULONG ulRemoved = 0;
+    DWORD dwStart = GetTickCount();
+
+    if (port == NULL || lpEntries == NULL || ulCount == 0 || ulNumEntriesRemoved == NULL)
+    {
+        SetLastError(ERROR_INVALID_PARAMETER);
+        goto done;
+    }
+
+    *ulNumEntriesRemoved = 0;
+
+    // Posted entries are handed out first, they do not need a system call
+    ulRemoved = IOCPDequeuePostedEntries(port, lpEntries, ulCount);
+
+    while (ulRemoved == 0)
+    {
+        struct epoll_event events[IO_COMPLETION_MAX_EVENTS_PER_WAIT];
+        int maxEvents = (int)min(ulCount, (ULONG)IO_COMPLETION_MAX_EVENTS_PER_WAIT);
+        int timeout = -1;
+
+        if (dwMilliseconds != INFINITE)
+        {
+            DWORD dwElapsed = GetTickCount() - dwStart;
+            timeout = (dwElapsed >= dwMilliseconds) ? 0 : (int)(dwMilliseconds - dwElapsed);
+        }
+
+        int numEvents = epoll_wait(port->epollFd, events, maxEvents, timeout);
+        if (numEvents == -1)
+        {
+            if (errno == EINTR)
+            {
+                // Interrupted by a signal, e.g. an activation injection;
+                // wait again for the rest of the timeout.
+                continue;
+            }
+
+            ERROR("epoll_wait() failed; errno is %d (%s)\n", errno, strerror(errno));
+            SetLastError(FILEGetLastErrorFromErrno());
+            goto done;
+        }
+
+        if (numEvents == 0)
+        {
+            SetLastError(WAIT_TIMEOUT);
+            goto done;
+        }
+
+        bool fPosted = false;
+        for (int i = 0; i < numEvents; i++)
+        {
+            if (events[i].data.ptr == port)
+            {
+                fPosted = true;
+                continue;
+            }
+
+            lpEntries[ulRemoved].CompletionKey = (ULONG_PTR)events[i].data.u64;
+            lpEntries[ulRemoved].Events = IOCPGetPalEvents(events[i].events);
+            ulRemoved++;
+        }
+
+        if (fPosted && ulRemoved < ulCount)
+        {
+            // Another waiter may have drained the posted entries in the
+            // meantime, in which case we go back to waiting.
+            ulRemoved += IOCPDequeuePostedEntries(port, lpEntries + ulRemoved, ulCount - ulRemoved);
+        }
+    }
+
+    *ulNumEntriesRemoved = ulRemoved;
+    fResult = TRUE;
+
+done:
+#else // HAVE_EPOLL
+    SetLastError(ERROR_NOT_SUPPORTED);
+#endif // HAVE_EPOLL
+
+    LOGEXIT("PAL_GetIoCompletionPortEntries returns BOOL %d\n", fResult);
+    return fResult;
+}
@@ -718,6 +718,24 @@ namespace CorUnix
             bool fAltertable
             ) = 0;
 
+        //
+        // RegisterWaitOnIoCompletionPort registers a wait that does not
+        // block any thread: once the object is signaled the signal is
+        // consumed as it would be by a wait, and an entry with the given
+        // completion key and PAL_IO_EVENT_SIGNALED is posted to the port.
+        // The registration holds on to the reference to pObject until it
+        // is unregistered through the synchronization manager.
+        //
+
+        virtual
+        PAL_ERROR
+        RegisterWaitOnIoCompletionPort(
+            PAL_IO_COMPLETION_PORT port,
+            ULONG_PTR completionKey,
+            IPalObject *pObject,
+            PAL_WAIT_REGISTRATION *ppRegistration     // OUT
+            ) = 0;
+
         //
         // Why is there no unregister waiting thread routine? Unregistration
         // is the responsibility of the synchronization provider, not the
@@ -1201,6 +1219,48 @@ namespace CorUnix
             CPalThread *pThread
             ) = 0;
 
+        //
+        // Removes a wait registered with
+        // ISynchWaitController::RegisterWaitOnIoCompletionPort if it has
+        // not been satisfied yet, and frees the registration. Each
+        // registration must be unregistered exactly once.
+        //
+
+        virtual
+        PAL_ERROR
+        UnRegisterWaitOnIoCompletionPort(
+            CPalThread *pThread,
+            PAL_WAIT_REGISTRATION pRegistration,
+            bool *pfSatisfied                   // OUT
+            ) = 0;
+
+        //
+        // Blocks the current thread while *plAddress holds lCompareValue,
+        // until WakeByAddress is called on the address, the timeout expires
+        // or, for an alertable wait, an APC is queued to the thread. The
+        // wakeup reason is WaitSucceeded for anything but the last two;
+        // wakeups can be spurious, so callers look at *plAddress again.
+        // Fails with ERROR_NOT_SUPPORTED where there are no futexes.
+        //
+
+        virtual
+        PAL_ERROR
+        WaitOnAddress(
+            CPalThread *pThread,
+            LONG volatile *plAddress,
+            LONG lCompareValue,
+            DWORD dwTimeout,
+            bool fAlertable,
+            ThreadWakeupReason *peWakeupReason  // OUT
+            ) = 0;
+
+        virtual
+        void
+        WakeByAddress(
+            LONG volatile *plAddress,
+            bool fWakeAll
+            ) = 0;
+
         //
         // The final routines are used by IPalObject::GetSynchStateController
         // and IPalObject::GetSynchWaitController
@@ -226,6 +226,38 @@ namespace CorUnix
         int nFlags,
         ...
         );
+
+    /*++
+    InternalAllocateIoCompletionEntry
+    Allocates an entry that can later be queued to an I/O completion port
+    with InternalPostIoCompletionEntry, so that posting it cannot fail
+    --*/
+    struct PostedIoCompletionEntry;
+
+    PostedIoCompletionEntry *
+    InternalAllocateIoCompletionEntry(
+        ULONG_PTR completionKey,
+        DWORD events
+        );
+
+    /*++
+    InternalFreeIoCompletionEntry
+    Frees an entry that was never posted
+    --*/
+    void
+    InternalFreeIoCompletionEntry(
+        PostedIoCompletionEntry *pEntry
+        );
+
+    /*++
+    InternalPostIoCompletionEntry
+    Queues a preallocated entry to the port, which takes ownership of it
+    --*/
+    void
+    InternalPostIoCompletionEntry(
+        PAL_IO_COMPLETION_PORT port,
+        PostedIoCompletionEntry *pEntry
+        );
 }
 
 extern "C"
@@ -116,6 +116,12 @@ namespace CorUnix
         ThreadNativeWaitData   m_tnwdNativeData;
         ThreadWaitInfo         m_twiWaitInfo;
 
+        // Address the thread is blocked on in an alertable
+        // IPalSynchronizationManager::WaitOnAddress, NULL otherwise
+        LONG volatile *        m_plAlertableWaitAddress;
+        // Incremented every time such a wait ends
+        LONG                   m_lAlertableWaitSequence;
+
 #ifdef SYNCHMGR_SUSPENSION_SAFE_CONDITION_SIGNALING
         static const int       PendingSignalingsArraySize = 10;
         LONG                   m_lPendingSignalingCount;
@@ -478,6 +478,124 @@ namespace CorUnix
         return palErr;
     }                                                
 
+    /*++
+    Method:
+      CSynchWaitController::RegisterWaitOnIoCompletionPort
+
+    Registers a wait on the target object whose completion is posted to
+    the given I/O completion port rather than waking up a thread. If the
+    object is already signaled the wait is satisfied right away.
+
+    Only local objects without ownership semantics are supported, i.e.
+    no mutexes, and no processes since those need to be monitored on
+    behalf of a waiting thread.
+    --*/
+    PAL_ERROR CSynchWaitController::RegisterWaitOnIoCompletionPort(
+        PAL_IO_COMPLETION_PORT port,
+        ULONG_PTR completionKey,
+        IPalObject * pObject,
+        PAL_WAIT_REGISTRATION * ppwrRegistration)
+    {
+        VALIDATEOBJECT(m_psdSynchData);
+
+        PAL_ERROR palErr = NO_ERROR;
+        PAL_WAIT_REGISTRATION pwrRegistration = NULL;
+        PostedIoCompletionEntry * pEntry = NULL;
+        WaitingThreadsListNode * pwtlnNewNode = NULL;
+        bool fAbandoned = false;
+        CPalSynchronizationManager * pSynchManager = 
+            CPalSynchronizationManager::GetInstance();
+
+        _ASSERTE(InternalGetCurrentThread() == m_pthrOwner);
+        _ASSERTE(NULL != ppwrRegistration);
+
+        if (SharedObject == m_odObjectDomain || 
+            otiProcess == m_psdSynchData->GetObjectTypeId() ||
+            CObjectType::OwnershipTracked == 
+                m_psdSynchData->GetObjectType()->GetOwnershipSemantics())
+        {
+            palErr = ERROR_NOT_SUPPORTED;
+            goto RWOICP_exit;
+        }
+
+        pwrRegistration = InternalNew<_PAL_WAIT_REGISTRATION>();
+        pEntry = InternalAllocateIoCompletionEntry(completionKey, PAL_IO_EVENT_SIGNALED);
+        if (NULL == pwrRegistration || NULL == pEntry)
+        {
+            ERROR("Out of memory\n");
+            palErr = ERROR_NOT_ENOUGH_MEMORY;
+            goto RWOICP_exit;
+        }
+
+        pwrRegistration->port      = port;
+        pwrRegistration->pEntry    = NULL;
+        pwrRegistration->pwtlnNode = NULL;
+        pwrRegistration->pObject   = pObject;
+
+        if (m_psdSynchData->CanWaiterWaitWithoutBlocking(m_pthrOwner, &fAbandoned))
+        {
+            // Already signaled: consume the signal and post right away. The
+            // registration is handed out first, so that whoever dequeues the
+            // entry can find it.
+            palErr = m_psdSynchData->ReleaseWaiterWithoutBlocking(m_pthrOwner, m_pthrOwner);
+            if (NO_ERROR != palErr)
+            {
+                goto RWOICP_exit;
+            }
+
+            *ppwrRegistration = pwrRegistration;
+            pwrRegistration = NULL;
+
+            InternalPostIoCompletionEntry(port, pEntry);
+            pEntry = NULL;
+            goto RWOICP_exit;
+        }
+        else
+        {
+            pwtlnNewNode = pSynchManager->CacheGetLocalWTListNode(m_pthrOwner);
+            if (NULL == pwtlnNewNode)
+            {
+                ERROR("Out of memory\n");
+                palErr = ERROR_NOT_ENOUGH_MEMORY;
+                goto RWOICP_exit;
+            }
+
+            pwtlnNewNode->shridSHRThis             = NULL;
+            pwtlnNewNode->ptwiWaitInfo             = NULL;
+            pwtlnNewNode->dwObjIndex               = 0;
+            pwtlnNewNode->dwProcessId              = gPID;
+            pwtlnNewNode->dwThreadId               = 0;
+            pwtlnNewNode->dwFlags                  = WTLN_FLAG_REGISTERED_WAIT;
+            pwtlnNewNode->shridWaitingState        = NULL;
+            pwtlnNewNode->ptrOwnerObjSynchData.ptr = m_psdSynchData;
+            pwtlnNewNode->pwrRegistration          = pwrRegistration;
+
+            pwrRegistration->pEntry    = pEntry;
+            pwrRegistration->pwtlnNode = pwtlnNewNode;
+            pEntry = NULL;
+
+            // AddRef the synch data (will be released in RemoveRegisteredWait)
+            m_psdSynchData->AddRef();
+
+            m_psdSynchData->WaiterEnqueue(pwtlnNewNode);
+        }
+
+        *ppwrRegistration = pwrRegistration;
+        pwrRegistration = NULL;
+
+    RWOICP_exit:
+        if (NULL != pEntry)
+        {
+            InternalFreeIoCompletionEntry(pEntry);
+        }
+        if (NULL != pwrRegistration)
+        {
+            InternalDelete(pwrRegistration);
+        }
+
+        return palErr;
+    }
+
     /*++
     Method:
       CSynchWaitController::ReleaseController
@@ -1122,6 +1240,20 @@ namespace CorUnix
                 pwtlnNextItem = pwtlnItem->ptrNext.ptr;
             }                    
 
+            if (0 != (WTLN_FLAG_REGISTERED_WAIT & pwtlnItem->dwFlags))
+            {
+                // A wait registered on an I/O completion port is satisfied
+                // by definition and there is no thread to wake up: unlink
+                // the wait and post its completion entry
+                pSynchManager->CompleteRegisteredWait(pthrCurrent, pwtlnItem);
+
+                // After CompleteRegisteredWait pwtlnItem is invalid
+                pwtlnItem = NULL;
+
+                fThreadAwakened = true;
+                break;
+            }
+
             if (fWaitAll)
             {
                 // Wait All: we need to find out whether the wait is satisfied, 
@@ -1437,6 +1569,18 @@ namespace CorUnix
                 pwtlnNextItem = pwtlnItem->ptrNext.ptr;
             }    
 
+            if (0 != (WTLN_FLAG_REGISTERED_WAIT & pwtlnItem->dwFlags))
+            {
+                // See note in similar spot in ReleaseFirstWaiter
+                pSynchManager->CompleteRegisteredWait(pthrCurrent, pwtlnItem);
+                lAwakenedCount++;
+
+                // Go to the next item
+                shridItem = shridNextItem;
+                pwtlnItem = pwtlnNextItem;
+                continue;
+            }
+
             // See note in similar spot in ReleaseFirstWaiter
             
             _ASSERTE(fSharedObject || pwtlnItem->dwProcessId == gPID); 
@@ -38,6 +38,10 @@ SET_DEFAULT_DEBUG_CHANNEL(SYNC); // some headers have code with asserts, so do t
 #else
 #include "pal/fakepoll.h"
 #endif // HAVE_POLL
+#if HAVE_FUTEX
+#include <linux/futex.h>
+#include <sys/syscall.h>
+#endif // HAVE_FUTEX
 
 // We use the synchronization manager's worker thread to handle
 // process termination requests. It does so by calling the
@@ -1208,6 +1212,31 @@ namespace CorUnix
         pthrTarget->Unlock(pthrCurrent);
         fThreadLock = false;
 
+        // A thread in an alertable WaitOnAddress is not blocked in the
+        // synchronization manager, so it has to be woken through its address.
+        // Together with the barrier in WaitOnAddress, this makes sure that the
+        // target either sees the APC before blocking or gets woken up. A wake
+        // that comes between its check and the futex wait is lost, though, so
+        // keep waking the target until that wait is over.
+        MemoryBarrier();
+        {
+            CThreadSynchronizationInfo * psynchInfo = &pthrTarget->synchronizationInfo;
+            LONG lSequence = VolatileLoad(&psynchInfo->m_lAlertableWaitSequence);
+            LONG volatile * plWaitAddress = VolatileLoad(&psynchInfo->m_plAlertableWaitAddress);
+
+            while (NULL != plWaitAddress)
+            {
+                WakeByAddress(plWaitAddress, true);
+                sched_yield();
+
+                if (VolatileLoad(&psynchInfo->m_lAlertableWaitSequence) != lSequence)
+                {
+                    break;
+                }
+                plWaitAddress = VolatileLoad(&psynchInfo->m_plAlertableWaitAddress);
+            }
+        }
+
         if (TWS_ALERTABLE == dwWaitState)
         {
             // Unregister the wait
@@ -2870,6 +2899,222 @@ namespace CorUnix
         return;
     }
 
+    /*++
+    Method:
+      CPalSynchronizationManager::RemoveRegisteredWait
+
+    Unlinks the node of a wait registered on an I/O completion port from the
+    waiting list of its object, and releases the node's reference on the
+    object's synch data
+
+    Note: this method must be called while holding the local process
+          synchronization lock.
+    --*/
+    void CPalSynchronizationManager::RemoveRegisteredWait(
+        CPalThread * pthrCurrent,
+        WaitingThreadsListNode * pwtlnNode)
+    {
+        CSynchData * psdSynchData = pwtlnNode->ptrOwnerObjSynchData.ptr;
+
+        VALIDATEOBJECT(pwtlnNode);
+        VALIDATEOBJECT(psdSynchData);
+
+        _ASSERTE(0 != (WTLN_FLAG_REGISTERED_WAIT & pwtlnNode->dwFlags));
+        _ASSERTE(0 == (WTLN_FLAG_OWNER_OBJECT_IS_SHARED & pwtlnNode->dwFlags));
+
+        if (pwtlnNode->ptrPrev.ptr)
+        {
+            pwtlnNode->ptrPrev.ptr->ptrNext.ptr = pwtlnNode->ptrNext.ptr;
+        }
+        else
+        {
+            psdSynchData->SetWTLHeadPtr(pwtlnNode->ptrNext.ptr);
+        }
+
+        if (pwtlnNode->ptrNext.ptr)
+        {
+            pwtlnNode->ptrNext.ptr->ptrPrev.ptr = pwtlnNode->ptrPrev.ptr;
+        }
+        else
+        {
+            psdSynchData->SetWTLTailPtr(pwtlnNode->ptrPrev.ptr);
+        }
+
+        pwtlnNode->pwrRegistration->pwtlnNode = NULL;
+        m_cacheWTListNodes.Add(pthrCurrent, pwtlnNode);
+
+        psdSynchData->DecrementWaitingThreadCount();
+        psdSynchData->Release(pthrCurrent);
+    }
+
+    /*++
+    Method:
+      CPalSynchronizationManager::CompleteRegisteredWait
+
+    Satisfies a wait registered on an I/O completion port: the wait is
+    removed from its object and its preallocated completion entry is
+    posted to the port
+
+    Note: this method must be called while holding the local process
+          synchronization lock.
+    --*/
+    void CPalSynchronizationManager::CompleteRegisteredWait(
+        CPalThread * pthrCurrent,
+        WaitingThreadsListNode * pwtlnNode)
+    {
+        PAL_WAIT_REGISTRATION pwrRegistration = pwtlnNode->pwrRegistration;
+        PostedIoCompletionEntry * pEntry = pwrRegistration->pEntry;
+
+        TRACE("Completing wait registration %p on port %p\n",
+              pwrRegistration, pwrRegistration->port);
+
+        RemoveRegisteredWait(pthrCurrent, pwtlnNode);
+
+        pwrRegistration->pEntry = NULL;
+        InternalPostIoCompletionEntry(pwrRegistration->port, pEntry);
+    }
+
+    /*++
+    Method:
+      CPalSynchronizationManager::UnRegisterWaitOnIoCompletionPort
+
+    Removes a wait registered on an I/O completion port, unless it has already
+    been satisfied, and frees the registration along with its reference on
+    the object. *pfSatisfied tells whether the completion entry of the wait
+    was posted.
+    --*/
+    PAL_ERROR CPalSynchronizationManager::UnRegisterWaitOnIoCompletionPort(
+        CPalThread * pthrCurrent,
+        PAL_WAIT_REGISTRATION pwrRegistration,
+        bool * pfSatisfied)
+    {
+        PostedIoCompletionEntry * pEntry;
+
+        _ASSERTE(NULL != pwrRegistration);
+        _ASSERTE(NULL != pfSatisfied);
+
+        AcquireLocalSynchLock(pthrCurrent);
+
+        if (NULL != pwrRegistration->pwtlnNode)
+        {
+            RemoveRegisteredWait(pthrCurrent, pwrRegistration->pwtlnNode);
+        }
+
+        pEntry = pwrRegistration->pEntry;
+
+        ReleaseLocalSynchLock(pthrCurrent);
+
+        // The entry is posted if and only if the wait was satisfied
+        *pfSatisfied = (NULL == pEntry);
+        if (NULL != pEntry)
+        {
+            InternalFreeIoCompletionEntry(pEntry);
+        }
+
+        pwrRegistration->pObject->ReleaseReference(pthrCurrent);
+        InternalDelete(pwrRegistration);
+
+        return NO_ERROR;
+    }
+
+    /*++
+    Method:
+      CPalSynchronizationManager::WaitOnAddress
+
+    Blocks the current thread on a futex for as long as *plAddress holds
+    lCompareValue. The thread does not go through the synchronization locks,
+    the waiting thread lists or its native wait data, which is what makes
+    this cheaper than waiting on an event. Alertable waits publish the address
+    so that QueueUserAPC can wake the thread up.
+    --*/
+    PAL_ERROR CPalSynchronizationManager::WaitOnAddress(
+        CPalThread * pthrCurrent,
+        LONG volatile * plAddress,
+        LONG lCompareValue,
+        DWORD dwTimeout,
+        bool fAlertable,
+        ThreadWakeupReason * ptwrWakeupReason)
+    {
+#if HAVE_FUTEX
+        PAL_ERROR palErr = NO_ERROR;
+        struct timespec ts;
+        struct timespec * pts = NULL;
+        int iRet;
+
+        _ASSERTE(NULL != plAddress);
+        _ASSERTE(NULL != ptwrWakeupReason);
+
+        if (fAlertable)
+        {
+            VolatileStore(&pthrCurrent->synchronizationInfo.m_plAlertableWaitAddress, (LONG volatile *)plAddress);
+
+            // Pairs with the barrier in QueueUserAPC
+            MemoryBarrier();
+            if (AreAPCsPending(pthrCurrent))
+            {
+                *ptwrWakeupReason = Alerted;
+                goto WOA_exit;
+            }
+        }
+
+        if (INFINITE != dwTimeout)
+        {
+            ts.tv_sec = dwTimeout / tccSecondsToMillieSeconds;
+            ts.tv_nsec = (dwTimeout % tccSecondsToMillieSeconds) * tccMillieSecondsToNanoSeconds;
+            pts = &ts;
+        }
+
+        iRet = syscall(SYS_futex, plAddress, FUTEX_WAIT_PRIVATE, lCompareValue, pts, NULL, 0);
+        if (0 == iRet || EAGAIN == errno || EINTR == errno)
+        {
+            // Woken up, the value had changed already, or a signal came in
+            *ptwrWakeupReason = WaitSucceeded;
+        }
+        else if (ETIMEDOUT == errno)
+        {
+            *ptwrWakeupReason = WaitTimeout;
+        }
+        else
+        {
+            ERROR("futex wait failed [errno=%d {%s}]\n", errno, strerror(errno));
+            *ptwrWakeupReason = WaitFailed;
+            palErr = ERROR_INTERNAL_ERROR;
+        }
+
+        if (fAlertable && AreAPCsPending(pthrCurrent))
+        {
+            *ptwrWakeupReason = Alerted;
+        }
+
+    WOA_exit:
+        if (fAlertable)
+        {
+            // The address is cleared before the sequence moves on, see QueueUserAPC
+            VolatileStore(&pthrCurrent->synchronizationInfo.m_plAlertableWaitAddress, (LONG volatile *)NULL);
+            InterlockedIncrement(&pthrCurrent->synchronizationInfo.m_lAlertableWaitSequence);
+        }
+
+        return palErr;
+#else // HAVE_FUTEX
+        return ERROR_NOT_SUPPORTED;
+#endif // HAVE_FUTEX
+    }
+
+    /*++
+    Method:
+      CPalSynchronizationManager::WakeByAddress
+
+    Wakes up one or all of the threads blocked in WaitOnAddress on plAddress
+    --*/
+    void CPalSynchronizationManager::WakeByAddress(
+        LONG volatile * plAddress,
+        bool fWakeAll)
+    {
+#if HAVE_FUTEX
+        syscall(SYS_futex, plAddress, FUTEX_WAKE_PRIVATE, fWakeAll ? INT_MAX : 1, NULL, NULL, 0);
+#endif // HAVE_FUTEX
+    }
+
     /*++
     Method:
       CPalSynchronizationManager::UnsignalRestOfLocalAwakeningWaitAll
@@ -3747,6 +3992,23 @@ namespace CorUnix
         _ASSERTE(NULL != ppvSharedSynchData);
         _ASSERTE(ProcessLocalObject == psdLocal->GetObjectDomain());
 
+        //
+        // Waits registered on an I/O completion port cannot be moved to
+        // shared memory, since they have no waiting thread to wake up
+        //
+
+        for (WaitingThreadsListNode *pwtln = psdLocal->GetWTLHeadPtr();
+             pwtln != NULL;
+             pwtln = pwtln->ptrNext.ptr)
+        {
+            if (0 != (WTLN_FLAG_REGISTERED_WAIT & pwtln->dwFlags))
+            {
+                ERROR("Cannot promote an object with registered waits\n");
+                palError = ERROR_NOT_SUPPORTED;
+                goto POSD_exit;
+            }
+        }
+
 #if _DEBUG
 
         //
@@ -4023,7 +4285,9 @@ namespace CorUnix
             m_shridWaitAwakened(NULL),
             m_lLocalSynchLockCount(0),
             m_lSharedSynchLockCount(0),
-            m_ownedNamedMutexListHead(nullptr)
+            m_ownedNamedMutexListHead(nullptr),
+            m_plAlertableWaitAddress(NULL),
+            m_lAlertableWaitSequence(0)
     {
         InitializeListHead(&m_leOwnedObjsList);
         InitializeCriticalSection(&m_ownedNamedMutexListLock);
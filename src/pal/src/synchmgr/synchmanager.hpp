@@ -28,6 +28,7 @@ Abstract:
 #include "pal/procobj.hpp"
 #include "pal/init.h"
 #include "pal/process.h"
+#include "pal/file.hpp"
 
 #include <sys/types.h>
 #include <unistd.h>
@@ -52,6 +53,7 @@ namespace CorUnix
     const DWORD WTLN_FLAG_OWNER_OBJECT_IS_SHARED                 = 1<<0;
     const DWORD WTLN_FLAG_WAIT_ALL                               = 1<<1;
     const DWORD WTLN_FLAG_DELEGATED_OBJECT_SIGNALING_IN_PROGRESS = 1<<2;
+    const DWORD WTLN_FLAG_REGISTERED_WAIT                        = 1<<3;
 
 #ifdef SYNCH_OBJECT_VALIDATION
     const DWORD HeadSignature  = 0x48454144;
@@ -106,6 +108,8 @@ namespace CorUnix
         SynchDataGenrPtr ptrOwnerObjSynchData;
         struct _ThreadWaitInfo * ptwiWaitInfo;  // valid only in the 
                                                 // target process
+        PAL_WAIT_REGISTRATION pwrRegistration;  // valid only for nodes with
+                                                // WTLN_FLAG_REGISTERED_WAIT
 #ifdef SYNCH_OBJECT_VALIDATION
         _WaitingThreadsListNode();
         ~_WaitingThreadsListNode();
@@ -466,6 +470,12 @@ namespace CorUnix
             DWORD dwIndex,
             bool fAlertable);
 
+        virtual PAL_ERROR RegisterWaitOnIoCompletionPort(
+            PAL_IO_COMPLETION_PORT port,
+            ULONG_PTR completionKey,
+            IPalObject * pObject,
+            PAL_WAIT_REGISTRATION * ppwrRegistration);
+
         virtual void ReleaseController(void);
 
         CProcProcessLocalData * GetProcessLocalData(void);
@@ -885,6 +895,23 @@ namespace CorUnix
 
         virtual void ReleaseProcessLock(CPalThread *pthrCurrent);
 
+        virtual PAL_ERROR UnRegisterWaitOnIoCompletionPort(
+            CPalThread *pthrCurrent,
+            PAL_WAIT_REGISTRATION pwrRegistration,
+            bool *pfSatisfied);
+
+        virtual PAL_ERROR WaitOnAddress(
+            CPalThread *pthrCurrent,
+            LONG volatile *plAddress,
+            LONG lCompareValue,
+            DWORD dwTimeout,
+            bool fAlertable,
+            ThreadWakeupReason *ptwrWakeupReason);
+
+        virtual void WakeByAddress(
+            LONG volatile *plAddress,
+            bool fWakeAll);
+
         //
         // Static helper methods
         //
@@ -990,6 +1017,14 @@ namespace CorUnix
             ThreadWaitInfo * ptwiWaitInfo,
             bool fHaveSharedLock);
 
+        void CompleteRegisteredWait(
+            CPalThread * pthrCurrent,
+            WaitingThreadsListNode * pwtlnNode);
+
+        void RemoveRegisteredWait(
+            CPalThread * pthrCurrent,
+            WaitingThreadsListNode * pwtlnNode);
+
         PAL_ERROR RegisterProcessForMonitoring(
             CPalThread * pthrCurrent,
             CSynchData *psdSynchData,
@@ -1020,4 +1055,21 @@ namespace CorUnix
     };
 }
 
+//
+// Wait registered by PAL_RegisterWaitOnIoCompletionPort. It is owned by the
+// caller and only ever accessed while holding the local synch lock.
+//
+struct _PAL_WAIT_REGISTRATION
+{
+    // Port that receives the completion entry once the wait is satisfied
+    PAL_IO_COMPLETION_PORT port;
+    // Preallocated completion entry, NULL once it has been posted
+    CorUnix::PostedIoCompletionEntry * pEntry;
+    // Node in the waiting list of the object, NULL once the wait has
+    // been satisfied
+    CorUnix::WaitingThreadsListNode * pwtlnNode;
+    // Reference on the object, held for as long as the wait is registered
+    CorUnix::IPalObject * pObject;
+};
+
 #endif // _SYNCHMANAGER_HPP_
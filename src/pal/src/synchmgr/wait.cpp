@@ -45,6 +45,19 @@ static PalObjectTypeId sg_rgWaitObjectsIds[] =
 static CAllowedObjectTypes sg_aotWaitObject(sg_rgWaitObjectsIds, 
     sizeof(sg_rgWaitObjectsIds)/sizeof(sg_rgWaitObjectsIds[0]));
 
+// Objects that waits can be registered on with
+// PAL_RegisterWaitOnIoCompletionPort; see
+// CSynchWaitController::RegisterWaitOnIoCompletionPort
+static PalObjectTypeId sg_rgRegisteredWaitObjectsIds[] = 
+    { 
+        otiAutoResetEvent,
+        otiManualResetEvent,
+        otiSemaphore,
+        otiThread
+    };
+static CAllowedObjectTypes sg_aotRegisteredWaitObject(sg_rgRegisteredWaitObjectsIds, 
+    sizeof(sg_rgRegisteredWaitObjectsIds)/sizeof(sg_rgRegisteredWaitObjectsIds[0]));
+
 /*++
 Function:
   WaitForSingleObject
@@ -279,6 +292,234 @@ QueueUserAPC_exit:
     return dwRet;
 }
 
+/*++
+Function:
+  PAL_RegisterWaitOnIoCompletionPort
+
+Registers a one-shot wait on hObject that does not block any thread. Once the
+object is signaled the signal is consumed as it would be by a wait, and an
+entry with completionKey and PAL_IO_EVENT_SIGNALED is posted to the port.
+Registering and unregistering a wait takes constant time, regardless of the
+number of waits registered on the object or the port.
+
+Every registration must eventually be passed to
+PAL_UnregisterWaitOnIoCompletionPort. Mutexes and processes are not supported
+and fail with ERROR_NOT_SUPPORTED.
+--*/
+BOOL
+PALAPI
+PAL_RegisterWaitOnIoCompletionPort(
+    IN PAL_IO_COMPLETION_PORT port,
+    IN HANDLE hObject,
+    IN ULONG_PTR completionKey,
+    OUT PAL_WAIT_REGISTRATION *pRegistration)
+{
+    CPalThread * pThread;
+    IPalObject * pObject = NULL;
+    ISynchWaitController * pSyncWaitCtrlr = NULL;
+    PAL_ERROR palErr = NO_ERROR;
+
+    ENTRY("PAL_RegisterWaitOnIoCompletionPort(port=%p, hObject=%p, completionKey=%p, "
+          "pRegistration=%p)\n", port, hObject, (void *)completionKey, pRegistration);
+
+    pThread = InternalGetCurrentThread();
+
+    if (NULL == port || NULL == pRegistration)
+    {
+        palErr = ERROR_INVALID_PARAMETER;
+        goto PAL_RegisterWaitOnIoCompletionPort_exit;
+    }
+
+    palErr = g_pObjectManager->ReferenceObjectByHandle(pThread,
+                                                       hObject,
+                                                       &sg_aotRegisteredWaitObject,
+                                                       SYNCHRONIZE,
+                                                       &pObject);
+    if (NO_ERROR != palErr)
+    {
+        ERROR("Unable to obtain object for handle %p [error=%u]\n", hObject, palErr);
+        if (ERROR_INVALID_HANDLE != palErr)
+        {
+            palErr = ERROR_NOT_SUPPORTED;
+        }
+        goto PAL_RegisterWaitOnIoCompletionPort_exit;
+    }
+
+    palErr = g_pSynchronizationManager->GetSynchWaitControllersForObjects(
+        pThread, &pObject, 1, &pSyncWaitCtrlr);
+    if (NO_ERROR != palErr)
+    {
+        ERROR("Unable to obtain ISynchWaitController interface for object %p "
+              "[error=%u]\n", pObject, palErr);
+        goto PAL_RegisterWaitOnIoCompletionPort_exit;
+    }
+
+    // On success the registration takes over the object reference
+    palErr = pSyncWaitCtrlr->RegisterWaitOnIoCompletionPort(port, completionKey, pObject, pRegistration);
+    pSyncWaitCtrlr->ReleaseController();
+
+    if (NO_ERROR == palErr)
+    {
+        pObject = NULL;
+    }
+
+PAL_RegisterWaitOnIoCompletionPort_exit:
+    if (NULL != pObject)
+    {
+        pObject->ReleaseReference(pThread);
+    }
+
+    if (NO_ERROR != palErr)
+    {
+        pThread->SetLastError(palErr);
+    }
+
+    LOGEXIT("PAL_RegisterWaitOnIoCompletionPort returns BOOL %d\n", NO_ERROR == palErr);
+    return NO_ERROR == palErr;
+}
+
+/*++
+Function:
+  PAL_UnregisterWaitOnIoCompletionPort
+
+Cancels a wait registered with PAL_RegisterWaitOnIoCompletionPort and frees
+the registration. *pbSatisfied is set to TRUE if the wait was satisfied
+before it could be canceled, in which case its entry has been posted to the
+port, and to FALSE otherwise.
+--*/
+BOOL
+PALAPI
+PAL_UnregisterWaitOnIoCompletionPort(
+    IN PAL_WAIT_REGISTRATION registration,
+    OUT PBOOL pbSatisfied)
+{
+    CPalThread * pThread;
+    PAL_ERROR palErr = NO_ERROR;
+    bool fSatisfied = false;
+
+    ENTRY("PAL_UnregisterWaitOnIoCompletionPort(registration=%p, pbSatisfied=%p)\n",
+          registration, pbSatisfied);
+
+    pThread = InternalGetCurrentThread();
+
+    if (NULL == registration)
+    {
+        palErr = ERROR_INVALID_PARAMETER;
+        goto PAL_UnregisterWaitOnIoCompletionPort_exit;
+    }
+
+    palErr = g_pSynchronizationManager->UnRegisterWaitOnIoCompletionPort(
+        pThread, registration, &fSatisfied);
+
+    if (NO_ERROR == palErr && NULL != pbSatisfied)
+    {
+        *pbSatisfied = fSatisfied ? TRUE : FALSE;
+    }
+
+PAL_UnregisterWaitOnIoCompletionPort_exit:
+    if (NO_ERROR != palErr)
+    {
+        pThread->SetLastError(palErr);
+    }
+
+    LOGEXIT("PAL_UnregisterWaitOnIoCompletionPort returns BOOL %d\n", NO_ERROR == palErr);
+    return NO_ERROR == palErr;
+}
+
+/*++
+Function:
+  PAL_WaitOnAddress
+
+Blocks the current thread while *lpAddress holds lCompareValue, until
+PAL_WakeByAddress is called on the address or the timeout expires. An
+alertable wait also ends, after running them, when APCs are queued to the
+thread. Wakeups can be spurious, so callers look at the value again.
+
+Unlike events, this does not take the synchronization locks, which makes
+it suitable for locks that park their waiters on a word of their own.
+Fails with ERROR_NOT_SUPPORTED where the platform has no futexes.
+--*/
+DWORD
+PALAPI
+PAL_WaitOnAddress(
+    IN LONG volatile *lpAddress,
+    IN LONG lCompareValue,
+    IN DWORD dwMilliseconds,
+    IN BOOL bAlertable)
+{
+    CPalThread * pThread;
+    ThreadWakeupReason twrWakeupReason;
+    PAL_ERROR palErr;
+    DWORD dwRet = WAIT_FAILED;
+
+    ENTRY("PAL_WaitOnAddress(lpAddress=%p, lCompareValue=%d, dwMilliseconds=%u, bAlertable=%d)\n",
+          lpAddress, lCompareValue, dwMilliseconds, bAlertable);
+
+    pThread = InternalGetCurrentThread();
+
+    if (NULL == lpAddress)
+    {
+        pThread->SetLastError(ERROR_INVALID_PARAMETER);
+        goto PAL_WaitOnAddress_exit;
+    }
+
+    palErr = g_pSynchronizationManager->WaitOnAddress(pThread,
+                                                      lpAddress,
+                                                      lCompareValue,
+                                                      dwMilliseconds,
+                                                      (TRUE == bAlertable),
+                                                      &twrWakeupReason);
+    if (NO_ERROR != palErr)
+    {
+        pThread->SetLastError(palErr);
+        goto PAL_WaitOnAddress_exit;
+    }
+
+    switch (twrWakeupReason)
+    {
+    case WaitSucceeded:
+        dwRet = WAIT_OBJECT_0;
+        break;
+    case WaitTimeout:
+        dwRet = WAIT_TIMEOUT;
+        break;
+    case Alerted:
+        _ASSERT_MSG(bAlertable, "Awakened for APC from a non-alertable wait\n");
+
+        dwRet = WAIT_IO_COMPLETION;
+        palErr = g_pSynchronizationManager->DispatchPendingAPCs(pThread);
+        _ASSERT_MSG(NO_ERROR == palErr, "Awakened for APC, but no APC is pending\n");
+        break;
+    default:
+        pThread->SetLastError(ERROR_INTERNAL_ERROR);
+        break;
+    }
+
+PAL_WaitOnAddress_exit:
+    LOGEXIT("PAL_WaitOnAddress returns DWORD %u\n", dwRet);
+    return dwRet;
+}
+
+/*++
+Function:
+  PAL_WakeByAddress
+
+Wakes up one, or all, of the threads blocked in PAL_WaitOnAddress on
+lpAddress. Does nothing if there are none.
+--*/
+VOID
+PALAPI
+PAL_WakeByAddress(
+    IN LONG volatile *lpAddress,
+    IN BOOL bWakeAll)
+{
+    ENTRY("PAL_WakeByAddress(lpAddress=%p, bWakeAll=%d)\n", lpAddress, bWakeAll);
+
+    g_pSynchronizationManager->WakeByAddress(lpAddress, (TRUE == bWakeAll));
+
+    LOGEXIT("PAL_WakeByAddress returns\n");
+}
+
 DWORD CorUnix::InternalWaitForMultipleObjectsEx(
     CPalThread * pThread,
     DWORD nCount,
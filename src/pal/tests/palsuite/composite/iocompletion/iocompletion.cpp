@@ -0,0 +1,117 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*============================================================
+** Source Code: iocompletion.cpp
+**
+** Measures how many entries a single thread can post to a PAL
+** I/O completion port and dequeue with
+** PAL_GetIoCompletionPortEntries per second, in batches.
+**
+**
+**============================================================
+*/
+
+#include <palsuite.h>
+
+#define MAX_BATCH_SIZE  256
+
+/* Test Input Variables */
+unsigned int ENTRY_COUNT = 1000000;
+unsigned int BATCH_SIZE = 64;
+
+int GetParameters(int argc, char **argv)
+{
+    if (argc > 3 || (argc > 1 && (!strcmp(argv[1], "/?") || !strcmp(argv[1], "/h") || !strcmp(argv[1], "/H"))))
+    {
+        printf("PAL -Composite I/O Completion Port Throughput Test\n");
+        printf("Usage:\n");
+        printf("paltest_composite_iocompletion\n\t[ENTRY_COUNT [greater than 0]]\n");
+        printf("\t[BATCH_SIZE [greater than 0, at most %d]]\n", MAX_BATCH_SIZE);
+        return -1;
+    }
+
+    if (argc > 1)
+    {
+        ENTRY_COUNT = atoi(argv[1]);
+        if (ENTRY_COUNT < 1)
+        {
+            printf("\nInvalid ENTRY_COUNT number, Pass greater than 0\n");
+            return -1;
+        }
+    }
+
+    if (argc > 2)
+    {
+        BATCH_SIZE = atoi(argv[2]);
+        if (BATCH_SIZE < 1 || BATCH_SIZE > MAX_BATCH_SIZE)
+        {
+            printf("\nInvalid BATCH_SIZE number, Pass greater than 0 and at most %d\n", MAX_BATCH_SIZE);
+            return -1;
+        }
+    }
+
+    return 0;
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    PAL_IO_COMPLETION_PORT port;
+    PAL_IO_COMPLETION_ENTRY entries[MAX_BATCH_SIZE];
+    ULONG numEntries;
+    ULONG ulCompleted = 0;
+    ULONG i;
+    DWORD dwStart;
+    DWORD dwElapsed;
+
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    if (GetParameters(argc, argv))
+    {
+        Fail("Error in obtaining the parameters\n");
+    }
+
+    port = PAL_CreateIoCompletionPort();
+    if (port == NULL)
+    {
+        Fail("ERROR: PAL_CreateIoCompletionPort failed with error %u\n", GetLastError());
+    }
+
+    dwStart = GetTickCount();
+
+    while (ulCompleted < ENTRY_COUNT)
+    {
+        for (i = 0; i < BATCH_SIZE; i++)
+        {
+            if (!PAL_PostIoCompletionPort(port, (ULONG_PTR)(i + 1), 0))
+            {
+                PAL_CloseIoCompletionPort(port);
+                Fail("ERROR: PAL_PostIoCompletionPort failed with error %u\n", GetLastError());
+            }
+        }
+
+        for (i = 0; i < BATCH_SIZE; i += numEntries)
+        {
+            if (!PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, INFINITE))
+            {
+                PAL_CloseIoCompletionPort(port);
+                Fail("ERROR: PAL_GetIoCompletionPortEntries failed with error %u\n", GetLastError());
+            }
+        }
+
+        ulCompleted += BATCH_SIZE;
+    }
+
+    dwElapsed = GetTickCount() - dwStart;
+    printf("%u completions in batches of %u in %u ms (%u completions per second)\n", ulCompleted, BATCH_SIZE,
+           dwElapsed, dwElapsed == 0 ? ulCompleted : (ULONG)((ULONGLONG)ulCompleted * 1000 / dwElapsed));
+
+    PAL_CloseIoCompletionPort(port);
+
+    PAL_Terminate();
+    return PASS;
+}
@@ -0,0 +1,201 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: test1.cpp
+**
+** Purpose: Positive test for PAL_PostIoCompletionPort,
+**          PAL_AssociateIoCompletionPort and
+**          PAL_GetIoCompletionPortEntries. Posts entries to a
+**          port, checks that they are dequeued in batches and in
+**          order, and checks that a wait on an empty port times
+**          out. Then associates the read end of a pipe with the
+**          port and checks that it is reported readable once per
+**          write, and no longer once it is dissociated.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#include <unistd.h>
+
+#define BATCH_SIZE          64
+#define PIPE_KEY            ((ULONG_PTR)0x1234)
+
+int __cdecl main(int argc, char *argv[])
+{
+    PAL_IO_COMPLETION_PORT port;
+    PAL_IO_COMPLETION_ENTRY entries[BATCH_SIZE];
+    ULONG numEntries;
+    ULONG i;
+    int fds[2];
+    char buffer[2];
+
+    /* Initialize the PAL environment */
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    port = PAL_CreateIoCompletionPort();
+    if (port == NULL)
+    {
+        if (GetLastError() == ERROR_NOT_SUPPORTED)
+        {
+            /* The platform has no epoll; there is nothing to test */
+            PAL_Terminate();
+            return PASS;
+        }
+
+        Fail("ERROR: PAL_CreateIoCompletionPort failed with error %u\n", GetLastError());
+    }
+
+    /* Nothing was posted, so the wait has to time out */
+    if (PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, 10))
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries returned %u entries from an empty port\n", numEntries);
+    }
+
+    if (GetLastError() != WAIT_TIMEOUT)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries failed with error %u instead of WAIT_TIMEOUT\n",
+             GetLastError());
+    }
+
+    /* Posted entries come back in order, and only as many as asked for */
+    for (i = 0; i < 3; i++)
+    {
+        if (!PAL_PostIoCompletionPort(port, (ULONG_PTR)(i + 1), i + 10))
+        {
+            PAL_CloseIoCompletionPort(port);
+            Fail("ERROR: PAL_PostIoCompletionPort failed with error %u\n", GetLastError());
+        }
+    }
+
+    if (!PAL_GetIoCompletionPortEntries(port, entries, 2, &numEntries, 0) || numEntries != 2)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries did not return the first 2 posted entries\n");
+    }
+
+    if (!PAL_GetIoCompletionPortEntries(port, entries + 2, BATCH_SIZE - 2, &numEntries, INFINITE) ||
+        numEntries != 1)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries did not return the last posted entry\n");
+    }
+
+    for (i = 0; i < 3; i++)
+    {
+        if (entries[i].CompletionKey != (ULONG_PTR)(i + 1) || entries[i].Events != i + 10)
+        {
+            PAL_CloseIoCompletionPort(port);
+            Fail("ERROR: entry %u has key %p and events %u, expected key %p and events %u\n",
+                 i, (void *)entries[i].CompletionKey, entries[i].Events, (void *)(ULONG_PTR)(i + 1), i + 10);
+        }
+    }
+
+    /* The port is empty again once everything was dequeued */
+    if (PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, 0) ||
+        GetLastError() != WAIT_TIMEOUT)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries did not time out on a drained port\n");
+    }
+
+    /* The read end of a pipe is reported once for each write that makes it readable */
+    if (pipe(fds) != 0)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: pipe failed with errno %d\n", errno);
+    }
+
+    if (!PAL_AssociateIoCompletionPort(port, fds[0], PAL_IO_EVENT_READ, PIPE_KEY))
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_AssociateIoCompletionPort failed with error %u\n", GetLastError());
+    }
+
+    /* Nothing was written yet */
+    if (PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, 10) ||
+        GetLastError() != WAIT_TIMEOUT)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: the read end of an empty pipe was reported by PAL_GetIoCompletionPortEntries\n");
+    }
+
+    if (write(fds[1], "a", 1) != 1)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: write failed with errno %d\n", errno);
+    }
+
+    if (!PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, INFINITE) ||
+        numEntries != 1 || entries[0].CompletionKey != PIPE_KEY ||
+        (entries[0].Events & (PAL_IO_EVENT_READ | PAL_IO_EVENT_ERROR)) != PAL_IO_EVENT_READ)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries did not report the read end of the pipe as readable\n");
+    }
+
+    /* Readiness is edge triggered: the byte that is still in the pipe is not reported again */
+    if (PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, 10) ||
+        GetLastError() != WAIT_TIMEOUT)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries reported the read end of the pipe twice for one write\n");
+    }
+
+    /* The next write is reported again */
+    if (write(fds[1], "b", 1) != 1)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: write failed with errno %d\n", errno);
+    }
+
+    if (!PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, INFINITE) ||
+        numEntries != 1 || entries[0].CompletionKey != PIPE_KEY ||
+        (entries[0].Events & PAL_IO_EVENT_READ) == 0)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries did not report the second write to the pipe\n");
+    }
+
+    if (read(fds[0], buffer, sizeof(buffer)) != 2 || buffer[0] != 'a' || buffer[1] != 'b')
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: read did not return the bytes written to the pipe\n");
+    }
+
+    /* Once dissociated, the pipe is not reported any more */
+    if (!PAL_DissociateIoCompletionPort(port, fds[0]))
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_DissociateIoCompletionPort failed with error %u\n", GetLastError());
+    }
+
+    if (write(fds[1], "c", 1) != 1)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: write failed with errno %d\n", errno);
+    }
+
+    if (PAL_GetIoCompletionPortEntries(port, entries, BATCH_SIZE, &numEntries, 10) ||
+        GetLastError() != WAIT_TIMEOUT)
+    {
+        PAL_CloseIoCompletionPort(port);
+        Fail("ERROR: PAL_GetIoCompletionPortEntries reported a pipe that was dissociated from the port\n");
+    }
+
+    close(fds[0]);
+    close(fds[1]);
+
+    PAL_CloseIoCompletionPort(port);
+
+    PAL_Terminate();
+    return PASS;
+}
@@ -0,0 +1,275 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: test1.cpp
+**
+** Purpose: Positive test for PAL_RegisterWaitOnIoCompletionPort and
+**          PAL_UnregisterWaitOnIoCompletionPort. Registers waits on
+**          events and a semaphore, checks that each satisfied wait
+**          posts exactly one entry and consumes the signal, that a
+**          canceled wait is not posted, that mutexes are rejected,
+**          and reports how many waits a single thread can register,
+**          satisfy and unregister per second.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define NUM_WAITS           16
+#define THROUGHPUT_WAITS    100000
+
+static PAL_IO_COMPLETION_PORT port;
+
+static void CleanupAndFail(const char *message, HANDLE h)
+{
+    if (h != NULL)
+    {
+        CloseHandle(h);
+    }
+    PAL_CloseIoCompletionPort(port);
+    Fail("%s (error %u)\n", message, GetLastError());
+}
+
+/* Dequeues everything that is available and returns how many entries had the key */
+static ULONG DrainPort(ULONG_PTR completionKey)
+{
+    PAL_IO_COMPLETION_ENTRY entries[NUM_WAITS];
+    ULONG numEntries;
+    ULONG numMatches = 0;
+    ULONG i;
+
+    while (PAL_GetIoCompletionPortEntries(port, entries, NUM_WAITS, &numEntries, 0))
+    {
+        for (i = 0; i < numEntries; i++)
+        {
+            if (entries[i].Events != PAL_IO_EVENT_SIGNALED)
+            {
+                CleanupAndFail("ERROR: a registered wait posted an entry without PAL_IO_EVENT_SIGNALED", NULL);
+            }
+            if (entries[i].CompletionKey == completionKey)
+            {
+                numMatches++;
+            }
+        }
+    }
+
+    return numMatches;
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    PAL_WAIT_REGISTRATION registrations[NUM_WAITS];
+    BOOL bSatisfied;
+    HANDLE hEvent;
+    HANDLE hSemaphore;
+    HANDLE hMutex;
+    ULONG i;
+
+    /* Initialize the PAL environment */
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    port = PAL_CreateIoCompletionPort();
+    if (port == NULL)
+    {
+        if (GetLastError() == ERROR_NOT_SUPPORTED)
+        {
+            /* The platform has no epoll; there is nothing to test */
+            PAL_Terminate();
+            return PASS;
+        }
+
+        Fail("ERROR: PAL_CreateIoCompletionPort failed with error %u\n", GetLastError());
+    }
+
+    /* A wait on a signaled auto reset event is satisfied right away and resets the event */
+    hEvent = CreateEvent(NULL, FALSE, TRUE, NULL);
+    if (hEvent == NULL)
+    {
+        CleanupAndFail("ERROR: CreateEvent failed", NULL);
+    }
+
+    if (!PAL_RegisterWaitOnIoCompletionPort(port, hEvent, 1, &registrations[0]))
+    {
+        CleanupAndFail("ERROR: PAL_RegisterWaitOnIoCompletionPort failed", hEvent);
+    }
+
+    if (DrainPort(1) != 1 || WaitForSingleObject(hEvent, 0) != WAIT_TIMEOUT)
+    {
+        CleanupAndFail("ERROR: a wait on a signaled event was not satisfied right away", hEvent);
+    }
+
+    if (!PAL_UnregisterWaitOnIoCompletionPort(registrations[0], &bSatisfied) || !bSatisfied)
+    {
+        CleanupAndFail("ERROR: a satisfied wait was not reported as satisfied", hEvent);
+    }
+
+    /* Setting an auto reset event satisfies the registered waits one at a time */
+    for (i = 0; i < NUM_WAITS; i++)
+    {
+        if (!PAL_RegisterWaitOnIoCompletionPort(port, hEvent, 2, &registrations[i]))
+        {
+            CleanupAndFail("ERROR: PAL_RegisterWaitOnIoCompletionPort failed", hEvent);
+        }
+    }
+
+    if (DrainPort(2) != 0)
+    {
+        CleanupAndFail("ERROR: a wait on an unsignaled event was satisfied", hEvent);
+    }
+
+    for (i = 0; i < NUM_WAITS / 2; i++)
+    {
+        SetEvent(hEvent);
+    }
+
+    if (DrainPort(2) != NUM_WAITS / 2)
+    {
+        CleanupAndFail("ERROR: setting the event did not satisfy exactly one wait each time", hEvent);
+    }
+
+    for (i = 0; i < NUM_WAITS; i++)
+    {
+        if (!PAL_UnregisterWaitOnIoCompletionPort(registrations[i], &bSatisfied) ||
+            bSatisfied != (i < NUM_WAITS / 2))
+        {
+            CleanupAndFail("ERROR: waits were not satisfied in registration order", hEvent);
+        }
+    }
+
+    /* Canceled waits do not consume the signal */
+    SetEvent(hEvent);
+    if (WaitForSingleObject(hEvent, 0) != WAIT_OBJECT_0 || DrainPort(2) != 0)
+    {
+        CleanupAndFail("ERROR: a canceled wait consumed the signal of the event", hEvent);
+    }
+
+    CloseHandle(hEvent);
+
+    /* Releasing a semaphore satisfies as many waits as its count was increased by */
+    hSemaphore = CreateSemaphore(NULL, 0, NUM_WAITS, NULL);
+    if (hSemaphore == NULL)
+    {
+        CleanupAndFail("ERROR: CreateSemaphore failed", NULL);
+    }
+
+    for (i = 0; i < NUM_WAITS; i++)
+    {
+        if (!PAL_RegisterWaitOnIoCompletionPort(port, hSemaphore, 3, &registrations[i]))
+        {
+            CleanupAndFail("ERROR: PAL_RegisterWaitOnIoCompletionPort failed", hSemaphore);
+        }
+    }
+
+    /* Handles can be closed while waits are registered on them */
+    CloseHandle(hSemaphore);
+    hSemaphore = NULL;
+
+    for (i = 0; i < NUM_WAITS; i++)
+    {
+        if (!PAL_UnregisterWaitOnIoCompletionPort(registrations[i], &bSatisfied) || bSatisfied)
+        {
+            CleanupAndFail("ERROR: a wait on an unsignaled semaphore was satisfied", NULL);
+        }
+    }
+
+    hSemaphore = CreateSemaphore(NULL, 0, NUM_WAITS, NULL);
+    if (hSemaphore == NULL)
+    {
+        CleanupAndFail("ERROR: CreateSemaphore failed", NULL);
+    }
+
+    for (i = 0; i < NUM_WAITS; i++)
+    {
+        if (!PAL_RegisterWaitOnIoCompletionPort(port, hSemaphore, 4, &registrations[i]))
+        {
+            CleanupAndFail("ERROR: PAL_RegisterWaitOnIoCompletionPort failed", hSemaphore);
+        }
+    }
+
+    if (!ReleaseSemaphore(hSemaphore, 3, NULL) || DrainPort(4) != 3 ||
+        WaitForSingleObject(hSemaphore, 0) != WAIT_TIMEOUT)
+    {
+        CleanupAndFail("ERROR: releasing the semaphore did not satisfy 3 waits", hSemaphore);
+    }
+
+    for (i = 0; i < NUM_WAITS; i++)
+    {
+        if (!PAL_UnregisterWaitOnIoCompletionPort(registrations[i], &bSatisfied))
+        {
+            CleanupAndFail("ERROR: PAL_UnregisterWaitOnIoCompletionPort failed", hSemaphore);
+        }
+    }
+
+    CloseHandle(hSemaphore);
+
+    /* Mutexes are owned by threads, so waits cannot be registered on them */
+    hMutex = CreateMutex(NULL, FALSE, NULL);
+    if (hMutex == NULL)
+    {
+        CleanupAndFail("ERROR: CreateMutex failed", NULL);
+    }
+
+    if (PAL_RegisterWaitOnIoCompletionPort(port, hMutex, 5, &registrations[0]) ||
+        GetLastError() != ERROR_NOT_SUPPORTED)
+    {
+        CleanupAndFail("ERROR: PAL_RegisterWaitOnIoCompletionPort did not reject a mutex", hMutex);
+    }
+
+    CloseHandle(hMutex);
+
+    /* Measure how many waits go through the port per second */
+    hEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (hEvent == NULL)
+    {
+        CleanupAndFail("ERROR: CreateEvent failed", NULL);
+    }
+
+    {
+        DWORD dwStart = GetTickCount();
+        ULONG ulCompleted = 0;
+
+        while (ulCompleted < THROUGHPUT_WAITS)
+        {
+            for (i = 0; i < NUM_WAITS; i++)
+            {
+                if (!PAL_RegisterWaitOnIoCompletionPort(port, hEvent, 6, &registrations[i]))
+                {
+                    CleanupAndFail("ERROR: PAL_RegisterWaitOnIoCompletionPort failed", hEvent);
+                }
+            }
+
+            for (i = 0; i < NUM_WAITS; i++)
+            {
+                SetEvent(hEvent);
+            }
+
+            if (DrainPort(6) != NUM_WAITS)
+            {
+                CleanupAndFail("ERROR: not every registered wait was satisfied", hEvent);
+            }
+
+            for (i = 0; i < NUM_WAITS; i++)
+            {
+                PAL_UnregisterWaitOnIoCompletionPort(registrations[i], &bSatisfied);
+            }
+
+            ulCompleted += NUM_WAITS;
+        }
+
+        DWORD dwElapsed = GetTickCount() - dwStart;
+        Trace("%u registered waits in %u ms (%u waits per second)\n", ulCompleted, dwElapsed,
+              dwElapsed == 0 ? ulCompleted : (ULONG)((ULONGLONG)ulCompleted * 1000 / dwElapsed));
+    }
+
+    CloseHandle(hEvent);
+    PAL_CloseIoCompletionPort(port);
+
+    PAL_Terminate();
+    return PASS;
+}
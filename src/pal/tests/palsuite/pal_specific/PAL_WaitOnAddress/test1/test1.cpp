@@ -0,0 +1,269 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+/*=============================================================
+**
+** Source: test1.cpp
+**
+** Purpose: Positive test for PAL_WaitOnAddress and PAL_WakeByAddress.
+**          Checks that a wait returns right away when the value
+**          differs, times out, is woken up by another thread and,
+**          when alertable, by an APC. Then reports the throughput of
+**          a lock that parks its waiters on its lock word, against
+**          the same lock parking its waiters on an auto reset event,
+**          from 1 to 64 contending threads.
+**
+**
+**============================================================*/
+#include <palsuite.h>
+
+#define TOTAL_ACQUISITIONS  400000
+#define MAX_THREADS         64
+
+static LONG volatile lWaitValue;
+static LONG volatile lApcCount;
+static DWORD dwAlertableResult;
+
+/* Lock word: 0 when free, 1 when held, 2 when held and there may be waiters */
+static LONG volatile lLockState;
+static HANDLE hLockEvent;
+static BOOL bUseEvent;
+static ULONG ulIterations;
+static ULONG ulCounter;
+static HANDLE hStartEvent;
+
+static void AcquireLock()
+{
+    LONG c = InterlockedCompareExchange(&lLockState, 1, 0);
+    if (c == 0)
+    {
+        return;
+    }
+
+    if (c != 2)
+    {
+        c = InterlockedExchange(&lLockState, 2);
+    }
+
+    while (c != 0)
+    {
+        if (bUseEvent)
+        {
+            WaitForSingleObject(hLockEvent, INFINITE);
+        }
+        else
+        {
+            PAL_WaitOnAddress(&lLockState, 2, INFINITE, FALSE);
+        }
+
+        c = InterlockedExchange(&lLockState, 2);
+    }
+}
+
+static void ReleaseLock()
+{
+    if (InterlockedExchange(&lLockState, 0) == 2)
+    {
+        if (bUseEvent)
+        {
+            SetEvent(hLockEvent);
+        }
+        else
+        {
+            PAL_WakeByAddress(&lLockState, FALSE);
+        }
+    }
+}
+
+static DWORD PALAPI ContendingThread(LPVOID lpParameter)
+{
+    ULONG i;
+
+    WaitForSingleObject(hStartEvent, INFINITE);
+
+    for (i = 0; i < ulIterations; i++)
+    {
+        AcquireLock();
+        ulCounter++;
+        ReleaseLock();
+    }
+
+    return 0;
+}
+
+/* Returns the number of acquisitions per second */
+static ULONG RunContention(ULONG numThreads, BOOL useEvent)
+{
+    HANDLE hThreads[MAX_THREADS];
+    DWORD dwStart;
+    DWORD dwElapsed;
+    DWORD dwThreadId;
+    ULONG i;
+
+    bUseEvent = useEvent;
+    ulIterations = TOTAL_ACQUISITIONS / numThreads;
+    ulCounter = 0;
+    lLockState = 0;
+
+    hStartEvent = CreateEvent(NULL, TRUE, FALSE, NULL);
+    if (hStartEvent == NULL)
+    {
+        Fail("ERROR: CreateEvent failed with error %u\n", GetLastError());
+    }
+
+    for (i = 0; i < numThreads; i++)
+    {
+        hThreads[i] = CreateThread(NULL, 0, ContendingThread, NULL, 0, &dwThreadId);
+        if (hThreads[i] == NULL)
+        {
+            Fail("ERROR: CreateThread failed with error %u\n", GetLastError());
+        }
+    }
+
+    dwStart = GetTickCount();
+    SetEvent(hStartEvent);
+
+    for (i = 0; i < numThreads; i++)
+    {
+        WaitForSingleObject(hThreads[i], INFINITE);
+        CloseHandle(hThreads[i]);
+    }
+
+    dwElapsed = GetTickCount() - dwStart;
+    CloseHandle(hStartEvent);
+
+    if (ulCounter != ulIterations * numThreads)
+    {
+        Fail("ERROR: the lock let %u acquisitions through instead of %u\n",
+             ulCounter, ulIterations * numThreads);
+    }
+
+    return dwElapsed == 0 ? ulCounter : (ULONG)((ULONGLONG)ulCounter * 1000 / dwElapsed);
+}
+
+static DWORD PALAPI WakingThread(LPVOID lpParameter)
+{
+    Sleep(100);
+    InterlockedExchange(&lWaitValue, 1);
+    PAL_WakeByAddress(&lWaitValue, TRUE);
+    return 0;
+}
+
+static DWORD PALAPI AlertableThread(LPVOID lpParameter)
+{
+    dwAlertableResult = PAL_WaitOnAddress(&lWaitValue, 0, 5000, TRUE);
+    return 0;
+}
+
+static VOID PALAPI ApcFunc(ULONG_PTR dwParam)
+{
+    InterlockedIncrement(&lApcCount);
+}
+
+int __cdecl main(int argc, char *argv[])
+{
+    HANDLE hThread;
+    DWORD dwThreadId;
+    DWORD dwRet;
+    DWORD dwStart;
+    ULONG numThreads;
+
+    /* Initialize the PAL environment */
+    if (0 != PAL_Initialize(argc, argv))
+    {
+        return FAIL;
+    }
+
+    /* A wait returns right away when the value differs */
+    lWaitValue = 1;
+    dwRet = PAL_WaitOnAddress(&lWaitValue, 0, INFINITE, FALSE);
+    if (dwRet == WAIT_FAILED && GetLastError() == ERROR_NOT_SUPPORTED)
+    {
+        /* The platform has no futexes; there is nothing to test */
+        PAL_Terminate();
+        return PASS;
+    }
+
+    if (dwRet != WAIT_OBJECT_0)
+    {
+        Fail("ERROR: a wait on a differing value returned %u instead of WAIT_OBJECT_0\n", dwRet);
+    }
+
+    /* A wait times out when nobody wakes it up */
+    lWaitValue = 0;
+    dwStart = GetTickCount();
+    dwRet = PAL_WaitOnAddress(&lWaitValue, 0, 200, FALSE);
+    if (dwRet != WAIT_TIMEOUT)
+    {
+        Fail("ERROR: a wait that nobody woke up returned %u instead of WAIT_TIMEOUT\n", dwRet);
+    }
+
+    if (GetTickCount() - dwStart < 150)
+    {
+        Fail("ERROR: a wait timed out after %u ms instead of 200 ms\n", GetTickCount() - dwStart);
+    }
+
+    /* Another thread wakes the wait up after changing the value; wakeups may be spurious, so loop */
+    hThread = CreateThread(NULL, 0, WakingThread, NULL, 0, &dwThreadId);
+    if (hThread == NULL)
+    {
+        Fail("ERROR: CreateThread failed with error %u\n", GetLastError());
+    }
+
+    while (lWaitValue == 0)
+    {
+        dwRet = PAL_WaitOnAddress(&lWaitValue, 0, 5000, FALSE);
+        if (dwRet != WAIT_OBJECT_0)
+        {
+            Fail("ERROR: a wait that another thread woke up returned %u instead of WAIT_OBJECT_0\n", dwRet);
+        }
+    }
+
+    WaitForSingleObject(hThread, INFINITE);
+    CloseHandle(hThread);
+
+    /* An APC queued to a thread in an alertable wait runs and ends the wait */
+    lWaitValue = 0;
+    hThread = CreateThread(NULL, 0, AlertableThread, NULL, 0, &dwThreadId);
+    if (hThread == NULL)
+    {
+        Fail("ERROR: CreateThread failed with error %u\n", GetLastError());
+    }
+
+    Sleep(100);
+    if (QueueUserAPC(ApcFunc, hThread, 0) == 0)
+    {
+        Fail("ERROR: QueueUserAPC failed with error %u\n", GetLastError());
+    }
+
+    WaitForSingleObject(hThread, INFINITE);
+    CloseHandle(hThread);
+
+    if (dwAlertableResult != WAIT_IO_COMPLETION || lApcCount != 1)
+    {
+        Fail("ERROR: an alertable wait returned %u with %d APCs run instead of WAIT_IO_COMPLETION with 1\n",
+             dwAlertableResult, lApcCount);
+    }
+
+    /* Compare parking waiters on the lock word with parking them on an event */
+    hLockEvent = CreateEvent(NULL, FALSE, FALSE, NULL);
+    if (hLockEvent == NULL)
+    {
+        Fail("ERROR: CreateEvent failed with error %u\n", GetLastError());
+    }
+
+    for (numThreads = 1; numThreads <= MAX_THREADS; numThreads *= 2)
+    {
+        ULONG ulAddressRate = RunContention(numThreads, FALSE);
+        ULONG ulEventRate = RunContention(numThreads, TRUE);
+
+        Trace("%2u threads: %u acquisitions per second parking on the address, %u parking on an event\n",
+              numThreads, ulAddressRate, ulEventRate);
+    }
+
+    CloseHandle(hLockEvent);
+
+    PAL_Terminate();
+    return PASS;
+}
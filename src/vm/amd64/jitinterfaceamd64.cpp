@@ -42,6 +42,25 @@ EXTERN_C void JIT_WriteBarrier_PostGrow64_Patch_Label_CardBundleTable();
 #endif
 EXTERN_C void JIT_WriteBarrier_PostGrow64_End();
 
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+EXTERN_C void JIT_WriteBarrier_Precise_PreGrow64(Object **dst, Object *ref);
+EXTERN_C void JIT_WriteBarrier_Precise_PreGrow64_Patch_Label_Lower();
+EXTERN_C void JIT_WriteBarrier_Precise_PreGrow64_Patch_Label_CardTable();
+#ifdef FEATURE_MANUALLY_MANAGED_CARD_BUNDLES
+EXTERN_C void JIT_WriteBarrier_Precise_PreGrow64_Patch_Label_CardBundleTable();
+#endif
+EXTERN_C void JIT_WriteBarrier_Precise_PreGrow64_End();
+
+EXTERN_C void JIT_WriteBarrier_Precise_PostGrow64(Object **dst, Object *ref);
+EXTERN_C void JIT_WriteBarrier_Precise_PostGrow64_Patch_Label_Lower();
+EXTERN_C void JIT_WriteBarrier_Precise_PostGrow64_Patch_Label_Upper();
+EXTERN_C void JIT_WriteBarrier_Precise_PostGrow64_Patch_Label_CardTable();
+#ifdef FEATURE_MANUALLY_MANAGED_CARD_BUNDLES
+EXTERN_C void JIT_WriteBarrier_Precise_PostGrow64_Patch_Label_CardBundleTable();
+#endif
+EXTERN_C void JIT_WriteBarrier_Precise_PostGrow64_End();
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
+
 #ifdef FEATURE_SVR_GC
 EXTERN_C void JIT_WriteBarrier_SVR64(Object **dst, Object *ref);
 EXTERN_C void JIT_WriteBarrier_SVR64_PatchLabel_CardTable();
@@ -91,6 +110,9 @@ WriteBarrierManager g_WriteBarrierManager;
 
 WriteBarrierManager::WriteBarrierManager() : 
     m_currentWriteBarrier(WRITE_BARRIER_UNINITIALIZED)
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+    , m_usePreciseCardMarking(false)
+#endif
 {
     LIMITED_METHOD_CONTRACT;
 }
@@ -143,6 +165,30 @@ void WriteBarrierManager::Validate()
     _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pCardBundleTableImmediate) & 0x7) == 0);
 #endif
 
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+    pLowerBoundImmediate      = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PreGrow64, Patch_Label_Lower, 2);
+    pCardTableImmediate       = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PreGrow64, Patch_Label_CardTable, 2);
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pLowerBoundImmediate) & 0x7) == 0);
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pCardTableImmediate) & 0x7) == 0);
+
+#ifdef FEATURE_MANUALLY_MANAGED_CARD_BUNDLES
+    pCardBundleTableImmediate = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PreGrow64, Patch_Label_CardBundleTable, 2);
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pCardBundleTableImmediate) & 0x7) == 0);
+#endif
+
+    pLowerBoundImmediate      = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_Lower, 2);
+    pUpperBoundImmediate      = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_Upper, 2);
+    pCardTableImmediate       = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_CardTable, 2);
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pLowerBoundImmediate) & 0x7) == 0);
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pUpperBoundImmediate) & 0x7) == 0);
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pCardTableImmediate) & 0x7) == 0);
+
+#ifdef FEATURE_MANUALLY_MANAGED_CARD_BUNDLES
+    pCardBundleTableImmediate = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_CardBundleTable, 2);
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pCardBundleTableImmediate) & 0x7) == 0);
+#endif
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
+
 #ifdef FEATURE_SVR_GC
     pCardTableImmediate        = CALC_PATCH_LOCATION(JIT_WriteBarrier_SVR64, PatchLabel_CardTable, 2);
     _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", (reinterpret_cast<UINT64>(pCardTableImmediate) & 0x7) == 0);
@@ -211,6 +257,12 @@ PCODE WriteBarrierManager::GetCurrentWriteBarrierCode()
             return GetEEFuncEntryPoint(JIT_WriteBarrier_PreGrow64);
         case WRITE_BARRIER_POSTGROW64:
             return GetEEFuncEntryPoint(JIT_WriteBarrier_PostGrow64);
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_PREGROW64:
+            return GetEEFuncEntryPoint(JIT_WriteBarrier_Precise_PreGrow64);
+        case WRITE_BARRIER_PRECISE_POSTGROW64:
+            return GetEEFuncEntryPoint(JIT_WriteBarrier_Precise_PostGrow64);
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 #ifdef FEATURE_SVR_GC
         case WRITE_BARRIER_SVR64:
             return GetEEFuncEntryPoint(JIT_WriteBarrier_SVR64);
@@ -243,6 +295,12 @@ size_t WriteBarrierManager::GetSpecificWriteBarrierSize(WriteBarrierType writeBa
             return MARKED_FUNCTION_SIZE(JIT_WriteBarrier_PreGrow64);
         case WRITE_BARRIER_POSTGROW64:
             return MARKED_FUNCTION_SIZE(JIT_WriteBarrier_PostGrow64);
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_PREGROW64:
+            return MARKED_FUNCTION_SIZE(JIT_WriteBarrier_Precise_PreGrow64);
+        case WRITE_BARRIER_PRECISE_POSTGROW64:
+            return MARKED_FUNCTION_SIZE(JIT_WriteBarrier_Precise_PostGrow64);
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 #ifdef FEATURE_SVR_GC
         case WRITE_BARRIER_SVR64:
             return MARKED_FUNCTION_SIZE(JIT_WriteBarrier_SVR64);
@@ -331,6 +389,42 @@ void WriteBarrierManager::ChangeWriteBarrierTo(WriteBarrierType newWriteBarrier,
             break;
         }
 
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_PREGROW64:
+        {
+            m_pLowerBoundImmediate      = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PreGrow64, Patch_Label_Lower, 2);
+            m_pCardTableImmediate       = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PreGrow64, Patch_Label_CardTable, 2);
+
+            // Make sure that we will be bashing the right places (immediates should be hardcoded to 0x0f0f0f0f0f0f0f0f0).
+            _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", 0xf0f0f0f0f0f0f0f0 == *(UINT64*)m_pLowerBoundImmediate);
+            _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", 0xf0f0f0f0f0f0f0f0 == *(UINT64*)m_pCardTableImmediate);
+
+#ifdef FEATURE_MANUALLY_MANAGED_CARD_BUNDLES
+            m_pCardBundleTableImmediate = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PreGrow64, Patch_Label_CardBundleTable, 2);
+            _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", 0xf0f0f0f0f0f0f0f0 == *(UINT64*)m_pCardBundleTableImmediate);
+#endif
+            break;
+        }
+
+        case WRITE_BARRIER_PRECISE_POSTGROW64:
+        {
+            m_pLowerBoundImmediate      = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_Lower, 2);
+            m_pUpperBoundImmediate      = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_Upper, 2);
+            m_pCardTableImmediate       = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_CardTable, 2);
+
+            // Make sure that we will be bashing the right places (immediates should be hardcoded to 0x0f0f0f0f0f0f0f0f0).
+            _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", 0xf0f0f0f0f0f0f0f0 == *(UINT64*)m_pLowerBoundImmediate);
+            _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", 0xf0f0f0f0f0f0f0f0 == *(UINT64*)m_pCardTableImmediate);
+            _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", 0xf0f0f0f0f0f0f0f0 == *(UINT64*)m_pUpperBoundImmediate);
+
+#ifdef FEATURE_MANUALLY_MANAGED_CARD_BUNDLES
+            m_pCardBundleTableImmediate = CALC_PATCH_LOCATION(JIT_WriteBarrier_Precise_PostGrow64, Patch_Label_CardBundleTable, 2);
+            _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", 0xf0f0f0f0f0f0f0f0 == *(UINT64*)m_pCardBundleTableImmediate);
+#endif
+            break;
+        }
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
+
 #ifdef FEATURE_SVR_GC
         case WRITE_BARRIER_SVR64:
         {
@@ -437,6 +531,10 @@ void WriteBarrierManager::Initialize()
 
     _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", cbWriteBarrierBuffer >= GetSpecificWriteBarrierSize(WRITE_BARRIER_PREGROW64));
     _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", cbWriteBarrierBuffer >= GetSpecificWriteBarrierSize(WRITE_BARRIER_POSTGROW64));
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", cbWriteBarrierBuffer >= GetSpecificWriteBarrierSize(WRITE_BARRIER_PRECISE_PREGROW64));
+    _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", cbWriteBarrierBuffer >= GetSpecificWriteBarrierSize(WRITE_BARRIER_PRECISE_POSTGROW64));
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 #ifdef FEATURE_SVR_GC
     _ASSERTE_ALL_BUILDS("clr/src/VM/AMD64/JITinterfaceAMD64.cpp", cbWriteBarrierBuffer >= GetSpecificWriteBarrierSize(WRITE_BARRIER_SVR64));
 #endif // FEATURE_SVR_GC
@@ -451,6 +549,10 @@ void WriteBarrierManager::Initialize()
 #if !defined(CODECOVERAGE)
     Validate();
 #endif
+
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+    m_usePreciseCardMarking = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_GCPreciseCardMarking) != 0;
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 }
 
 bool WriteBarrierManager::NeedDifferentWriteBarrier(bool bReqUpperBoundsCheck, WriteBarrierType* pNewWriteBarrierType)
@@ -477,6 +579,12 @@ bool WriteBarrierManager::NeedDifferentWriteBarrier(bool bReqUpperBoundsCheck, W
 #endif
 
             writeBarrierType = GCHeapUtilities::IsServerHeap() ? WRITE_BARRIER_SVR64 : WRITE_BARRIER_PREGROW64;
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+            if (m_usePreciseCardMarking && (writeBarrierType == WRITE_BARRIER_PREGROW64))
+            {
+                writeBarrierType = WRITE_BARRIER_PRECISE_PREGROW64;
+            }
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
             continue;
 
         case WRITE_BARRIER_PREGROW64:
@@ -489,6 +597,18 @@ bool WriteBarrierManager::NeedDifferentWriteBarrier(bool bReqUpperBoundsCheck, W
         case WRITE_BARRIER_POSTGROW64:
             break;
 
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_PREGROW64:
+            if (bReqUpperBoundsCheck)
+            {
+                writeBarrierType = WRITE_BARRIER_PRECISE_POSTGROW64;
+            }
+            break;
+
+        case WRITE_BARRIER_PRECISE_POSTGROW64:
+            break;
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
+
 #ifdef FEATURE_SVR_GC
         case WRITE_BARRIER_SVR64:
             break;
@@ -541,6 +661,9 @@ void WriteBarrierManager::UpdateEphemeralBounds(bool isRuntimeSuspended)
     switch (m_currentWriteBarrier)
     {
         case WRITE_BARRIER_POSTGROW64:
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_POSTGROW64:
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 #ifdef FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
         case WRITE_BARRIER_WRITE_WATCH_POSTGROW64:
 #endif // FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
@@ -556,6 +679,9 @@ void WriteBarrierManager::UpdateEphemeralBounds(bool isRuntimeSuspended)
         // INTENTIONAL FALL-THROUGH!
         //
         case WRITE_BARRIER_PREGROW64:
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_PREGROW64:
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 #ifdef FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
         case WRITE_BARRIER_WRITE_WATCH_PREGROW64:
 #endif // FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP
@@ -660,10 +786,16 @@ void WriteBarrierManager::SwitchToWriteWatchBarrier(bool isRuntimeSuspended)
             return;
 
         case WRITE_BARRIER_PREGROW64:
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_PREGROW64:
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
             newWriteBarrierType = WRITE_BARRIER_WRITE_WATCH_PREGROW64;
             break;
 
         case WRITE_BARRIER_POSTGROW64:
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        case WRITE_BARRIER_PRECISE_POSTGROW64:
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
             newWriteBarrierType = WRITE_BARRIER_WRITE_WATCH_POSTGROW64;
             break;
 
@@ -691,10 +823,22 @@ void WriteBarrierManager::SwitchToNonWriteWatchBarrier(bool isRuntimeSuspended)
 
         case WRITE_BARRIER_WRITE_WATCH_PREGROW64:
             newWriteBarrierType = WRITE_BARRIER_PREGROW64;
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+            if (m_usePreciseCardMarking)
+            {
+                newWriteBarrierType = WRITE_BARRIER_PRECISE_PREGROW64;
+            }
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
             break;
 
         case WRITE_BARRIER_WRITE_WATCH_POSTGROW64:
             newWriteBarrierType = WRITE_BARRIER_POSTGROW64;
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+            if (m_usePreciseCardMarking)
+            {
+                newWriteBarrierType = WRITE_BARRIER_PRECISE_POSTGROW64;
+            }
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
             break;
 
 #ifdef FEATURE_SVR_GC
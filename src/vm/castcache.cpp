@@ -0,0 +1,116 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+// ===========================================================================
+// File: CastCache.cpp
+//
+// ===========================================================================
+
+
+
+#include "common.h"
+#include "castcache.h"
+
+#ifndef DACCESS_COMPILE
+
+CastCache::Entry CastCache::s_entries[1 << CAST_CACHE_SIZE_LOG2];
+
+// static
+BOOL CastCache::IsCacheable(MethodTable * pSourceMT, TypeHandle targetType)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        SO_TOLERANT;
+    }
+    CONTRACTL_END;
+
+    // Arrays and other TypeDescs are rare cast targets; leaving them out means every cached
+    // target is a MethodTable whose collectibility is cheap to check.
+    if (targetType.IsTypeDesc())
+        return FALSE;
+
+    if (pSourceMT->Collectible() || targetType.AsMethodTable()->Collectible())
+        return FALSE;
+
+    // The result of these casts depends on the object instance rather than just its type
+    if (pSourceMT->IsTransparentProxy() || pSourceMT->IsComObjectType() || pSourceMT->IsICastable())
+        return FALSE;
+
+    return TRUE;
+}
+
+// static
+TypeHandle::CastResult CastCache::TryGet(MethodTable * pSourceMT, TypeHandle targetType)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        SO_TOLERANT;
+    }
+    CONTRACTL_END;
+
+    TADDR source = dac_cast<TADDR>(pSourceMT);
+    TADDR target = targetType.AsTAddr();
+    Entry * pEntry = &s_entries[GetBucket(source, target)];
+
+    DWORD version = VolatileLoad(&pEntry->version);
+    if ((version & 1) != 0)
+    {
+        // An update is in progress
+        return TypeHandle::MaybeCast;
+    }
+
+    // These loads must not be reordered with the version loads around them
+    TADDR  entrySource = VolatileLoad(&pEntry->source);
+    TADDR  entryTarget = VolatileLoad(&pEntry->target);
+    DWORD  result      = VolatileLoad(&pEntry->result);
+
+    if ((entrySource != source) || (entryTarget != target) || (VolatileLoad(&pEntry->version) != version))
+    {
+        return TypeHandle::MaybeCast;
+    }
+
+    return (TypeHandle::CastResult)result;
+}
+
+// static
+void CastCache::TryAdd(MethodTable * pSourceMT, TypeHandle targetType, TypeHandle::CastResult result)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        SO_TOLERANT;
+    }
+    CONTRACTL_END;
+
+    if ((result == TypeHandle::MaybeCast) || !IsCacheable(pSourceMT, targetType))
+        return;
+
+    TADDR source = dac_cast<TADDR>(pSourceMT);
+    TADDR target = targetType.AsTAddr();
+    Entry * pEntry = &s_entries[GetBucket(source, target)];
+
+    DWORD version = VolatileLoad(&pEntry->version);
+    if ((version & 1) != 0)
+        return;
+
+    // Claim the entry. If another thread got there first, its result is as good as ours.
+    if (FastInterlockCompareExchange((LONG *)&pEntry->version, (LONG)(version + 1), (LONG)version) != (LONG)version)
+        return;
+
+    VolatileStore(&pEntry->source, source);
+    VolatileStore(&pEntry->target, target);
+    VolatileStore(&pEntry->result, (DWORD)result);
+
+    // Publish the entry
+    VolatileStore(&pEntry->version, version + 2);
+}
+
+#endif // !DACCESS_COMPILE
@@ -0,0 +1,65 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+// ===========================================================================
+// File: CastCache.h
+//
+// ===========================================================================
+
+
+#ifndef CAST_CACHE_H
+#define CAST_CACHE_H
+
+#ifndef DACCESS_COMPILE
+
+// Number of entries in the cast cache, as a power of two
+#define CAST_CACHE_SIZE_LOG2 12
+
+// A global, fixed size cache of cast results keyed by (source MethodTable, target TypeHandle),
+// consulted by the casting helpers before they walk the type hierarchy or the interface map,
+// and before they take the framed slow path for variant generic casts.
+//
+// The cache is lock free: each entry carries a version that is odd while the entry is being
+// written. Readers discard an entry whose version is odd or changed while it was read, and
+// writers give up rather than wait if another writer holds the entry. Entries are simply
+// overwritten on collision.
+//
+// Only results that depend on nothing but the two types are cached, so casts involving COM
+// objects, ICastable and transparent proxies are never cached. Neither are casts involving
+// collectible types, whose MethodTables may be freed and their addresses reused.
+class CastCache
+{
+public:
+    // Returns CanCast or CannotCast if the result of casting an instance of pSourceMT to
+    // targetType is cached, and MaybeCast otherwise.
+    static TypeHandle::CastResult TryGet(MethodTable * pSourceMT, TypeHandle targetType);
+
+    // Records the result of casting an instance of pSourceMT to targetType, if it may be cached.
+    static void TryAdd(MethodTable * pSourceMT, TypeHandle targetType, TypeHandle::CastResult result);
+
+private:
+    struct Entry
+    {
+        DWORD   version;
+        DWORD   result;
+        TADDR   source;
+        TADDR   target;
+    };
+
+    static DWORD GetBucket(TADDR source, TADDR target)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        // Fibonacci hashing of both keys; MethodTables are at least pointer aligned.
+        DWORD hash = (DWORD)((source >> 3) ^ (target >> 1) ^ (target >> 13));
+        return (hash * 2654435769u) >> (32 - CAST_CACHE_SIZE_LOG2);
+    }
+
+    static BOOL IsCacheable(MethodTable * pSourceMT, TypeHandle targetType);
+
+    static Entry s_entries[1 << CAST_CACHE_SIZE_LOG2];
+};
+
+#endif // !DACCESS_COMPILE
+
+#endif // CAST_CACHE_H
@@ -128,6 +128,8 @@
 #include "ceemain.h"
 #include "dllimport.h"
 #include "syncblk.h"
+#include "lockcontention.h"
+#include "readerbiasedrwlock.hpp"
 #include "eeconfig.h"
 #include "stublink.h"
 #include "method.hpp"
@@ -789,8 +791,11 @@ void EEStartupHelper(COINITIEE fFlags)
         // Monitors, Crsts, and SimpleRWLocks all use the same spin heuristics
         // Cache the (potentially user-overridden) values now so they are accessible from asm routines
         InitializeSpinConstants();
+        ReaderBiasedRWLock::Initialize();
 
 #ifndef CROSSGEN_COMPILE
+        AwareLock::Initialize();
+        LockContentionProfiler::Initialize();
 
 
 #ifdef FEATURE_PREJIT
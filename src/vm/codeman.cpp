@@ -626,6 +626,11 @@ BOOL EEJitManager::CodeHeapIterator::Next()
         {
             BYTE * code = m_Iterator.GetMethodCode();
             CodeHeader * pHdr = (CodeHeader *)(code - sizeof(CodeHeader));
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+            // Split methods are reported once, for their hot code
+            if (!pHdr->IsStubCodeBlock() && pHdr->IsColdCode())
+                continue;
+#endif
             m_pCurrent = !pHdr->IsStubCodeBlock() ? pHdr->GetMethodDesc() : NULL;
             if (m_pDomain && m_pCurrent)
             {
@@ -2068,6 +2073,7 @@ HeapList* LoaderCodeHeap::CreateCodeHeap(CodeHeapRequestInfo *pInfo, LoaderHeap
 
     pHp->bFull           = fAllocatedFromEmergencyJumpStubReserve;
     pHp->bFullForJumpStubs = false;
+    pHp->bColdCode       = pInfo->IsColdCode();
 
     pHp->cBlocks         = 0;
 
@@ -2121,6 +2127,7 @@ void CodeHeapRequestInfo::Init()
         m_pAllocator = m_pMD->GetLoaderAllocatorForCode();
     m_isDynamicDomain = (m_pMD != NULL) ? m_pMD->IsLCGMethod() : false;
     m_isCollectible = m_pAllocator->IsCollectible() ? true : false;
+    m_isColdCode = false;
 }
 
 #ifdef WIN64EXCEPTIONS
@@ -2189,7 +2196,7 @@ HeapList* EEJitManager::NewCodeHeap(CodeHeapRequestInfo *pInfo, DomainCodeHeapLi
     size_t minReserveSize = VIRTUAL_ALLOC_RESERVE_GRANULARITY; //     ( 64 KB)
 
 #ifdef _WIN64
-    if (pInfo->m_hiAddr == 0)
+    if ((pInfo->m_hiAddr == 0) || pInfo->IsColdCode())
     {
         if (pADHeapList->m_CodeHeapList.Count() > CODE_HEAP_SIZE_INCREASE_THRESHOLD)
         {
@@ -2320,6 +2327,11 @@ void* EEJitManager::allocCodeRaw(CodeHeapRequestInfo *pInfo,
             pCodeHeap = (HeapList *)pInfo->m_pAllocator->m_pLastUsedDynamicCodeHeap;
             pInfo->m_pAllocator->m_pLastUsedDynamicCodeHeap = NULL;
         }
+        else if (pInfo->IsColdCode())
+        {
+            // Cold code heaps are never cached, so that hot code keeps being packed together
+            pCodeHeap = NULL;
+        }
         else
         {
             pCodeHeap = (HeapList *)pInfo->m_pAllocator->m_pLastUsedCodeHeap;
@@ -2412,7 +2424,7 @@ void* EEJitManager::allocCodeRaw(CodeHeapRequestInfo *pInfo,
     {
         pInfo->m_pAllocator->m_pLastUsedDynamicCodeHeap = pCodeHeap;
     }
-    else
+    else if (!pInfo->IsColdCode())
     {
         pInfo->m_pAllocator->m_pLastUsedCodeHeap = pCodeHeap;
     }
@@ -2545,6 +2557,9 @@ CodeHeader* EEJitManager::allocCode(MethodDesc* pMD, size_t blockSize, CorJitAll
         pCodeHdr->SetEHInfo(NULL);
         pCodeHdr->SetGCInfo(NULL);
         pCodeHdr->SetMethodDesc(pMD);
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+        pCodeHdr->SetColdCode(NULL, 0, NULL);
+#endif
 #ifdef WIN64EXCEPTIONS
         pCodeHdr->SetNumberOfUnwindInfos(nUnwindInfos);
         *pModuleBase = (TADDR)pCodeHeap;
@@ -2556,6 +2571,57 @@ CodeHeader* EEJitManager::allocCode(MethodDesc* pMD, size_t blockSize, CorJitAll
     RETURN(pCodeHdr);
 }
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+// Allocates the cold part of a method whose hot part was allocated by allocCode. The cold code
+// goes to a code heap of its own, preceded by a CodeHeader that shares the RealCodeHeader of the
+// hot code so that it can be mapped back to the method.
+TADDR EEJitManager::allocColdCode(CodeHeader* pCodeHeader, size_t hotCodeSize, size_t coldCodeSize, TADDR moduleBase)
+{
+    CONTRACT(TADDR) {
+        THROWS;
+        GC_NOTRIGGER;
+        POSTCONDITION(RETVAL != NULL);
+    } CONTRACT_END;
+
+    MethodDesc * pMD = pCodeHeader->GetMethodDesc();
+
+    // Dynamic methods are allocated and freed as a single block
+    _ASSERTE(!pMD->IsLCGMethod());
+
+    // The hot and cold code reach each other with rel32 jumps, and the unwind info of the cold
+    // code is relative to the code heap of the hot code, so keep the cold code within 2GB of it.
+    BYTE * loAddr = (BYTE *)moduleBase;
+    BYTE * hiAddr = loAddr + 0x7FFF0000;
+
+    CodeHeapRequestInfo requestInfo(pMD, pMD->GetLoaderAllocatorForCode(), loAddr, hiAddr);
+    requestInfo.SetColdCode();
+
+    TADDR pCode;
+
+    // Scope the lock
+    {
+        CrstHolder ch(&m_CodeHeapCritSec);
+
+        HeapList *pCodeHeap = NULL;
+
+        pCode = (TADDR) allocCodeRaw(&requestInfo, sizeof(CodeHeader), coldCodeSize, CODE_SIZE_ALIGN, &pCodeHeap);
+
+        _ASSERTE(pCodeHeap);
+        _ASSERTE(pCode >= moduleBase);
+
+        CodeHeader * pColdCodeHdr = ((CodeHeader *)pCode) - 1;
+        pColdCodeHdr->SetRealCodeHeader((BYTE*)pCodeHeader->pRealCodeHeader);
+
+        // Initialize the headers *BEFORE* publishing the cold code via the nibble map
+        pCodeHeader->SetColdCode(pCodeHeader->GetCodeStartAddress(), (DWORD)hotCodeSize, pCode);
+
+        NibbleMapSet(pCodeHeap, pCode, TRUE);
+    }
+
+    RETURN(pCode);
+}
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
+
 EEJitManager::DomainCodeHeapList *EEJitManager::GetCodeHeapList(CodeHeapRequestInfo *pInfo, LoaderAllocator *pAllocator, BOOL fDynamicOnly)
 {
     CONTRACTL {
@@ -2650,6 +2716,10 @@ bool EEJitManager::CanUseCodeHeap(CodeHeapRequestInfo *pInfo, HeapList *pCodeHea
 
     bool retVal = false;
 
+    // Cold code and everything else never share a code heap
+    if (pCodeHeap->bColdCode != pInfo->IsColdCode())
+        return false;
+
     if ((pInfo->m_loAddr == 0) && (pInfo->m_hiAddr == 0))
     {
         if (!pCodeHeap->IsHeapFull())
@@ -3146,6 +3216,25 @@ void EEJitManager::RemoveJitData (CodeHeader * pCHdr, size_t GCinfo_len, size_t
             return;
 
         NibbleMapSet(pHp, (TADDR)(pCHdr + 1), FALSE);
+
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+        TADDR pColdCode = pCHdr->GetColdCode();
+        if (pColdCode != NULL)
+        {
+            pHp = GetCodeHeapList();
+
+            while (pHp && ((pHp->startAddress > pColdCode) ||
+                            (pHp->endAddress < pColdCode)))
+            {
+                pHp = pHp->GetNext();
+            }
+
+            _ASSERTE(pHp && pHp->bColdCode);
+
+            if (pHp != NULL)
+                NibbleMapSet(pHp, pColdCode, FALSE);
+        }
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
     }
 
     // Backout the GCInfo  
@@ -3582,6 +3671,14 @@ PCODE EEJitManager::GetCodeAddressForRelOffset(const METHODTOKEN& MethodToken, D
     WRAPPER_NO_CONTRACT;
 
     CodeHeader * pHeader = GetCodeHeader(MethodToken);
+
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    if ((pHeader->GetColdCode() != NULL) && (relOffset >= pHeader->GetHotCodeSize()))
+    {
+        return pHeader->GetColdCode() + (relOffset - pHeader->GetHotCodeSize());
+    }
+#endif
+
     return pHeader->GetCodeStartAddress() + relOffset;
 }
 
@@ -3612,12 +3709,29 @@ BOOL EEJitManager::JitCodeToMethodInfo(
 
     if (pCodeInfo)
     {
-        pCodeInfo->m_methodToken = METHODTOKEN(pRangeSection, dac_cast<TADDR>(pCHdr));
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+        if (pCHdr->IsColdCode())
+        {
+            // Describe cold code in terms of the hot code, whose header is the method token. The cold
+            // code offsets start right after the hot code.
+            TADDR hotCode = pCHdr->GetHotCode();
 
-        // This can be counted on for Jitted code. For NGEN code in the case
-        // where we have hot/cold splitting this isn't valid and we need to
-        // take into account cold code.
-        pCodeInfo->m_relOffset = (DWORD)(PCODEToPINSTR(currentPC) - pCHdr->GetCodeStartAddress());
+            RangeSection * pHotRangeSection = ExecutionManager::FindCodeRange(hotCode, ExecutionManager::GetScanFlags());
+            _ASSERTE(pHotRangeSection != NULL);
+
+            pCodeInfo->m_methodToken = METHODTOKEN(pHotRangeSection, hotCode - sizeof(CodeHeader));
+            pCodeInfo->m_relOffset = pCHdr->GetHotCodeSize() + (DWORD)(PCODEToPINSTR(currentPC) - start);
+        }
+        else
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
+        {
+            pCodeInfo->m_methodToken = METHODTOKEN(pRangeSection, dac_cast<TADDR>(pCHdr));
+
+            // This can be counted on for Jitted code that is not split. For NGEN code in the case
+            // where we have hot/cold splitting this isn't valid and we need to
+            // take into account cold code.
+            pCodeInfo->m_relOffset = (DWORD)(PCODEToPINSTR(currentPC) - pCHdr->GetCodeStartAddress());
+        }
 
 #ifdef WIN64EXCEPTIONS
         // Computed lazily by code:EEJitManager::LazyGetFunctionEntry
@@ -3814,6 +3928,13 @@ PTR_RUNTIME_FUNCTION EEJitManager::LazyGetFunctionEntry(EECodeInfo * pCodeInfo)
     // Thus, save it off right now.
     TADDR baseAddress = pCodeInfo->GetModuleBase();
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    if ((pHeader->GetColdCode() != NULL) && (pCodeInfo->GetRelOffset() >= pHeader->GetHotCodeSize()))
+    {
+        address = (DWORD)(pHeader->GetColdCode() - baseAddress) + (pCodeInfo->GetRelOffset() - pHeader->GetHotCodeSize());
+    }
+#endif
+
     // NOTE: We could binary search here, if it would be helpful (e.g., large number of funclets)
     for (UINT iUnwindInfo = 0; iUnwindInfo < pHeader->GetNumberOfUnwindInfos(); iUnwindInfo++)
     {
@@ -3821,6 +3942,13 @@ PTR_RUNTIME_FUNCTION EEJitManager::LazyGetFunctionEntry(EECodeInfo * pCodeInfo)
 
         if (RUNTIME_FUNCTION__BeginAddress(pFunctionEntry) <= address && address < RUNTIME_FUNCTION__EndAddress(pFunctionEntry, baseAddress))
         {
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+            // Cold code is chained to the main body
+            if ((pFunctionEntry->UnwindData & RUNTIME_FUNCTION_INDIRECT) != 0)
+            {
+                pFunctionEntry = PTR_RUNTIME_FUNCTION(baseAddress + (pFunctionEntry->UnwindData & ~RUNTIME_FUNCTION_INDIRECT));
+            }
+#endif
             return pFunctionEntry;
         }
     }
@@ -3849,6 +3977,12 @@ DWORD EEJitManager::GetFuncletStartOffsets(const METHODTOKEN& MethodToken, DWORD
     {
         PTR_RUNTIME_FUNCTION pFunctionEntry = pCH->GetUnwindInfo(iUnwindInfo);
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+        // Skip the cold part of the method body
+        if ((pFunctionEntry->UnwindData & RUNTIME_FUNCTION_INDIRECT) != 0)
+            continue;
+#endif
+
 #if defined(EXCEPTION_DATA_SUPPORTS_FUNCTION_FRAGMENTS)
         if (IsFunctionFragment(moduleBase, pFunctionEntry))
         {
@@ -73,6 +73,14 @@ Abstract:
 #error "WIN64EXCEPTIONS requires USE_INDIRECT_CODEHEADER"
 #endif // WIN64EXCEPTIONS && !USE_INDIRECT_CODEHEADER
 
+#if defined(_TARGET_AMD64_) && defined(FEATURE_PAL) && !defined(CROSSGEN_COMPILE)
+// Jitted code may be split into a hot and a cold part that live in different code heaps. The
+// cold part has its own CodeHeader that shares the RealCodeHeader of the hot part. This relies
+// on the runtime rather than the OS looking up the unwind info of managed code, as the unwind
+// info of the cold part is relative to the code heap of the hot part.
+#define FEATURE_JIT_HOT_COLD_SPLITTING
+#endif
+
 class MethodDesc;
 class ICorJitCompiler;
 class IJitManager;
@@ -148,6 +156,14 @@ public:
 
     PTR_MethodDesc      phdrMDesc;
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    // Set only if the code was split into a hot and a cold part. The offsets of the cold code
+    // (e.g. in the GC info) start right after the hot code.
+    TADDR               phdrHotCode;
+    TADDR               phdrColdCode;
+    DWORD               phdrHotCodeSize;
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
+
 #ifdef WIN64EXCEPTIONS
     DWORD               nUnwindInfos;
     T_RUNTIME_FUNCTION  unwindInfos[0];
@@ -323,6 +339,35 @@ public:
         pRealCodeHeader = (PTR_RealCodeHeader)kind;
     }
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    TADDR                   GetHotCode()
+    {
+        SUPPORTS_DAC;
+        return pRealCodeHeader->phdrHotCode;
+    }
+    TADDR                   GetColdCode()
+    {
+        SUPPORTS_DAC;
+        return pRealCodeHeader->phdrColdCode;
+    }
+    DWORD                   GetHotCodeSize()
+    {
+        SUPPORTS_DAC;
+        return pRealCodeHeader->phdrHotCodeSize;
+    }
+    BOOL                    IsColdCode()
+    {
+        SUPPORTS_DAC;
+        return GetCodeStartAddress() == pRealCodeHeader->phdrColdCode;
+    }
+    void SetColdCode(TADDR hotCode, DWORD hotCodeSize, TADDR coldCode)
+    {
+        pRealCodeHeader->phdrHotCode = hotCode;
+        pRealCodeHeader->phdrHotCodeSize = hotCodeSize;
+        pRealCodeHeader->phdrColdCode = coldCode;
+    }
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
+
 #if defined(WIN64EXCEPTIONS)
     UINT                    GetNumberOfUnwindInfos()
     {
@@ -367,10 +412,14 @@ struct CodeHeapRequestInfo
     size_t       m_reserveSize;     // Amount that VirtualAlloc will reserved
     bool         m_isDynamicDomain;
     bool         m_isCollectible;
+    bool         m_isColdCode;
     
     bool   IsDynamicDomain()                    { return m_isDynamicDomain;    }
     void   SetDynamicDomain()                   { m_isDynamicDomain = true;    }
 
+    bool   IsColdCode()                         { return m_isColdCode;         }
+    void   SetColdCode()                        { m_isColdCode = true;         }
+
     bool   IsCollectible()                      { return m_isCollectible;      }
     
     size_t getRequestSize()                     { return m_requestSize;        }
@@ -470,6 +519,7 @@ typedef struct _HeapList
     DWORD               cBlocks;        // Number of allocations
     bool                bFull;          // Heap is considered full do not use for new allocations
     bool                bFullForJumpStubs; // Heap is considered full do not use for new allocations of jump stubs
+    bool                bColdCode;      // Heap is only used for the cold part of split methods
 
 #if defined(_TARGET_AMD64_)
     BYTE        CLRPersonalityRoutine[JUMP_ALLOCATE_SIZE];                 // jump thunk to personality routine
@@ -1021,6 +1071,9 @@ public:
                                   , TADDR * pModuleBase
 #endif
                                   );
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    TADDR               allocColdCode(CodeHeader* pCodeHeader, size_t hotCodeSize, size_t coldCodeSize, TADDR moduleBase);
+#endif
     BYTE *              allocGCInfo(CodeHeader* pCodeHeader, DWORD blockSize, size_t * pAllocationSize);
     EE_ILEXCEPTION*     allocEHInfo(CodeHeader* pCodeHeader, unsigned numClauses, size_t * pAllocationSize);
     JumpStubBlockHeader* allocJumpStubBlock(MethodDesc* pMD, DWORD numJumps, 
@@ -1541,6 +1594,17 @@ inline void EEJitManager::JitTokenToMethodRegionInfo(const METHODTOKEN& MethodTo
     methodRegionInfo->hotSize          = GetCodeManager()->GetFunctionSize(GetGCInfoToken(MethodToken));
     methodRegionInfo->coldStartAddress = 0;
     methodRegionInfo->coldSize         = 0;
+
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    CodeHeader * pCH = GetCodeHeader(MethodToken);
+    if (pCH->GetColdCode() != NULL)
+    {
+        // The size in the GC info covers both parts
+        methodRegionInfo->coldStartAddress = pCH->GetColdCode();
+        methodRegionInfo->coldSize         = methodRegionInfo->hotSize - pCH->GetHotCodeSize();
+        methodRegionInfo->hotSize          = pCH->GetHotCodeSize();
+    }
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
 }
 
 
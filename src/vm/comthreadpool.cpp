@@ -222,6 +222,23 @@ FCIMPL1(VOID, ThreadPoolNative::ReportThreadStatus, CLR_BOOL isWorking)
 }
 FCIMPLEND
 
+// Managed work items are timed with the same clock as native work requests
+FCIMPL0(INT64, ThreadPoolNative::GetWorkItemTimestamp)
+{
+    FCALL_CONTRACT;
+    return ThreadpoolTelemetry::GetTimestamp();
+}
+FCIMPLEND
+
+// Called after a managed work item has run. enqueueTimestamp is 0 if the work item does not
+// carry the time it was queued, in which case only its execution time is recorded.
+FCIMPL2_VV(VOID, ThreadPoolNative::ReportWorkItemTimings, INT64 enqueueTimestamp, INT64 dequeueTimestamp)
+{
+    FCALL_CONTRACT;
+    ThreadpoolTelemetry::RecordWorkItem(enqueueTimestamp, dequeueTimestamp, ThreadpoolTelemetry::GetTimestamp());
+}
+FCIMPLEND
+
 FCIMPL0(FC_BOOL_RET, ThreadPoolNative::NotifyRequestComplete)
 {
     FCALL_CONTRACT;
@@ -286,13 +303,14 @@ FCIMPLEND
 
 /*****************************************************************************************************/
 
-void QCALLTYPE ThreadPoolNative::InitializeVMTp(CLR_BOOL* pEnableWorkerTracking)
+void QCALLTYPE ThreadPoolNative::InitializeVMTp(CLR_BOOL* pEnableWorkerTracking, CLR_BOOL* pEnableWorkItemTimings)
 {
     QCALL_CONTRACT;
 
     BEGIN_QCALL;
     ThreadpoolMgr::EnsureInitialized();
     *pEnableWorkerTracking = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_EnableWorkerTracking) ? TRUE : FALSE;
+    *pEnableWorkItemTimings = ThreadpoolTelemetry::IsEnabled() ? TRUE : FALSE;
     END_QCALL;
 }
 
@@ -762,6 +780,158 @@ FCIMPL1(FC_BOOL_RET, ThreadPoolNative::CorBindIoCompletionCallback, HANDLE fileH
 }
 FCIMPLEND
 
+#ifdef FEATURE_PAL
+struct IoReadinessCallback_Args
+{
+    DelegateInfo *delegateInfo;
+    DWORD events;
+};
+
+static VOID
+IoReadinessCallback_Worker(LPVOID ptr)
+{
+    CONTRACTL
+    {
+        GC_TRIGGERS;
+        THROWS;
+        MODE_COOPERATIVE;
+    }
+    CONTRACTL_END;
+
+    OBJECTREF orRegistration = NULL;
+
+    GCPROTECT_BEGIN( orRegistration );
+
+    IoReadinessCallback_Args *args = (IoReadinessCallback_Args *) ptr;
+    orRegistration = ObjectFromHandle(args->delegateInfo->m_stateHandle);
+
+#ifdef _DEBUG
+    MethodDesc *pMeth = MscorlibBinder::GetMethod(METHOD__IO_READINESS_REGISTRATION__PERFORM_IO_READINESS_CALLBACK);
+    LogCall(pMeth,"IoReadinessCallback");
+#endif
+
+    // Caution: the args are not protected, we have to garantee there's no GC from here till
+    // the managed call happens.
+    PREPARE_NONVIRTUAL_CALLSITE(METHOD__IO_READINESS_REGISTRATION__PERFORM_IO_READINESS_CALLBACK);
+    DECLARE_ARGHOLDER_ARRAY(arg, 2);
+    arg[ARGNUM_0]  = OBJECTREF_TO_ARGHOLDER(orRegistration);
+    arg[ARGNUM_1]  = DWORD_TO_ARGHOLDER(args->events);
+
+    // Call the method...
+    CALL_MANAGED_METHOD_NORET(arg);
+
+    GCPROTECT_END();
+}
+
+// Runs on an I/O completion thread for the readiness events of a descriptor bound by CorBindIoReadiness
+static VOID IoReadinessCallback(DWORD events, LPVOID delegateInfo)
+{
+    Thread* pThread = GetThread();
+    if (pThread == NULL)
+    {
+        pThread = SetupThreadNoThrow();
+        if (pThread == NULL) {
+            return;
+        }
+    }
+
+    CONTRACTL
+    {
+        MODE_PREEMPTIVE;    // I/O completion thread will be in preempt mode. We switch to coop below.
+        THROWS;
+        GC_TRIGGERS;
+
+        PRECONDITION(CheckPointer(delegateInfo));
+    }
+    CONTRACTL_END;
+
+    // This thread should not have any locks held at entry point.
+    _ASSERTE(pThread->m_dwLockCount == 0);
+
+    GCX_COOP();
+
+    IoReadinessCallback_Args args = { ((DelegateInfo*) delegateInfo), events };
+
+    ManagedThreadBase::ThreadPool(((DelegateInfo*) delegateInfo)->m_appDomainId, IoReadinessCallback_Worker, &args);
+
+    // We should have released all locks.
+    _ASSERTE(g_fEEShutDown || pThread->m_dwLockCount == 0 || pThread->m_fRudeAborted);
+}
+
+// Called by the thread pool once no callback can run any more for an unbound descriptor
+static VOID IoReadinessReleaseCallback(LPVOID delegateInfo)
+{
+    WRAPPER_NO_CONTRACT;
+    ReleaseDelegateInfo((DelegateInfo*) delegateInfo);
+}
+
+FCIMPL3(LPVOID, ThreadPoolNative::CorBindIoReadiness, INT32 fd, INT32 events, Object* registrationUNSAFE)
+{
+    FCALL_CONTRACT;
+
+    ThreadpoolMgr::IoReadinessBinding* pBinding = NULL;
+    OBJECTREF registration = (OBJECTREF) registrationUNSAFE;
+
+    HELPER_METHOD_FRAME_BEGIN_RET_1(registration); // Eventually calls BEGIN_SO_INTOLERANT_CODE_NOTHROW
+
+    _ASSERTE(registration != NULL);
+
+    Thread* pCurThread = GetThread();
+    _ASSERTE( pCurThread);
+
+    AppDomain* appDomain = pCurThread->GetDomain();
+    _ASSERTE(appDomain);
+
+    // The registration is kept alive by a strong handle until the descriptor is unbound
+    DelegateInfoHolder delegateInfo = DelegateInfo::MakeDelegateInfo(appDomain,
+                                                                &registration,
+                                                                NULL,
+                                                                NULL);
+
+    DWORD errCode = 0;
+    pBinding = ThreadpoolMgr::BindIoReadinessCallback(fd,
+                                                      (DWORD) events,
+                                                      IoReadinessCallback,
+                                                      IoReadinessReleaseCallback,
+                                                      (LPVOID) delegateInfo,
+                                                      OUT errCode);
+    if (pBinding == NULL)
+    {
+        if (errCode == ERROR_NOT_SUPPORTED)
+            COMPlusThrow(kPlatformNotSupportedException);
+        else
+        {
+            SetLastError(errCode);
+            COMPlusThrowWin32();
+        }
+    }
+
+    delegateInfo.SuppressRelease();
+    HELPER_METHOD_FRAME_END();
+    return (LPVOID) pBinding;
+}
+FCIMPLEND
+
+FCIMPL1(FC_BOOL_RET, ThreadPoolNative::CorUnbindIoReadiness, LPVOID binding)
+{
+    FCALL_CONTRACT;
+
+    BOOL retVal = FALSE;
+
+    HELPER_METHOD_FRAME_BEGIN_RET_0(); // Eventually calls BEGIN_SO_INTOLERANT_CODE_NOTHROW
+
+    _ASSERTE(binding != NULL);
+
+    DWORD errCode = 0;
+    retVal = ThreadpoolMgr::UnbindIoReadinessCallback((ThreadpoolMgr::IoReadinessBinding*) binding,
+                                                      OUT errCode);
+
+    HELPER_METHOD_FRAME_END();
+    FC_RETURN_BOOL(retVal);
+}
+FCIMPLEND
+#endif // FEATURE_PAL
+
 FCIMPL1(FC_BOOL_RET, ThreadPoolNative::CorPostQueuedCompletionStatus, LPOVERLAPPED lpOverlapped)
 {
     FCALL_CONTRACT;
@@ -35,10 +35,13 @@ public:
     static FCDECL0(VOID, NotifyRequestProgress);
     static FCDECL0(FC_BOOL_RET, NotifyRequestComplete);
 
-    static void QCALLTYPE InitializeVMTp(CLR_BOOL* pEnableWorkerTracking);
+    static void QCALLTYPE InitializeVMTp(CLR_BOOL* pEnableWorkerTracking, CLR_BOOL* pEnableWorkItemTimings);
 
     static FCDECL1(void, ReportThreadStatus, CLR_BOOL isWorking);
 
+    static FCDECL0(INT64, GetWorkItemTimestamp);
+    static FCDECL2_VV(void, ReportWorkItemTimings, INT64 enqueueTimestamp, INT64 dequeueTimestamp);
+
 
     static FCDECL7(LPVOID, CorRegisterWaitForSingleObject,
                                 Object* waitObjectUNSAFE,
@@ -55,6 +58,10 @@ public:
     static FCDECL2(FC_BOOL_RET, CorUnregisterWait, LPVOID WaitHandle, Object * objectToNotify);
     static FCDECL1(void, CorWaitHandleCleanupNative, LPVOID WaitHandle);
     static FCDECL1(FC_BOOL_RET, CorBindIoCompletionCallback, HANDLE fileHandle);
+#ifdef FEATURE_PAL
+    static FCDECL3(LPVOID, CorBindIoReadiness, INT32 fd, INT32 events, Object* registrationUNSAFE);
+    static FCDECL1(FC_BOOL_RET, CorUnbindIoReadiness, LPVOID binding);
+#endif // FEATURE_PAL
 };
 
 class AppDomainTimerNative
@@ -99,7 +99,7 @@ void SetJitTls(void* v)
 // All locks are nops because of there is always only one thread.
 //
 
-void CrstBase::InitWorker(INDEBUG_COMMA(CrstType crstType) CrstFlags flags)
+void CrstBase::InitWorker(CrstType crstType, CrstFlags flags)
 {
     m_dwFlags = flags;
 }
@@ -17,6 +17,7 @@
 // We need to know if we're on the helper thread.  We need this header for g_pDebugInterface.
 #include "dbginterface.h"
 #include "threadsuspend.h"
+#include "lockcontention.h"
 
 #define __IN_CRST_CPP
 #include <crsttypes.h>
@@ -28,7 +29,7 @@ Volatile<LONG> g_ShutdownCrstUsageCount = 0;
 //-----------------------------------------------------------------
 // Initialize critical section
 //-----------------------------------------------------------------
-VOID CrstBase::InitWorker(INDEBUG_COMMA(CrstType crstType) CrstFlags flags)
+VOID CrstBase::InitWorker(CrstType crstType, CrstFlags flags)
 {
     CONTRACTL {
         THROWS;
@@ -47,6 +48,7 @@ VOID CrstBase::InitWorker(INDEBUG_COMMA(CrstType crstType) CrstFlags flags)
 
     SetFlags(flags);
     SetCrstInitialized();
+    m_crstType = crstType;
 
 #ifdef _DEBUG
     DebugInit(crstType, flags);
@@ -310,7 +312,20 @@ void CrstBase::Enter(INDEBUG(NoLevelCheckFlag noLevelCheckFlag/* = CRST_LEVEL_CH
         }
     }
 
-    UnsafeEnterCriticalSection(&m_criticalsection);
+    if (!LockContentionProfiler::IsEnabled())
+    {
+        UnsafeEnterCriticalSection(&m_criticalsection);
+    }
+    else if (UnsafeTryEnterCriticalSection(&m_criticalsection))
+    {
+        LockContentionProfiler::RecordCrstAcquire(m_crstType);
+    }
+    else
+    {
+        LONGLONG startTime = LockContentionProfiler::GetTimestamp();
+        UnsafeEnterCriticalSection(&m_criticalsection);
+        LockContentionProfiler::RecordCrstContention(m_crstType, startTime);
+    }
 
 #ifdef _DEBUG
     PostEnter();
@@ -587,7 +602,6 @@ void CrstBase::DebugInit(CrstType crstType, CrstFlags flags)
 {
     LIMITED_METHOD_CONTRACT;
 
-    m_crstType = crstType;
     m_tag = GetCrstName(crstType);
     m_crstlevel = GetCrstLevel(crstType);
     m_holderthreadid.Clear();
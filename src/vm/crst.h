@@ -288,7 +288,7 @@ public:
 
 protected:    
 
-    VOID InitWorker(INDEBUG_COMMA(CrstType crstType) CrstFlags flags);
+    VOID InitWorker(CrstType crstType, CrstFlags flags);
 
 #ifdef _DEBUG
     void DebugInit(CrstType crstType, CrstFlags flags);
@@ -310,9 +310,9 @@ protected:
         // rest of the flags are CrstFlags
     } CrstReservedFlags;
     DWORD               m_dwFlags;            // Re-entrancy and same level
+    CrstType            m_crstType;         // Type enum; also keys the lock contention profile
 #ifdef _DEBUG
     UINT                m_entercount;       // # of unmatched Enters.
-    CrstType            m_crstType;         // Type enum (should have a descriptive name for debugging)
     const char         *m_tag;              // Stringized form of the tag for easy debugging
     int                 m_crstlevel;        // what level is the crst in?
     EEThreadId          m_holderthreadid;   // current holder (or NULL)
@@ -437,8 +437,7 @@ public:
     {
         WRAPPER_NO_CONTRACT;
 
-        // throw away the debug-only parameter in retail
-        InitWorker(INDEBUG_COMMA(crstType) flags);
+        InitWorker(crstType, flags);
     }
 
     //-----------------------------------------------------------------
@@ -477,8 +476,7 @@ public:
 
         _ASSERTE((flags & CRST_INITIALIZED) == 0);
 
-        // throw away the debug-only parameter in retail
-        InitWorker(INDEBUG_COMMA(crstType) flags);
+        InitWorker(crstType, flags);
     }
 
     bool InitNoThrow(CrstType crstType, CrstFlags flags = CRST_DEFAULT)
@@ -493,8 +491,7 @@ public:
 
         EX_TRY
         {
-            // throw away the debug-only parameter in retail
-            InitWorker(INDEBUG_COMMA(crstType) flags);
+            InitWorker(crstType, flags);
             fSuccess = true;
         }
         EX_CATCH
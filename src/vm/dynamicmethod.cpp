@@ -374,6 +374,7 @@ HeapList* HostCodeHeap::CreateCodeHeap(CodeHeapRequestInfo *pInfo, EEJitManager
     // Furthermore, if we avoid writing to it, these pages don't come into our working set
 
     pHp->bFull           = FALSE;
+    pHp->bColdCode       = false;
     pHp->cBlocks         = 0;
 #ifdef _WIN64
     emitJump((LPBYTE)pHp->CLRPersonalityRoutine, (void *)ProcessCLRException);
@@ -749,9 +749,18 @@ FCFuncStart(gThreadPoolFuncs)
     FCFuncElement("NotifyWorkItemProgressNative", ThreadPoolNative::NotifyRequestProgress)
     QCFuncElement("InitializeVMTp", ThreadPoolNative::InitializeVMTp)
     FCFuncElement("ReportThreadStatus", ThreadPoolNative::ReportThreadStatus)   
+    FCFuncElement("GetWorkItemTimestamp", ThreadPoolNative::GetWorkItemTimestamp)
+    FCFuncElement("ReportWorkItemTimings", ThreadPoolNative::ReportWorkItemTimings)
     QCFuncElement("RequestWorkerThread", ThreadPoolNative::RequestWorkerThread)
 FCFuncEnd()
 
+#ifdef FEATURE_PAL
+FCFuncStart(gIoReadinessRegistrationFuncs)
+    FCFuncElement("BindIoReadinessNative", ThreadPoolNative::CorBindIoReadiness)
+    FCFuncElement("UnbindIoReadinessNative", ThreadPoolNative::CorUnbindIoReadiness)
+FCFuncEnd()
+#endif // FEATURE_PAL
+
 FCFuncStart(gTimerFuncs)
     QCFuncElement("CreateAppDomainTimer", AppDomainTimerNative::CreateAppDomainTimer)
     QCFuncElement("ChangeAppDomainTimer", AppDomainTimerNative::ChangeAppDomainTimer)
@@ -1368,6 +1377,9 @@ FCClassElement("IReflect", "System.Reflection", gStdMngIReflectFuncs)
 FCClassElement("InterfaceMarshaler", "System.StubHelpers", gInterfaceMarshalerFuncs)
 #endif
 FCClassElement("Interlocked", "System.Threading", gInterlockedFuncs)
+#ifdef FEATURE_PAL
+FCClassElement("IoReadinessRegistration", "System.Threading", gIoReadinessRegistrationFuncs)
+#endif // FEATURE_PAL
 FCClassElement("JitHelpers", "System.Runtime.CompilerServices", gJitHelpers)
 FCClassElement("LoaderAllocatorScout", "System.Reflection", gLoaderAllocatorFuncs)
 FCClassElement("Log", "System.Diagnostics", gDiagnosticsLog)
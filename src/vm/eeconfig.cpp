@@ -380,6 +380,8 @@ HRESULT EEConfig::Init()
 
 #if defined(FEATURE_TIERED_COMPILATION)
     fTieredCompilation = false;
+    fTieredCompilation_SplitTier1Code = false;
+    dwTieredCompilation_BackgroundWorkerCount = 0;
 #endif
     
     // After initialization, register the code:#GetConfigValueCallback method with code:CLRConfig to let
@@ -1238,6 +1240,8 @@ HRESULT EEConfig::sync()
 
 #if defined(FEATURE_TIERED_COMPILATION)
     fTieredCompilation = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_TieredCompilation) != 0;
+    fTieredCompilation_SplitTier1Code = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_TC_SplitTier1Code) != 0;
+    dwTieredCompilation_BackgroundWorkerCount = CLRConfig::GetConfigValue(CLRConfig::UNSUPPORTED_TC_BackgroundWorkerCount);
 #endif
 
     return hr;
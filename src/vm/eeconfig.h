@@ -284,6 +284,8 @@ public:
     // Tiered Compilation config
 #if defined(FEATURE_TIERED_COMPILATION)
     bool          TieredCompilation(void)           const {LIMITED_METHOD_CONTRACT;  return fTieredCompilation; }
+    bool          TieredCompilation_SplitTier1Code() const {LIMITED_METHOD_CONTRACT; return fTieredCompilation_SplitTier1Code; }
+    DWORD         TieredCompilation_BackgroundWorkerCount() const {LIMITED_METHOD_CONTRACT; return dwTieredCompilation_BackgroundWorkerCount; }
 #endif
 
     BOOL PInvokeRestoreEsp(BOOL fDefault) const
@@ -1099,6 +1101,8 @@ private: //----------------------------------------------------------------
 
 #if defined(FEATURE_TIERED_COMPILATION)
     bool fTieredCompilation;
+    bool fTieredCompilation_SplitTier1Code;
+    DWORD dwTieredCompilation_BackgroundWorkerCount;
 #endif
 
 public:
@@ -29,6 +29,8 @@ enum HillClimbingStateTransition
     Stabilizing,
     Starvation, //used by ThreadpoolMgr
     ThreadTimedOut, //used by ThreadpoolMgr
+    CooperativeBlocking, //used by ThreadpoolMgr
+    CooperativeBlockingEnded, //used by ThreadpoolMgr
     Undefined,
 };
 
@@ -49,6 +49,8 @@
 #include "security.h"
 #include "safemath.h"
 #include "threadstatics.h"
+#include "castcache.h"
+#include "lockcontention.h"
 
 #ifdef FEATURE_PREJIT
 #include "compile.h"
@@ -2294,6 +2296,32 @@ TypeHandle::CastResult STDCALL ObjIsInstanceOfNoGC(Object *pObject, TypeHandle t
     return pMT->CanCastToClassOrInterfaceNoGC(toTypeHnd.AsMethodTable());
 }
 
+// Like ObjIsInstanceOfNoGC, but consults and updates the cast cache
+static TypeHandle::CastResult ObjIsInstanceOfCachedNoGC(Object *pObject, TypeHandle toTypeHnd)
+{
+    CONTRACTL {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_COOPERATIVE;
+        SO_TOLERANT;
+        PRECONDITION(CheckPointer(pObject));
+    } CONTRACTL_END;
+
+    MethodTable *pMT = pObject->GetMethodTable();
+
+    // Quick exact match first
+    if (TypeHandle(pMT) == toTypeHnd)
+        return TypeHandle::CanCast;
+
+    TypeHandle::CastResult result = CastCache::TryGet(pMT, toTypeHnd);
+    if (result != TypeHandle::MaybeCast)
+        return result;
+
+    result = ObjIsInstanceOfNoGC(pObject, toTypeHnd);
+    CastCache::TryAdd(pMT, toTypeHnd, result);
+    return result;
+}
+
 BOOL ObjIsInstanceOf(Object *pObject, TypeHandle toTypeHnd, BOOL throwCastException)
 {
     CONTRACTL {
@@ -2363,6 +2391,9 @@ BOOL ObjIsInstanceOf(Object *pObject, TypeHandle toTypeHnd, BOOL throwCastExcept
     }
 #endif // FEATURE_ICASTABLE
 
+    // Casts that only depend on the types involved are remembered for the fast helpers
+    CastCache::TryAdd(obj->GetMethodTable(), toTypeHnd, fCast ? TypeHandle::CanCast : TypeHandle::CannotCast);
+
     if (!fCast && throwCastException) 
     {
         COMPlusThrowInvalidCastException(&obj, toTypeHnd);
@@ -2477,8 +2508,16 @@ HCIMPL2(Object*, JIT_ChkCastInterface_Portable, MethodTable *pInterfaceMT, Objec
         return pObject;
     }
 
-    if (pObject->GetMethodTable()->ImplementsInterfaceInline(pInterfaceMT))
+    MethodTable* pMT = pObject->GetMethodTable();
+
+    if (CastCache::TryGet(pMT, TypeHandle(pInterfaceMT)) == TypeHandle::CanCast)
+    {
+        return pObject;
+    }
+
+    if (pMT->ImplementsInterfaceInline(pInterfaceMT))
     {
+        CastCache::TryAdd(pMT, TypeHandle(pInterfaceMT), TypeHandle::CanCast);
         return pObject;
     }
 
@@ -2499,13 +2538,26 @@ HCIMPL2(Object*, JIT_IsInstanceOfInterface_Portable, MethodTable *pInterfaceMT,
         return NULL;
     }
 
-    if (pObject->GetMethodTable()->ImplementsInterfaceInline(pInterfaceMT))
+    MethodTable* pMT = pObject->GetMethodTable();
+
+    switch (CastCache::TryGet(pMT, TypeHandle(pInterfaceMT))) {
+    case TypeHandle::CanCast:
+        return pObject;
+    case TypeHandle::CannotCast:
+        return NULL;
+    default:
+        break;
+    }
+
+    if (pMT->ImplementsInterfaceInline(pInterfaceMT))
     {
+        CastCache::TryAdd(pMT, TypeHandle(pInterfaceMT), TypeHandle::CanCast);
         return pObject;
     }
 
-    if (!pObject->GetMethodTable()->InstanceRequiresNonTrivialInterfaceCast())
+    if (!pMT->InstanceRequiresNonTrivialInterfaceCast())
     {
+        CastCache::TryAdd(pMT, TypeHandle(pInterfaceMT), TypeHandle::CannotCast);
         return NULL;
     }
 
@@ -2598,7 +2650,7 @@ HCIMPL2(Object *, JIT_IsInstanceOfAny, CORINFO_CLASS_HANDLE type, Object* obj)
         return NULL;
     }
 
-    switch (ObjIsInstanceOfNoGC(obj, TypeHandle(type))) {
+    switch (ObjIsInstanceOfCachedNoGC(obj, TypeHandle(type))) {
     case TypeHandle::CanCast:
         return obj;
     case TypeHandle::CannotCast:
@@ -2625,7 +2677,7 @@ HCIMPL2(Object *, JIT_ChkCastAny, CORINFO_CLASS_HANDLE type, Object *obj)
         return NULL;
     }
 
-    TypeHandle::CastResult result = ObjIsInstanceOfNoGC(obj, TypeHandle(type));
+    TypeHandle::CastResult result = ObjIsInstanceOfCachedNoGC(obj, TypeHandle(type));
 
     if (result == TypeHandle::CanCast)
     {
@@ -4440,7 +4492,15 @@ NOINLINE static void JIT_MonContention_Helper(Object* obj, BYTE* pbLockTaken, LP
 
     GCPROTECT_BEGININTERIOR(pbLockTaken);
 
-    objRef->GetSyncBlock()->QuickGetMonitor()->Contention();
+    {
+        // Covers the thin lock spinning too, which happens before the sync block exists
+        MonitorContentionHolder contentionHolder;
+
+        if (!ObjHeader::SpinOnThinLock(&objRef))
+        {
+            objRef->GetSyncBlock()->QuickGetMonitor()->Contention();
+        }
+    }
     if (pbLockTaken != 0) *pbLockTaken = 1;
 
     GCPROTECT_END();
@@ -9792,6 +9792,21 @@ void CEEInfo::getEEInfo(CORINFO_EE_INFO *pEEInfoOut)
     pEEInfoOut->osMinor = 0;
     pEEInfoOut->osBuild = 0;
 
+    // Inline allocation. The jitted code gets the Thread from CORINFO_HELP_GETCURRENTTHREAD,
+    // which InitJITHelpers1 only sets when the fast allocation helpers are in use.
+    CORINFO_EE_INFO::InlineAllocInfo* pInlineAllocInfo = &pEEInfoOut->inlineAllocInfo;
+    pInlineAllocInfo->offsetOfAllocContext  = 0;
+#ifndef CROSSGEN_COMPILE
+    if (hlpDynamicFuncTable[DYNAMIC_CORINFO_HELP_GETCURRENTTHREAD].pfnHelper != NULL)
+        pInlineAllocInfo->offsetOfAllocContext = offsetof(Thread, m_alloc_context);
+#endif // !CROSSGEN_COMPILE
+    pInlineAllocInfo->offsetOfAllocPtr      = offsetof(gc_alloc_context, alloc_ptr);
+    pInlineAllocInfo->offsetOfAllocLimit    = offsetof(gc_alloc_context, alloc_limit);
+    pInlineAllocInfo->offsetOfBaseSize      = MethodTable::GetOffsetOfBaseSize();
+    pInlineAllocInfo->offsetOfComponentSize = MethodTable::GetOffsetOfComponentSize();
+    // Same limit as JIT_NewArr1VC_MP_FastPortable, which keeps the size computation from overflowing
+    pInlineAllocInfo->maxArrayLength        = 65535 - 256;
+
     EE_TO_JIT_TRANSITION();
 }
 
@@ -10800,17 +10815,25 @@ void CEEJitInfo::reserveUnwindInfo(BOOL isFunclet, BOOL isColdCode, ULONG unwind
 
     JIT_TO_EE_TRANSITION_LEAF();
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    CONSISTENCY_CHECK_MSG(!isColdCode || (!isFunclet && (unwindSize == 0)), "Only the main body of jitted code may be split");
+#else
     CONSISTENCY_CHECK_MSG(!isColdCode, "Hot/Cold splitting is not supported in jitted code");
+#endif
     _ASSERTE_MSG(m_theUnwindBlock == NULL,
         "reserveUnwindInfo() can only be called before allocMem(), but allocMem() has already been called. "
         "This may indicate the JIT has hit a NO_WAY assert after calling allocMem(), and is re-JITting. "
         "Set COMPlus_JitBreakOnBadCode=1 and rerun to get the real error.");
 
-    ULONG currentSize  = unwindSize;
+    // The unwind info of cold code is chained to the main body and needs no space of its own
+    if (!isColdCode)
+    {
+        ULONG currentSize  = unwindSize;
 
-    reservePersonalityRoutineSpace(currentSize);
+        reservePersonalityRoutineSpace(currentSize);
 
-    m_totalUnwindSize += currentSize;
+        m_totalUnwindSize += currentSize;
+    }
 
     m_totalUnwindInfos++;
 
@@ -10858,12 +10881,17 @@ void CEEJitInfo::allocUnwindInfo (
         GC_TRIGGERS;
         MODE_PREEMPTIVE;
         PRECONDITION(m_theUnwindBlock != NULL);
-        PRECONDITION(m_usedUnwindSize < m_totalUnwindSize);
+        PRECONDITION((pColdCode != NULL) || (m_usedUnwindSize < m_totalUnwindSize));
         PRECONDITION(m_usedUnwindInfos < m_totalUnwindInfos);
-        PRECONDITION(endOffset <= m_codeSize);
+        PRECONDITION((pColdCode != NULL) || (endOffset <= m_codeSize));
     } CONTRACTL_END;
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    CONSISTENCY_CHECK_MSG((pColdCode == NULL) || ((funcKind == CORJIT_FUNC_ROOT) && (unwindSize == 0)),
+                          "Only the main body of jitted code may be split");
+#else
     CONSISTENCY_CHECK_MSG(pColdCode == NULL, "Hot/Cold code splitting not supported for jitted code");
+#endif
 
     JIT_TO_EE_TRANSITION();
 
@@ -10890,6 +10918,34 @@ void CEEJitInfo::allocUnwindInfo (
     // Make sure that the RUNTIME_FUNCTION is aligned on a DWORD sized boundary
     _ASSERTE(IS_ALIGNED(pRuntimeFunction, sizeof(DWORD)));
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    if (pColdCode != NULL)
+    {
+        // Chain the cold code to the unwind info of the main body, which is always reported first.
+        // Like the rest of the unwind info, it is relative to the code heap of the hot code.
+        _ASSERTE(m_usedUnwindInfos > 1);
+
+        size_t coldCodeOffsetT = (size_t)pColdCode - m_moduleBase;
+        size_t rootFunctionOffsetT = (size_t)m_CodeHeader->GetUnwindInfo(0) - m_moduleBase;
+
+        if (!FitsInU4(coldCodeOffsetT + endOffset) || !FitsInU4(rootFunctionOffsetT))
+        {
+            _ASSERTE(!"Bad coldCodeOffsetT");
+            COMPlusThrowHR(E_FAIL);
+        }
+
+        RUNTIME_FUNCTION__SetBeginAddress(pRuntimeFunction, (DWORD)coldCodeOffsetT + startOffset);
+        pRuntimeFunction->EndAddress = (DWORD)coldCodeOffsetT + endOffset;
+        RUNTIME_FUNCTION__SetUnwindInfoAddress(pRuntimeFunction, (DWORD)rootFunctionOffsetT | RUNTIME_FUNCTION_INDIRECT);
+
+        if (m_usedUnwindInfos == m_totalUnwindInfos)
+            UnwindInfoTable::PublishUnwindInfoForMethod(m_moduleBase, m_CodeHeader->GetUnwindInfo(0), m_totalUnwindInfos);
+
+        EE_TO_JIT_TRANSITION();
+        return;
+    }
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
+
     UNWIND_INFO * pUnwindInfo = (UNWIND_INFO *) &(m_theUnwindBlock[m_usedUnwindSize]);
     m_usedUnwindSize += unwindSize;
 
@@ -11487,7 +11543,9 @@ void CEEJitInfo::allocMem (
 
     JIT_TO_EE_TRANSITION();
 
+#ifndef FEATURE_JIT_HOT_COLD_SPLITTING
     _ASSERTE(coldCodeSize == 0);
+#endif
     if (coldCodeBlock)
     {
         *coldCodeBlock = NULL;
@@ -11569,6 +11627,14 @@ void CEEJitInfo::allocMem (
 
     _ASSERTE((SIZE_T)(current - (BYTE *)m_CodeHeader->GetCodeStartAddress()) <= totalSize.Value());
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+    if (coldCodeSize > 0)
+    {
+        _ASSERTE(coldCodeBlock != NULL);
+        *coldCodeBlock = (void *)m_jitManager->allocColdCode(m_CodeHeader, codeSize, coldCodeSize, m_moduleBase);
+    }
+#endif // FEATURE_JIT_HOT_COLD_SPLITTING
+
 #ifdef _DEBUG
     m_codeSize = codeSize;
 #endif  // _DEBUG
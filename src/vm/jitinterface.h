@@ -269,6 +269,11 @@ extern "C" FCDECL1(void*, JIT_InternalThrowFromHelper, unsigned exceptNum);
 
 #ifdef _TARGET_AMD64_
 
+#if defined(FEATURE_PAL) && defined(FEATURE_USE_SOFTWARE_WRITE_WATCH_FOR_GC_HEAP)
+// Workstation write barriers that set only the card covering the destination rather than
+// the whole card table byte (see jithelpers_fastwritebarriers.S).
+#define FEATURE_PRECISE_CARD_MARKING_BARRIER
+#endif
 
 class WriteBarrierManager
 {
@@ -278,6 +283,10 @@ public:
         WRITE_BARRIER_UNINITIALIZED,
         WRITE_BARRIER_PREGROW64,
         WRITE_BARRIER_POSTGROW64,
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+        WRITE_BARRIER_PRECISE_PREGROW64,
+        WRITE_BARRIER_PRECISE_POSTGROW64,
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 #ifdef FEATURE_SVR_GC
         WRITE_BARRIER_SVR64,
 #endif // FEATURE_SVR_GC
@@ -314,6 +323,9 @@ private:
     void Validate();
     
     WriteBarrierType    m_currentWriteBarrier;
+#ifdef FEATURE_PRECISE_CARD_MARKING_BARRIER
+    bool                m_usePreciseCardMarking;
+#endif // FEATURE_PRECISE_CARD_MARKING_BARRIER
 
     PBYTE   m_pWriteWatchTableImmediate;    // PREGROW | POSTGROW | SVR | WRITE_WATCH |
     PBYTE   m_pLowerBoundImmediate;         // PREGROW | POSTGROW |     | WRITE_WATCH |
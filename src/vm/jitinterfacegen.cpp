@@ -192,6 +192,10 @@ EXTERN_C void JIT_MonEnterStaticWorker();
 EXTERN_C void JIT_MonExitStaticWorker();
 #endif
 
+#if defined(_TARGET_AMD64_) && defined(FEATURE_PAL)
+EXTERN_C Thread* JIT_GetThreadPreserveArgs();
+#endif
+
 void InitJITHelpers1()
 {
     STANDARD_VM_CONTRACT;
@@ -232,6 +236,12 @@ void InitJITHelpers1()
             SetJitHelperFunction(CORINFO_HELP_NEWARR_1_OBJ, JIT_NewArr1OBJ_MP_FastPortable);
 
             ECall::DynamicallyAssignFCallImpl(GetEEFuncEntryPoint(AllocateString_MP_FastPortable), ECall::FastAllocateString);
+
+#ifdef FEATURE_PAL
+            // The JIT may expand the fast path of these helpers inline, and only when they are
+            // in use, i.e. allocations are not being tracked or logged.
+            SetJitHelperFunction(CORINFO_HELP_GETCURRENTTHREAD, JIT_GetThreadPreserveArgs);
+#endif // FEATURE_PAL
 #else // !FEATURE_IMPLICIT_TLS
             // If the TLS for Thread is low enough use the super-fast helpers
             if (gThreadTLSIndex < TLS_MINIMUM_AVAILABLE)
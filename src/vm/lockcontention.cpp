@@ -0,0 +1,387 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+#include "common.h"
+#include "lockcontention.h"
+
+#ifdef FEATURE_PERFTRACING
+#include "eventpipe.h"
+#include "eventpipeprovider.h"
+#include "eventpipeevent.h"
+#endif // FEATURE_PERFTRACING
+
+bool LockContentionProfiler::s_enabled = false;
+double LockContentionProfiler::s_nanosecondsPerTick = 0;
+DWORD LockContentionProfiler::s_publishingInterval = 0;
+DWORD LockContentionProfiler::s_lastPublishTime = 0;
+LockContentionCounts LockContentionProfiler::s_crstCounts[kNumberOfCrstTypes];
+LockContentionCounts LockContentionProfiler::s_spinLockCounts[LOCK_TYPE_DEFAULT + 1];
+LockContentionProfiler::MonitorCallSite LockContentionProfiler::s_monitorCallSites[MonitorCallSiteCount];
+LockContentionCounts LockContentionProfiler::s_monitorOverflowCounts;
+LockContentionCounts LockContentionProfiler::s_lastPublishedCrstCounts[kNumberOfCrstTypes];
+LockContentionCounts LockContentionProfiler::s_lastPublishedSpinLockCounts[LOCK_TYPE_DEFAULT + 1];
+LockContentionCounts LockContentionProfiler::s_lastPublishedMonitorCounts[MonitorCallSiteCount];
+LockContentionCounts LockContentionProfiler::s_lastPublishedMonitorOverflowCounts;
+
+#ifdef FEATURE_PERFTRACING
+const GUID LockContentionProfiler::s_providerID = {0x5e1f7a93,0x2c64,0x4d08,{0x9b,0x31,0x6a,0xe2,0x0f,0x85,0xc4,0x17}}; // {5e1f7a93-2c64-4d08-9b31-6ae20f85c417}
+EventPipeProvider* LockContentionProfiler::s_pEventPipeProvider = NULL;
+EventPipeEvent* LockContentionProfiler::s_pContentionEvents[LockContention_Count];
+#endif // FEATURE_PERFTRACING
+
+// Set while the thread is in the outermost MonitorContentionHolder
+static __declspec(thread) bool t_fTimingMonitorContention = false;
+
+void LockContentionProfiler::Initialize()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_LockContentionProfiling) == 0)
+        return;
+
+    LARGE_INTEGER frequency;
+    if (!QueryPerformanceFrequency(&frequency) || frequency.QuadPart <= 0)
+        return;
+
+    s_nanosecondsPerTick = 1000000000.0 / (double)frequency.QuadPart;
+    s_publishingInterval = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_LockContentionProfilingPublishInterval);
+    s_lastPublishTime = GetTickCount();
+    s_enabled = true;
+}
+
+void LockContentionProfiler::RecordContention(LockContentionCounts* pCounts, LONGLONG startTime)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    LARGE_INTEGER endTime;
+    QueryPerformanceCounter(&endTime);
+
+    RecordAcquire(pCounts);
+    FastInterlockExchangeAddLong(&pCounts->m_contentionCount, 1);
+    if (endTime.QuadPart > startTime)
+    {
+        FastInterlockExchangeAddLong(&pCounts->m_waitTicks, endTime.QuadPart - startTime);
+    }
+}
+
+LockContentionCounts* LockContentionProfiler::GetMonitorCounts(PCODE callSite)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (callSite == NULL)
+        return &s_monitorOverflowCounts;
+
+    // Fibonacci hashing spreads the call sites, which are mostly close to each other
+    unsigned int index = (unsigned int)(((UINT64)callSite * UI64(0x9E3779B97F4A7C15)) >> 32) & (MonitorCallSiteCount - 1);
+
+    for (unsigned int probe = 0; probe < MonitorCallSiteCount; probe++)
+    {
+        MonitorCallSite* pEntry = &s_monitorCallSites[(index + probe) & (MonitorCallSiteCount - 1)];
+
+        PCODE entryCallSite = VolatileLoad(&pEntry->m_callSite);
+        if (entryCallSite == NULL)
+        {
+            entryCallSite = (PCODE)FastInterlockCompareExchangePointer((void**)&pEntry->m_callSite, (void*)callSite, NULL);
+            if (entryCallSite == NULL)
+                return &pEntry->m_counts;
+        }
+
+        if (entryCallSite == callSite)
+            return &pEntry->m_counts;
+    }
+
+    return &s_monitorOverflowCounts;
+}
+
+void LockContentionProfiler::RecordMonitorContention(PCODE callSite, LONGLONG startTime)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    RecordContention(GetMonitorCounts(callSite), startTime);
+}
+
+BOOL LockContentionProfiler::GetCounts(LockContentionKind kind, SIZE_T id, LockContentionCounts* pCounts)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        PRECONDITION(kind < LockContention_Count);
+        PRECONDITION(CheckPointer(pCounts));
+    }
+    CONTRACTL_END;
+
+    const LockContentionCounts* pSource = NULL;
+
+    switch (kind)
+    {
+    case LockContention_Crst:
+        if (id < kNumberOfCrstTypes)
+            pSource = &s_crstCounts[id];
+        break;
+
+    case LockContention_SpinLock:
+        if (id <= LOCK_TYPE_DEFAULT)
+            pSource = &s_spinLockCounts[id];
+        break;
+
+    case LockContention_Monitor:
+        if (id == 0)
+        {
+            pSource = &s_monitorOverflowCounts;
+            break;
+        }
+
+        for (unsigned int i = 0; i < MonitorCallSiteCount; i++)
+        {
+            if (VolatileLoad(&s_monitorCallSites[i].m_callSite) == (PCODE)id)
+            {
+                pSource = &s_monitorCallSites[i].m_counts;
+                break;
+            }
+        }
+        break;
+
+    default:
+        break;
+    }
+
+    if (pSource == NULL)
+        return FALSE;
+
+    pCounts->m_acquireCount = VolatileLoadWithoutBarrier(&pSource->m_acquireCount);
+    pCounts->m_contentionCount = VolatileLoadWithoutBarrier(&pSource->m_contentionCount);
+    pCounts->m_waitTicks = VolatileLoadWithoutBarrier(&pSource->m_waitTicks);
+    return TRUE;
+}
+
+void LockContentionProfiler::PublishIfDue()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_PREEMPTIVE;
+    }
+    CONTRACTL_END;
+
+    if (!s_enabled)
+        return;
+
+    DWORD currentTime = GetTickCount();
+    if (currentTime - s_lastPublishTime < s_publishingInterval)
+        return;
+
+    s_lastPublishTime = currentTime;
+
+    bool fTracing = false;
+#ifdef FEATURE_PERFTRACING
+    fTracing = EventPipe::Enabled();
+    if (fTracing)
+    {
+        EnsureEventPipeProvider();
+    }
+#endif // FEATURE_PERFTRACING
+
+    for (unsigned int i = 0; i < kNumberOfCrstTypes; i++)
+    {
+        PublishCounts(LockContention_Crst, i, &s_crstCounts[i], &s_lastPublishedCrstCounts[i], fTracing);
+    }
+
+    for (unsigned int i = 0; i <= LOCK_TYPE_DEFAULT; i++)
+    {
+        PublishCounts(LockContention_SpinLock, i, &s_spinLockCounts[i], &s_lastPublishedSpinLockCounts[i], fTracing);
+    }
+
+    for (unsigned int i = 0; i < MonitorCallSiteCount; i++)
+    {
+        PCODE callSite = VolatileLoad(&s_monitorCallSites[i].m_callSite);
+        if (callSite != NULL)
+        {
+            PublishCounts(LockContention_Monitor, (SIZE_T)callSite, &s_monitorCallSites[i].m_counts,
+                          &s_lastPublishedMonitorCounts[i], fTracing);
+        }
+    }
+
+    PublishCounts(LockContention_Monitor, 0, &s_monitorOverflowCounts, &s_lastPublishedMonitorOverflowCounts, fTracing);
+}
+
+// The baseline moves on every interval, so that each event covers one interval whenever tracing started. Locks
+// that were not taken during the interval get no event.
+void LockContentionProfiler::PublishCounts(LockContentionKind kind, SIZE_T id, const LockContentionCounts* pCounts,
+                                           LockContentionCounts* pLastPublishedCounts, bool fTracing)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    LockContentionCounts counts;
+    counts.m_acquireCount = VolatileLoadWithoutBarrier(&pCounts->m_acquireCount);
+    counts.m_contentionCount = VolatileLoadWithoutBarrier(&pCounts->m_contentionCount);
+    counts.m_waitTicks = VolatileLoadWithoutBarrier(&pCounts->m_waitTicks);
+
+    LockContentionCounts delta;
+    delta.m_acquireCount = counts.m_acquireCount - pLastPublishedCounts->m_acquireCount;
+    delta.m_contentionCount = counts.m_contentionCount - pLastPublishedCounts->m_contentionCount;
+    delta.m_waitTicks = counts.m_waitTicks - pLastPublishedCounts->m_waitTicks;
+    *pLastPublishedCounts = counts;
+
+    if (delta.m_acquireCount == 0 && delta.m_contentionCount == 0)
+        return;
+
+#ifdef FEATURE_PERFTRACING
+    if (fTracing)
+    {
+        WriteContentionEvent(kind, id, &delta);
+    }
+#endif // FEATURE_PERFTRACING
+}
+
+#ifdef FEATURE_PERFTRACING
+
+void LockContentionProfiler::EnsureEventPipeProvider()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    // Only the gate thread creates the provider. It is created once tracing is first enabled, since the event
+    // pipe may not be initialized before that.
+    if (s_pEventPipeProvider != NULL)
+        return;
+
+    EX_TRY
+    {
+        EventPipeProvider* pProvider = EventPipe::CreateProvider(s_providerID);
+        for (int kind = 0; kind < LockContention_Count; kind++)
+        {
+            s_pContentionEvents[kind] = pProvider->AddEvent(
+                kind + 1, /* eventID */
+                0, /* keywords */
+                0, /* eventVersion */
+                EventPipeEventLevel::Informational,
+                false /* NeedStack */);
+        }
+
+        s_pEventPipeProvider = pProvider;
+    }
+    EX_CATCH
+    {
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+}
+
+// Payload: the CrstType, LOCK_TYPE or call site as a UINT64, then the acquire count, the contended count and
+// the time spent in contended acquisitions in nanoseconds as UINT64s. The counts are those added since the
+// previous event.
+void LockContentionProfiler::WriteContentionEvent(LockContentionKind kind, SIZE_T id, const LockContentionCounts* pCounts)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (s_pEventPipeProvider == NULL)
+        return;
+
+    EventPipeEvent* pEvent = s_pContentionEvents[kind];
+    if (pEvent == NULL || !pEvent->IsEnabled())
+        return;
+
+    struct
+    {
+        UINT64 id;
+        UINT64 acquireCount;
+        UINT64 contentionCount;
+        UINT64 waitNanoseconds;
+    } payload;
+
+    payload.id = id;
+    payload.acquireCount = pCounts->m_acquireCount;
+    payload.contentionCount = pCounts->m_contentionCount;
+    payload.waitNanoseconds = (UINT64)(pCounts->m_waitTicks * s_nanosecondsPerTick);
+
+    EventPipe::WriteEvent(*pEvent, (BYTE*)&payload, sizeof(payload));
+}
+
+#endif // FEATURE_PERFTRACING
+
+void MonitorContentionHolder::Begin()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (t_fTimingMonitorContention)
+        return;
+
+    // The frame that entered the runtime knows where managed code called Monitor.Enter from
+    m_callSite = NULL;
+    Thread* pThread = GetThread();
+    if (pThread != NULL)
+    {
+        Frame* pFrame = pThread->GetFrame();
+        if (pFrame != NULL && pFrame != FRAME_TOP)
+        {
+            m_callSite = pFrame->GetReturnAddress();
+        }
+    }
+
+    t_fTimingMonitorContention = true;
+    m_startTime = LockContentionProfiler::GetTimestamp();
+}
+
+void MonitorContentionHolder::End()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    LockContentionProfiler::RecordMonitorContention(m_callSite, m_startTime);
+    t_fTimingMonitorContention = false;
+}
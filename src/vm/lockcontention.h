@@ -0,0 +1,190 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+#ifndef __LOCKCONTENTION_H__
+#define __LOCKCONTENTION_H__
+
+#ifdef FEATURE_PERFTRACING
+class EventPipeProvider;
+class EventPipeEvent;
+#endif // FEATURE_PERFTRACING
+
+enum LockContentionKind
+{
+    LockContention_Crst = 0,        // one record per CrstType
+    LockContention_SpinLock = 1,    // one record per LOCK_TYPE
+    LockContention_Monitor = 2,     // one record per call site of Monitor.Enter
+    LockContention_Count = 3
+};
+
+struct LockContentionCounts
+{
+    SIZE_T m_acquireCount;          // every acquisition, contended or not
+    LONGLONG m_contentionCount;     // acquisitions that had to spin or block
+    LONGLONG m_waitTicks;           // QueryPerformanceCounter ticks spent in contended acquisitions
+};
+
+// Counts acquisitions and contention of the runtime's own locks when the LockContentionProfiling knob is set.
+// Crsts are tracked per CrstType and SpinLocks per LOCK_TYPE. Uncontended monitor acquisitions never leave the
+// JIT helper fast paths, so monitors are only tracked once contended, per call site, where the call site is
+// the return address of the frame that entered the runtime. The gate thread writes the counts added since the
+// last time as EventPipe events once per publishing interval.
+//
+// Acquire counts are bumped without interlocked operations, so that an uncontended lock does not get a
+// second contended cache line; racing threads may lose a few of them. Contended counts and wait times are
+// exact.
+class LockContentionProfiler
+{
+    public:
+
+        static const unsigned int MonitorCallSiteCount = 1024;  // power of two
+
+        static void Initialize();
+
+        static bool IsEnabled()
+        {
+            LIMITED_METHOD_CONTRACT;
+            return s_enabled;
+        }
+
+        // Timestamp to pass to the Record*Contention methods, 0 when contention is not being recorded
+        static LONGLONG GetTimestamp()
+        {
+            LIMITED_METHOD_CONTRACT;
+
+            if (!s_enabled)
+                return 0;
+
+            LARGE_INTEGER timestamp;
+            QueryPerformanceCounter(&timestamp);
+            return timestamp.QuadPart;
+        }
+
+        static void RecordCrstAcquire(CrstType crstType)
+        {
+            LIMITED_METHOD_CONTRACT;
+            _ASSERTE((unsigned int)crstType < kNumberOfCrstTypes);
+            RecordAcquire(&s_crstCounts[crstType]);
+        }
+
+        static void RecordCrstContention(CrstType crstType, LONGLONG startTime)
+        {
+            LIMITED_METHOD_CONTRACT;
+            _ASSERTE((unsigned int)crstType < kNumberOfCrstTypes);
+            RecordContention(&s_crstCounts[crstType], startTime);
+        }
+
+        static void RecordSpinLockAcquire(LOCK_TYPE lockType)
+        {
+            LIMITED_METHOD_CONTRACT;
+            _ASSERTE((unsigned int)lockType <= LOCK_TYPE_DEFAULT);
+            RecordAcquire(&s_spinLockCounts[lockType]);
+        }
+
+        static void RecordSpinLockContention(LOCK_TYPE lockType, LONGLONG startTime)
+        {
+            LIMITED_METHOD_CONTRACT;
+            _ASSERTE((unsigned int)lockType <= LOCK_TYPE_DEFAULT);
+            RecordContention(&s_spinLockCounts[lockType], startTime);
+        }
+
+        static void RecordMonitorContention(PCODE callSite, LONGLONG startTime);
+
+        // Called by the gate thread on every pass; publishes the counts once per publishing interval
+        static void PublishIfDue();
+
+        // Copies the counts recorded since the process started. Returns FALSE if there is no such record.
+        // Monitor records are looked up by call site; the call site 0 holds the contention of call sites that
+        // did not fit in the table.
+        static BOOL GetCounts(LockContentionKind kind, SIZE_T id, LockContentionCounts* pCounts);
+
+    private:
+
+        struct MonitorCallSite
+        {
+            PCODE m_callSite;               // 0 while the entry is free
+            LockContentionCounts m_counts;
+        };
+
+        static void RecordAcquire(LockContentionCounts* pCounts)
+        {
+            LIMITED_METHOD_CONTRACT;
+            VolatileStore(&pCounts->m_acquireCount, VolatileLoadWithoutBarrier(&pCounts->m_acquireCount) + 1);
+        }
+
+        static void RecordContention(LockContentionCounts* pCounts, LONGLONG startTime);
+
+        static LockContentionCounts* GetMonitorCounts(PCODE callSite);
+
+        static void PublishCounts(LockContentionKind kind, SIZE_T id, const LockContentionCounts* pCounts,
+                                  LockContentionCounts* pLastPublishedCounts, bool fTracing);
+
+#ifdef FEATURE_PERFTRACING
+        static void EnsureEventPipeProvider();
+        static void WriteContentionEvent(LockContentionKind kind, SIZE_T id, const LockContentionCounts* pCounts);
+#endif // FEATURE_PERFTRACING
+
+        static bool s_enabled;
+        static double s_nanosecondsPerTick;
+        static DWORD s_publishingInterval;
+        static DWORD s_lastPublishTime;
+
+        static LockContentionCounts s_crstCounts[kNumberOfCrstTypes];
+        static LockContentionCounts s_spinLockCounts[LOCK_TYPE_DEFAULT + 1];
+
+        // Open addressing on the call site; entries are never removed
+        static MonitorCallSite s_monitorCallSites[MonitorCallSiteCount];
+        static LockContentionCounts s_monitorOverflowCounts;
+
+        // Counts as of the last publishing interval; only used by the gate thread
+        static LockContentionCounts s_lastPublishedCrstCounts[kNumberOfCrstTypes];
+        static LockContentionCounts s_lastPublishedSpinLockCounts[LOCK_TYPE_DEFAULT + 1];
+        static LockContentionCounts s_lastPublishedMonitorCounts[MonitorCallSiteCount];
+        static LockContentionCounts s_lastPublishedMonitorOverflowCounts;
+
+#ifdef FEATURE_PERFTRACING
+        static const GUID s_providerID;
+        static EventPipeProvider* s_pEventPipeProvider;
+        static EventPipeEvent* s_pContentionEvents[LockContention_Count];
+#endif // FEATURE_PERFTRACING
+};
+
+// Times a contended monitor acquisition for LockContentionProfiler. Only the outermost holder on a thread
+// records, so that an acquisition that spins in AwareLock::Contention and then blocks in AwareLock::EnterEpilog
+// is counted once.
+class MonitorContentionHolder
+{
+    public:
+
+        MonitorContentionHolder()
+        {
+            WRAPPER_NO_CONTRACT;
+
+            m_startTime = 0;
+            if (LockContentionProfiler::IsEnabled())
+            {
+                Begin();
+            }
+        }
+
+        ~MonitorContentionHolder()
+        {
+            WRAPPER_NO_CONTRACT;
+
+            if (m_startTime != 0)
+            {
+                End();
+            }
+        }
+
+    private:
+
+        void Begin();
+        void End();
+
+        LONGLONG m_startTime;
+        PCODE m_callSite;
+};
+
+#endif // __LOCKCONTENTION_H__
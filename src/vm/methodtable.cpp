@@ -138,8 +138,8 @@ class MethodDataCache
         { WRAPPER_NO_CONTRACT; return GetEntryData() + i; }
 
   private:
-    // This serializes access to the cache
-    SimpleRWLock    m_lock;
+    // This serializes access to the cache. Lookups far outnumber insertions, so it is reader biased.
+    ReaderBiasedRWLock m_lock;
 
     // This allows ageing of entries to decide which to punt when
     // inserting a new entry.
@@ -215,7 +215,7 @@ MethodTable::MethodData *MethodDataCache::Find(MethodTable *pMTDecl, MethodTable
     g_sdStats.m_cCacheLookups++;
 #endif
 
-    SimpleReadLockHolder lh(&m_lock);
+    ReaderBiasedReadLockHolder lh(&m_lock);
 
     // Check the last touched entry.
     MethodData *pEntry = FindHelper(pMTDecl, pMTImpl, GetLastTouchedEntryIndex());
@@ -261,7 +261,7 @@ void MethodDataCache::Insert(MethodData *pMData)
         INSTANCE_CHECK;
     } CONTRACTL_END;
 
-    SimpleWriteLockHolder hLock(&m_lock);
+    ReaderBiasedWriteLockHolder hLock(&m_lock);
 
     UINT32 iMin = UINT32_MAX;
     UINT32 idxMin = UINT32_MAX;
@@ -293,7 +293,7 @@ void MethodDataCache::Clear()
     // should be suspended because this is called while unloading an
     // AppDomain at the SysSuspendEE stage. But, if someone calls it
     // outside of that context, we should be extra cautious.
-    SimpleWriteLockHolder lh(&m_lock);
+    ReaderBiasedWriteLockHolder lh(&m_lock);
 
     for (UINT32 i = 0; i < NumEntries(); i++) {
         Entry *pEntry = GetEntry(i);
@@ -2193,6 +2193,23 @@ public:
         return offsetof(MethodTable, m_dwFlags);
     } 
 
+    static UINT32 GetOffsetOfBaseSize()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return offsetof(MethodTable, m_BaseSize);
+    } 
+
+    // Offset of the WORD returned by RawGetComponentSize
+    static UINT32 GetOffsetOfComponentSize()
+    {
+        LIMITED_METHOD_CONTRACT;
+#if BIGENDIAN
+        return offsetof(MethodTable, m_dwFlags) + sizeof(WORD);
+#else // !BIGENDIAN
+        return offsetof(MethodTable, m_dwFlags);
+#endif // !BIGENDIAN
+    } 
+
     static UINT32 GetIfArrayThenSzArrayFlag()
     {
         LIMITED_METHOD_CONTRACT;
@@ -933,6 +933,11 @@ DEFINE_CLASS(PARAMETERIZEDTHREADSTART,     Threading,                 Parameteri
 DEFINE_CLASS(IOCB_HELPER,              Threading,            _IOCompletionCallback)
 DEFINE_METHOD(IOCB_HELPER,             PERFORM_IOCOMPLETION_CALLBACK,        PerformIOCompletionCallback,          SM_UInt_UInt_PtrNativeOverlapped_RetVoid)
 
+#ifdef FEATURE_PAL
+DEFINE_CLASS(IO_READINESS_REGISTRATION,         Threading,            IoReadinessRegistration)
+DEFINE_METHOD(IO_READINESS_REGISTRATION,        PERFORM_IO_READINESS_CALLBACK,       PerformIoReadinessCallback,          SM_Obj_Int_RetVoid)
+#endif // FEATURE_PAL
+
 DEFINE_CLASS(TPWAITORTIMER_HELPER,              Threading,            _ThreadPoolWaitOrTimerCallback)
 DEFINE_METHOD(TPWAITORTIMER_HELPER,             PERFORM_WAITORTIMER_CALLBACK,        PerformWaitOrTimerCallback,          SM_Obj_Bool_RetVoid)
 
@@ -0,0 +1,129 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+//
+
+//
+
+#include "common.h"
+#include "readerbiasedrwlock.hpp"
+
+BOOL ReaderBiasedRWLock::s_fEnabled = FALSE;
+ReaderBiasedRWLock * ReaderBiasedRWLock::s_visibleReaders[VisibleReaderCount];
+
+// Only its address is used, to tell threads apart without a call into the OS
+static __declspec(thread) BYTE t_readerIdentity;
+
+//=====================================================================
+void ReaderBiasedRWLock::Initialize()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    // With a single processor there is no cache line to bounce
+    s_fEnabled = (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ReaderBiasedLocks) != 0) &&
+                 (GetCurrentProcessCpuCount() > 1);
+}
+
+//=====================================================================
+ReaderBiasedRWLock ** ReaderBiasedRWLock::GetVisibleReaderSlot()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    // Fibonacci hashing of the lock and the thread, so that the readers of a lock spread over the table
+    UINT64 hash = ((UINT64)(SIZE_T)this >> 3) ^ ((UINT64)(SIZE_T)&t_readerIdentity << 13);
+    hash *= UI64(0x9E3779B97F4A7C15);
+    return &s_visibleReaders[(UINT32)(hash >> 32) & (VisibleReaderCount - 1)];
+}
+
+//=====================================================================
+ReaderBiasedRWLock ** ReaderBiasedRWLock::EnterRead()
+{
+    STATIC_CONTRACT_NOTHROW;
+    STATIC_CONTRACT_CAN_TAKE_LOCK;
+
+    if (m_readerBias)
+    {
+        ReaderBiasedRWLock ** pSlot = GetVisibleReaderSlot();
+        if (VolatileLoad(pSlot) == NULL &&
+            FastInterlockCompareExchangePointer(pSlot, this, (ReaderBiasedRWLock *)NULL) == NULL)
+        {
+            // The interlocked operation orders the publication before this read. A writer clears the
+            // bias before it scans the table, so either it sees the slot or we see the bias cleared.
+            if (m_readerBias)
+            {
+                INCTHREADLOCKCOUNT();
+                EE_LOCK_TAKEN(this);
+                return pSlot;
+            }
+
+            VolatileStore(pSlot, (ReaderBiasedRWLock *)NULL);
+        }
+    }
+
+    m_lock.EnterRead();
+
+    // No writer holds the lock now, so the bias can be turned back on if writers have been quiet for long enough
+    if (!m_readerBias && s_fEnabled)
+    {
+        LARGE_INTEGER now;
+        QueryPerformanceCounter(&now);
+        if (now.QuadPart >= m_inhibitUntil)
+        {
+            m_readerBias = TRUE;
+        }
+    }
+
+    return NULL;
+}
+
+//=====================================================================
+void ReaderBiasedRWLock::EnterWrite()
+{
+    STATIC_CONTRACT_NOTHROW;
+    STATIC_CONTRACT_CAN_TAKE_LOCK;
+
+    m_lock.EnterWrite();
+
+    if (m_readerBias)
+    {
+        RevokeReaderBias();
+    }
+}
+
+//=====================================================================
+// Turns the bias off and waits for the readers that went through the table to leave. Called with the
+// underlying lock held for writing, so no new reader can turn the bias back on.
+void ReaderBiasedRWLock::RevokeReaderBias()
+{
+    STATIC_CONTRACT_NOTHROW;
+    STATIC_CONTRACT_CAN_TAKE_LOCK;
+
+    LARGE_INTEGER start;
+    QueryPerformanceCounter(&start);
+
+    // The interlocked operation orders clearing the bias before the scan
+    FastInterlockExchange((LONG *)&m_readerBias, FALSE);
+
+    {
+        GCX_MAYBE_PREEMP(m_gcMode == PREEMPTIVE);
+
+        DWORD dwSwitchCount = 0;
+        for (UINT32 i = 0; i < VisibleReaderCount; i++)
+        {
+            while (VolatileLoad(&s_visibleReaders[i]) == this)
+            {
+                __SwitchToThread(0, ++dwSwitchCount);
+            }
+        }
+    }
+
+    LARGE_INTEGER end;
+    QueryPerformanceCounter(&end);
+    m_inhibitUntil = end.QuadPart + (end.QuadPart - start.QuadPart) * InhibitMultiplier;
+}
@@ -0,0 +1,175 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+//
+
+//
+
+#ifndef _ReaderBiasedRWLock_hpp_
+#define _ReaderBiasedRWLock_hpp_
+
+#include "simplerwlock.hpp"
+
+//-------------------------------------------------------------------------------------------
+// ReaderBiasedRWLock
+//
+// A SimpleRWLock for read-mostly data, in the style of BRAVO (Dice and Kogan, "BRAVO - Biased
+// Locking for Reader-Writer Locks"). Readers of a SimpleRWLock all increment its lock word, so
+// the cache line of the lock bounces between the cores that read. While the lock is reader
+// biased, a reader instead publishes the lock in a slot of a process wide table of visible
+// readers, picked by hashing the lock and the thread. Readers on different cores mostly write
+// to different cache lines, and the table is shared by all locks, so a lock costs no more
+// memory than a SimpleRWLock.
+//
+// A writer takes the underlying lock, then revokes the bias and waits until no slot of the
+// table holds the lock any more. Revocation scans the whole table, so the bias stays off for
+// a multiple of the time the revocation took; the first reader that takes the underlying lock
+// after that turns it back on. Readers fall back to the underlying lock while the bias is off
+// and when their slot is taken, which also covers recursive reads.
+//
+// Readers and writers follow the GC_MODE of the underlying lock. A reader that gets in through
+// the table never waits, so it does not switch modes.
+//-------------------------------------------------------------------------------------------
+class ReaderBiasedRWLock
+{
+public:
+    ReaderBiasedRWLock (GC_MODE gcMode, LOCK_TYPE locktype)
+        : m_lock (gcMode, locktype),
+          m_gcMode (gcMode)
+    {
+        CONTRACTL {
+            NOTHROW;
+            GC_NOTRIGGER;
+        } CONTRACTL_END;
+
+        m_readerBias = FALSE;
+        m_inhibitUntil = 0;
+    }
+
+    // Special empty CTOR for DAC. We still need to assign to const fields, but they won't actually be used.
+    ReaderBiasedRWLock()
+        : m_gcMode(COOPERATIVE_OR_PREEMPTIVE)
+    {
+        LIMITED_METHOD_CONTRACT;
+    }
+
+    // Reads the configuration; until it is called, readers always take the underlying lock
+    static void Initialize();
+
+#ifndef DACCESS_COMPILE
+    // Acquire the reader lock. Returns the slot of the table the reader went through, or NULL if it
+    // took the underlying lock; pass it to LeaveRead.
+    ReaderBiasedRWLock ** EnterRead();
+
+    // Acquire the writer lock.
+    void EnterWrite();
+
+    // Leave the reader lock.
+    void LeaveRead(ReaderBiasedRWLock ** pSlot)
+    {
+        LIMITED_METHOD_CONTRACT;
+
+        if (pSlot == NULL)
+        {
+            m_lock.LeaveRead();
+            return;
+        }
+
+        _ASSERTE(*pSlot == this);
+        VolatileStore(pSlot, (ReaderBiasedRWLock *)NULL);
+        DECTHREADLOCKCOUNT();
+        EE_LOCK_RELEASED(this);
+    }
+
+    // Leave the writer lock.
+    void LeaveWrite()
+    {
+        LIMITED_METHOD_CONTRACT;
+        m_lock.LeaveWrite();
+    }
+#endif // DACCESS_COMPILE
+
+    BOOL IsWriterLock ()
+    {
+        LIMITED_METHOD_DAC_CONTRACT;
+        return m_lock.IsWriterLock();
+    }
+
+    // Readers need to remember how they got in, so the read holder is not a plain Holder.
+    class ReadLockHolder
+    {
+    public:
+        ReadLockHolder(ReaderBiasedRWLock * pLock)
+        {
+            SUPPORTS_DAC;
+#ifndef DACCESS_COMPILE
+            m_pLock = pLock;
+            m_pSlot = pLock->EnterRead();
+#else // DACCESS_COMPILE
+            // in DAC builds, we don't actually acquire the lock, we just determine whether the LS
+            // already holds it. If so, we assume the data is inconsistent and throw an exception.
+            if (pLock->IsWriterLock())
+            {
+                ThrowHR(CORDBG_E_PROCESS_NOT_SYNCHRONIZED);
+            }
+#endif // DACCESS_COMPILE
+        }
+
+        ~ReadLockHolder()
+        {
+            LIMITED_METHOD_DAC_CONTRACT;
+#ifndef DACCESS_COMPILE
+            m_pLock->LeaveRead(m_pSlot);
+#endif // DACCESS_COMPILE
+        }
+
+    private:
+#ifndef DACCESS_COMPILE
+        ReaderBiasedRWLock * m_pLock;
+        ReaderBiasedRWLock ** m_pSlot;
+#endif // DACCESS_COMPILE
+    };
+
+private:
+#ifndef DACCESS_COMPILE
+    static void AcquireWriteLock(ReaderBiasedRWLock *s) { LIMITED_METHOD_CONTRACT; s->EnterWrite(); }
+    static void ReleaseWriteLock(ReaderBiasedRWLock *s) { LIMITED_METHOD_CONTRACT; s->LeaveWrite(); }
+#else // DACCESS_COMPILE
+    static void AcquireWriteLock(ReaderBiasedRWLock *s) { SUPPORTS_DAC; ThrowHR(CORDBG_E_TARGET_READONLY); };
+    static void ReleaseWriteLock(ReaderBiasedRWLock *s) { };
+#endif // DACCESS_COMPILE
+
+public:
+    typedef DacHolder<ReaderBiasedRWLock *, ReaderBiasedRWLock::AcquireWriteLock, ReaderBiasedRWLock::ReleaseWriteLock> WriteLockHolder;
+
+private:
+    // Power of two. 32K of pointers, as in the paper; a revocation scans all of it.
+    static const UINT32 VisibleReaderCount = 4096;
+
+    // How many times longer than the last revocation took the bias stays off
+    static const UINT32 InhibitMultiplier = 9;
+
+#ifndef DACCESS_COMPILE
+    ReaderBiasedRWLock ** GetVisibleReaderSlot();
+    void RevokeReaderBias();
+#endif // DACCESS_COMPILE
+
+    SimpleRWLock        m_lock;
+
+    const GC_MODE       m_gcMode;
+
+    // Set while readers may go through the visible readers table. Only set by readers that hold
+    // the underlying lock and only cleared by writers that hold it.
+    Volatile<BOOL>      m_readerBias;
+
+    // QueryPerformanceCounter value before which readers leave the bias off
+    LONGLONG            m_inhibitUntil;
+
+    static BOOL s_fEnabled;
+    static ReaderBiasedRWLock * s_visibleReaders[VisibleReaderCount];
+};
+
+typedef ReaderBiasedRWLock::ReadLockHolder ReaderBiasedReadLockHolder;
+typedef ReaderBiasedRWLock::WriteLockHolder ReaderBiasedWriteLockHolder;
+
+#endif // _ReaderBiasedRWLock_hpp_
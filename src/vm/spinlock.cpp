@@ -14,6 +14,7 @@
 #include "spinlock.h"
 #include "threads.h"
 #include "corhost.h"
+#include "lockcontention.h"
 
 enum
 {
@@ -92,8 +93,9 @@ void SpinLock::Init(LOCK_TYPE type, bool RequireCoopGC)
         m_lock = 0;
     }
 
-#ifdef _DEBUG
     m_LockType = type;
+
+#ifdef _DEBUG
     m_requireCoopGCMode = RequireCoopGC;
 #endif
 
@@ -157,6 +159,12 @@ void SpinLock::GetLock(Thread* pThread)
         {
             SpinToAcquire();
         }
+#if !defined(DACCESS_COMPILE) && !defined(CROSSGEN_COMPILE)
+        else if (LockContentionProfiler::IsEnabled())
+        {
+            LockContentionProfiler::RecordSpinLockAcquire(m_LockType);
+        }
+#endif // !DACCESS_COMPILE && !CROSSGEN_COMPILE
     }
 
     INCTHREADLOCKCOUNTTHREAD(pThread);
@@ -243,6 +251,9 @@ SpinLock::SpinToAcquire()
 
     DWORD backoffs = 0;
     ULONG ulSpins = 0;
+#if !defined(DACCESS_COMPILE) && !defined(CROSSGEN_COMPILE)
+    LONGLONG startTime = LockContentionProfiler::GetTimestamp();
+#endif // !DACCESS_COMPILE && !CROSSGEN_COMPILE
 
     while (true)
     {
@@ -272,6 +283,13 @@ SpinLock::SpinToAcquire()
         __SwitchToThread(0, backoffs++);
     }
 
+#if !defined(DACCESS_COMPILE) && !defined(CROSSGEN_COMPILE)
+    if (startTime != 0)
+    {
+        LockContentionProfiler::RecordSpinLockContention(m_LockType, startTime);
+    }
+#endif // !DACCESS_COMPILE && !CROSSGEN_COMPILE
+
 #ifdef _DEBUG
     //profile info
     SpinLockProfiler::IncrementCollisions (m_LockType);
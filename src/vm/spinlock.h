@@ -165,9 +165,9 @@ private:
     Volatile<SpinLockState>      m_Initialized; // To verify initialized
                                         // And initialize once
 
-#ifdef _DEBUG
     LOCK_TYPE           m_LockType;     // lock type to track statistics
-    
+
+#ifdef _DEBUG
     // Check for dead lock situation.
     bool                m_requireCoopGCMode;
     EEThreadId          m_holdingThreadId;
@@ -177,7 +177,7 @@ public:
     SpinLock ();
     ~SpinLock ();
 
-    //Init method, initialize lock and _DEBUG flags
+    //Init method, initialize lock, lock type and _DEBUG flags
     void Init(LOCK_TYPE type, bool RequireCoopGC = FALSE);
 
     //-----------------------------------------------------------------
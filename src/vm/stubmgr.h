@@ -32,6 +32,7 @@
 #define __stubmgr_h__
 
 #include "simplerwlock.hpp"
+#include "readerbiasedrwlock.hpp"
 
 // When 'TraceStub' returns, it gives the address of where the 'target' is for a stub'
 // TraceType indicates what this 'target' is
@@ -331,7 +332,9 @@ private:
 
 // -------------------------------------------------------
 // This just wraps the RangeList methods in a read or
-// write lock depending on the operation.
+// write lock depending on the operation. Ranges are looked
+// up on every stub check and rarely added, so the lock is
+// reader biased.
 // -------------------------------------------------------
 
 class LockedRangeList : public RangeList
@@ -354,14 +357,14 @@ class LockedRangeList : public RangeList
     virtual BOOL AddRangeWorker(const BYTE *start, const BYTE *end, void *id)
     {
         WRAPPER_NO_CONTRACT;
-        SimpleWriteLockHolder lh(&m_RangeListRWLock);
+        ReaderBiasedWriteLockHolder lh(&m_RangeListRWLock);
         return RangeList::AddRangeWorker(start,end,id);
     }
 
     virtual void RemoveRangesWorker(void *id, const BYTE *start = NULL, const BYTE *end = NULL)
     {
         WRAPPER_NO_CONTRACT;
-        SimpleWriteLockHolder lh(&m_RangeListRWLock);
+        ReaderBiasedWriteLockHolder lh(&m_RangeListRWLock);
         RangeList::RemoveRangesWorker(id,start,end);
     }
 
@@ -369,11 +372,11 @@ class LockedRangeList : public RangeList
     {
         WRAPPER_NO_CONTRACT;
         SUPPORTS_DAC;
-        SimpleReadLockHolder lh(&m_RangeListRWLock);
+        ReaderBiasedReadLockHolder lh(&m_RangeListRWLock);
         return RangeList::IsInRangeWorker(address, pID);
     }
 
-    SimpleRWLock m_RangeListRWLock;
+    ReaderBiasedRWLock m_RangeListRWLock;
 };
 
 #ifndef CROSSGEN_COMPILE
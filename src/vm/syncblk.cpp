@@ -30,6 +30,8 @@
 #include "corhost.h"
 #include "comdelegate.h"
 #include "finalizerthread.h"
+#include "win32threadpool.h"
+#include "lockcontention.h"
 
 #ifdef FEATURE_COMINTEROP
 #include "runtimecallablewrapper.h"
@@ -518,6 +520,8 @@ SyncBlockCache::SyncBlockCache()
       m_ActiveCount(0),
       m_SyncBlocks(0),
       m_FreeSyncBlock(0),
+      m_InflationCount(0),
+      m_DeflationCount(0),
       m_FreeSyncTableIndex(1),
       m_FreeSyncTableList(0),
       m_SyncTableSize(SYNC_TABLE_INITIAL_SIZE),
@@ -1055,6 +1059,7 @@ SyncBlock *SyncBlockCache::GetNextFreeSyncBlock()
     SLink           *plst = m_FreeBlockList;
 
     m_ActiveCount++;
+    m_InflationCount++;
 
     if (plst)
     {
@@ -1354,6 +1359,13 @@ void SyncBlockCache::GCWeakPtrScan(HANDLESCANPROC scanProc, uintptr_t lp1, uintp
 
     // First delete the obsolete arrays since we have exclusive access
     BOOL fSetSyncBlockCleanup = FALSE;
+    DWORD initialDeflationCount = m_DeflationCount;
+
+    // Marking scans first; the relocation scan that may follow belongs to the same GC
+    if (((ScanContext*)lp1)->promotion)
+    {
+        AwareLock::s_dwSyncBlockScan++;
+    }
 
     SyncTableEntry* arr;
     while ((arr = m_OldSyncTables) != NULL)
@@ -1484,6 +1496,12 @@ void SyncBlockCache::GCWeakPtrScan(HANDLESCANPROC scanProc, uintptr_t lp1, uintp
         FinalizerThread::EnableFinalization();
     }
 
+    if (m_DeflationCount != initialDeflationCount)
+    {
+        STRESS_LOG3(LF_GC | LF_SYNC, LL_INFO100, "GCWeakPtrScan deflated %d sync blocks (%d inflations, %d deflations so far)\n",
+                    m_DeflationCount - initialDeflationCount, m_InflationCount, m_DeflationCount);
+    }
+
 #if defined(VERIFY_HEAP)
     if (g_pConfig->GetHeapVerifyLevel() & EEConfig::HEAPVERIFY_GC)
     {
@@ -1568,7 +1586,21 @@ BOOL SyncBlockCache::GCWeakPtrScanElement (int nb, HANDLESCANPROC scanProc, LPAR
             if (*keyv)
             {
                 _ASSERTE (pSB);
-                GCDeleteSyncBlock(pSB);
+
+                // The object is alive and goes back to a thin lock
+                m_DeflationCount++;
+
+                if (pSB->m_Monitor.m_SemEvent.IsMonitorEventAllocated())
+                {
+                    // Closing the event is left to the finalizer thread, as for the sync blocks of dead objects
+                    cleanup = TRUE;
+                    InsertCleanupSyncBlock(pSB);
+                }
+                else
+                {
+                    GCDeleteSyncBlock(pSB);
+                }
+
                 //clean the object syncblock header
                 ((Object*)(*keyv))->GetHeader()->GCResetIndex();
             }
@@ -1859,6 +1891,7 @@ void DumpSyncBlockCache()
             LogSpewAlways("[%4.4d]: %s\n", nb, descrip);
     }
     LogSpewAlways("Done dumping SyncBlockCache used slots: %d, objects: %d\n", slotCount, objectCount);
+    LogSpewAlways("Sync blocks inflated: %d, deflated: %d\n", pCache->GetInflationCount(), pCache->GetDeflationCount());
 }
 #endif
 
@@ -1901,6 +1934,57 @@ BOOL ObjHeader::TryEnterObjMonitor(INT32 timeOut)
     return GetSyncBlock()->TryEnterMonitor(timeOut);
 }
 
+// Waiting for a monitor takes a sync block, which the object keeps until the GC finds its lock idle. Most
+// contention on thin locks is brief, so spin some more, yielding the processor between rounds, before
+// giving up on the thin lock. The caller protects the object, since yielding switches to preemptive mode.
+BOOL ObjHeader::SpinOnThinLock(OBJECTREF *pObjRef)
+{
+    CONTRACTL
+    {
+        THROWS;
+        GC_TRIGGERS;
+        MODE_COOPERATIVE;
+        PRECONDITION(CheckPointer(pObjRef));
+    }
+    CONTRACTL_END;
+
+    if (g_SystemInfo.dwNumberOfProcessors <= 1)
+    {
+        return FALSE;
+    }
+
+    Thread *pCurThread = GetThread();
+
+    for (DWORD iter = 0; iter < AwareLock::GetThinLockSpinRetryCount(); iter++)
+    {
+        // Inflated locks spin in AwareLock::Contention instead
+        ObjHeader *pHeader = (*pObjRef)->GetHeader();
+        if (pHeader->GetBits() & BIT_SBLK_IS_HASH_OR_SYNCBLKINDEX)
+        {
+            return FALSE;
+        }
+
+        AwareLock::EnterHelperResult result = pHeader->EnterObjMonitorHelperSpin(pCurThread);
+        if (result == AwareLock::EnterHelperResult_Entered)
+        {
+            return TRUE;
+        }
+        if (result == AwareLock::EnterHelperResult_UseSlowPath)
+        {
+            return FALSE;
+        }
+
+        pCurThread->HandleThreadAbort();
+
+        {
+            GCX_PREEMP();
+            __SwitchToThread(0, CALLER_LIMITS_SPINNING);
+        }
+    }
+
+    return FALSE;
+}
+
 BOOL ObjHeader::LeaveObjMonitor()
 {
     CONTRACTL
@@ -2798,6 +2882,99 @@ void ObjHeader::PulseAll()
 //
 // ***************************************************************************
 
+#ifdef FEATURE_PAL
+bool AwareLock::s_fUseWaitOnAddress = false;
+#endif // FEATURE_PAL
+bool AwareLock::s_fAdaptiveSpin = false;
+bool AwareLock::s_fDeflateIdleMonitors = false;
+DWORD AwareLock::s_dwThinLockSpinRetryCount = 0;
+DWORD AwareLock::s_dwSyncBlockScan = 1;
+
+void AwareLock::Initialize()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    s_fAdaptiveSpin = (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_Monitor_AdaptiveSpin) != 0);
+    s_fDeflateIdleMonitors = (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_Monitor_DeflateIdleSyncBlocks) != 0);
+    s_dwThinLockSpinRetryCount = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_Monitor_ThinLockSpinRetryCount);
+
+#ifdef FEATURE_PAL
+    // This is decided before any monitor has waiters, since Signal and the waiters have to agree on where to
+    // park. Waiting on a value other than the current one returns right away where the PAL supports it.
+    if (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_Monitor_UseWaitOnAddress) != 0)
+    {
+        LONG probe = 1;
+        s_fUseWaitOnAddress = (PAL_WaitOnAddress(&probe, 0, 0, FALSE) == WAIT_OBJECT_0);
+    }
+#endif // FEATURE_PAL
+}
+
+#ifdef FEATURE_PAL
+// AppropriateWaitFunc that parks the thread on m_WaitSignal until Signal is called, consuming the signal
+// the way waiting on m_SemEvent would. Futex wakeups can be spurious, hence the loop.
+DWORD AwareLock::WaitForSignal(void *args, DWORD timeout, DWORD option)
+{
+    STATIC_CONTRACT_NOTHROW;
+    STATIC_CONTRACT_GC_NOTRIGGER;
+    STATIC_CONTRACT_MODE_PREEMPTIVE;
+
+    AwareLock *pThis = (AwareLock *)args;
+    ULONGLONG start = (timeout != INFINITE) ? CLRGetTickCount64() : 0;
+    DWORD remaining = timeout;
+
+    for (;;)
+    {
+        if (FastInterlockExchange(&pThis->m_WaitSignal, 0) != 0)
+        {
+            return WAIT_OBJECT_0;
+        }
+
+        if (timeout != INFINITE)
+        {
+            ULONGLONG elapsed = CLRGetTickCount64() - start;
+            if (elapsed >= timeout)
+            {
+                return WAIT_TIMEOUT;
+            }
+            remaining = timeout - (DWORD)elapsed;
+        }
+
+        DWORD ret = PAL_WaitOnAddress(&pThis->m_WaitSignal, 0, remaining, (option & WAIT_ALERTABLE) != 0);
+        if ((ret != WAIT_OBJECT_0) && (ret != WAIT_TIMEOUT))
+        {
+            // WAIT_IO_COMPLETION is handled by Thread::DoAppropriateWait, which calls back
+            return ret;
+        }
+    }
+}
+#endif // FEATURE_PAL
+
+// Feeds the outcome of a spinning phase in Contention back into the spin duration of the lock
+void AwareLock::UpdateSpinDuration(DWORD dwSpun, bool fEntered)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DWORD dwDuration = m_dwSpinDuration;
+    if (fEntered)
+    {
+        // Move a quarter of the way toward the latest duration, or start from it
+        dwDuration = (dwDuration == 0) ? dwSpun : (dwDuration - dwDuration / 4 + dwSpun / 4);
+    }
+    else
+    {
+        // Spinning did not pay off, the lock is held for long. Spin for less next time.
+        dwDuration /= 2;
+    }
+
+    m_dwSpinDuration = max(dwDuration, g_SpinConstants.dwInitialDuration);
+}
+
 void AwareLock::AllocLockSemEvent()
 {
     CONTRACTL
@@ -2810,10 +2987,13 @@ void AwareLock::AllocLockSemEvent()
     }
     CONTRACTL_END;
 
-    // Before we switch from cooperative, ensure that this syncblock won't disappear
-    // under us.  For something as expensive as an event, do it permanently rather
-    // than transiently.
-    SetPrecious();
+    // The caller keeps this syncblock from disappearing under us while it waits. Unless
+    // the GC may deflate idle monitors, hold on to it permanently rather than transiently,
+    // for something as expensive as an event.
+    if (!s_fDeflateIdleMonitors)
+    {
+        SetPrecious();
+    }
 
     GCX_PREEMP();
 
@@ -3051,6 +3231,8 @@ BOOL AwareLock::EnterEpilog(Thread* pCurThread, INT32 timeOut)
     blockingMonitorInfo.type = DebugBlock_MonitorCriticalSection;
     DebugBlockingItemHolder holder(pCurThread, &blockingMonitorInfo);
 
+    MonitorContentionHolder contentionHolder;
+
     // We need a separate helper because it uses SEH and the holder has a
     // destructor
     return EnterEpilogHelper(pCurThread, timeOut);
@@ -3076,17 +3258,27 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
 
     // We cannot allow the AwareLock to be cleaned up underneath us by the GC.
     IncrementTransientPrecious();
+    RecordContention();
 
     GCPROTECT_BEGIN(obj);
     {
-        if (!m_SemEvent.IsMonitorEventAllocated())
+#ifdef FEATURE_PAL
+        // Waiters park on m_WaitSignal instead, which needs no allocation
+        if (!s_fUseWaitOnAddress)
+#endif // FEATURE_PAL
         {
-            AllocLockSemEvent();
+            if (!m_SemEvent.IsMonitorEventAllocated())
+            {
+                AllocLockSemEvent();
+            }
+            _ASSERTE(m_SemEvent.IsMonitorEventAllocated());
         }
-        _ASSERTE(m_SemEvent.IsMonitorEventAllocated());
 
         pCurThread->EnablePreemptiveGC();
 
+        // A thread pool worker counts as blocked for the whole contended acquisition, not just for each wait
+        bool fBlockingCounted = ThreadpoolMgr::NotifyBlockingBegin();
+
         for (;;)
         {
             // We might be interrupted during the wait (Thread.Interrupt), so we need an
@@ -3108,7 +3300,16 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
                 // accordingly.
                 ULONGLONG start = CLRGetTickCount64();
 
-                pParam->ret = pParam->pThis->m_SemEvent.Wait(pParam->timeOut, TRUE);
+#ifdef FEATURE_PAL
+                if (s_fUseWaitOnAddress)
+                {
+                    pParam->ret = GetThread()->DoAppropriateWait(WaitForSignal, pParam->pThis, pParam->timeOut, WaitMode_Alertable);
+                }
+                else
+#endif // FEATURE_PAL
+                {
+                    pParam->ret = pParam->pThis->m_SemEvent.Wait(pParam->timeOut, TRUE);
+                }
                 _ASSERTE((pParam->ret == WAIT_OBJECT_0) || (pParam->ret == WAIT_TIMEOUT));
 
                 // When calculating duration we consider a couple of special cases.
@@ -3152,7 +3353,12 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
                     }
 
                     // And signal the next waiter, else they'll wait forever.
-                    m_SemEvent.Set();
+                    Signal();
+
+                    if (fBlockingCounted)
+                    {
+                        ThreadpoolMgr::NotifyBlockingEnd();
+                    }
                 }
             } EE_END_FINALLY;
 
@@ -3199,6 +3405,11 @@ BOOL AwareLock::EnterEpilogHelper(Thread* pCurThread, INT32 timeOut)
             }
         }
 
+        if (fBlockingCounted)
+        {
+            ThreadpoolMgr::NotifyBlockingEnd();
+        }
+
         pCurThread->DisablePreemptiveGC();
     }
     GCPROTECT_END();
@@ -3299,13 +3510,28 @@ bool AwareLock::Contention(INT32 timeOut)
 
 
     LogContention();
+    MonitorContentionHolder contentionHolder;
     Thread      *pCurThread = GetThread();
     OBJECTREF    obj = GetOwningObject();
     bool    bEntered = false;
     bool   bKeepGoing = true;
 
+    // Spin for up to twice as long as spinning took to acquire this lock recently, or as long as the spin
+    // constants allow when there is no history yet
+    DWORD dwSpinBudget = MAXDWORD;
+    DWORD dwSpun = 0;
+    if (s_fAdaptiveSpin)
+    {
+        DWORD dwSpinDuration = m_dwSpinDuration;
+        if (dwSpinDuration != 0)
+        {
+            dwSpinBudget = (dwSpinDuration > MAXDWORD / 2) ? MAXDWORD : dwSpinDuration * 2;
+        }
+    }
+
     // We cannot allow the AwareLock to be cleaned up underneath us by the GC.
     IncrementTransientPrecious();
+    RecordContention();
 
     GCPROTECT_BEGIN(obj);
     {
@@ -3337,6 +3563,12 @@ bool AwareLock::Contention(INT32 timeOut)
                     bKeepGoing = false;
                     break;
                 }
+
+                if (dwSpun >= dwSpinBudget)
+                {
+                    bKeepGoing = false;
+                    break;
+                }
                 
                 // Spin for i iterations, and make sure to never go more than 20000 iterations between
                 // checking if we should SwitchToThread
@@ -3377,6 +3609,8 @@ bool AwareLock::Contention(INT32 timeOut)
                     }
                 }
 
+                dwSpun += i;
+
                 // exponential backoff: wait a factor longer in the next iteration
                 i *= g_SpinConstants.dwBackoffFactor;
             }
@@ -3394,6 +3628,13 @@ entered: ;
     GCPROTECT_END();
     // we are in co-operative mode so no need to keep this set
     DecrementTransientPrecious();
+
+    // Timing out says nothing about how long the lock is held for
+    if (s_fAdaptiveSpin && g_SystemInfo.dwNumberOfProcessors > 1 && (bEntered || timeOut == (INT32)INFINITE))
+    {
+        UpdateSpinDuration(dwSpun, bEntered);
+    }
+
     if (!bEntered && timeOut == (INT32)INFINITE)
     {
         // We've tried hard to enter - we need to eventually block to avoid wasting too much cpu
@@ -198,6 +198,28 @@ public:
 
     CLREvent        m_SemEvent;
 
+    // How long spinning in Contention took to acquire the lock recently, in spin iterations. Zero until the
+    // lock has been acquired by spinning once. Updated without synchronization; it is only a hint.
+    DWORD           m_dwSpinDuration;
+
+    // Value of s_dwSyncBlockScan when the lock was last contended, 0 if it never was
+    DWORD           m_dwContentionScan;
+
+#ifdef FEATURE_PAL
+    // Used instead of m_SemEvent when waiters park on an address: 1 while a signal is pending, like a set
+    // auto-reset event
+    LONG            m_WaitSignal;
+
+    static bool     s_fUseWaitOnAddress;
+#endif // FEATURE_PAL
+
+    static bool     s_fAdaptiveSpin;
+    static bool     s_fDeflateIdleMonitors;
+    static DWORD    s_dwThinLockSpinRetryCount;
+
+    // Number of GC scans of the sync block table so far, plus one
+    static DWORD    s_dwSyncBlockScan;
+
     // Only SyncBlocks can create AwareLocks.  Hence this private constructor.
     AwareLock(DWORD indx)
         : m_MonitorHeld(0),
@@ -207,7 +229,12 @@ public:
           m_HoldingThread(NULL),
 #endif // DACCESS_COMPILE          
           m_TransientPrecious(0),
-          m_dwSyncIndex(indx)
+          m_dwSyncIndex(indx),
+          m_dwSpinDuration(0),
+          m_dwContentionScan(0)
+#ifdef FEATURE_PAL
+          , m_WaitSignal(0)
+#endif // FEATURE_PAL
     {
         LIMITED_METHOD_CONTRACT;
     }
@@ -236,7 +263,37 @@ public:
     }
 #endif // defined(ENABLE_CONTRACTS_IMPL)
 
+#ifdef FEATURE_PAL
+    static DWORD WaitForSignal(void *args, DWORD timeout, DWORD option);
+#endif // FEATURE_PAL
+
+    void    UpdateSpinDuration(DWORD dwSpun, bool fEntered);
+
+    void    RecordContention()
+    {
+        LIMITED_METHOD_CONTRACT;
+        m_dwContentionScan = s_dwSyncBlockScan;
+    }
+
 public:
+    // Reads the monitor configuration; called once at startup, after InitializeSpinConstants
+    static void Initialize();
+
+    // How many rounds of spinning a contended thin lock gets before it is inflated to a sync block
+    static DWORD GetThinLockSpinRetryCount()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return s_dwThinLockSpinRetryCount;
+    }
+
+    // True if the lock was contended since the GC before last. Such a lock is likely to be contended
+    // again, so the GC leaves its sync block in place rather than deflating it.
+    bool    IsRecentlyContended()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return (m_dwContentionScan != 0) && (s_dwSyncBlockScan - m_dwContentionScan < 2);
+    }
+
     enum EnterHelperResult {
         EnterHelperResult_Entered,
         EnterHelperResult_Contention,
@@ -268,6 +325,18 @@ public:
     void    Signal()
     {
         WRAPPER_NO_CONTRACT;
+
+#ifdef FEATURE_PAL
+        if (s_fUseWaitOnAddress)
+        {
+            // Only wake a waiter up if the signal was not already pending, as setting a set event does nothing
+            if (FastInterlockExchange(&m_WaitSignal, 1) == 0)
+            {
+                PAL_WakeByAddress(&m_WaitSignal, FALSE);
+            }
+            return;
+        }
+#endif // FEATURE_PAL
         
         // CLREvent::SetMonitorEvent works even if the event has not been intialized yet
         m_SemEvent.SetMonitorEvent();
@@ -636,7 +705,8 @@ class SyncBlock
         WRAPPER_NO_CONTRACT;
         return (!IsPrecious() &&
                 m_Monitor.m_MonitorHeld.RawValue() == (LONG)0 &&
-                m_Monitor.m_TransientPrecious == 0);
+                m_Monitor.m_TransientPrecious == 0 &&
+                !m_Monitor.IsRecentlyContended());
     }
 
     // Gets the InteropInfo block, creates a new one if none is present.
@@ -935,6 +1005,8 @@ class SyncBlockCache
     DWORD       m_ActiveCount;          // number active
     SyncBlockArray *m_SyncBlocks;       // Array of new SyncBlocks.
     DWORD       m_FreeSyncBlock;        // Next Free Syncblock in the array 
+    DWORD       m_InflationCount;       // number of sync blocks handed out so far
+    DWORD       m_DeflationCount;       // number of sync blocks taken back from live objects so far
 
         // The next variables deal with SyncTableEntries.  Instead of having the object-header
         // point directly at SyncBlocks, the object points a a syncTableEntry, which points at
@@ -1032,6 +1104,18 @@ class SyncBlockCache
         return m_ActiveCount;
     }
 
+    DWORD GetInflationCount()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return m_InflationCount;
+    }
+
+    DWORD GetDeflationCount()
+    {
+        LIMITED_METHOD_CONTRACT;
+        return m_DeflationCount;
+    }
+
     // Encapsulate a CrstHolder, so that clients of our lock don't have to know
     // the details of our implementation.
     class LockHolder : public CrstHolder
@@ -1265,6 +1349,10 @@ class ObjHeader
     // non-blocking version of above
     BOOL TryEnterObjMonitor(INT32 timeOut = 0);
 
+    // Spins on the thin lock of an object while another thread holds it, before the lock is inflated
+    // to a sync block for waiting. Returns TRUE if the lock was taken.
+    static BOOL SpinOnThinLock(OBJECTREF *pObjRef);
+
     // Inlineable fast path of EnterObjMonitor/TryEnterObjMonitor
     AwareLock::EnterHelperResult EnterObjMonitorHelper(Thread* pCurThread);
     AwareLock::EnterHelperResult EnterObjMonitorHelperSpin(Thread* pCurThread);
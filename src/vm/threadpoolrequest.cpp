@@ -421,18 +421,15 @@ void UnManagedPerAppDomainTPCount::QueueUnmanagedWorkRequest(LPTHREAD_START_ROUT
     _ASSERTE(pWorkRequest != NULL);
     PREFIX_ASSUME(pWorkRequest != NULL);
 
-    m_lock.Init(LOCK_TYPE_DEFAULT);
-    
-    {
-        SpinLock::Holder slh(&m_lock);
+    if (ETW_EVENT_ENABLED(MICROSOFT_WINDOWS_DOTNETRUNTIME_PROVIDER_Context, ThreadPoolEnqueue) && 
+        !ThreadpoolMgr::AreEtwQueueEventsSpeciallyHandled(function))
+        FireEtwThreadPoolEnqueue(pWorkRequest, GetClrInstanceId());
 
-        if (ETW_EVENT_ENABLED(MICROSOFT_WINDOWS_DOTNETRUNTIME_PROVIDER_Context, ThreadPoolEnqueue) && 
-            !ThreadpoolMgr::AreEtwQueueEventsSpeciallyHandled(function))
-            FireEtwThreadPoolEnqueue(pWorkRequest, GetClrInstanceId());
-        ThreadpoolMgr::EnqueueWorkRequest(pWorkRequest);
-        pWorkRequest.SuppressRelease();
-        m_NumRequests++;
-    }
+    //The thread pool queues need no lock; the count is bumped before the
+    //request is visible so that it never goes negative in DeQueue.
+    FastInterlockIncrement(&m_NumRequests);
+    ThreadpoolMgr::EnqueueWorkRequest(pWorkRequest);
+    pWorkRequest.SuppressRelease();
 
     SetAppDomainRequestsActive();
 #endif //DACCESS_COMPILE
@@ -454,9 +451,7 @@ PVOID UnManagedPerAppDomainTPCount::DeQueueUnManagedWorkRequest(bool* lastOne)
 
     if (pWorkRequest) 
     {
-        m_NumRequests--;
-
-        if(m_NumRequests > 0) 
+        if(FastInterlockDecrement(&m_NumRequests) > 0) 
             *lastOne = false;
     }
 
@@ -490,17 +485,15 @@ void UnManagedPerAppDomainTPCount::DispatchWorkItem(bool* foundWork, bool* wasNo
     WorkRequest * pWorkRequest=NULL;
     LPTHREAD_START_ROUTINE wrFunction;
     LPVOID wrContext;
+    LONGLONG wrEnqueueTime;
+    LONGLONG dequeueTime;
 
     bool firstIteration = true;
     bool lastOne = false;
 
     while (*wasNotRecalled) 
     {
-        m_lock.Init(LOCK_TYPE_DEFAULT);
-        {
-            SpinLock::Holder slh(&m_lock);
-            pWorkRequest = (WorkRequest*) DeQueueUnManagedWorkRequest(&lastOne);
-        }
+        pWorkRequest = (WorkRequest*) DeQueueUnManagedWorkRequest(&lastOne);
 
         if (NULL == pWorkRequest)
             break;
@@ -523,6 +516,8 @@ void UnManagedPerAppDomainTPCount::DispatchWorkItem(bool* foundWork, bool* wasNo
 
         wrFunction = pWorkRequest->Function;
         wrContext  = pWorkRequest->Context;
+        wrEnqueueTime = pWorkRequest->EnqueueTime;
+        dequeueTime = ThreadpoolTelemetry::GetTimestamp();
 
         if (ETW_EVENT_ENABLED(MICROSOFT_WINDOWS_DOTNETRUNTIME_PROVIDER_Context, ThreadPoolDequeue) &&
             !ThreadpoolMgr::AreEtwQueueEventsSpeciallyHandled(wrFunction))
@@ -541,6 +536,11 @@ void UnManagedPerAppDomainTPCount::DispatchWorkItem(bool* foundWork, bool* wasNo
             (wrFunction) (wrContext);
         }
 
+        if (dequeueTime != 0)
+        {
+            ThreadpoolTelemetry::RecordWorkItem(wrEnqueueTime, dequeueTime, ThreadpoolTelemetry::GetTimestamp());
+        }
+
         ThreadpoolMgr::NotifyWorkItemCompleted();
         if (ThreadpoolMgr::ShouldAdjustMaxWorkersActive())
         {
@@ -284,8 +284,7 @@ public:
     }
 
 private:
-    SpinLock m_lock;
-    ULONG m_NumRequests;
+    DECLSPEC_ALIGN(64) LONG m_NumRequests;
     DECLSPEC_ALIGN(64) struct {
         BYTE m_padding1[64 - sizeof(LONG)];
         // Only use with VolatileLoad+VolatileStore+FastInterlockCompareExchange
@@ -0,0 +1,331 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+#include "common.h"
+#include "threadpooltelemetry.h"
+#include "win32threadpool.h"
+
+#ifdef FEATURE_PERFTRACING
+#include "eventpipe.h"
+#include "eventpipeprovider.h"
+#include "eventpipeevent.h"
+#endif // FEATURE_PERFTRACING
+
+bool ThreadpoolTelemetry::s_enabled = false;
+double ThreadpoolTelemetry::s_nanosecondsPerTick = 0;
+DWORD ThreadpoolTelemetry::s_publishingInterval = 0;
+DWORD ThreadpoolTelemetry::s_lastPublishTime = 0;
+ThreadpoolTelemetry::ThreadTimings* ThreadpoolTelemetry::s_pThreadTimingsList = NULL;
+SIZE_T ThreadpoolTelemetry::s_lastPublishedCounts[ThreadpoolHistogram_Count][LatencyHistogram::BucketCount];
+
+#ifdef FEATURE_PERFTRACING
+const GUID ThreadpoolTelemetry::s_providerID = {0x8c3a5e27,0x4b0d,0x5f91,{0x2a,0x6e,0xd1,0x47,0xc9,0x03,0xb8,0x5f}}; // {8c3a5e27-4b0d-5f91-2a6e-d147c903b85f}
+EventPipeProvider* ThreadpoolTelemetry::s_pEventPipeProvider = NULL;
+EventPipeEvent* ThreadpoolTelemetry::s_pHistogramEvents[ThreadpoolHistogram_Count];
+#endif // FEATURE_PERFTRACING
+
+unsigned int LatencyHistogram::GetBucketIndex(UINT64 value)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (value < SubBucketCount)
+        return (unsigned int)value;
+
+    if (value >= ((UINT64)1 << MaxValueBits))
+        return BucketCount - 1;
+
+    // Position of the highest bit that is set
+    unsigned int highBit = 0;
+    for (unsigned int shift = 32; shift != 0; shift >>= 1)
+    {
+        if ((value >> (highBit + shift)) != 0)
+            highBit += shift;
+    }
+
+    // The bits right below the highest one pick the sub-bucket
+    unsigned int subBucket = (unsigned int)(value >> (highBit - SubBucketBits)) & (SubBucketCount - 1);
+    return SubBucketCount + (highBit - SubBucketBits) * SubBucketCount + subBucket;
+}
+
+UINT64 LatencyHistogram::GetBucketLowerBound(unsigned int index)
+{
+    LIMITED_METHOD_CONTRACT;
+    _ASSERTE(index < BucketCount);
+
+    if (index < SubBucketCount)
+        return index;
+
+    unsigned int shift = (index - SubBucketCount) / SubBucketCount;
+    unsigned int subBucket = (index - SubBucketCount) % SubBucketCount;
+    return (UINT64)(SubBucketCount + subBucket) << shift;
+}
+
+void ThreadpoolTelemetry::Initialize()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_EnableWorkItemTimings) == 0)
+        return;
+
+    LARGE_INTEGER frequency;
+    if (!QueryPerformanceFrequency(&frequency) || frequency.QuadPart <= 0)
+        return;
+
+    s_nanosecondsPerTick = 1000000000.0 / (double)frequency.QuadPart;
+    s_publishingInterval = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_WorkItemTimingsPublishInterval);
+    s_lastPublishTime = GetTickCount();
+    s_enabled = true;
+}
+
+ThreadpoolTelemetry::ThreadTimings* ThreadpoolTelemetry::GetThreadTimings()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    ThreadTimings* pTimings = (ThreadTimings*) ClrFlsGetValue(TlsIdx_ThreadpoolWorkItemTimings);
+    if (pTimings != NULL)
+        return pTimings;
+
+    // Take over the histograms of a worker that has gone, so that the list only grows with the number of
+    // workers that run at the same time
+    for (pTimings = VolatileLoad(&s_pThreadTimingsList); pTimings != NULL; pTimings = pTimings->m_pNext)
+    {
+        if (VolatileLoad(&pTimings->m_owned) == 0 &&
+            FastInterlockCompareExchange(&pTimings->m_owned, 1, 0) == 0)
+        {
+            break;
+        }
+    }
+
+    if (pTimings == NULL)
+    {
+        pTimings = new (nothrow) ThreadTimings();
+        if (pTimings == NULL)
+            return NULL;
+
+        pTimings->m_owned = 1;
+
+        ThreadTimings* pHead = VolatileLoad(&s_pThreadTimingsList);
+        while (true)
+        {
+            pTimings->m_pNext = pHead;
+            ThreadTimings* pPrevHead = FastInterlockCompareExchangePointer(&s_pThreadTimingsList, pTimings, pHead);
+            if (pPrevHead == pHead)
+                break;
+
+            pHead = pPrevHead;
+        }
+    }
+
+    ClrFlsSetValue(TlsIdx_ThreadpoolWorkItemTimings, pTimings);
+    return pTimings;
+}
+
+void ThreadpoolTelemetry::RecordWorkItem(LONGLONG enqueueTime, LONGLONG dequeueTime, LONGLONG completionTime)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (!s_enabled)
+        return;
+
+    ThreadTimings* pTimings = GetThreadTimings();
+    if (pTimings == NULL)
+        return;
+
+    // The request was made before timings were enabled if it has no enqueue time
+    if (enqueueTime != 0)
+    {
+        pTimings->m_histograms[ThreadpoolHistogram_QueueLatency].Record(TicksToNanoseconds(dequeueTime - enqueueTime));
+    }
+
+    pTimings->m_histograms[ThreadpoolHistogram_ExecutionTime].Record(TicksToNanoseconds(completionTime - dequeueTime));
+}
+
+void ThreadpoolTelemetry::ReleaseThreadTimings()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    ThreadTimings* pTimings = (ThreadTimings*) ClrFlsGetValue(TlsIdx_ThreadpoolWorkItemTimings);
+    if (pTimings == NULL)
+        return;
+
+    ClrFlsSetValue(TlsIdx_ThreadpoolWorkItemTimings, NULL);
+    VolatileStore(&pTimings->m_owned, (LONG)0);
+}
+
+unsigned int ThreadpoolTelemetry::GetHistogram(ThreadpoolHistogramKind kind, SIZE_T* pCounts, unsigned int numCounts)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+        PRECONDITION(kind < ThreadpoolHistogram_Count);
+        PRECONDITION(CheckPointer(pCounts));
+    }
+    CONTRACTL_END;
+
+    if (numCounts < LatencyHistogram::BucketCount)
+        return 0;
+
+    memset(pCounts, 0, LatencyHistogram::BucketCount * sizeof(SIZE_T));
+
+    for (ThreadTimings* pTimings = VolatileLoad(&s_pThreadTimingsList); pTimings != NULL; pTimings = pTimings->m_pNext)
+    {
+        pTimings->m_histograms[kind].AddTo(pCounts);
+    }
+
+    return LatencyHistogram::BucketCount;
+}
+
+void ThreadpoolTelemetry::PublishIfDue()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_PREEMPTIVE;
+    }
+    CONTRACTL_END;
+
+    if (!s_enabled)
+        return;
+
+    DWORD currentTime = GetTickCount();
+    if (currentTime - s_lastPublishTime < s_publishingInterval)
+        return;
+
+    s_lastPublishTime = currentTime;
+
+#ifdef FEATURE_PERFTRACING
+    bool fTracing = EventPipe::Enabled();
+    if (fTracing)
+    {
+        EnsureEventPipeProvider();
+    }
+#endif // FEATURE_PERFTRACING
+
+    // The baseline moves on every interval, so that each event covers one interval whenever tracing started
+    for (int kind = 0; kind < ThreadpoolHistogram_Count; kind++)
+    {
+        SIZE_T counts[LatencyHistogram::BucketCount];
+        GetHistogram((ThreadpoolHistogramKind)kind, counts, LatencyHistogram::BucketCount);
+
+        for (unsigned int i = 0; i < LatencyHistogram::BucketCount; i++)
+        {
+            SIZE_T count = counts[i];
+            counts[i] = count - s_lastPublishedCounts[kind][i];
+            s_lastPublishedCounts[kind][i] = count;
+        }
+
+#ifdef FEATURE_PERFTRACING
+        if (fTracing)
+        {
+            WriteHistogramEvent((ThreadpoolHistogramKind)kind, counts);
+        }
+#endif // FEATURE_PERFTRACING
+    }
+}
+
+#ifdef FEATURE_PERFTRACING
+
+void ThreadpoolTelemetry::EnsureEventPipeProvider()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    // Only the gate thread creates the provider. It is created once tracing is first enabled, since the event
+    // pipe may not be initialized before that.
+    if (s_pEventPipeProvider != NULL)
+        return;
+
+    EX_TRY
+    {
+        EventPipeProvider* pProvider = EventPipe::CreateProvider(s_providerID);
+        for (int kind = 0; kind < ThreadpoolHistogram_Count; kind++)
+        {
+            s_pHistogramEvents[kind] = pProvider->AddEvent(
+                kind + 1, /* eventID */
+                0, /* keywords */
+                0, /* eventVersion */
+                EventPipeEventLevel::Informational,
+                false /* NeedStack */);
+        }
+
+        s_pEventPipeProvider = pProvider;
+    }
+    EX_CATCH
+    {
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+}
+
+// Payload: the number of sub-bucket bits and of buckets as UINT32s, then the total count and the count of
+// every bucket as UINT64s. The counts are those added since the previous event.
+void ThreadpoolTelemetry::WriteHistogramEvent(ThreadpoolHistogramKind kind, const SIZE_T* pCounts)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (s_pEventPipeProvider == NULL)
+        return;
+
+    EventPipeEvent* pEvent = s_pHistogramEvents[kind];
+    if (pEvent == NULL || !pEvent->IsEnabled())
+        return;
+
+    struct
+    {
+        UINT32 subBucketBits;
+        UINT32 bucketCount;
+        UINT64 totalCount;
+        UINT64 counts[LatencyHistogram::BucketCount];
+    } payload;
+
+    payload.subBucketBits = LatencyHistogram::SubBucketBits;
+    payload.bucketCount = LatencyHistogram::BucketCount;
+    payload.totalCount = 0;
+    for (unsigned int i = 0; i < LatencyHistogram::BucketCount; i++)
+    {
+        payload.counts[i] = pCounts[i];
+        payload.totalCount += pCounts[i];
+    }
+
+    EventPipe::WriteEvent(*pEvent, (BYTE*)&payload, sizeof(payload));
+}
+
+#endif // FEATURE_PERFTRACING
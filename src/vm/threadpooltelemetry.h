@@ -0,0 +1,151 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+#ifndef __THREADPOOLTELEMETRY_H__
+#define __THREADPOOLTELEMETRY_H__
+
+#ifdef FEATURE_PERFTRACING
+class EventPipeProvider;
+class EventPipeEvent;
+#endif // FEATURE_PERFTRACING
+
+enum ThreadpoolHistogramKind
+{
+    ThreadpoolHistogram_QueueLatency = 0,   // time between queueing a work request and a worker dequeueing it
+    ThreadpoolHistogram_ExecutionTime = 1,  // time a worker spends running a work request
+    ThreadpoolHistogram_Count = 2
+};
+
+// A log-linear histogram of durations in nanoseconds, in the style of HdrHistogram. Values below
+// 2^SubBucketBits get a bucket each; above that, every power of two is split into 2^SubBucketBits buckets,
+// so no bucket is wider than 1/2^SubBucketBits of its lower bound. Only the thread that owns the histogram
+// records into it, so counts are bumped without interlocked operations; readers may see a count that is
+// one behind.
+class LatencyHistogram
+{
+    public:
+
+        static const unsigned int SubBucketBits = 3;
+        static const unsigned int SubBucketCount = 1 << SubBucketBits;
+        static const unsigned int MaxValueBits = 40;    // about 18 minutes; longer durations go to the last bucket
+        static const unsigned int BucketCount = SubBucketCount + (MaxValueBits - SubBucketBits) * SubBucketCount;
+
+        LatencyHistogram()
+        {
+            LIMITED_METHOD_CONTRACT;
+            memset(m_counts, 0, sizeof(m_counts));
+        }
+
+        void Record(UINT64 nanoseconds)
+        {
+            LIMITED_METHOD_CONTRACT;
+
+            unsigned int index = GetBucketIndex(nanoseconds);
+            VolatileStore(&m_counts[index], VolatileLoadWithoutBarrier(&m_counts[index]) + 1);
+        }
+
+        // Adds the counts of this histogram to pCounts, which has BucketCount entries
+        void AddTo(SIZE_T* pCounts) const
+        {
+            LIMITED_METHOD_CONTRACT;
+
+            for (unsigned int i = 0; i < BucketCount; i++)
+            {
+                pCounts[i] += VolatileLoadWithoutBarrier(&m_counts[i]);
+            }
+        }
+
+        static unsigned int GetBucketIndex(UINT64 value);
+
+        // Smallest value that lands in the bucket
+        static UINT64 GetBucketLowerBound(unsigned int index);
+
+    private:
+
+        SIZE_T m_counts[BucketCount];
+};
+
+// Times the work requests that go through the native thread pool queue. Every worker records into a pair of
+// histograms of its own. The gate thread sums them up periodically and, when the provider is enabled, writes
+// the counts added since the last time as one EventPipe event per histogram.
+class ThreadpoolTelemetry
+{
+    public:
+
+        static void Initialize();
+
+        static bool IsEnabled()
+        {
+            LIMITED_METHOD_CONTRACT;
+            return s_enabled;
+        }
+
+        // Timestamp to pass to RecordWorkItem, 0 when timings are not being recorded
+        static LONGLONG GetTimestamp()
+        {
+            LIMITED_METHOD_CONTRACT;
+
+            if (!s_enabled)
+                return 0;
+
+            LARGE_INTEGER timestamp;
+            QueryPerformanceCounter(&timestamp);
+            return timestamp.QuadPart;
+        }
+
+        // Called by a worker after running a work request
+        static void RecordWorkItem(LONGLONG enqueueTime, LONGLONG dequeueTime, LONGLONG completionTime);
+
+        // Called by a worker before it exits, so that a later worker can take over its histograms
+        static void ReleaseThreadTimings();
+
+        // Called by the gate thread on every pass; publishes the histograms once per publishing interval
+        static void PublishIfDue();
+
+        // Fills pCounts with the counts recorded by all workers since the process started. pCounts has
+        // numCounts entries, which should be LatencyHistogram::BucketCount. Returns the number of
+        // entries filled.
+        static unsigned int GetHistogram(ThreadpoolHistogramKind kind, SIZE_T* pCounts, unsigned int numCounts);
+
+    private:
+
+        struct ThreadTimings
+        {
+            ThreadTimings* m_pNext;
+            LONG m_owned;
+            LatencyHistogram m_histograms[ThreadpoolHistogram_Count];
+        };
+
+        static ThreadTimings* GetThreadTimings();
+
+        static UINT64 TicksToNanoseconds(LONGLONG ticks)
+        {
+            LIMITED_METHOD_CONTRACT;
+            return (ticks > 0) ? (UINT64)(ticks * s_nanosecondsPerTick) : 0;
+        }
+
+#ifdef FEATURE_PERFTRACING
+        static void EnsureEventPipeProvider();
+        static void WriteHistogramEvent(ThreadpoolHistogramKind kind, const SIZE_T* pCounts);
+#endif // FEATURE_PERFTRACING
+
+        static bool s_enabled;
+        static double s_nanosecondsPerTick;
+        static DWORD s_publishingInterval;
+        static DWORD s_lastPublishTime;
+
+        // List of the histograms of all workers, current and past. Entries are never removed.
+        static ThreadTimings* s_pThreadTimingsList;
+
+        // Counts as of the last publishing interval; only used by the gate thread
+        static SIZE_T s_lastPublishedCounts[ThreadpoolHistogram_Count][LatencyHistogram::BucketCount];
+
+#ifdef FEATURE_PERFTRACING
+        static const GUID s_providerID;
+        static EventPipeProvider* s_pEventPipeProvider;
+        static EventPipeEvent* s_pHistogramEvents[ThreadpoolHistogram_Count];
+#endif // FEATURE_PERFTRACING
+};
+
+#endif // __THREADPOOLTELEMETRY_H__
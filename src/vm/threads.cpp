@@ -3944,6 +3944,9 @@ DWORD Thread::DoAppropriateWaitWorker(int countHandles, HANDLE *handles, BOOL wa
 
     GCX_PREEMP();
 
+    // Lets the thread pool run another worker while this one waits
+    ThreadpoolMgr::BlockingHolder blockingHolder(millis != 0);
+
     if (alertable)
     {
         DoAppropriateWaitWorkerAlertableHelper(mode);
@@ -4131,6 +4134,9 @@ DWORD Thread::DoAppropriateWaitWorker(AppropriateWaitFunc func, void *args,
     ThreadStateNCStackHolder tsNC(isCoop && alertable, TSNC_DebuggerSleepWaitJoin);
     GCX_PREEMP();
 
+    // Lets the thread pool run another worker while this one waits
+    ThreadpoolMgr::BlockingHolder blockingHolder(millis != 0);
+
     // <TODO>
     // @TODO cwb: we don't know whether a thread has a message pump or
     // how to pump its messages, currently.
@@ -4680,6 +4686,9 @@ void Thread::UserSleep(INT32 time)
     ThreadStateNCStackHolder tsNC(TRUE, TSNC_DebuggerSleepWaitJoin);
     GCX_PREEMP();
 
+    // Lets the thread pool run another worker while this one sleeps
+    ThreadpoolMgr::BlockingHolder blockingHolder(time != 0);
+
     // A word about ordering for Interrupt.  If someone tries to interrupt a thread
     // that's in the interruptible state, we queue an APC.  But if they try to interrupt
     // a thread that's not in the interruptible state, we just record that fact.  So
@@ -60,16 +60,46 @@
 //
 // Methods initially call into OnMethodCalled() and once the call count exceeds
 // a fixed limit we queue work on to our internal list of methods needing to
-// be recompiled (m_methodsToOptimize). If there is currently no thread
-// servicing our queue asynchronously then we use the runtime threadpool
-// QueueUserWorkItem to recruit one. During the callback for each threadpool work
-// item we handle as many methods as possible in a fixed period of time, then
-// queue another threadpool work item if m_methodsToOptimize hasn't been drained.
+// be recompiled (m_methodsToOptimize). If fewer threads are servicing our queue
+// than we want then we use the runtime threadpool QueueUserWorkItem to recruit
+// more. During the callback for each threadpool work item we handle as many
+// methods as possible in a fixed period of time, then queue another threadpool
+// work item if m_methodsToOptimize hasn't been drained.
 //
-// The background thread enters at StaticOptimizeMethodsCallback(), enters the
-// appdomain, and then begins calling OptimizeMethod on each method in the
+// The background threads enter at StaticOptimizeMethodsCallback(), enter the
+// appdomain, and then begin calling OptimizeMethod on each method in the
 // queue. For each method we jit it, then update the precode so that future
 // entrypoint callers will run the new code.
+//
+// # Background thread count
+//
+// When many methods cross the call count threshold together (typically during
+// startup) a single thread can take a long time to drain the backlog. We allow
+// up to COMPLUS_TC_BackgroundWorkerCount threads to service the queue at once,
+// further limited by the number of processors the threadpool currently sees as
+// idle and by the depth of the backlog. With the default of 0 we use at most half
+// the processors so that the app keeps some cores of its own. Each thread
+// re-evaluates the desired count at the end of its quantum and retires if there
+// are now more threads than we want.
+//
+// # Prioritization
+//
+// m_methodsToOptimize is split into TIERED_COMPILATION_PRIORITY_LEVELS lists and
+// threads always dequeue from the highest non-empty one. Methods that are waiting
+// in the queue keep receiving call notifications and each time the call count
+// doubles the method is promoted to the next level, so the hottest methods in a
+// large backlog are optimized first. Promotion leaves a stale element behind in
+// the lower list; m_queuedMethods records the current level of every waiting
+// method and stale elements are discarded when they are dequeued. Calls between
+// doublings do not touch the queue or m_lock. Notifications stop once a method
+// reaches the highest level, or at the first doubling after it has been dequeued.
+//
+// # Statistics
+//
+// Under m_lock we track the current and peak backlog depth as well as the number
+// of methods optimized and the time from reaching the call count threshold to the
+// optimized code being installed. A summary is written to the stress log each time
+// the backlog drains.
 // 
 // # Error handling
 //
@@ -86,11 +116,18 @@
 TieredCompilationManager::TieredCompilationManager() :
     m_isAppDomainShuttingDown(FALSE),
     m_countOptimizationThreadsRunning(0),
+    m_maxOptimizationThreads(0),
     m_callCountOptimizationThreshhold(30),
-    m_optimizationQuantumMs(50)
+    m_optimizationQuantumMs(50),
+    m_backlogDepth(0),
+    m_peakBacklogDepth(0),
+    m_countMethodsOptimized(0),
+    m_totalTimeToTier1Ms(0),
+    m_maxTimeToTier1Ms(0)
 {
     LIMITED_METHOD_CONTRACT;
     m_lock.Init(LOCK_TYPE_DEFAULT);
+    m_addLock.Init(CrstTieredCompilationAdd);
 }
 
 // Called at AppDomain Init
@@ -107,6 +144,7 @@ void TieredCompilationManager::Init(ADID appDomainId)
 
     SpinLockHolder holder(&m_lock);
     m_domainId = appDomainId;
+    m_maxOptimizationThreads = g_pConfig->TieredCompilation_BackgroundWorkerCount();
 }
 
 // Called each time code in this AppDomain has been run. This is our sole entrypoint to begin
@@ -123,65 +161,205 @@ BOOL TieredCompilationManager::OnMethodCalled(MethodDesc* pMethodDesc, DWORD cur
     {
         return FALSE; // continue notifications for this method
     }
-    else if (currentCallCount > m_callCountOptimizationThreshhold)
+
+    // The method enters the queue at priority 0 when it reaches the threshold and is
+    // promoted one level each time its call count doubles while it is still waiting.
+    DWORD priority = 0;
+    while (priority + 1 < TIERED_COMPILATION_PRIORITY_LEVELS &&
+           currentCallCount >= (m_callCountOptimizationThreshhold << (priority + 1)))
+    {
+        priority++;
+    }
+    BOOL isLastPriority = (priority + 1 == TIERED_COMPILATION_PRIORITY_LEVELS);
+
+    if (currentCallCount != (m_callCountOptimizationThreshhold << priority))
+    {
+        // Keep counting up to the next doubling without looking at the queue. Once the method
+        // has been optimized its callers no longer come through here, and a method that has
+        // been dequeued in the meantime is noticed at the next doubling, in EnqueueMethod.
+        return isLastPriority; // stop notifications for this method at the last level
+    }
+
+    if (!EnqueueMethod(pMethodDesc, priority))
     {
         return TRUE; // stop notifications for this method
     }
 
-    // Insert the method into the optimization queue and trigger a thread to service
-    // the queue if needed.
-    //
-    // Terminal exceptions escape as exceptions, but all other errors should gracefully
-    // return to the caller. Non-terminal error conditions should be rare (ie OOM,
-    // OS failure to create thread) and we consider it reasonable for some methods
-    // to go unoptimized or have their optimization arbitrarily delayed under these
-    // circumstances. Note an error here could affect concurrent threads running this
-    // code. Those threads will observe m_countOptimizationThreadsRunning > 0 and return,
-    // then QueueUserWorkItem fails on this thread lowering the count and leaves them 
-    // unserviced. Synchronous retries appear unlikely to offer any material improvement 
-    // and complicating the code to narrow an already rare error case isn't desirable.
+    StartOptimizationThreads();
+    return isLastPriority;
+}
+
+// Inserts the method into the optimization queue at the given priority, or promotes it
+// there if it is already waiting at a lower one. Returns TRUE if the queue was updated.
+BOOL TieredCompilationManager::EnqueueMethod(MethodDesc* pMethodDesc, DWORD priority)
+{
+    STANDARD_VM_CONTRACT;
+
+    _ASSERTE(priority < TIERED_COMPILATION_PRIORITY_LEVELS);
+
+    NewHolder<SListElem<MethodDesc*>> pMethodListItem = new (nothrow) SListElem<MethodDesc*>(pMethodDesc);
+    if (pMethodListItem == NULL)
     {
-        SListElem<MethodDesc*>* pMethodListItem = new (nothrow) SListElem<MethodDesc*>(pMethodDesc);
-        SpinLockHolder holder(&m_lock);
-        if (pMethodListItem != NULL)
+        return FALSE;
+    }
+
+    // Adding to m_queuedMethods may grow it, which must not happen under m_lock. All additions
+    // are serialized by m_addLock so that a larger table can be allocated before taking m_lock.
+    CrstHolder addHolder(&m_addLock);
+    TieredCompilationQueueHash::AddPhases addCall;
+    if (priority == 0)
+    {
+        BOOL preallocated = FALSE;
+        EX_TRY
         {
-            m_methodsToOptimize.InsertTail(pMethodListItem);
+            addCall.PreallocateForAdd(&m_queuedMethods);
+            preallocated = TRUE;
         }
-
-        if (0 == m_countOptimizationThreadsRunning && !m_isAppDomainShuttingDown)
+        EX_CATCH
         {
-            // Our current policy throttles at 1 thread, but in the future we
-            // could experiment with more parallelism.
-            m_countOptimizationThreadsRunning++;
         }
-        else
+        EX_END_CATCH(RethrowTerminalExceptions);
+
+        if (!preallocated)
         {
-            return TRUE; // stop notifications for this method
+            return FALSE;
         }
     }
 
-    EX_TRY
+    SpinLockHolder holder(&m_lock);
+    if (m_isAppDomainShuttingDown)
+    {
+        return FALSE;
+    }
+
+    TieredCompilationQueueEntry* pEntry =
+        const_cast<TieredCompilationQueueEntry*>(m_queuedMethods.LookupPtr(pMethodDesc));
+    if (priority == 0)
     {
-        if (!ThreadpoolMgr::QueueUserWorkItem(StaticOptimizeMethodsCallback, this, QUEUE_ONLY, TRUE))
+        if (pEntry != NULL)
         {
-            SpinLockHolder holder(&m_lock);
-            m_countOptimizationThreadsRunning--;
-            STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::OnMethodCalled: "
-                "ThreadpoolMgr::QueueUserWorkItem returned FALSE (no thread will run), method=%pM\n",
-                pMethodDesc);
+            return FALSE;
+        }
+        addCall.Add(TieredCompilationQueueEntry(pMethodDesc, CLRGetTickCount64(), 0));
+        m_backlogDepth++;
+        if (m_backlogDepth > m_peakBacklogDepth)
+        {
+            m_peakBacklogDepth = m_backlogDepth;
         }
     }
-    EX_CATCH
+    else
+    {
+        // The method has already been dequeued, or promoted by a racing notification
+        if (pEntry == NULL || pEntry->priority >= priority)
+        {
+            return FALSE;
+        }
+        pEntry->priority = priority;
+    }
+
+    m_methodsToOptimize[priority].InsertTail(pMethodListItem.Extract());
+    return TRUE;
+}
+
+// Returns the number of background threads we want servicing the queue.
+// This should be called with m_lock already held.
+DWORD TieredCompilationManager::GetDesiredOptimizationThreadCount()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DWORD processorCount = ThreadpoolMgr::NumberOfProcessors;
+    if (processorCount == 0)
+    {
+        processorCount = 1;
+    }
+
+    // cpuUtilization is sampled periodically by the threadpool's gate thread
+    LONG cpuUtilization = ThreadpoolMgr::cpuUtilization;
+    if (cpuUtilization < 0)
+    {
+        cpuUtilization = 0;
+    }
+    else if (cpuUtilization > 100)
+    {
+        cpuUtilization = 100;
+    }
+    DWORD desiredCount = processorCount * (DWORD)(100 - cpuUtilization) / 100;
+
+    DWORD maxCount = m_maxOptimizationThreads;
+    if (maxCount == 0)
+    {
+        maxCount = processorCount / 2;
+    }
+    if (desiredCount > maxCount)
+    {
+        desiredCount = maxCount;
+    }
+    if (desiredCount > m_backlogDepth)
+    {
+        desiredCount = m_backlogDepth;
+    }
+    return (desiredCount == 0) ? 1 : desiredCount;
+}
+
+// Recruits threadpool threads to service the optimization queue until
+// m_countOptimizationThreadsRunning reaches the desired count.
+//
+// Terminal exceptions escape as exceptions, but all other errors should gracefully
+// return to the caller. Non-terminal error conditions should be rare (ie OOM,
+// OS failure to create thread) and we consider it reasonable for some methods
+// to go unoptimized or have their optimization arbitrarily delayed under these
+// circumstances. Note an error here could affect concurrent threads running this
+// code. Those threads will observe enough threads already reserved and return,
+// then QueueUserWorkItem fails on this thread lowering the count and leaves them 
+// unserviced. Synchronous retries appear unlikely to offer any material improvement 
+// and complicating the code to narrow an already rare error case isn't desirable.
+void TieredCompilationManager::StartOptimizationThreads()
+{
+    STANDARD_VM_CONTRACT;
+
+    DWORD countThreadsToStart = 0;
     {
         SpinLockHolder holder(&m_lock);
-        m_countOptimizationThreadsRunning--;
-        STRESS_LOG2(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::OnMethodCalled: "
-            "Exception queuing work item to threadpool, hr=0x%x, method=%pM\n",
-            GET_EXCEPTION()->GetHR(), pMethodDesc);
+        if (m_isAppDomainShuttingDown)
+        {
+            return;
+        }
+
+        DWORD desiredCount = GetDesiredOptimizationThreadCount();
+        if (desiredCount > m_countOptimizationThreadsRunning)
+        {
+            countThreadsToStart = desiredCount - m_countOptimizationThreadsRunning;
+            m_countOptimizationThreadsRunning = desiredCount;
+        }
     }
-    EX_END_CATCH(RethrowTerminalExceptions);
 
-    return TRUE; // stop notifications for this method
+    BOOL failed = FALSE;
+    for (; countThreadsToStart > 0 && !failed; countThreadsToStart--)
+    {
+        EX_TRY
+        {
+            if (!ThreadpoolMgr::QueueUserWorkItem(StaticOptimizeMethodsCallback, this, QUEUE_ONLY, TRUE))
+            {
+                failed = TRUE;
+                STRESS_LOG0(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::StartOptimizationThreads: "
+                    "ThreadpoolMgr::QueueUserWorkItem returned FALSE (no thread will run)\n");
+            }
+        }
+        EX_CATCH
+        {
+            failed = TRUE;
+            STRESS_LOG1(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::StartOptimizationThreads: "
+                "Exception queuing work item to threadpool, hr=0x%x\n",
+                GET_EXCEPTION()->GetHR());
+        }
+        EX_END_CATCH(RethrowTerminalExceptions);
+
+        if (failed)
+        {
+            SpinLockHolder holder(&m_lock);
+            m_countOptimizationThreadsRunning -= countThreadsToStart;
+        }
+    }
 }
 
 void TieredCompilationManager::OnAppDomainShutdown()
@@ -228,6 +406,7 @@ void TieredCompilationManager::OptimizeMethodsCallback()
 
     ULONGLONG startTickCount = CLRGetTickCount64();
     MethodDesc* pMethod = NULL;
+    ULONGLONG enqueueTickCount = 0;
     EX_TRY
     {
         ENTER_DOMAIN_ID(m_domainId);
@@ -236,16 +415,22 @@ void TieredCompilationManager::OptimizeMethodsCallback()
             {
                 {
                     SpinLockHolder holder(&m_lock); 
-                    pMethod = GetNextMethodToOptimize();
+                    pMethod = GetNextMethodToOptimize(&enqueueTickCount);
                     if (pMethod == NULL ||
                         m_isAppDomainShuttingDown)
                     {
                         m_countOptimizationThreadsRunning--;
+                        if (pMethod == NULL && m_countOptimizationThreadsRunning == 0)
+                        {
+                            STRESS_LOG4(LF_TIEREDCOMPILATION, LL_INFO10, "TieredCompilationManager::OptimizeMethodsCallback: "
+                                "Backlog drained, optimized=%u, peak backlog=%u, total time to tier1=%u ms, max=%u ms\n",
+                                m_countMethodsOptimized, m_peakBacklogDepth, (DWORD)m_totalTimeToTier1Ms, (DWORD)m_maxTimeToTier1Ms);
+                        }
                         break;
                     }
                     
                 }
-                OptimizeMethod(pMethod);
+                OptimizeMethod(pMethod, enqueueTickCount);
 
                 // If we have been running for too long return the thread to the threadpool and queue another event
                 // This gives the threadpool a chance to service other requests on this thread before returning to
@@ -253,6 +438,17 @@ void TieredCompilationManager::OptimizeMethodsCallback()
                 ULONGLONG currentTickCount = CLRGetTickCount64();
                 if (currentTickCount >= startTickCount + m_optimizationQuantumMs)
                 {
+                    // Retire this thread if fewer processors are idle than when it was recruited
+                    // or the backlog no longer needs it.
+                    {
+                        SpinLockHolder holder(&m_lock);
+                        if (m_countOptimizationThreadsRunning > GetDesiredOptimizationThreadCount())
+                        {
+                            m_countOptimizationThreadsRunning--;
+                            break;
+                        }
+                    }
+
                     if (!ThreadpoolMgr::QueueUserWorkItem(StaticOptimizeMethodsCallback, this, QUEUE_ONLY, TRUE))
                     {
                         SpinLockHolder holder(&m_lock);
@@ -260,6 +456,10 @@ void TieredCompilationManager::OptimizeMethodsCallback()
                         STRESS_LOG0(LF_TIEREDCOMPILATION, LL_WARNING, "TieredCompilationManager::OptimizeMethodsCallback: "
                             "ThreadpoolMgr::QueueUserWorkItem returned FALSE (no thread will run)\n");
                     }
+                    else
+                    {
+                        StartOptimizationThreads();
+                    }
                     break;
                 }
             }
@@ -277,7 +477,10 @@ void TieredCompilationManager::OptimizeMethodsCallback()
 
 // Jit compiles and installs new optimized code for a method.
 // Called on a background thread.
-void TieredCompilationManager::OptimizeMethod(MethodDesc* pMethod)
+//
+// enqueueTickCount is the tick count at which the method reached the call
+// count threshold, used to track the time to tier1.
+void TieredCompilationManager::OptimizeMethod(MethodDesc* pMethod, ULONGLONG enqueueTickCount)
 {
     STANDARD_VM_CONTRACT;
 
@@ -286,6 +489,15 @@ void TieredCompilationManager::OptimizeMethod(MethodDesc* pMethod)
     if (pJittedCode != NULL)
     {
         InstallMethodCode(pMethod, pJittedCode);
+
+        ULONGLONG timeToTier1Ms = CLRGetTickCount64() - enqueueTickCount;
+        SpinLockHolder holder(&m_lock);
+        m_countMethodsOptimized++;
+        m_totalTimeToTier1Ms += timeToTier1Ms;
+        if (timeToTier1Ms > m_maxTimeToTier1Ms)
+        {
+            m_maxTimeToTier1Ms = timeToTier1Ms;
+        }
     }
 }
 
@@ -302,6 +514,14 @@ PCODE TieredCompilationManager::CompileMethod(MethodDesc* pMethod)
         CORJIT_FLAGS flags = CORJIT_FLAGS(CORJIT_FLAGS::CORJIT_FLAG_MCJIT_BACKGROUND);
         flags.Add(CORJIT_FLAGS(CORJIT_FLAGS::CORJIT_FLAG_TIER1));
 
+#ifdef FEATURE_JIT_HOT_COLD_SPLITTING
+        // Move the rarely run parts of the optimized code out of the way of the hot parts
+        if (g_pConfig->TieredCompilation_SplitTier1Code() && !pMethod->IsLCGMethod())
+        {
+            flags.Add(CORJIT_FLAGS(CORJIT_FLAGS::CORJIT_FLAG_PROCSPLIT));
+        }
+#endif
+
         if (pMethod->IsDynamicMethod())
         {
             ILStubResolver* pResolver = pMethod->AsDynamicMethodDesc()->GetILStubResolver();
@@ -361,19 +581,34 @@ void TieredCompilationManager::InstallMethodCode(MethodDesc* pMethod, PCODE pCod
     }
 }
 
-// Dequeues the next method in the optmization queue.
+// Dequeues the next method in the optmization queue, taking the highest
+// priority first, and returns the tick count at which it was queued.
 // This should be called with m_lock already held and runs
 // on the background thread.
-MethodDesc* TieredCompilationManager::GetNextMethodToOptimize()
+MethodDesc* TieredCompilationManager::GetNextMethodToOptimize(ULONGLONG* pEnqueueTickCount)
 {
     STANDARD_VM_CONTRACT;
 
-    SListElem<MethodDesc*>* pElem = m_methodsToOptimize.RemoveHead();
-    if (pElem != NULL)
+    for (int priority = TIERED_COMPILATION_PRIORITY_LEVELS - 1; priority >= 0; priority--)
     {
-        MethodDesc* pMD = pElem->GetValue();
-        delete pElem;
-        return pMD;
+        SListElem<MethodDesc*>* pElem;
+        while ((pElem = m_methodsToOptimize[priority].RemoveHead()) != NULL)
+        {
+            MethodDesc* pMD = pElem->GetValue();
+            delete pElem;
+
+            // Promoted methods leave a stale element behind at their previous priority
+            const TieredCompilationQueueEntry* pEntry = m_queuedMethods.LookupPtr(pMD);
+            if (pEntry == NULL || pEntry->priority != (DWORD)priority)
+            {
+                continue;
+            }
+
+            *pEnqueueTickCount = pEntry->enqueueTickCount;
+            m_queuedMethods.Remove(pMD);
+            m_backlogDepth--;
+            return pMD;
+        }
     }
     return NULL;
 }
@@ -12,6 +12,55 @@
 
 #ifdef FEATURE_TIERED_COMPILATION
 
+// Methods waiting for optimization are queued at a priority level. A method enters the
+// queue at level 0 when it reaches the call count threshold and is promoted one level
+// each time its call count doubles while it is still waiting.
+#define TIERED_COMPILATION_PRIORITY_LEVELS 4
+
+// One entry in our dictionary of methods that are waiting in the optimization queue
+struct TieredCompilationQueueEntry
+{
+    TieredCompilationQueueEntry() {}
+    TieredCompilationQueueEntry(const MethodDesc* m, ULONGLONG t, DWORD p)
+        : pMethod(m), enqueueTickCount(t), priority(p) {}
+
+    const MethodDesc* pMethod;
+    ULONGLONG enqueueTickCount;
+    DWORD priority;
+};
+
+class TieredCompilationQueueHashTraits : public DefaultSHashTraits<TieredCompilationQueueEntry>
+{
+public:
+    typedef typename DefaultSHashTraits<TieredCompilationQueueEntry>::element_t element_t;
+    typedef typename DefaultSHashTraits<TieredCompilationQueueEntry>::count_t count_t;
+
+    typedef const MethodDesc* key_t;
+
+    static key_t GetKey(element_t e)
+    {
+        LIMITED_METHOD_CONTRACT;
+        return e.pMethod;
+    }
+    static BOOL Equals(key_t k1, key_t k2)
+    {
+        LIMITED_METHOD_CONTRACT;
+        return k1 == k2;
+    }
+    static count_t Hash(key_t k)
+    {
+        LIMITED_METHOD_CONTRACT;
+        return (count_t)(size_t)k;
+    }
+
+    static const element_t Null() { LIMITED_METHOD_CONTRACT; return element_t(NULL, 0, 0); }
+    static const element_t Deleted() { LIMITED_METHOD_CONTRACT; return element_t((const MethodDesc*)-1, 0, 0); }
+    static bool IsNull(const element_t &e) { LIMITED_METHOD_CONTRACT; return e.pMethod == NULL; }
+    static bool IsDeleted(const element_t &e) { return e.pMethod == (const MethodDesc*)-1; }
+};
+
+typedef SHash<TieredCompilationQueueHashTraits> TieredCompilationQueueHash;
+
 // TieredCompilationManager determines which methods should be recompiled and
 // how they should be recompiled to best optimize the running code. It then
 // handles logistics of getting new code created and installed.
@@ -32,18 +81,31 @@ private:
 
     static DWORD StaticOptimizeMethodsCallback(void* args);
     void OptimizeMethodsCallback();
-    void OptimizeMethod(MethodDesc* pMethod);
-    MethodDesc* GetNextMethodToOptimize();
+    void OptimizeMethod(MethodDesc* pMethod, ULONGLONG enqueueTickCount);
+    MethodDesc* GetNextMethodToOptimize(ULONGLONG* pEnqueueTickCount);
+    BOOL EnqueueMethod(MethodDesc* pMethodDesc, DWORD priority);
+    DWORD GetDesiredOptimizationThreadCount();
+    void StartOptimizationThreads();
     PCODE CompileMethod(MethodDesc* pMethod);
     void InstallMethodCode(MethodDesc* pMethod, PCODE pCode);
 
     SpinLock m_lock;
-    SList<SListElem<MethodDesc*>> m_methodsToOptimize;
+    CrstExplicitInit m_addLock;   // serializes additions to m_queuedMethods, taken before m_lock
+    SList<SListElem<MethodDesc*>> m_methodsToOptimize[TIERED_COMPILATION_PRIORITY_LEVELS];
+    TieredCompilationQueueHash m_queuedMethods;
     ADID m_domainId;
     BOOL m_isAppDomainShuttingDown;
     DWORD m_countOptimizationThreadsRunning;
+    DWORD m_maxOptimizationThreads;
     DWORD m_callCountOptimizationThreshhold;
     DWORD m_optimizationQuantumMs;
+
+    // counters, protected by m_lock
+    DWORD m_backlogDepth;
+    DWORD m_peakBacklogDepth;
+    DWORD m_countMethodsOptimized;
+    ULONGLONG m_totalTimeToTier1Ms;
+    ULONGLONG m_maxTimeToTier1Ms;
 };
 
 #endif // FEATURE_TIERED_COMPILATION
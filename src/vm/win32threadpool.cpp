@@ -33,6 +33,7 @@ Revision History:
 #include "nativeoverlapped.h"
 #include "hillclimbing.h"
 #include "configuration.h"
+#include "lockcontention.h"
 
 
 #ifndef FEATURE_PAL
@@ -77,6 +78,25 @@ SetWaitableTimerExProc g_pufnSetWaitableTimerEx = NULL;
 BOOL ThreadpoolMgr::InitCompletionPortThreadpool = FALSE;
 HANDLE ThreadpoolMgr::GlobalCompletionPort;                 // used for binding io completions on file handles
 
+#ifdef FEATURE_PAL
+PAL_IO_COMPLETION_PORT ThreadpoolMgr::GlobalIoReadinessPort;  // used for binding readiness callbacks on file descriptors
+CrstStatic ThreadpoolMgr::IoReadinessBindingsLock;
+ThreadpoolMgr::IoReadinessBinding* ThreadpoolMgr::FreeIoReadinessBindings = NULL;
+
+// Cacheline aligned, hot variable
+DECLSPEC_ALIGN(64) LONG ThreadpoolMgr::IoReadinessCompletions = 0;
+LONG ThreadpoolMgr::PriorIoReadinessCompletions = 0;
+DWORD ThreadpoolMgr::PriorIoReadinessSampleTime = 0;
+double ThreadpoolMgr::PriorIoReadinessThroughput = 0;
+int ThreadpoolMgr::IoReadinessLastMove = 0;
+int ThreadpoolMgr::IoReadinessHoldSamples = 0;
+
+PAL_IO_COMPLETION_PORT ThreadpoolMgr::RegisteredWaitPort = NULL;
+DWORD ThreadpoolMgr::RegisteredWaitThreadId = 0;
+BOOL ThreadpoolMgr::RegisteredWaitPortDisabled = FALSE;
+ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::RegisteredTimedWaitsHead;
+#endif // FEATURE_PAL
+
 SVAL_IMPL(ThreadpoolMgr::ThreadCounter,ThreadpoolMgr,CPThreadCounter);
 
 SVAL_IMPL_INIT(LONG,ThreadpoolMgr,MaxLimitTotalCPThreads,1000);   // = MaxLimitCPThreadsPerCPU * number of CPUS
@@ -124,7 +144,13 @@ DECLSPEC_ALIGN(64) int ThreadpoolMgr::offset_counter = 0;
 SPTR_IMPL(WorkRequest,ThreadpoolMgr,WorkRequestHead);        // Head of work request queue
 SPTR_IMPL(WorkRequest,ThreadpoolMgr,WorkRequestTail);        // Head of work request queue
 
-SVAL_IMPL(ThreadpoolMgr::LIST_ENTRY,ThreadpoolMgr,TimerQueue);  // queue of timers
+DECLSPEC_ALIGN(64) WorkRequest* ThreadpoolMgr::InjectedWorkRequests = NULL;
+DECLSPEC_ALIGN(64) DangerousNonHostedSpinLock ThreadpoolMgr::WorkRequestLock;
+
+ThreadpoolMgr::WorkStealingQueue* ThreadpoolMgr::LocalWorkQueues[ThreadpoolMgr::MaxLocalWorkQueues];
+LONG ThreadpoolMgr::NumLocalWorkQueues = 0;
+BOOL ThreadpoolMgr::UseLocalWorkQueues = FALSE;
+ULONG ThreadpoolMgr::NumInjectedWorkRequests = 0;
 
 //unsigned int ThreadpoolMgr::LastCpuSamplingTime=0;      //  last time cpu utilization was sampled by gate thread
 unsigned int ThreadpoolMgr::LastCPThreadCreation=0;     //  last time a completion port thread was created
@@ -142,9 +168,18 @@ CLRSemaphore* ThreadpoolMgr::RetiredWorkerSemaphore;
 CrstStatic ThreadpoolMgr::TimerQueueCriticalSection;
 HANDLE ThreadpoolMgr::TimerThread=NULL;
 Thread *ThreadpoolMgr::pTimerThread=NULL;
+CLREvent * ThreadpoolMgr::TimerThreadWakeEvent=NULL;
 
-// Cacheline aligned, hot variable
-DECLSPEC_ALIGN(64) DWORD ThreadpoolMgr::LastTickCount;
+ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::TimerWheelRoot[TIMER_WHEEL_ROOT_SIZE];
+ThreadpoolMgr::LIST_ENTRY ThreadpoolMgr::TimerWheelLevels[TIMER_WHEEL_LEVELS][TIMER_WHEEL_LEVEL_SIZE];
+DWORD ThreadpoolMgr::TimerWheelTime;
+DWORD ThreadpoolMgr::NumTimersInWheel=0;
+
+ThreadpoolMgr::PendingTimerList* ThreadpoolMgr::PendingTimerLists=NULL;
+DWORD ThreadpoolMgr::NumPendingTimerLists=0;
+
+// Cacheline aligned, read by every thread creating a timer
+DECLSPEC_ALIGN(64) DWORD ThreadpoolMgr::TimerThreadWakeTime;
 
 #ifdef _DEBUG
 DWORD ThreadpoolMgr::TickCountAdjustment=0;
@@ -354,17 +389,39 @@ BOOL ThreadpoolMgr::Initialize()
     EX_TRY
     {
         ThreadAdjustmentInterval = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_HillClimbing_SampleIntervalLow);
+        UseLocalWorkQueues = (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_UseLocalWorkQueues) != 0);
+        EnableBlockingCompensation = (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_EnableBlockingCompensation) != 0);
+        ThreadpoolTelemetry::Initialize();
         
         pADTPCount->InitResources();
         WorkerCriticalSection.Init(CrstThreadpoolWorker);
         WaitThreadsCriticalSection.Init(CrstThreadpoolWaitThreads);
         TimerQueueCriticalSection.Init(CrstThreadpoolTimerQueue);
+#ifdef FEATURE_PAL
+        IoReadinessBindingsLock.Init(CrstThreadpoolIoReadinessBindings);
+#endif // FEATURE_PAL
 
         // initialize WaitThreadsHead
         InitializeListHead(&WaitThreadsHead);
 
-        // initialize TimerQueue
-        InitializeListHead(&TimerQueue);
+#ifdef FEATURE_PAL
+        InitializeListHead(&RegisteredTimedWaitsHead);
+        RegisteredWaitPortDisabled = (CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_RegisteredWaitPort) == 0);
+#endif // FEATURE_PAL
+
+        // initialize the timer wheel
+        for (DWORD i = 0; i < TIMER_WHEEL_ROOT_SIZE; i++)
+        {
+            InitializeListHead(&TimerWheelRoot[i]);
+        }
+
+        for (DWORD level = 0; level < TIMER_WHEEL_LEVELS; level++)
+        {
+            for (DWORD i = 0; i < TIMER_WHEEL_LEVEL_SIZE; i++)
+            {
+                InitializeListHead(&TimerWheelLevels[level][i]);
+            }
+        }
 
         RetiredCPWakeupEvent = new CLREvent();
         RetiredCPWakeupEvent->CreateAutoEvent(FALSE);
@@ -390,6 +447,11 @@ BOOL ThreadpoolMgr::Initialize()
             RecycledLists.Initialize( sysInfo.dwNumberOfProcessors );
         }
     */
+
+        // one list of pending timers per processor, indexed the same way as RecycledLists
+        NumPendingTimerLists = (CPUGroupInfo::CanEnableGCCPUGroups() && CPUGroupInfo::CanEnableThreadUseAllCpuGroups()) ?
+            CPUGroupInfo::GetNumActiveProcessors() : g_SystemInfo.dwNumberOfProcessors;
+        PendingTimerLists = new PendingTimerList[NumPendingTimerLists]();
     }
     EX_CATCH
     {
@@ -405,6 +467,9 @@ BOOL ThreadpoolMgr::Initialize()
         WorkerCriticalSection.Destroy();
         WaitThreadsCriticalSection.Destroy();
         TimerQueueCriticalSection.Destroy();
+#ifdef FEATURE_PAL
+        IoReadinessBindingsLock.Destroy();
+#endif // FEATURE_PAL
 
         bExceptionCaught = TRUE;
     }
@@ -454,6 +519,10 @@ BOOL ThreadpoolMgr::Initialize()
                                                       0,        /*ignored for invalid handle value*/
                                                       NumberOfProcessors);
     }
+#else // !FEATURE_PAL
+    // Failing to create the port only disables BindIoReadinessCallback
+    GlobalIoReadinessPort = PAL_CreateIoCompletionPort();
+    PriorIoReadinessSampleTime = GetTickCount();
 #endif // !FEATURE_PAL    
 
     HillClimbingInstance.Initialize();
@@ -902,6 +971,10 @@ bool ThreadpoolMgr::ShouldWorkerKeepRunning()
 
 DangerousNonHostedSpinLock ThreadpoolMgr::ThreadAdjustmentLock;
 
+DECLSPEC_ALIGN(64) LONG ThreadpoolMgr::NumBlockedWorkers = 0;
+LONG ThreadpoolMgr::NumBlockingCompensation = 0;
+BOOL ThreadpoolMgr::EnableBlockingCompensation = FALSE;
+
 
 //
 // This method must only be called if ShouldAdjustMaxWorkersActive has returned true, *and*
@@ -988,6 +1061,15 @@ void ThreadpoolMgr::AdjustMaxWorkersActive()
         MemoryBarrier(); // flush previous writes (especially NextCompletedWorkRequestsTime)
         PriorCompletedWorkRequestsTime = currentTicks;
         CurrentSampleStartTime = endTime;;
+
+        if (UseLocalWorkQueues)
+        {
+            ULONG numLocal, numStolen, numInjected;
+            LONG localDepth;
+            GetWorkQueueStatistics(&numLocal, &numStolen, &numInjected, &localDepth);
+            STRESS_LOG4(LF_THREADPOOL, LL_INFO100, "Work requests: %u local, %u stolen, %u injected, %d in local queues\n",
+                        numLocal, numStolen, numInjected, localDepth);
+        }
     }
 }
 
@@ -1083,6 +1165,126 @@ void ThreadpoolMgr::MaybeAddWorkingWorker()
     }
 }
 
+// Called by a thread that is about to block. Returns true if it is a worker that is now counted as blocked,
+// in which case it has to call NotifyBlockingEnd once it is done.
+bool ThreadpoolMgr::NotifyBlockingBegin()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (!EnableBlockingCompensation)
+        return false;
+
+    // Nested waits, such as the event wait of a contended monitor, are only counted once
+    size_t threadType = (size_t)ClrFlsGetValue(TlsIdx_ThreadType);
+    if ((threadType & (ThreadType_Threadpool_Worker | ThreadType_Threadpool_Blocking)) != ThreadType_Threadpool_Worker)
+        return false;
+
+    ClrFlsSetThreadType(ThreadType_Threadpool_Blocking);
+    FastInterlockIncrement(&NumBlockedWorkers);
+
+    // Whoever holds the lock is adjusting the thread count already; the gate thread catches up otherwise
+    DangerousNonHostedSpinLockTryHolder tal(&ThreadAdjustmentLock);
+    if (tal.Acquired())
+    {
+        AdjustBlockingCompensation(TRUE);
+    }
+
+    return true;
+}
+
+void ThreadpoolMgr::NotifyBlockingEnd()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    _ASSERTE(IsThreadPoolWorkerSpecialThread());
+
+    ClrFlsClearThreadType(ThreadType_Threadpool_Blocking);
+    LONG numBlocked = FastInterlockDecrement(&NumBlockedWorkers);
+    _ASSERTE(numBlocked >= 0);
+
+    if (VolatileLoad(&NumBlockingCompensation) > numBlocked)
+    {
+        DangerousNonHostedSpinLockTryHolder tal(&ThreadAdjustmentLock);
+        if (tal.Acquired())
+        {
+            // Only lowers MaxWorking, so it does not create threads
+            AdjustBlockingCompensation(FALSE);
+        }
+    }
+}
+
+// Moves MaxWorking by the difference between the number of blocked workers and the number of workers already
+// let in for them. Extra workers are only let in while there is work for them. Surplus workers retire by
+// themselves once MaxWorking is lowered.
+void ThreadpoolMgr::AdjustBlockingCompensation(BOOL fAllowIncrease)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        if (GetThread() && fAllowIncrease) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    _ASSERTE(ThreadAdjustmentLock.IsHeld());
+
+    LONG numBlocked = VolatileLoad(&NumBlockedWorkers);
+    LONG delta = numBlocked - NumBlockingCompensation;
+
+    if (delta == 0)
+        return;
+
+    if (delta > 0 && (!fAllowIncrease || !PerAppDomainTPCountList::AreRequestsPendingInAnyAppDomains()))
+        return;
+
+    ThreadCounter::Counts counts = WorkerCounter.GetCleanCounts();
+    ThreadCounter::Counts newCounts;
+    while (true)
+    {
+        newCounts = counts;
+        newCounts.MaxWorking = max((LONG)MinLimitTotalWorkerThreads, min((LONG)counts.MaxWorking + delta, (LONG)MaxLimitTotalWorkerThreads));
+
+        if (newCounts == counts)
+            break;
+
+        ThreadCounter::Counts oldCounts = WorkerCounter.CompareExchangeCounts(newCounts, counts);
+        if (oldCounts == counts)
+            break;
+
+        counts = oldCounts;
+    }
+
+    // An increase that hit MaxLimitTotalWorkerThreads is only partly applied, and is retried later. A decrease
+    // that hit MinLimitTotalWorkerThreads is dropped, since hill climbing has taken MaxWorking down already.
+    if (delta > 0)
+        NumBlockingCompensation += (newCounts.MaxWorking - counts.MaxWorking);
+    else
+        NumBlockingCompensation = numBlocked;
+
+    STRESS_LOG3(LF_THREADPOOL, LL_INFO100, "%d workers blocked, %d compensated for, MaxWorking %d\n",
+                numBlocked, NumBlockingCompensation, newCounts.MaxWorking);
+
+    if (newCounts.MaxWorking != counts.MaxWorking)
+    {
+        HillClimbingInstance.ForceChange(newCounts.MaxWorking, (delta > 0) ? CooperativeBlocking : CooperativeBlockingEnded);
+
+        if (newCounts.MaxWorking > counts.MaxWorking)
+            MaybeAddWorkingWorker();
+    }
+}
+
 BOOL ThreadpoolMgr::PostQueuedCompletionStatus(LPOVERLAPPED lpOverlapped,
                                       LPOVERLAPPED_COMPLETION_ROUTINE Function)
 {
@@ -1453,9 +1655,15 @@ bool ThreadpoolMgr::ShouldGateThreadKeepRunning()
         bool needGateThreadForWorkerTracking = 
             0 != CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_EnableWorkerTracking);
 
+        //
+        // Lock contention counts are also published by the gate thread, for as long as it has been started once.
+        //
+        bool needGateThreadForLockContention = LockContentionProfiler::IsEnabled();
+
         if (!(needGateThreadForCompletionPort || 
               needGateThreadForWorkerThreads ||
-              needGateThreadForWorkerTracking))
+              needGateThreadForWorkerTracking ||
+              needGateThreadForLockContention))
         {
             //
             // It looks like we shouldn't be running.  But another thread may now tell us to run.  If so, they will set GateThreadStatus
@@ -1476,6 +1684,8 @@ bool ThreadpoolMgr::ShouldGateThreadKeepRunning()
 
 
 //************************************************************************
+// Work requests queued by a worker thread go to its local queue. Everything else is injected into the global
+// queue, without taking a lock.
 void ThreadpoolMgr::EnqueueWorkRequest(WorkRequest* workRequest)
 {
     CONTRACTL
@@ -1486,9 +1696,17 @@ void ThreadpoolMgr::EnqueueWorkRequest(WorkRequest* workRequest)
     }
     CONTRACTL_END;
 
-    AppendWorkRequest(workRequest);
+    _ASSERTE(workRequest->next == NULL);
+
+    WorkStealingQueue* localQueue = GetLocalWorkQueue();
+    if (localQueue != NULL && localQueue->TryPush(workRequest))
+        return;
+
+    InjectWorkRequests(workRequest, workRequest);
 }
 
+// Looks for work in the local queue of the current thread, then in the global queue, and finally in the local
+// queues of the other workers.
 WorkRequest* ThreadpoolMgr::DequeueWorkRequest()
 {
     WorkRequest* entry = NULL;
@@ -1501,11 +1719,232 @@ WorkRequest* ThreadpoolMgr::DequeueWorkRequest()
         POSTCONDITION(CheckPointer(entry, NULL_OK));
     } CONTRACT_END;
 
-    entry = RemoveWorkRequest();
+    WorkStealingQueue* localQueue = GetLocalWorkQueue();
+    if (localQueue != NULL)
+    {
+        entry = localQueue->TryPop();
+        if (entry != NULL)
+            RETURN entry;
+    }
+
+    if (VolatileLoad(&WorkRequestHead) != NULL || VolatileLoad(&InjectedWorkRequests) != NULL)
+    {
+        DangerousNonHostedSpinLockHolder lh(&WorkRequestLock);
+
+        if (WorkRequestHead == NULL)
+        {
+            // Take everything that was injected so far. It comes newest first, so turn it around.
+            WorkRequest* injected = InterlockedExchangeT(&InjectedWorkRequests, (WorkRequest*)NULL);
+            while (injected != NULL)
+            {
+                WorkRequest* next = injected->next;
+                injected->next = WorkRequestHead;
+                if (WorkRequestHead == NULL)
+                    WorkRequestTail = injected;
+                WorkRequestHead = injected;
+                injected = next;
+                NumInjectedWorkRequests++;
+            }
+        }
+
+        entry = RemoveWorkRequest();
+        if (entry != NULL)
+        {
+            entry->next = NULL;
+            RETURN entry;
+        }
+    }
+
+    entry = StealWorkRequest(localQueue);
 
     RETURN entry;
 }
 
+// Pushes a chain of work requests, linked from first to last, onto InjectedWorkRequests. Consumers take
+// them in the reverse order, so first should be the most recent one.
+void ThreadpoolMgr::InjectWorkRequests(WorkRequest* first, WorkRequest* last)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    WorkRequest* head = VolatileLoad(&InjectedWorkRequests);
+    while (true)
+    {
+        last->next = head;
+
+        WorkRequest* prevHead = InterlockedCompareExchangeT(&InjectedWorkRequests, first, head);
+        if (prevHead == head)
+            break;
+
+        head = prevHead;
+    }
+}
+
+// Returns the local queue of the current thread, claiming one if it is a worker thread that has none yet.
+// Returns NULL for other threads, and for workers beyond MaxLocalWorkQueues.
+ThreadpoolMgr::WorkStealingQueue* ThreadpoolMgr::GetLocalWorkQueue()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (!UseLocalWorkQueues)
+        return NULL;
+
+    WorkStealingQueue* localQueue = (WorkStealingQueue*) ClrFlsGetValue(TlsIdx_ThreadpoolLocalWorkQueue);
+    if (localQueue != NULL || !IsThreadPoolWorkerSpecialThread())
+        return localQueue;
+
+    // Reuse the queue of a worker that has gone
+    LONG numQueues = VolatileLoad(&NumLocalWorkQueues);
+    for (LONG i = 0; i < numQueues; i++)
+    {
+        WorkStealingQueue* queue = VolatileLoad(&LocalWorkQueues[i]);
+        if (queue != NULL && VolatileLoad(&queue->m_owned) == 0 &&
+            FastInterlockCompareExchange(&queue->m_owned, 1, 0) == 0)
+        {
+            localQueue = queue;
+            break;
+        }
+    }
+
+    if (localQueue == NULL && numQueues < MaxLocalWorkQueues)
+    {
+        WorkStealingQueue* queue = new (nothrow) WorkStealingQueue();
+        if (queue == NULL)
+            return NULL;
+
+        queue->m_owned = 1;
+
+        // Thieves only look at slots below NumLocalWorkQueues, so publish the queue before raising it
+        LONG index;
+        for (index = 0; index < MaxLocalWorkQueues; index++)
+        {
+            if (InterlockedCompareExchangeT(&LocalWorkQueues[index], queue, (WorkStealingQueue*)NULL) == NULL)
+                break;
+        }
+
+        if (index == MaxLocalWorkQueues)
+        {
+            delete queue;
+            return NULL;
+        }
+
+        LONG oldNumQueues = VolatileLoad(&NumLocalWorkQueues);
+        while (oldNumQueues <= index)
+        {
+            LONG prevNumQueues = FastInterlockCompareExchange(&NumLocalWorkQueues, index + 1, oldNumQueues);
+            if (prevNumQueues == oldNumQueues)
+                break;
+            oldNumQueues = prevNumQueues;
+        }
+
+        localQueue = queue;
+    }
+
+    if (localQueue != NULL)
+        ClrFlsSetValue(TlsIdx_ThreadpoolLocalWorkQueue, localQueue);
+
+    return localQueue;
+}
+
+// Takes the oldest request out of the local queue of another worker. Each thread starts its scan at a
+// different queue so that thieves spread over the victims.
+WorkRequest* ThreadpoolMgr::StealWorkRequest(WorkStealingQueue* localQueue)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    LONG numQueues = VolatileLoad(&NumLocalWorkQueues);
+    if (numQueues == 0)
+        return NULL;
+
+    LONG start = (LONG)(GetCurrentThreadId() % (DWORD)numQueues);
+
+    bool missed;
+    do
+    {
+        missed = false;
+
+        for (LONG i = 0; i < numQueues; i++)
+        {
+            WorkStealingQueue* queue = VolatileLoad(&LocalWorkQueues[(start + i) % numQueues]);
+            if (queue == NULL || queue == localQueue)
+                continue;
+
+            WorkRequest* workRequest = queue->TrySteal(&missed);
+            if (workRequest != NULL)
+                return workRequest;
+        }
+
+        // If we lost a race for a request, there may be more behind it; look again rather than report
+        // that there is no work
+    } while (missed);
+
+    return NULL;
+}
+
+// Gives up the local queue of the current worker thread, which is about to retire or exit. Whatever is left in
+// it is injected into the global queue, so that it does not wait for thieves.
+void ThreadpoolMgr::ReleaseLocalWorkQueue()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    WorkStealingQueue* localQueue = (WorkStealingQueue*) ClrFlsGetValue(TlsIdx_ThreadpoolLocalWorkQueue);
+    if (localQueue == NULL)
+        return;
+
+    // TryPop returns the most recent request first, which is the order InjectWorkRequests expects
+    WorkRequest* first = NULL;
+    WorkRequest* last = NULL;
+    WorkRequest* workRequest;
+    while ((workRequest = localQueue->TryPop()) != NULL)
+    {
+        workRequest->next = NULL;
+        if (last == NULL)
+            first = workRequest;
+        else
+            last->next = workRequest;
+        last = workRequest;
+    }
+
+    if (first != NULL)
+        InjectWorkRequests(first, last);
+
+    ClrFlsSetValue(TlsIdx_ThreadpoolLocalWorkQueue, NULL);
+    VolatileStore(&localQueue->m_owned, (LONG)0);
+}
+
+void ThreadpoolMgr::GetWorkQueueStatistics(ULONG* pNumLocal, ULONG* pNumStolen, ULONG* pNumInjected, LONG* pLocalDepth)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    *pNumLocal = 0;
+    *pNumStolen = 0;
+    *pLocalDepth = 0;
+    *pNumInjected = VolatileLoad(&NumInjectedWorkRequests);
+
+    LONG numQueues = VolatileLoad(&NumLocalWorkQueues);
+    for (LONG i = 0; i < numQueues; i++)
+    {
+        WorkStealingQueue* queue = VolatileLoad(&LocalWorkQueues[i]);
+        if (queue == NULL)
+            continue;
+
+        *pNumLocal += queue->GetNumPushed();
+        *pNumStolen += queue->GetNumStolen();
+        *pLocalDepth += queue->GetCount();
+    }
+}
+
 DWORD WINAPI ThreadpoolMgr::ExecuteHostRequest(PVOID pArg)
 {
     CONTRACTL
@@ -2041,6 +2480,9 @@ Work:
 
 Retire:
 
+    // a retired thread may sleep for a long time, so don't leave requests behind in its local queue
+    ReleaseLocalWorkQueue();
+
     counts = WorkerCounter.GetCleanCounts();
     FireEtwThreadPoolWorkerThreadRetirementStart(counts.NumActive, counts.NumRetired, GetClrInstanceId());
 
@@ -2191,6 +2633,9 @@ RetryWaitForWork:
 
 Exit:
 
+    ReleaseLocalWorkQueue();
+    ThreadpoolTelemetry::ReleaseThreadTimings();
+
 #ifdef FEATURE_COMINTEROP
     if (pThread) {
         pThread->SetApartment(Thread::AS_Unknown, TRUE);
@@ -2292,6 +2737,49 @@ BOOL ThreadpoolMgr::RegisterWaitForSingleObject(PHANDLE phNewWaitObject,
     CONTRACTL_END;
     EnsureInitialized();
 
+    *phNewWaitObject = NULL;
+
+    WaitInfo* waitInfo = new (nothrow) WaitInfo;
+
+    if (waitInfo == NULL)
+        return FALSE;
+
+    waitInfo->waitHandle = hWaitObject;
+    waitInfo->Callback = Callback;
+    waitInfo->Context = Context;
+    waitInfo->timeout = timeout;
+    waitInfo->flag = dwFlag;
+    waitInfo->threadCB = NULL;
+    waitInfo->state = 0;
+    waitInfo->refCount = 1;     // safe to do this since no wait has yet been queued, so no other thread could be modifying this
+    waitInfo->ExternalCompletionEvent = INVALID_HANDLE;
+    waitInfo->ExternalEventSafeHandle = NULL;
+    waitInfo->handleOwningAD = (ADID) 0;
+
+    waitInfo->timer.startTime = GetTickCount();
+    waitInfo->timer.remainingTime = timeout;
+
+    *phNewWaitObject = waitInfo;
+
+    // We fire the "enqueue" ETW event here, to "mark" the thread that had called the API, rather than the
+    // thread that will PostQueuedCompletionStatus (the dedicated WaitThread).
+    // This event correlates with ThreadPoolIODequeue in ThreadpoolMgr::AsyncCallbackCompletion
+    if (ETW_EVENT_ENABLED(MICROSOFT_WINDOWS_DOTNETRUNTIME_PROVIDER_Context, ThreadPoolIOEnqueue))
+        FireEtwThreadPoolIOEnqueue((LPOVERLAPPED)waitInfo, reinterpret_cast<void*>(Callback), (dwFlag & WAIT_SINGLE_EXECUTION) == 0, GetClrInstanceId());
+
+#ifdef FEATURE_PAL
+    // A single thread services any number of waits through RegisteredWaitPort. It hands the waits
+    // the PAL cannot register on the port over to wait threads.
+    waitInfo->registration = NULL;
+    InitializeListHead(&waitInfo->link);
+
+    if (EnsureRegisteredWaitThreadRunning() &&
+        PAL_PostIoCompletionPort(RegisteredWaitPort, (ULONG_PTR)waitInfo, REGISTERED_WAIT_INSERT))
+    {
+        return TRUE;
+    }
+#endif // FEATURE_PAL
+
     ThreadCB* threadCB;
     {
         CrstHolder csh(&WaitThreadsCriticalSection);
@@ -2299,50 +2787,22 @@ BOOL ThreadpoolMgr::RegisterWaitForSingleObject(PHANDLE phNewWaitObject,
         threadCB = FindWaitThread();
     }
 
-    *phNewWaitObject = NULL;
+    BOOL status = FALSE;
 
     if (threadCB)
     {
-        WaitInfo* waitInfo = new (nothrow) WaitInfo;
-
-        if (waitInfo == NULL)
-            return FALSE;
-
-        waitInfo->waitHandle = hWaitObject;
-        waitInfo->Callback = Callback;
-        waitInfo->Context = Context;
-        waitInfo->timeout = timeout;
-        waitInfo->flag = dwFlag;
         waitInfo->threadCB = threadCB;
-        waitInfo->state = 0;
-        waitInfo->refCount = 1;     // safe to do this since no wait has yet been queued, so no other thread could be modifying this
-        waitInfo->ExternalCompletionEvent = INVALID_HANDLE;
-        waitInfo->ExternalEventSafeHandle = NULL;
-        waitInfo->handleOwningAD = (ADID) 0;
 
-        waitInfo->timer.startTime = GetTickCount();
-        waitInfo->timer.remainingTime = timeout;
-
-        *phNewWaitObject = waitInfo;
-
-        // We fire the "enqueue" ETW event here, to "mark" the thread that had called the API, rather than the
-        // thread that will PostQueuedCompletionStatus (the dedicated WaitThread).
-        // This event correlates with ThreadPoolIODequeue in ThreadpoolMgr::AsyncCallbackCompletion
-        if (ETW_EVENT_ENABLED(MICROSOFT_WINDOWS_DOTNETRUNTIME_PROVIDER_Context, ThreadPoolIOEnqueue))
-            FireEtwThreadPoolIOEnqueue((LPOVERLAPPED)waitInfo, reinterpret_cast<void*>(Callback), (dwFlag & WAIT_SINGLE_EXECUTION) == 0, GetClrInstanceId());
-    
-        BOOL status = QueueUserAPC((PAPCFUNC)InsertNewWaitForSelf, threadCB->threadHandle, (size_t) waitInfo);
-
-        if (status == FALSE)
-        {
-            *phNewWaitObject = NULL;
-            delete waitInfo;
-        }
+        status = QueueUserAPC((PAPCFUNC)InsertNewWaitForSelf, threadCB->threadHandle, (size_t) waitInfo);
+    }
 
-        return status;
+    if (status == FALSE)
+    {
+        *phNewWaitObject = NULL;
+        delete waitInfo;
     }
 
-    return FALSE;
+    return status;
 }
 
 
@@ -2911,6 +3371,14 @@ void ThreadpoolMgr::DeactivateWait(WaitInfo* waitInfo)
 {
     LIMITED_METHOD_CONTRACT;
 
+#ifdef FEATURE_PAL
+    if (waitInfo->threadCB == NULL)
+    {
+        DeactivateRegisteredWait(waitInfo);
+        return;
+    }
+#endif // FEATURE_PAL
+
     ThreadCB* threadCB = waitInfo->threadCB;
     DWORD endIndex = threadCB->NumActiveWaits-1;
     DWORD index;
@@ -2939,6 +3407,14 @@ void ThreadpoolMgr::DeactivateNthWait(WaitInfo* waitInfo, DWORD index)
 {
     LIMITED_METHOD_CONTRACT;
 
+#ifdef FEATURE_PAL
+    if (waitInfo->threadCB == NULL)
+    {
+        DeactivateRegisteredWait(waitInfo);
+        return;
+    }
+#endif // FEATURE_PAL
+
     ThreadCB* threadCB = waitInfo->threadCB;
 
     if (waitInfo->link.Flink != waitInfo->link.Blink)
@@ -3040,7 +3516,11 @@ BOOL ThreadpoolMgr::UnregisterWaitEx(HANDLE hWaitObject,HANDLE Event)
     }
 
     // we do not allow callbacks to run in the wait thread, hence the assert
+#ifdef FEATURE_PAL
+    _ASSERTE(GetCurrentThreadId() != (waitInfo->threadCB ? waitInfo->threadCB->threadId : RegisteredWaitThreadId));
+#else
     _ASSERTE(GetCurrentThreadId() != waitInfo->threadCB->threadId);
+#endif // FEATURE_PAL
 
 
     if (Blocking)
@@ -3057,7 +3537,7 @@ BOOL ThreadpoolMgr::UnregisterWaitEx(HANDLE hWaitObject,HANDLE Event)
         waitInfo->PartialCompletionEvent.CreateAutoEvent(FALSE);
     }
 
-    BOOL status = QueueDeregisterWait(waitInfo->threadCB->threadHandle, waitInfo);
+    BOOL status = QueueDeregisterWait(waitInfo);
 
 
     if (status == 0)
@@ -3157,23 +3637,378 @@ void ThreadpoolMgr::WaitHandleCleanup(HANDLE hWaitObject)
     WaitInfo* waitInfo = (WaitInfo*) hWaitObject;
     _ASSERTE(waitInfo->refCount > 0);
 
-    DWORD result = QueueDeregisterWait(waitInfo->threadCB->threadHandle, waitInfo);
+    DWORD result = QueueDeregisterWait(waitInfo);
 
     if (result == 0)
         STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "Queue APC failed in WaitHandleCleanup %x", result);
 
 }
 
-BOOL ThreadpoolMgr::CreateGateThread()
-{
-    LIMITED_METHOD_CONTRACT;
+#ifdef FEATURE_PAL
 
-    HANDLE threadHandle = Thread::CreateUtilityThread(Thread::StackSize_Small, GateThreadStart, NULL);
+#define REGISTERED_WAIT_BATCH_SIZE 64
 
-    if (threadHandle)
+// Starts the thread that services RegisteredWaitPort. Returns FALSE if registered waits have to go to wait threads.
+BOOL ThreadpoolMgr::EnsureRegisteredWaitThreadRunning()
+{
+    CONTRACTL
     {
-        CloseHandle(threadHandle);  //we don't need this anymore
-        return TRUE;
+        NOTHROW;
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    if (VolatileLoad(&RegisteredWaitPort) != NULL)
+        return TRUE;
+
+    if (RegisteredWaitPortDisabled)
+        return FALSE;
+
+    CrstHolder csh(&WaitThreadsCriticalSection);
+
+    if (RegisteredWaitPort != NULL)
+        return TRUE;
+
+    if (RegisteredWaitPortDisabled || (g_fEEShutDown & ShutDown_Finalize2))
+        return FALSE;
+
+    PAL_IO_COMPLETION_PORT port = PAL_CreateIoCompletionPort();
+    if (port == NULL)
+    {
+        // e.g. the platform has no epoll
+        RegisteredWaitPortDisabled = TRUE;
+        return FALSE;
+    }
+
+    DWORD threadId;
+    HANDLE threadHandle = Thread::CreateUtilityThread(Thread::StackSize_Small, RegisteredWaitThreadStart, (LPVOID)port, 0, &threadId);
+
+    if (threadHandle == NULL)
+    {
+        PAL_CloseIoCompletionPort(port);
+        return FALSE;
+    }
+
+    CloseHandle(threadHandle);          // we don't need this anymore
+
+    RegisteredWaitThreadId = threadId;
+    VolatileStore(&RegisteredWaitPort, port);
+
+    return TRUE;
+}
+
+// Services RegisteredWaitPort. Waits are inserted, deregistered and satisfied by entries posted to the port,
+// so the thread holds no handles of its own and a single one services any number of waits. Timeouts are
+// checked each time it wakes up.
+DWORD WINAPI ThreadpoolMgr::RegisteredWaitThreadStart(LPVOID lpArgs)
+{
+    CONTRACTL
+    {
+        THROWS;
+        GC_TRIGGERS;
+        MODE_PREEMPTIVE;
+        SO_TOLERANT;
+    }
+    CONTRACTL_END;
+
+    ClrFlsSetThreadType (ThreadType_Wait);
+
+    PAL_IO_COMPLETION_PORT port = (PAL_IO_COMPLETION_PORT) lpArgs;
+    Thread* pThread = SetupThreadNoThrow();
+
+    if (pThread == NULL)
+    {
+        // Entries keep being posted to the port, but nobody services them
+        STRESS_LOG0(LF_THREADPOOL, LL_ERROR, "Failed to set up the registered wait thread");
+        return 0;
+    }
+
+    BEGIN_SO_INTOLERANT_CODE(pThread);  // we probe at the top of the thread so we can safely call anything below here.
+    {
+        PAL_IO_COMPLETION_ENTRY entries[REGISTERED_WAIT_BATCH_SIZE];
+
+        // the registered wait thread never dies, just like the wait threads
+        for (;;)
+        {
+            DWORD timeout = FireRegisteredWaitTimeouts();
+
+            ULONG numEntries = 0;
+            if (!PAL_GetIoCompletionPortEntries(port, entries, REGISTERED_WAIT_BATCH_SIZE, &numEntries, timeout))
+            {
+                _ASSERTE(GetLastError() == WAIT_TIMEOUT);
+                continue;
+            }
+
+            for (ULONG i = 0; i < numEntries; i++)
+            {
+                WaitInfo* waitInfo = (WaitInfo*) entries[i].CompletionKey;
+                _ASSERTE(waitInfo != NULL);
+
+                switch (entries[i].Events)
+                {
+                case REGISTERED_WAIT_INSERT:
+                    InsertRegisteredWait(waitInfo);
+                    break;
+
+                case REGISTERED_WAIT_DEREGISTER:
+                    if (waitInfo->threadCB != NULL)
+                    {
+                        // the wait was moved to a wait thread after the request was posted
+                        if (!QueueDeregisterWait(waitInfo))
+                            STRESS_LOG0(LF_THREADPOOL, LL_ERROR, "Queue APC failed when forwarding a deregistration");
+                    }
+                    else
+                    {
+                        DeregisterWait(waitInfo);
+                    }
+                    break;
+
+                case PAL_IO_EVENT_SIGNALED:
+                    ProcessRegisteredWaitSignal(waitInfo);
+                    break;
+
+                default:
+                    _ASSERTE(!"Unexpected entry on RegisteredWaitPort");
+                    break;
+                }
+            }
+        }
+    }
+    END_SO_INTOLERANT_CODE;
+    return 0;
+}
+
+// Executed on the registered wait thread. Counterpart of InsertNewWaitForSelf.
+void ThreadpoolMgr::InsertRegisteredWait(WaitInfo* waitInfo)
+{
+    WRAPPER_NO_CONTRACT;
+    STATIC_CONTRACT_SO_INTOLERANT;
+
+    _ASSERTE(waitInfo->threadCB == NULL);
+
+    if (waitInfo->state & WAIT_DELETE)
+    {
+        // some thread unregistered the wait
+        DeleteWait(waitInfo);
+        return;
+    }
+
+    if (!ArmRegisteredWait(waitInfo))
+    {
+        // mutexes, processes and the like cannot be waited on through the port
+        MoveRegisteredWaitToWaitThread(waitInfo);
+        return;
+    }
+
+    waitInfo->state = (WAIT_REGISTERED | WAIT_ACTIVE);
+
+    InitializeListHead(&waitInfo->link);
+    if (waitInfo->timeout != INFINITE)
+    {
+        InsertTailList(&RegisteredTimedWaitsHead, &waitInfo->link);
+    }
+}
+
+// Executed on the registered wait thread for a wait that could not be registered on the port. The wait is
+// handed over to a wait thread the same way RegisterWaitForSingleObject would have done it.
+void ThreadpoolMgr::MoveRegisteredWaitToWaitThread(WaitInfo* waitInfo)
+{
+    WRAPPER_NO_CONTRACT;
+    STATIC_CONTRACT_SO_INTOLERANT;
+
+    ThreadCB* threadCB = NULL;
+    EX_TRY
+    {
+        CrstHolder csh(&WaitThreadsCriticalSection);
+
+        threadCB = FindWaitThread();
+    }
+    EX_CATCH
+    {
+        threadCB = NULL;
+    }
+    EX_END_CATCH(SwallowAllExceptions);
+
+    if (threadCB != NULL)
+    {
+        // InsertNewWaitForSelf activates the wait, and DeregisterWait requests are forwarded from now on
+        waitInfo->state = 0;
+        VolatileStore(&waitInfo->threadCB, threadCB);
+
+        if (QueueUserAPC((PAPCFUNC)InsertNewWaitForSelf, threadCB->threadHandle, (size_t) waitInfo))
+            return;
+
+        VolatileStore(&waitInfo->threadCB, (ThreadCB*) NULL);
+        InterlockedDecrement(&threadCB->NumWaitHandles);
+    }
+
+    // The wait stays registered but is never satisfied, as if its handle never got signaled
+    STRESS_LOG1(LF_THREADPOOL, LL_ERROR, "Failed to move wait %p to a wait thread", waitInfo);
+    waitInfo->state = WAIT_REGISTERED;
+}
+
+BOOL ThreadpoolMgr::ArmRegisteredWait(WaitInfo* waitInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    _ASSERTE(waitInfo->registration == NULL);
+
+    if (!PAL_RegisterWaitOnIoCompletionPort(RegisteredWaitPort, waitInfo->waitHandle, (ULONG_PTR)waitInfo, &waitInfo->registration))
+    {
+        waitInfo->registration = NULL;
+        return FALSE;
+    }
+
+    return TRUE;
+}
+
+// Cancels the registration of the wait. If the wait was satisfied already, the entry is on its way through
+// the port: WAIT_SIGNAL_PENDING is set and the wait keeps a reference until ProcessRegisteredWaitSignal
+// drops the entry.
+void ThreadpoolMgr::DisarmRegisteredWait(WaitInfo* waitInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (waitInfo->registration == NULL)
+        return;
+
+    BOOL satisfied = FALSE;
+    PAL_UnregisterWaitOnIoCompletionPort(waitInfo->registration, &satisfied);
+    waitInfo->registration = NULL;
+
+    if (satisfied)
+    {
+        _ASSERTE(!(waitInfo->state & WAIT_SIGNAL_PENDING));
+        waitInfo->state |= WAIT_SIGNAL_PENDING;
+        InterlockedIncrement(&waitInfo->refCount);
+    }
+}
+
+// Counterpart of DeactivateNthWait for waits serviced through RegisteredWaitPort
+void ThreadpoolMgr::DeactivateRegisteredWait(WaitInfo* waitInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DisarmRegisteredWait(waitInfo);
+
+    RemoveEntryList(&waitInfo->link);
+    InitializeListHead(&waitInfo->link);
+
+    waitInfo->state &= ~WAIT_ACTIVE;
+}
+
+void ThreadpoolMgr::ProcessRegisteredWaitSignal(WaitInfo* waitInfo)
+{
+    WRAPPER_NO_CONTRACT;
+    STATIC_CONTRACT_SO_INTOLERANT;
+
+    BOOL signalPending = (waitInfo->state & WAIT_SIGNAL_PENDING) != 0;
+
+    if (signalPending)
+    {
+        // the registration was canceled after it was satisfied, so the signal belongs to nobody
+        waitInfo->state &= ~WAIT_SIGNAL_PENDING;
+    }
+    else
+    {
+        BOOL satisfied = FALSE;
+        PAL_UnregisterWaitOnIoCompletionPort(waitInfo->registration, &satisfied);
+        _ASSERTE(satisfied);
+        waitInfo->registration = NULL;
+
+        if (waitInfo->state & WAIT_ACTIVE)
+        {
+            ProcessWaitCompletion(waitInfo, 0, FALSE);
+
+            // a recurring wait waits for the next signal
+            if ((waitInfo->state & WAIT_ACTIVE) && !ArmRegisteredWait(waitInfo))
+            {
+                DeactivateRegisteredWait(waitInfo);
+            }
+        }
+    }
+
+    if (signalPending && InterlockedDecrement(&waitInfo->refCount) == 0)
+    {
+        if (!g_fSuspendOnShutdown)
+        {
+            DeleteWait(waitInfo);
+        }
+    }
+}
+
+// Completes the waits of RegisteredTimedWaitsHead that timed out, and returns the time until the next one does
+DWORD ThreadpoolMgr::FireRegisteredWaitTimeouts()
+{
+    WRAPPER_NO_CONTRACT;
+    STATIC_CONTRACT_SO_INTOLERANT;
+
+    DWORD minWait = INFINITE;
+    DWORD currentTime = GetTickCount();
+
+    LIST_ENTRY* node = (LIST_ENTRY*) RegisteredTimedWaitsHead.Flink;
+    while (node != &RegisteredTimedWaitsHead)
+    {
+        _ASSERTE(offsetof(WaitInfo, link) == 0);
+        WaitInfo* waitInfo = (WaitInfo*) node;
+
+        // the wait may leave the list below
+        node = (LIST_ENTRY*) node->Flink;
+
+        _ASSERTE(waitInfo->state & WAIT_ACTIVE);
+
+        if (waitInfo->state & WAIT_SIGNAL_PENDING)
+        {
+            // the signal beat the timeout, and ProcessRegisteredWaitSignal will pick it up shortly
+            continue;
+        }
+
+        DWORD elapsedTime = TimeInterval(currentTime, waitInfo->timer.startTime);
+
+        if (elapsedTime < waitInfo->timeout)
+        {
+            minWait = min(minWait, waitInfo->timeout - elapsedTime);
+            continue;
+        }
+
+        DisarmRegisteredWait(waitInfo);
+        if (waitInfo->state & WAIT_SIGNAL_PENDING)
+        {
+            continue;
+        }
+
+        ProcessWaitCompletion(waitInfo, 0, TRUE);
+
+        if (waitInfo->state & WAIT_ACTIVE)
+        {
+            if (ArmRegisteredWait(waitInfo))
+            {
+                minWait = min(minWait, waitInfo->timeout);
+            }
+            else
+            {
+                DeactivateRegisteredWait(waitInfo);
+            }
+        }
+    }
+
+    return minWait;
+}
+
+#endif // FEATURE_PAL
+
+
+BOOL ThreadpoolMgr::CreateGateThread()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    HANDLE threadHandle = Thread::CreateUtilityThread(Thread::StackSize_Small, GateThreadStart, NULL);
+
+    if (threadHandle)
+    {
+        CloseHandle(threadHandle);  //we don't need this anymore
+        return TRUE;
     }
 
     return FALSE;
@@ -3852,64 +4687,652 @@ BOOL ThreadpoolMgr::ShouldGrowCompletionPortThreadpool(ThreadCounter::Counts cou
         if (counts.NumRetired > 0)
             return TRUE;
     }
-    return FALSE;
-}
+    return FALSE;
+}
+
+void ThreadpoolMgr::GrowCompletionPortThreadpoolIfNeeded()
+{
+    CONTRACTL
+    {
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        NOTHROW;
+        MODE_ANY;
+    }
+    CONTRACTL_END;    
+
+    ThreadCounter::Counts oldCounts, newCounts;
+    while (true)
+    {
+        oldCounts = CPThreadCounter.GetCleanCounts();
+        newCounts = oldCounts;
+        
+        if(!ShouldGrowCompletionPortThreadpool(oldCounts))
+        {
+            break;
+        }
+        else
+        {
+            if (oldCounts.NumRetired > 0)
+            {        
+                // wakeup retired thread instead
+                RetiredCPWakeupEvent->Set();
+                return;
+            }
+            else 
+            {
+                // create a new thread.  New IOCP threads start as "active" and "working"
+                newCounts.NumActive++;
+                newCounts.NumWorking++;
+                if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+                {
+                    if (!CreateCompletionPortThread(NULL))
+                    {
+                        // if thread creation failed, we have to adjust the counts back down.
+                        while (true)
+                        {
+                            // counts volatile read paired with CompareExchangeCounts loop set
+                            oldCounts = CPThreadCounter.DangerousGetDirtyCounts();
+                            newCounts = oldCounts;
+                            newCounts.NumActive--;
+                            newCounts.NumWorking--;
+                            if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+                                break;
+                        }
+                    }
+                    return;
+                }
+            }    
+        } 
+    }
+}
+#else // !FEATURE_PAL
+
+// Upper bound of ThreadPool_IoReadinessBatchSize, the entries are dequeued into a buffer on the stack
+#define IO_READINESS_MAX_BATCH_SIZE 256
+
+ThreadpoolMgr::IoReadinessBinding* ThreadpoolMgr::BindIoReadinessCallback(int fd,
+                                                                         DWORD events,
+                                                                         LPIO_READINESS_ROUTINE Function,
+                                                                         LPIO_READINESS_RELEASE_ROUTINE ReleaseFunction,
+                                                                         LPVOID Context,
+                                                                         DWORD& errorCode)
+{
+    CONTRACTL
+    {
+        THROWS;     // EnsureInitialized can throw
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    _ASSERTE(fd >= 0 && Function != NULL);
+
+    errorCode = S_OK;
+
+    EnsureInitialized();
+
+    if (GlobalIoReadinessPort == NULL)
+    {
+        errorCode = ERROR_NOT_SUPPORTED;
+        return NULL;
+    }
+
+    IoReadinessBinding* pBinding;
+    {
+        CrstHolder csh(&IoReadinessBindingsLock);
+        pBinding = FreeIoReadinessBindings;
+        if (pBinding != NULL)
+            FreeIoReadinessBindings = pBinding->Next;
+    }
+
+    if (pBinding == NULL)
+    {
+        pBinding = new (nothrow) IoReadinessBinding;
+        if (pBinding == NULL)
+        {
+            errorCode = ERROR_NOT_ENOUGH_MEMORY;
+            return NULL;
+        }
+        pBinding->CallbacksRunning = 0;
+    }
+
+    // A recycled binding can still be reached by entries dequeued for the descriptor it was bound to before,
+    // so it only becomes live once its callback is set.
+    {
+        CrstHolder csh(&IoReadinessBindingsLock);
+        _ASSERTE(pBinding->CallbacksRunning == 0);
+        pBinding->Next = NULL;
+        pBinding->Function = Function;
+        pBinding->ReleaseFunction = ReleaseFunction;
+        pBinding->Context = Context;
+        pBinding->Fd = fd;
+    }
+
+    if (!InitCompletionPortThreadpool)
+        InitCompletionPortThreadpool = TRUE;
+
+    GrowIoReadinessThreadsIfNeeded();
+
+    if (!PAL_AssociateIoCompletionPort(GlobalIoReadinessPort, fd, events, (ULONG_PTR)pBinding))
+    {
+        errorCode = GetLastError();
+
+        // The binding is handed back to the free list without releasing the context, which stays with the
+        // caller. Stale entries may have reached it meanwhile, but their callbacks have returned once Fd is
+        // reset under the lock with none of them running.
+        for (;;)
+        {
+            {
+                CrstHolder csh(&IoReadinessBindingsLock);
+                if (pBinding->CallbacksRunning == 0)
+                {
+                    pBinding->Fd = -1;
+                    pBinding->Function = NULL;
+                    pBinding->ReleaseFunction = NULL;
+                    pBinding->Context = NULL;
+                    pBinding->Next = FreeIoReadinessBindings;
+                    FreeIoReadinessBindings = pBinding;
+                    break;
+                }
+            }
+            __SwitchToThread(0, CALLER_LIMITS_SPINNING);
+        }
+
+        return NULL;
+    }
+
+    return pBinding;
+}
+
+BOOL ThreadpoolMgr::UnbindIoReadinessCallback(IoReadinessBinding* pBinding, DWORD& errorCode)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    _ASSERTE(pBinding != NULL && pBinding->Fd >= 0);
+    _ASSERTE(GlobalIoReadinessPort != NULL);
+
+    errorCode = S_OK;
+
+    // Even when the descriptor could not be dissociated (it may have been closed already), the binding is
+    // released, so that no callback runs for it after the last one running now has returned.
+    BOOL fDissociated = PAL_DissociateIoCompletionPort(GlobalIoReadinessPort, pBinding->Fd);
+    if (!fDissociated)
+    {
+        errorCode = GetLastError();
+    }
+
+    BOOL fRelease;
+    {
+        CrstHolder csh(&IoReadinessBindingsLock);
+        pBinding->Fd = -1;
+        fRelease = (pBinding->CallbacksRunning == 0);
+    }
+
+    if (fRelease)
+    {
+        ReleaseIoReadinessBinding(pBinding);
+    }
+
+    return fDissociated;
+}
+
+// Called once a binding is unbound and none of its callbacks is running, which can no longer change
+void ThreadpoolMgr::ReleaseIoReadinessBinding(IoReadinessBinding* pBinding)
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    _ASSERTE(pBinding->Fd == -1 && pBinding->CallbacksRunning == 0);
+
+    if (pBinding->ReleaseFunction != NULL)
+    {
+        pBinding->ReleaseFunction(pBinding->Context);
+    }
+
+    CrstHolder csh(&IoReadinessBindingsLock);
+    pBinding->Function = NULL;
+    pBinding->ReleaseFunction = NULL;
+    pBinding->Context = NULL;
+    pBinding->Next = FreeIoReadinessBindings;
+    FreeIoReadinessBindings = pBinding;
+}
+
+BOOL ThreadpoolMgr::CreateIoReadinessThread()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    Thread *pThread;
+    BOOL fIsCLRThread;
+    if ((pThread = CreateUnimpersonatedThread(IoReadinessThreadStart, NULL, &fIsCLRThread)) != NULL)
+    {
+        LastCPThreadCreation = GetTickCount();          // record this for use by logic to spawn additional threads
+
+        if (fIsCLRThread) {
+            pThread->ChooseThreadCPUGroupAffinity();
+            pThread->StartThread();
+        }
+        else {
+            DWORD status;
+            status = ResumeThread((HANDLE)pThread);
+            _ASSERTE(status != (DWORD) (-1));
+            CloseHandle((HANDLE)pThread);          // we don't need this anymore
+        }
+
+        ThreadCounter::Counts counts = CPThreadCounter.GetCleanCounts();
+        FireEtwIOThreadCreate_V1(counts.NumActive + counts.NumRetired, counts.NumRetired, GetClrInstanceId());
+
+        return TRUE;
+    }
+
+    return FALSE;
+}
+
+// Services GlobalIoReadinessPort. Each wait dequeues a batch of readiness events, whose callbacks are then run
+// back to back. The thread exits after waiting for CP_THREAD_WAIT without getting any event, or when the gate
+// thread has lowered the I/O thread limit below the number of active threads.
+DWORD WINAPI ThreadpoolMgr::IoReadinessThreadStart(LPVOID lpArgs)
+{
+    ClrFlsSetThreadType (ThreadType_Threadpool_IOCompletion);
+
+    CONTRACTL
+    {
+        THROWS;
+        if (GetThread()) { MODE_PREEMPTIVE;} else { DISABLED(MODE_ANY);}
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        SO_INTOLERANT;
+    }
+    CONTRACTL_END;
+
+    const DWORD CP_THREAD_WAIT = 15000; /* milliseconds */
+
+    _ASSERTE(GlobalIoReadinessPort != NULL);
+
+    PAL_IO_COMPLETION_ENTRY entries[IO_READINESS_MAX_BATCH_SIZE];
+    ULONG batchSize = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_IoReadinessBatchSize);
+    batchSize = max((ULONG)1, min(batchSize, (ULONG)IO_READINESS_MAX_BATCH_SIZE));
+
+    BOOL fThreadInit = FALSE;
+    Thread *pThread = NULL;
+
+    ThreadCounter::Counts oldCounts;
+    ThreadCounter::Counts newCounts;
+
+    for (;;)
+    {
+        if (!fThreadInit) {
+            if (g_fEEStarted) {
+                pThread = SetupThreadNoThrow();
+                if (pThread == NULL) {
+                    break;
+                }
+
+                // converted to CLRThread and added to ThreadStore, pick an group affinity for this thread
+                pThread->ChooseThreadCPUGroupAffinity();
+
+                fThreadInit = TRUE;
+            }
+        }
+
+        GCX_PREEMP_NO_DTOR();
+
+        //
+        // We're about to wait on the port; mark ourselves as no longer "working."
+        //
+        DWORD cpThreadWait;
+        while (true)
+        {
+            oldCounts = CPThreadCounter.DangerousGetDirtyCounts();
+            newCounts = oldCounts;
+            newCounts.NumWorking--;
+
+            // The last thread never exits, so it has no use for a timeout
+            cpThreadWait = (newCounts.NumActive == 1) ? INFINITE : CP_THREAD_WAIT;
+
+            if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+                break;
+        }
+
+        ULONG numEntries = 0;
+        DWORD errorCode = S_OK;
+        if (!PAL_GetIoCompletionPortEntries(GlobalIoReadinessPort, entries, batchSize, &numEntries, cpThreadWait))
+        {
+            errorCode = GetLastError();
+            numEntries = 0;
+        }
+
+        bool exitThread = false;
+        while (true)
+        {
+            // counts volatile read paired with CompareExchangeCounts loop set
+            oldCounts = CPThreadCounter.DangerousGetDirtyCounts();
+            newCounts = oldCounts;
+            exitThread = false;
+
+            if (errorCode != S_OK)
+            {
+                //
+                // We timed out (or the port failed) and are going to exit, unless we're the last free thread,
+                // which has to stay to notice incoming events.
+                //
+                newCounts.NumActive--;
+                if (newCounts.NumWorking == newCounts.NumActive)
+                {
+                    newCounts = oldCounts;
+                    newCounts.NumWorking++; //not really working, but we'll decremented it at the top
+                }
+                else
+                {
+                    exitThread = true;
+                }
+            }
+            else
+            {
+                //
+                // We have work to do
+                //
+                newCounts.NumWorking++;
+            }
+
+            if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+                break;
+        }
+
+        if (exitThread)
+        {
+            break;
+        }
+
+        if (numEntries == 0)
+        {
+            continue;
+        }
+
+        // Let another thread wait on the port while this one runs the callbacks
+        GrowIoReadinessThreadsIfNeeded();
+
+        {
+            CONTRACT_VIOLATION(ThrowsViolation);
+
+            ThreadLocaleHolder localeHolder;
+
+            // Entries for bindings that were unbound since they were dequeued are dropped; the others keep
+            // their binding from being released until their callback has returned.
+            {
+                CrstHolder csh(&IoReadinessBindingsLock);
+                for (ULONG i = 0; i < numEntries; i++)
+                {
+                    IoReadinessBinding *pBinding = (IoReadinessBinding *)entries[i].CompletionKey;
+                    _ASSERTE(pBinding != NULL);
+
+                    if (pBinding->Fd == -1)
+                        entries[i].CompletionKey = 0;
+                    else
+                        pBinding->CallbacksRunning++;
+                }
+            }
+
+            for (ULONG i = 0; i < numEntries; i++)
+            {
+                IoReadinessBinding *pBinding = (IoReadinessBinding *)entries[i].CompletionKey;
+                if (pBinding != NULL)
+                {
+                    pBinding->Function(entries[i].Events, pBinding->Context);
+                }
+            }
+
+            IoReadinessBinding *pBindingsToRelease = NULL;
+            {
+                CrstHolder csh(&IoReadinessBindingsLock);
+                for (ULONG i = 0; i < numEntries; i++)
+                {
+                    IoReadinessBinding *pBinding = (IoReadinessBinding *)entries[i].CompletionKey;
+                    if (pBinding != NULL && --pBinding->CallbacksRunning == 0 && pBinding->Fd == -1)
+                    {
+                        // Unbound while its callback ran, it is this thread's to release
+                        pBinding->Next = pBindingsToRelease;
+                        pBindingsToRelease = pBinding;
+                    }
+                }
+            }
+
+            while (pBindingsToRelease != NULL)
+            {
+                IoReadinessBinding *pBinding = pBindingsToRelease;
+                pBindingsToRelease = pBinding->Next;
+                ReleaseIoReadinessBinding(pBinding);
+            }
+        }
+
+        FastInterlockExchangeAdd(&IoReadinessCompletions, (LONG)numEntries);
+
+        if (pThread == NULL) {
+            pThread = GetThread();
+        }
+        if (pThread) {
+            if (pThread->IsAbortRequested())
+                pThread->EEResetAbort(Thread::TAR_ALL);
+            pThread->InternalReset(FALSE);
+        }
+
+        //
+        // Exit if the gate thread has lowered the limit on I/O threads below the number of active ones.
+        //
+        while (true)
+        {
+            oldCounts = CPThreadCounter.DangerousGetDirtyCounts();
+            if (oldCounts.NumActive <= max(oldCounts.MaxWorking, 1))
+            {
+                exitThread = false;
+                break;
+            }
+
+            newCounts = oldCounts;
+            newCounts.NumActive--;
+            newCounts.NumWorking--;
+            exitThread = true;
+            if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+                break;
+        }
+
+        if (exitThread)
+        {
+            break;
+        }
+    }   // for (;;)
+
+    oldCounts = CPThreadCounter.GetCleanCounts();
+
+    // we should never destroy all I/O threads, because then we won't have any threads to notice incoming events.
+    _ASSERTE(oldCounts.NumActive > 0);
+
+    FireEtwIOThreadTerminate_V1(oldCounts.NumActive + oldCounts.NumRetired, oldCounts.NumRetired, GetClrInstanceId());
+
+    if (pThread) {
+        pThread->ClearThreadCPUGroupAffinity();
+
+        DestroyThread(pThread);
+    }
+
+    return 0;
+}
+
+// Creates an I/O thread when none is waiting on the port and the current limit allows it. When every thread
+// is busy at the limit, it is up to the gate thread to raise the limit.
+void ThreadpoolMgr::GrowIoReadinessThreadsIfNeeded()
+{
+    CONTRACTL
+    {
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        NOTHROW;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    ThreadCounter::Counts oldCounts, newCounts;
+    while (true)
+    {
+        oldCounts = CPThreadCounter.GetCleanCounts();
+
+        if (oldCounts.NumActive > oldCounts.NumWorking)
+        {
+            // A thread is already waiting on the port
+            return;
+        }
+
+        if (oldCounts.NumActive >= oldCounts.MaxWorking || oldCounts.NumActive >= MaxLimitTotalCPThreads)
+        {
+            EnsureGateThreadRunning();
+            return;
+        }
+
+        // create a new thread.  New I/O threads start as "active" and "working"
+        newCounts = oldCounts;
+        newCounts.NumActive++;
+        newCounts.NumWorking++;
+        if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+            break;
+    }
+
+    if (!CreateIoReadinessThread())
+    {
+        // if thread creation failed, we have to adjust the counts back down.
+        while (true)
+        {
+            // counts volatile read paired with CompareExchangeCounts loop set
+            oldCounts = CPThreadCounter.DangerousGetDirtyCounts();
+            newCounts = oldCounts;
+            newCounts.NumActive--;
+            newCounts.NumWorking--;
+            if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+                break;
+        }
+    }
+}
+
+// Called by the gate thread every GATE_THREAD_DELAY. While all the I/O threads are busy, the limit on their
+// number is moved one thread at a time in the direction that raised the number of readiness callbacks run per
+// second over the last sample. A move that did not help is undone, and the limit is then held for a few
+// samples before probing upwards again. Threads are not added beyond the limit when the CPU is saturated.
+void ThreadpoolMgr::AdjustIoReadinessThreads()
+{
+    CONTRACTL
+    {
+        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
+        NOTHROW;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    const int IoReadinessHoldSampleCount = 4;
+
+    DWORD currentTime = GetTickCount();
+    LONG completions = VolatileLoad(&IoReadinessCompletions);
+    DWORD elapsed = currentTime - PriorIoReadinessSampleTime;
+
+    if (elapsed == 0)
+    {
+        return;
+    }
+
+    double throughput = (double)(completions - PriorIoReadinessCompletions) * 1000.0 / elapsed;
+    double priorThroughput = PriorIoReadinessThroughput;
+
+    PriorIoReadinessCompletions = completions;
+    PriorIoReadinessSampleTime = currentTime;
+    PriorIoReadinessThroughput = throughput;
+
+    ThreadCounter::Counts counts = CPThreadCounter.GetCleanCounts();
+
+    if (counts.NumActive > counts.NumWorking)
+    {
+        // Some threads are waiting on the port; more threads would not dequeue more events.
+        IoReadinessLastMove = 0;
+        return;
+    }
+
+    double noise = CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_IoThroughputNoisePercent) / 100.0;
+    int move = 0;
+
+    if (IoReadinessLastMove != 0)
+    {
+        if (throughput > priorThroughput * (1.0 + noise))
+        {
+            // The last move helped; keep going the same way
+            move = IoReadinessLastMove;
+        }
+        else if (IoReadinessLastMove > 0)
+        {
+            // The extra thread did not help; take it back and settle
+            move = -1;
+            IoReadinessHoldSamples = IoReadinessHoldSampleCount;
+        }
+    }
+    else if (IoReadinessHoldSamples > 0)
+    {
+        IoReadinessHoldSamples--;
+    }
+    else if (throughput == 0 && counts.NumActive > 0)
+    {
+        // Every thread is blocked in a callback; add one regardless of the CPU, as the worker pool does on starvation
+        move = 1;
+    }
+    else if (cpuUtilization < CpuUtilizationHigh)
+    {
+        move = 1;
+    }
 
-void ThreadpoolMgr::GrowCompletionPortThreadpoolIfNeeded()
-{
-    CONTRACTL
+    if (move > 0 && !SufficientDelaySinceLastSample(LastCPThreadCreation, counts.NumActive))
     {
-        if (GetThread()) { GC_TRIGGERS;} else {DISABLED(GC_NOTRIGGER);}
-        NOTHROW;
-        MODE_ANY;
+        return;
     }
-    CONTRACTL_END;    
 
-    ThreadCounter::Counts oldCounts, newCounts;
     while (true)
     {
-        oldCounts = CPThreadCounter.GetCleanCounts();
-        newCounts = oldCounts;
-        
-        if(!ShouldGrowCompletionPortThreadpool(oldCounts))
+        ThreadCounter::Counts oldCounts = CPThreadCounter.GetCleanCounts();
+        ThreadCounter::Counts newCounts = oldCounts;
+
+        int newMax = oldCounts.MaxWorking + move;
+        newMax = max(newMax, (int)MinLimitTotalCPThreads);
+        newMax = min(newMax, (int)MaxLimitTotalCPThreads);
+        newMax = max(newMax, 1);
+
+        if (newMax == oldCounts.MaxWorking)
         {
+            move = 0;
             break;
         }
-        else
-        {
-            if (oldCounts.NumRetired > 0)
-            {        
-                // wakeup retired thread instead
-                RetiredCPWakeupEvent->Set();
-                return;
-            }
-            else 
-            {
-                // create a new thread.  New IOCP threads start as "active" and "working"
-                newCounts.NumActive++;
-                newCounts.NumWorking++;
-                if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
-                {
-                    if (!CreateCompletionPortThread(NULL))
-                    {
-                        // if thread creation failed, we have to adjust the counts back down.
-                        while (true)
-                        {
-                            // counts volatile read paired with CompareExchangeCounts loop set
-                            oldCounts = CPThreadCounter.DangerousGetDirtyCounts();
-                            newCounts = oldCounts;
-                            newCounts.NumActive--;
-                            newCounts.NumWorking--;
-                            if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
-                                break;
-                        }
-                    }
-                    return;
-                }
-            }    
-        } 
+
+        newCounts.MaxWorking = newMax;
+        if (oldCounts == CPThreadCounter.CompareExchangeCounts(newCounts, oldCounts))
+            break;
+    }
+
+    IoReadinessLastMove = move;
+
+    if (move > 0)
+    {
+        GrowIoReadinessThreadsIfNeeded();
     }
 }
+
+
 #endif // !FEATURE_PAL
 
 // Returns true if there is pending io on the thread.
@@ -4347,8 +5770,25 @@ DWORD WINAPI ThreadpoolMgr::GateThreadStart(LPVOID lpArgs)
                 }
             }
         }
+#else // !FEATURE_PAL
+        // don't mess with I/O thread settings if no file descriptor was bound yet
+        if (InitCompletionPortThreadpool)
+        {
+            AdjustIoReadinessThreads();
+        }
 #endif // !FEATURE_PAL
 
+        ThreadpoolTelemetry::PublishIfDue();
+        LockContentionProfiler::PublishIfDue();
+
+        if (EnableBlockingCompensation &&
+            VolatileLoad(&NumBlockingCompensation) != VolatileLoad(&NumBlockedWorkers))
+        {
+            // catch up with blocking notifications that found ThreadAdjustmentLock taken
+            DangerousNonHostedSpinLockHolder tal(&ThreadAdjustmentLock);
+            AdjustBlockingCompensation(TRUE);
+        }
+
         if (0 == CLRConfig::GetConfigValue(CLRConfig::INTERNAL_ThreadPool_DisableStarvationDetection))
         {
             if (PerAppDomainTPCountList::AreRequestsPendingInAnyAppDomains() && SufficientDelaySinceLastDequeue())
@@ -4491,6 +5931,14 @@ BOOL ThreadpoolMgr::CreateTimerQueueTimer(PHANDLE phNewTimer,
         // check again
         if (NULL == TimerThread)
         {
+            if (NULL == TimerThreadWakeEvent)
+            {
+                // The timer thread waits on this with the OS wait functions, so that APCs still get delivered
+                NewHolder<CLREvent> wakeEvent(new CLREvent());
+                wakeEvent->CreateOSAutoEvent(FALSE);
+                TimerThreadWakeEvent = wakeEvent.Extract();
+            }
+
             CreateTimerThreadParams params;
             params.event.CreateAutoEvent(FALSE);
             params.setupSucceeded = FALSE;
@@ -4537,23 +5985,101 @@ BOOL ThreadpoolMgr::CreateTimerQueueTimer(PHANDLE phNewTimer,
     timerInfoHolder.Assign(timerInfo);
 
     timerInfo->FiringTime = DueTime;
+    timerInfo->StartTime = GetTickCount();
     timerInfo->Function = Callback;
     timerInfo->Context = Parameter;
     timerInfo->Period = Period;
     timerInfo->state = 0;
+    timerInfo->refCount = 1;    // DeleteTimerQueueTimer can overtake the registration of the timer
     timerInfo->flag = Flag;
     timerInfo->ExternalCompletionEvent = INVALID_HANDLE;
     timerInfo->ExternalEventSafeHandle = NULL;
     timerInfo->handleOwningAD = (ADID) 0;
 
-    BOOL status = QueueUserAPC((PAPCFUNC)InsertNewTimer,TimerThread,(size_t)timerInfo);
-    if (FALSE == status)
+    timerInfoHolder.SuppressRelease();
+
+    // The timer may be handed to the timer thread (and fire) as soon as it is queued, so
+    // compute when it is due first
+    QueueNewTimer(timerInfo, timerInfo->StartTime + DueTime);
+    return TRUE;
+}
+
+// Hands a new timer to the timer thread through the pending list of the current processor.
+// Pushing onto the list takes no lock, and the timer thread is only woken up when the new
+// timer is due before the timer thread would wake up on its own.
+void ThreadpoolMgr::QueueNewTimer(TimerInfo* timerInfo, DWORD dueTick)
+{
+    CONTRACTL
     {
-        return FALSE;
+        NOTHROW;
+        GC_NOTRIGGER;
+        MODE_ANY;
     }
+    CONTRACTL_END;
 
-    timerInfoHolder.SuppressRelease();
-    return TRUE;
+    DWORD index;
+    if (CPUGroupInfo::CanEnableGCCPUGroups() && CPUGroupInfo::CanEnableThreadUseAllCpuGroups())
+        index = CPUGroupInfo::CalculateCurrentProcessorNumber();
+    else
+        index = GetCurrentProcessorNumber();
+
+    PendingTimerList* pList = &PendingTimerLists[index % NumPendingTimerLists];
+    BOOL isInfinite = (timerInfo->FiringTime == (ULONG) -1);
+
+    TimerInfo* head;
+    do
+    {
+        head = VolatileLoad(&pList->Head);
+        timerInfo->link.Flink = (LIST_ENTRY*) head;
+    }
+    while (InterlockedCompareExchangeT(&pList->Head, timerInfo, head) != head);
+
+    // The interlocked operation above is a full barrier. The timer thread publishes its wake
+    // up time before looking at the pending lists one last time, so either it sees this timer
+    // or this thread sees the wake up time it is going to sleep until.
+    if (!isInfinite && (LONG)(dueTick - VolatileLoad(&TimerThreadWakeTime)) < 0)
+    {
+        TimerThreadWakeEvent->Set();
+    }
+}
+
+// Executed by the timer thread. Moves the timers created since the last call into the wheel.
+void ThreadpoolMgr::InsertPendingTimers()
+{
+    CONTRACTL
+    {
+        NOTHROW;
+        GC_TRIGGERS;
+        MODE_ANY;
+    }
+    CONTRACTL_END;
+
+    for (DWORD i = 0; i < NumPendingTimerLists; i++)
+    {
+        if (VolatileLoad(&PendingTimerLists[i].Head) == NULL)
+            continue;
+
+        TimerInfo* timerInfo = InterlockedExchangeT(&PendingTimerLists[i].Head, NULL);
+        while (timerInfo != NULL)
+        {
+            TimerInfo* next = (TimerInfo*) timerInfo->link.Flink;
+            InsertNewTimer(timerInfo);
+            timerInfo = next;
+        }
+    }
+}
+
+BOOL ThreadpoolMgr::HavePendingTimers()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    for (DWORD i = 0; i < NumPendingTimerLists; i++)
+    {
+        if (VolatileLoad(&PendingTimerLists[i].Head) != NULL)
+            return TRUE;
+    }
+
+    return FALSE;
 }
 
 #ifdef _MSC_VER
@@ -4593,7 +6119,7 @@ DWORD WINAPI ThreadpoolMgr::TimerThreadStart(LPVOID p)
     pTimerThread = pThread;
     // Timer threads never die
 
-    LastTickCount = GetTickCount();
+    TimerWheelTime = GetTickCount();
 
 #ifdef FEATURE_COMINTEROP
     if (pThread->SetApartment(Thread::AS_InMTA, TRUE) != Thread::AS_InMTA)
@@ -4640,13 +6166,22 @@ void ThreadpoolMgr::TimerThreadFire()
     EX_TRY {
         DWORD timeout = FireTimers();
 
-#undef SleepEx
-        SleepEx(timeout, TRUE);
-#define SleepEx(a,b) Dont_Use_SleepEx(a,b)
+        // Threads creating timers only wake this thread up when their timer is due before this
+        // thread wakes up on its own, so publish when that is, then check for timers that were
+        // created while the wheel was turning
+        VolatileStore(&TimerThreadWakeTime, GetTickCount() + timeout);
+        MemoryBarrier();
 
-        // the thread could wake up either because an APC completed or the sleep timeout
-        // in both case, we need to sweep the timer queue, firing timers, and readjusting
-        // the next firing time
+        if (HavePendingTimers())
+            timeout = 0;
+
+        // We use the OS wait instead of CLREvent::Wait for the same reason the wait threads use
+        // SleepEx: the deregistration and update logic depends on APCs being delivered.
+        WaitForSingleObjectEx(TimerThreadWakeEvent->GetHandleUNHOSTED(), timeout, TRUE);
+
+        // the thread could wake up because an APC completed, a new timer is due early, or the
+        // timeout elapsed. In all cases, we need to turn the timer wheel, firing timers, and
+        // work out the next time the wheel has to be turned
 
     }
     EX_CATCH {
@@ -4672,7 +6207,7 @@ void ThreadpoolMgr::TimerThreadFire()
 #endif
 #endif
 
-// Executed as an APC in timer thread
+// Executed by the timer thread for each timer taken off a pending list
 void ThreadpoolMgr::InsertNewTimer(TimerInfo* pArg)
 {
     CONTRACTL
@@ -4693,23 +6228,13 @@ void ThreadpoolMgr::InsertNewTimer(TimerInfo* pArg)
         return;
     }
 
-    // set the firing time = current time + due time (note initially firing time = due time)
-    DWORD currentTime = GetTickCount();
-    if (timerInfo->FiringTime == (ULONG) -1)
-    {
-        timerInfo->state = TIMER_REGISTERED;
-        timerInfo->refCount = 1;
+    timerInfo->state = TIMER_REGISTERED;
+    timerInfo->refCount = 1;
 
-    }
-    else
+    // initially firing time = due time, counted from the time the timer was created
+    if (timerInfo->FiringTime != (ULONG) -1)
     {
-        timerInfo->FiringTime += currentTime;
-
-        timerInfo->state = (TIMER_REGISTERED | TIMER_ACTIVE);
-        timerInfo->refCount = 1;
-
-        // insert the timer in the queue
-        InsertTailList(&TimerQueue,(&timerInfo->link));
+        ActivateTimer(timerInfo, timerInfo->StartTime, timerInfo->FiringTime);
     }
 
     return;
@@ -4717,8 +6242,9 @@ void ThreadpoolMgr::InsertNewTimer(TimerInfo* pArg)
 
 
 // executed by the Timer thread
-// sweeps through the list of timers, readjusting the firing times, queueing APCs for
-// those that have expired, and returns the next firing time interval
+// turns the timer wheel up to the current tick, queueing callbacks for the timers that have
+// expired, and returns the interval until the wheel next has timers to fire or cascade.
+// All timers that expire on the same tick are fired from a single sweep of their bucket.
 DWORD ThreadpoolMgr::FireTimers()
 {
     CONTRACTL
@@ -4729,25 +6255,57 @@ DWORD ThreadpoolMgr::FireTimers()
     }
     CONTRACTL_END;
 
+    InsertPendingTimers();
+
+    // read the clock after the pending timers were inserted, since inserting into an empty
+    // wheel moves the wheel to the current tick
     DWORD currentTime = GetTickCount();
-    DWORD nextFiringInterval = (DWORD) -1;
     TimerInfo* timerInfo = NULL;
-    
+    LIST_ENTRY* bucket = NULL;
+
     EX_TRY 
     {
-        for (LIST_ENTRY* node = (LIST_ENTRY*) TimerQueue.Flink;
-             node != &TimerQueue;
-            )
+        for (;;)
         {
-            timerInfo = (TimerInfo*) node;
-            node = (LIST_ENTRY*) node->Flink;
+            LONG ticksBehind = (LONG) (currentTime + 1 - TimerWheelTime);
+            if (ticksBehind <= 0)
+                break;
+
+            DWORD index = TimerWheelTime & TIMER_WHEEL_ROOT_MASK;
+            bucket = &TimerWheelRoot[index];
+
+            if (index != 0 && IsListEmpty(bucket))
+            {
+                // nothing to do on this tick, skip ahead to the next tick that has work
+                DWORD ticksToWork = GetTicksToNextTimerWheelWork();
+                if (ticksToWork >= (DWORD) ticksBehind)
+                {
+                    TimerWheelTime = currentTime + 1;
+                    break;
+                }
+
+                TimerWheelTime += ticksToWork;
+                continue;
+            }
+
+            if (index == 0)
+            {
+                CascadeTimerWheel();
+            }
 
-            if (TimeExpired(LastTickCount, currentTime, timerInfo->FiringTime))
+            while (!IsListEmpty(bucket))
             {
+                timerInfo = (TimerInfo*) bucket->Flink;
+                _ASSERTE(timerInfo->FiringTime == TimerWheelTime);
+
                 if (timerInfo->Period == 0 || timerInfo->Period == (ULONG) -1)
                 {
                     DeactivateTimer(timerInfo);
                 }
+                else
+                {
+                    RemoveEntryList(&timerInfo->link);
+                }
 
                 InterlockedIncrement(&timerInfo->refCount);
 
@@ -4757,31 +6315,24 @@ DWORD ThreadpoolMgr::FireTimers()
 
                 if (timerInfo->Period != 0 && timerInfo->Period != (ULONG)-1)
                 {
-                    ULONG nextFiringTime = timerInfo->FiringTime + timerInfo->Period;
-                    DWORD firingInterval;
-                    if (TimeExpired(timerInfo->FiringTime, currentTime, nextFiringTime))
+                    if (timerInfo->Period <= currentTime - TimerWheelTime)
                     {
                         // Enough time has elapsed to fire the timer yet again. The timer is not able to keep up with the short
                         // period, have it fire 1 ms from now to avoid spinning without a delay.
                         timerInfo->FiringTime = currentTime + 1;
-                        firingInterval = 1;
                     }
                     else
                     {
-                        timerInfo->FiringTime = nextFiringTime;
-                        firingInterval = TimeInterval(nextFiringTime, currentTime);
+                        timerInfo->FiringTime += timerInfo->Period;
                     }
 
-                    if (firingInterval < nextFiringInterval)
-                        nextFiringInterval = firingInterval;
+                    InsertTimerIntoWheel(timerInfo);
                 }
+
+                timerInfo = NULL;
             }
-            else
-            {
-                DWORD firingInterval = TimeInterval(timerInfo->FiringTime, currentTime);
-                if (firingInterval < nextFiringInterval)
-                    nextFiringInterval = firingInterval;
-            }
+
+            TimerWheelTime++;
         }
     } 
     EX_CATCH 
@@ -4789,10 +6340,18 @@ DWORD ThreadpoolMgr::FireTimers()
         // If QueueUserWorkItem throws OOM, swallow the exception and retry on
         // the next call to FireTimers(), otherwise retrhow.
         Exception *ex = GET_EXCEPTION();
-        // undo the call to DeactivateTimer()
-        InterlockedDecrement(&timerInfo->refCount);
-        timerInfo->state = timerInfo->state & TIMER_ACTIVE;
-        InsertTailList(&TimerQueue, (&timerInfo->link));
+        if (timerInfo != NULL)
+        {
+            // undo the call to DeactivateTimer() and put the timer back on the tick it was
+            // taken from, which the wheel has not moved past yet
+            InterlockedDecrement(&timerInfo->refCount);
+            if (!(timerInfo->state & TIMER_ACTIVE))
+            {
+                timerInfo->state |= TIMER_ACTIVE;
+                NumTimersInWheel++;
+            }
+            InsertTailList(bucket, (&timerInfo->link));
+        }
         if (ex->GetHR() != E_OUTOFMEMORY)
         {
            EX_RETHROW;
@@ -4800,7 +6359,18 @@ DWORD ThreadpoolMgr::FireTimers()
     }
     EX_END_CATCH(RethrowTerminalExceptions);
 
-    LastTickCount = currentTime;
+    DWORD nextFiringInterval;
+    if (TimerWheelTime != currentTime + 1)
+    {
+        // the wheel was stopped short of the current tick by an OOM, retry soon
+        nextFiringInterval = 1;
+    }
+    else
+    {
+        // the wheel sits on the tick after the current one. Even an empty wheel gets looked at
+        // now and then, which keeps the tick arithmetic on TimerWheelTime unambiguous.
+        nextFiringInterval = min(GetTicksToNextTimerWheelWork(), (DWORD) TIMER_THREAD_MAX_SLEEP) + 1;
+    }
 
     return nextFiringInterval;
 }
@@ -4847,18 +6417,154 @@ DWORD WINAPI ThreadpoolMgr::AsyncTimerCallbackCompletion(PVOID pArgs)
 }
 
 
-// removes the timer from the timer queue, thereby cancelling it
+// schedules the timer to fire dueTime ticks after startTime and puts it on the timer wheel
+void ThreadpoolMgr::ActivateTimer(TimerInfo* timerInfo, DWORD startTime, DWORD dueTime)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    _ASSERTE((timerInfo->state & TIMER_ACTIVE) == 0);
+    _ASSERTE(dueTime != (DWORD) -1);
+
+    if (NumTimersInWheel == 0)
+    {
+        // nothing is waiting on the wheel, so it can jump straight to the current tick
+        TimerWheelTime = GetTickCount();
+    }
+
+    // The wheel lags behind the clock while the timer thread sleeps, and the timer may have
+    // waited in a pending list for a while, so count from where the wheel is. A timer that is
+    // already due goes on the next tick the wheel processes.
+    LONGLONG ticks = (LONGLONG) (LONG) (startTime - TimerWheelTime) + dueTime;
+    if (ticks < 0)
+        ticks = 0;
+    else if (ticks > (LONGLONG) 0xffffffff)
+        ticks = 0xffffffff;
+
+    timerInfo->FiringTime = TimerWheelTime + (DWORD) ticks;
+    timerInfo->state |= TIMER_ACTIVE;
+    NumTimersInWheel++;
+
+    InsertTimerIntoWheel(timerInfo);
+}
+
+// removes the timer from the timer wheel, thereby cancelling it
 // there may still be pending callbacks that haven't completed
 void ThreadpoolMgr::DeactivateTimer(TimerInfo* timerInfo)
 {
     LIMITED_METHOD_CONTRACT;
 
+    _ASSERTE(NumTimersInWheel > 0);
+
     RemoveEntryList((LIST_ENTRY*) timerInfo);
 
     // This timer info could go into another linked list of timer infos
     // waiting to be released. Reinitialize the list pointers
     InitializeListHead(&timerInfo->link);
     timerInfo->state = timerInfo->state & ~TIMER_ACTIVE;
+    NumTimersInWheel--;
+}
+
+// puts an active timer in the bucket for its firing time. Timers due within the span of the
+// root level go in the bucket for their tick; later ones go in the lowest level whose span
+// covers them, and move down a level each time the level below wraps around.
+void ThreadpoolMgr::InsertTimerIntoWheel(TimerInfo* timerInfo)
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DWORD firingTime = timerInfo->FiringTime;
+    DWORD ticks = firingTime - TimerWheelTime;
+    LIST_ENTRY* bucket;
+
+    if (ticks < TIMER_WHEEL_ROOT_SIZE)
+    {
+        bucket = &TimerWheelRoot[firingTime & TIMER_WHEEL_ROOT_MASK];
+    }
+    else
+    {
+        DWORD level = 0;
+        DWORD shift = TIMER_WHEEL_ROOT_BITS;
+        while (level < TIMER_WHEEL_LEVELS - 1 && (ticks >> (shift + TIMER_WHEEL_LEVEL_BITS)) != 0)
+        {
+            level++;
+            shift += TIMER_WHEEL_LEVEL_BITS;
+        }
+
+        bucket = &TimerWheelLevels[level][(firingTime >> shift) & TIMER_WHEEL_LEVEL_MASK];
+    }
+
+    InsertTailList(bucket, (&timerInfo->link));
+}
+
+// called when the root level wraps around. Moves the timers in the bucket of each level that
+// has come due down to the levels below, stopping at the first level that does not wrap.
+void ThreadpoolMgr::CascadeTimerWheel()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    DWORD shift = TIMER_WHEEL_ROOT_BITS;
+    for (DWORD level = 0; level < TIMER_WHEEL_LEVELS; level++)
+    {
+        DWORD index = (TimerWheelTime >> shift) & TIMER_WHEEL_LEVEL_MASK;
+        LIST_ENTRY* bucket = &TimerWheelLevels[level][index];
+
+        while (!IsListEmpty(bucket))
+        {
+            LIST_ENTRY* node;
+            RemoveHeadList(bucket, node);
+            InsertTimerIntoWheel((TimerInfo*) node);
+        }
+
+        if (index != 0)
+            break;
+
+        shift += TIMER_WHEEL_LEVEL_BITS;
+    }
+}
+
+// returns the number of ticks from TimerWheelTime to the first tick that has timers to fire
+// or cascade, or -1 if the wheel is empty
+DWORD ThreadpoolMgr::GetTicksToNextTimerWheelWork()
+{
+    LIMITED_METHOD_CONTRACT;
+
+    if (NumTimersInWheel == 0)
+        return (DWORD) -1;
+
+    DWORD ticksToWork = (DWORD) -1;
+
+    DWORD rootIndex = TimerWheelTime & TIMER_WHEEL_ROOT_MASK;
+    for (DWORD i = 0; i < TIMER_WHEEL_ROOT_SIZE; i++)
+    {
+        if (!IsListEmpty(&TimerWheelRoot[(rootIndex + i) & TIMER_WHEEL_ROOT_MASK]))
+        {
+            ticksToWork = i;
+            break;
+        }
+    }
+
+    // the buckets of a level are cascaded in turn, each time the level below wraps around
+    DWORD shift = TIMER_WHEEL_ROOT_BITS;
+    for (DWORD level = 0; level < TIMER_WHEEL_LEVELS; level++, shift += TIMER_WHEEL_LEVEL_BITS)
+    {
+        DWORD span = 1 << shift;
+        DWORD firstCascadeTime = (TimerWheelTime + span - 1) & ~(span - 1);
+        DWORD index = (firstCascadeTime >> shift) & TIMER_WHEEL_LEVEL_MASK;
+
+        for (DWORD i = 0; i < TIMER_WHEEL_LEVEL_SIZE; i++)
+        {
+            DWORD ticks = (firstCascadeTime - TimerWheelTime) + i * span;
+            if (ticks >= ticksToWork)
+                break;
+
+            if (!IsListEmpty(&TimerWheelLevels[level][(index + i) & TIMER_WHEEL_LEVEL_MASK]))
+            {
+                ticksToWork = ticks;
+                break;
+            }
+        }
+    }
+
+    return ticksToWork;
 }
 
 DWORD WINAPI ThreadpoolMgr::AsyncDeleteTimer(PVOID pArgs)
@@ -5121,6 +6827,17 @@ void ThreadpoolMgr::UpdateTimer(TimerUpdateInfo* pArgs)
 
     timerInfo->Period = updateInfo->Period;
 
+    if (! (timerInfo->state & TIMER_REGISTERED))
+    {
+        // The timer was created on another processor and is still in a pending list, which this
+        // APC can overtake. InsertNewTimer picks up the new due time when it registers the timer.
+        timerInfo->FiringTime = updateInfo->DueTime;
+        timerInfo->StartTime = GetTickCount();
+
+        delete updateInfo;
+        return;
+    }
+
     if (updateInfo->DueTime == (ULONG) -1)
     {
         if (timerInfo->state & TIMER_ACTIVE)
@@ -5134,20 +6851,17 @@ void ThreadpoolMgr::UpdateTimer(TimerUpdateInfo* pArgs)
         return;
     }
 
-    DWORD currentTime = GetTickCount();
-    timerInfo->FiringTime = currentTime + updateInfo->DueTime;
-
-    delete updateInfo;
-
-    if (! (timerInfo->state & TIMER_ACTIVE))
+    if (timerInfo->state & TIMER_ACTIVE)
     {
-        // timer not active (probably a one shot timer that has expired), so activate it
-        timerInfo->state |= TIMER_ACTIVE;
-        _ASSERTE(timerInfo->refCount >= 1);
-        // insert the timer in the queue
-        InsertTailList(&TimerQueue,(&timerInfo->link));
-
+        // take the timer out of the bucket for its old firing time
+        DeactivateTimer(timerInfo);
     }
+    // else, the timer was not active (probably a one shot timer that has expired)
+
+    _ASSERTE(timerInfo->refCount >= 1);
+    ActivateTimer(timerInfo, GetTickCount(), updateInfo->DueTime);
+
+    delete updateInfo;
 
     return;
 }
@@ -25,6 +25,7 @@ Revision History:
 #include "util.hpp"
 #include "nativeoverlapped.h"
 #include "hillclimbing.h"
+#include "threadpooltelemetry.h"
 
 #define MAX_WAITHANDLES 64
 
@@ -33,11 +34,31 @@ Revision History:
 #define WAIT_REGISTERED     0x01
 #define WAIT_ACTIVE         0x02
 #define WAIT_DELETE         0x04
+#define WAIT_SIGNAL_PENDING 0x08    // the entry of a canceled port registration that was already satisfied is still queued
+
+#ifdef FEATURE_PAL
+// Entries posted to RegisteredWaitPort, besides the PAL_IO_EVENT_SIGNALED ones of satisfied waits
+#define REGISTERED_WAIT_INSERT      0x00010000
+#define REGISTERED_WAIT_DEREGISTER  0x00020000
+#endif // FEATURE_PAL
 
 #define TIMER_REGISTERED    0x01
 #define TIMER_ACTIVE        0x02
 #define TIMER_DELETE        0x04
 
+// Geometry of the timer wheel. The root level has one bucket per tick for the next 256 ticks;
+// each of the levels above it covers 64 times the span of the level below, so that together
+// they cover the whole 32 bit range of the tick count.
+#define TIMER_WHEEL_ROOT_BITS   8
+#define TIMER_WHEEL_LEVEL_BITS  6
+#define TIMER_WHEEL_LEVELS      4
+#define TIMER_WHEEL_ROOT_SIZE   (1 << TIMER_WHEEL_ROOT_BITS)
+#define TIMER_WHEEL_LEVEL_SIZE  (1 << TIMER_WHEEL_LEVEL_BITS)
+#define TIMER_WHEEL_ROOT_MASK   (TIMER_WHEEL_ROOT_SIZE - 1)
+#define TIMER_WHEEL_LEVEL_MASK  (TIMER_WHEEL_LEVEL_SIZE - 1)
+
+#define TIMER_THREAD_MAX_SLEEP  0x3fffffff  // keeps the timer wheel well within 2^31 ticks of the clock
+
 #define WAIT_SINGLE_EXECUTION      0x00000001
 #define WAIT_FREE_CONTEXT          0x00000002
 #define WAIT_INTERNAL_COMPLETION   0x00000004
@@ -81,6 +102,7 @@ struct WorkRequest {
     WorkRequest*            next;
     LPTHREAD_START_ROUTINE  Function; 
     PVOID                   Context;
+    LONGLONG                EnqueueTime;    // ThreadpoolTelemetry timestamp
 
 };
 
@@ -103,6 +125,7 @@ class ThreadpoolMgr
     friend class ManagedPerAppDomainTPCount;
     friend class PerAppDomainTPCountList;
     friend class HillClimbing;
+    friend class TieredCompilationManager;
     friend struct _DacGlobals;
 
     //
@@ -345,6 +368,126 @@ class ThreadpoolMgr
         }
     };
 
+    //
+    // WorkStealingQueue is the local queue of a worker thread. Work requests queued while the worker runs
+    // a request are pushed and popped by the owner at the bottom, so it runs the most recent (and most likely
+    // cache-hot) one first. Idle workers steal from the top, which holds the oldest. A pop costs the owner one
+    // interlocked exchange, and it only races thieves for the last request.
+    //
+    // Indices only ever grow and are compared through their difference, so they are free to wrap around.
+    //
+    class WorkStealingQueue
+    {
+    public:
+        static const LONG Capacity = 256;   // must be a power of 2
+
+        WorkStealingQueue()
+        {
+            LIMITED_METHOD_CONTRACT;
+            m_top = 0;
+            m_bottom = 0;
+            m_owned = 0;
+            m_numPushed = 0;
+            m_numStolen = 0;
+        }
+
+        // Owner only. Fails when the queue is full.
+        bool TryPush(WorkRequest* workRequest)
+        {
+            LIMITED_METHOD_CONTRACT;
+
+            ULONG bottom = (ULONG)m_bottom;
+            ULONG top = (ULONG)VolatileLoad(&m_top);
+
+            if ((LONG)(bottom - top) >= Capacity)
+                return false;
+
+            m_requests[bottom & (Capacity - 1)] = workRequest;
+
+            // publishes the request to thieves
+            VolatileStore(&m_bottom, (LONG)(bottom + 1));
+            m_numPushed++;
+            return true;
+        }
+
+        // Owner only. Returns the most recently pushed request.
+        WorkRequest* TryPop()
+        {
+            LIMITED_METHOD_CONTRACT;
+
+            ULONG bottom = (ULONG)m_bottom - 1;
+
+            // thieves must see the new bottom before we look at top, or both of us could take the last request
+            FastInterlockExchange(&m_bottom, (LONG)bottom);
+            ULONG top = (ULONG)VolatileLoad(&m_top);
+
+            LONG count = (LONG)(bottom - top);
+            if (count < 0)
+            {
+                // empty
+                VolatileStore(&m_bottom, (LONG)top);
+                return NULL;
+            }
+
+            WorkRequest* workRequest = m_requests[bottom & (Capacity - 1)];
+            if (count > 0)
+                return workRequest;
+
+            // this is the last request, which a thief may be taking at the same time
+            if (FastInterlockCompareExchange(&m_top, (LONG)(top + 1), (LONG)top) != (LONG)top)
+                workRequest = NULL;
+
+            VolatileStore(&m_bottom, (LONG)(top + 1));
+            return workRequest;
+        }
+
+        // Any thread. Returns the oldest request, or NULL if the queue is empty or another thread won the race
+        // for it, in which case *pMissed is set.
+        WorkRequest* TrySteal(bool* pMissed)
+        {
+            LIMITED_METHOD_CONTRACT;
+
+            ULONG top = (ULONG)VolatileLoad(&m_top);
+            MemoryBarrier();
+            ULONG bottom = (ULONG)VolatileLoad(&m_bottom);
+
+            if ((LONG)(bottom - top) <= 0)
+                return NULL;
+
+            WorkRequest* workRequest = VolatileLoad(&m_requests[top & (Capacity - 1)]);
+            if (FastInterlockCompareExchange(&m_top, (LONG)(top + 1), (LONG)top) != (LONG)top)
+            {
+                *pMissed = true;
+                return NULL;
+            }
+
+            FastInterlockIncrement(&m_numStolen);
+            return workRequest;
+        }
+
+        LONG GetCount()
+        {
+            LIMITED_METHOD_CONTRACT;
+            LONG count = (LONG)((ULONG)VolatileLoad(&m_bottom) - (ULONG)VolatileLoad(&m_top));
+            return max(count, (LONG)0);
+        }
+
+        ULONG GetNumPushed() { LIMITED_METHOD_CONTRACT; return VolatileLoad(&m_numPushed); }
+        ULONG GetNumStolen() { LIMITED_METHOD_CONTRACT; return (ULONG)VolatileLoad(&m_numStolen); }
+
+        // 1 while a worker thread owns the queue. Queues are never freed, since thieves may be looking at them;
+        // a worker that exits gives its queue up to the next one.
+        LONG m_owned;
+
+    private:
+        // Statistics are kept per queue, next to the index their writer updates anyway
+        DECLSPEC_ALIGN(64) LONG m_top;      // next request to steal
+        LONG m_numStolen;
+        DECLSPEC_ALIGN(64) LONG m_bottom;   // next free slot, only written by the owner
+        ULONG m_numPushed;
+        WorkRequest* m_requests[Capacity];
+    };
+
 public:
     struct ThreadCounter
     {
@@ -509,6 +652,41 @@ public:
                                             ULONG Flags,
                                             DWORD& errorCode);
 
+#ifdef FEATURE_PAL
+    // Called on an I/O completion thread with the PAL_IO_EVENT_* flags reported for a file descriptor
+    typedef VOID (*LPIO_READINESS_ROUTINE)(DWORD events, LPVOID context);
+
+    // Called once the callback will not run again for a binding, to release its context
+    typedef VOID (*LPIO_READINESS_RELEASE_ROUTINE)(LPVOID context);
+
+    // A file descriptor bound to the I/O completion threads. Bindings are owned by the thread pool and are
+    // never freed, only recycled: entries for a descriptor can already be dequeued when it is dissociated
+    // from the port, and they have to find either the binding they were posted for, with Fd set to -1, or
+    // a binding reused since, for which they are a spurious readiness event that callers have to tolerate
+    // anyway with edge triggered readiness.
+    struct IoReadinessBinding
+    {
+        IoReadinessBinding*            Next;               // links free bindings
+        int                            Fd;                 // -1 once unbound
+        LPIO_READINESS_ROUTINE         Function;
+        LPIO_READINESS_RELEASE_ROUTINE ReleaseFunction;
+        LPVOID                         Context;
+        DWORD                          CallbacksRunning;   // under IoReadinessBindingsLock
+    };
+
+    // Returns NULL on failure, in which case Context stays with the caller
+    static IoReadinessBinding* BindIoReadinessCallback(int fd,
+                                                       DWORD events,
+                                                       LPIO_READINESS_ROUTINE Function,
+                                                       LPIO_READINESS_RELEASE_ROUTINE ReleaseFunction,
+                                                       LPVOID Context,
+                                                       DWORD& errorCode);
+
+    // The release routine runs once no callback is running any more, which may be before or after this returns
+    static BOOL UnbindIoReadinessCallback(IoReadinessBinding* pBinding,
+                                          DWORD& errorCode);
+#endif // FEATURE_PAL
+
     static void WINAPI WaitIOCompletionCallback(DWORD dwErrorCode,
                                             DWORD numBytesTransferred,
                                             LPOVERLAPPED lpOverlapped);
@@ -603,6 +781,7 @@ private:
         wr->Function = function;
         wr->Context = context;
         wr->next = NULL;
+        wr->EnqueueTime = ThreadpoolTelemetry::GetTimestamp();
         return wr;
     }
     
@@ -660,6 +839,10 @@ private:
         HANDLE              ExternalCompletionEvent; // they are signalled when all callbacks have completed (refCount=0)
         ADID                handleOwningAD;
         OBJECTHANDLE        ExternalEventSafeHandle;
+#ifdef FEATURE_PAL
+        PAL_WAIT_REGISTRATION registration;     // armed registration of a wait serviced through RegisteredWaitPort,
+                                                // in which case threadCB is NULL and link is in RegisteredTimedWaitsHead
+#endif // FEATURE_PAL
 
     } ;
 
@@ -799,8 +982,9 @@ private:
 
     // Timer 
     typedef struct {
-        LIST_ENTRY  link;           // doubly linked list of timers
+        LIST_ENTRY  link;           // doubly linked list of timers in a bucket of the timer wheel
         ULONG FiringTime;           // TickCount of when to fire next
+        ULONG StartTime;            // TickCount the due time of a timer that is not registered yet counts from
         WAITORTIMERCALLBACK Function;             // Function to call when timer fires
         PVOID Context;              // Context to pass to function when timer fires
         ULONG Period;
@@ -847,6 +1031,14 @@ private:
         ULONG Period ;              // new period
     } TimerUpdateInfo;
 
+    // New timers are handed to the timer thread through one of these lists per processor, so
+    // that threads creating timers on different processors do not contend on a lock or on a
+    // single list head. Pending timers are chained through link.Flink.
+    struct PendingTimerList {
+        TimerInfo*  Head;
+        BYTE        Padding[64 - sizeof(TimerInfo*)];   // keep each head on its own cache line
+    };
+
     // Definitions and data structures to support recycling of high-frequency 
     // memory blocks. We use a spin-lock to access the list
 
@@ -1012,6 +1204,16 @@ public:
 
     static WorkRequest* DequeueWorkRequest();
 
+    static void InjectWorkRequests(WorkRequest* first, WorkRequest* last);
+
+    static WorkStealingQueue* GetLocalWorkQueue();
+
+    static WorkRequest* StealWorkRequest(WorkStealingQueue* localQueue);
+
+    static void ReleaseLocalWorkQueue();
+
+    static void GetWorkQueueStatistics(ULONG* pNumLocal, ULONG* pNumStolen, ULONG* pNumInjected, LONG* pLocalDepth);
+
     static void ExecuteWorkRequest(bool* foundWork, bool* wasNotRecalled);
 
     static DWORD WINAPI ExecuteHostRequest(PVOID pArg);
@@ -1028,6 +1230,8 @@ public:
         }
         CONTRACTL_END;
 
+        _ASSERTE(WorkRequestLock.IsHeld());
+
         if (WorkRequestTail)
         {
             _ASSERTE(WorkRequestHead != NULL);
@@ -1053,6 +1257,8 @@ public:
         }
         CONTRACTL_END;
 
+        _ASSERTE(WorkRequestLock.IsHeld());
+
         WorkRequest* entry = NULL;
         if (WorkRequestHead)
         {
@@ -1103,6 +1309,32 @@ public:
     static void AdjustMaxWorkersActive();
     static bool ShouldWorkerKeepRunning();
 
+    // A worker that blocks in a wait is compensated for right away, by raising MaxWorking so that another
+    // worker can run in its place, rather than only once the gate thread detects starvation. The extra
+    // workers retire once the blocked ones are done. BlockingHolder marks such a wait.
+    static bool NotifyBlockingBegin();
+    static void NotifyBlockingEnd();
+
+    class BlockingHolder
+    {
+    public:
+        BlockingHolder(bool fBlocking = true)
+        {
+            WRAPPER_NO_CONTRACT;
+            m_fCounted = fBlocking && NotifyBlockingBegin();
+        }
+
+        ~BlockingHolder()
+        {
+            WRAPPER_NO_CONTRACT;
+            if (m_fCounted)
+                NotifyBlockingEnd();
+        }
+
+    private:
+        bool m_fCounted;
+    };
+
     static BOOL SuspendProcessing();
 
     static DWORD SafeWait(CLREvent * ev, DWORD sleepTime, BOOL alertable);
@@ -1174,7 +1406,7 @@ public:
     inline static bool HaveNativeWork()
     {
         LIMITED_METHOD_CONTRACT;
-        return WorkRequestHead != NULL;
+        return WorkRequestHead != NULL || VolatileLoad(&InjectedWorkRequests) != NULL;
     }
 
     static void GrowCompletionPortThreadpoolIfNeeded();
@@ -1182,6 +1414,21 @@ public:
 #else
     static int GetCPUBusyTime_NT(PAL_IOCP_CPU_INFORMATION* pOldInfo);
 
+    static BOOL CreateIoReadinessThread();
+    static DWORD WINAPI IoReadinessThreadStart(LPVOID lpArgs);
+    static void GrowIoReadinessThreadsIfNeeded();
+    static void AdjustIoReadinessThreads();
+    static void ReleaseIoReadinessBinding(IoReadinessBinding* pBinding);
+
+    static BOOL EnsureRegisteredWaitThreadRunning();
+    static DWORD WINAPI RegisteredWaitThreadStart(LPVOID lpArgs);
+    static void InsertRegisteredWait(WaitInfo* waitInfo);
+    static void MoveRegisteredWaitToWaitThread(WaitInfo* waitInfo);
+    static BOOL ArmRegisteredWait(WaitInfo* waitInfo);
+    static void DisarmRegisteredWait(WaitInfo* waitInfo);
+    static void DeactivateRegisteredWait(WaitInfo* waitInfo);
+    static void ProcessRegisteredWaitSignal(WaitInfo* waitInfo);
+    static DWORD FireRegisteredWaitTimeouts();
 #endif // !FEATURE_PAL
 
 private:
@@ -1196,22 +1443,30 @@ private:
                                                double   throttleRate=0.0 // the delay is increased by this percentage for each extra thread
                                                );
     static BOOL SufficientDelaySinceLastDequeue();
+    static void AdjustBlockingCompensation(BOOL fAllowIncrease);
 
     static LPVOID   GetRecycledMemory(enum MemType memType);
 
     static DWORD WINAPI TimerThreadStart(LPVOID args);
     static void TimerThreadFire(); // helper method used by TimerThreadStart
-    static void WINAPI InsertNewTimer(TimerInfo* pArg);
+    static void InsertNewTimer(TimerInfo* pArg);
     static DWORD FireTimers();
     static DWORD WINAPI AsyncTimerCallbackCompletion(PVOID pArgs);
+    static void ActivateTimer(TimerInfo* timerInfo, DWORD startTime, DWORD dueTime);
     static void DeactivateTimer(TimerInfo* timerInfo);
+    static void InsertTimerIntoWheel(TimerInfo* timerInfo);
+    static void CascadeTimerWheel();
+    static DWORD GetTicksToNextTimerWheelWork();
+    static void QueueNewTimer(TimerInfo* timerInfo, DWORD dueTick);
+    static void InsertPendingTimers();
+    static BOOL HavePendingTimers();
     static DWORD WINAPI AsyncDeleteTimer(PVOID pArgs);
     static void DeleteTimer(TimerInfo* timerInfo);
     static void WINAPI UpdateTimer(TimerUpdateInfo* pArgs);
 
     static void WINAPI DeregisterTimer(TimerInfo* pArgs);
 
-    inline static DWORD QueueDeregisterWait(HANDLE waitThread, WaitInfo* waitInfo)
+    inline static DWORD QueueDeregisterWait(WaitInfo* waitInfo)
     {
         CONTRACTL
         {
@@ -1221,7 +1476,19 @@ private:
         }
         CONTRACTL_END;
 
-        DWORD result = QueueUserAPC(reinterpret_cast<PAPCFUNC>(DeregisterWait), waitThread, reinterpret_cast<ULONG_PTR>(waitInfo));
+#ifdef FEATURE_PAL
+        ThreadCB* threadCB = VolatileLoad(&waitInfo->threadCB);
+        if (threadCB == NULL)
+        {
+            // The wait is serviced by the registered wait thread, which forwards the request if it has
+            // moved the wait to a wait thread in the meantime
+            return PAL_PostIoCompletionPort(RegisteredWaitPort, reinterpret_cast<ULONG_PTR>(waitInfo), REGISTERED_WAIT_DEREGISTER);
+        }
+#else
+        ThreadCB* threadCB = waitInfo->threadCB;
+#endif // FEATURE_PAL
+
+        DWORD result = QueueUserAPC(reinterpret_cast<PAPCFUNC>(DeregisterWait), threadCB->threadHandle, reinterpret_cast<ULONG_PTR>(waitInfo));
         SetWaitThreadAPCPending();
         return result;
     }
@@ -1262,6 +1529,18 @@ private:
     SPTR_DECL(WorkRequest,WorkRequestHead);             // Head of work request queue
     SPTR_DECL(WorkRequest,WorkRequestTail);             // Head of work request queue
 
+    // Requests queued by threads without a local queue are pushed onto InjectedWorkRequests without taking a
+    // lock. Consumers move them, oldest first, to the queue above under WorkRequestLock.
+    DECLSPEC_ALIGN(64) static WorkRequest* InjectedWorkRequests;
+    DECLSPEC_ALIGN(64) static DangerousNonHostedSpinLock WorkRequestLock;
+
+    static const LONG MaxLocalWorkQueues = 256;
+    static WorkStealingQueue* LocalWorkQueues[MaxLocalWorkQueues];
+    static LONG NumLocalWorkQueues;                     // high water mark of LocalWorkQueues
+    static BOOL UseLocalWorkQueues;
+
+    static ULONG NumInjectedWorkRequests;               // requests moved off InjectedWorkRequests, under WorkRequestLock
+
     static unsigned int LastCPThreadCreation;		// last time a completion port thread was created
     static unsigned int NumberOfProcessors;             // = NumberOfWorkerThreads - no. of blocked threads
 
@@ -1270,6 +1549,10 @@ private:
     // This needs to be non-hosted, because worker threads can run prior to EE startup.
     static DangerousNonHostedSpinLock ThreadAdjustmentLock;
 
+    DECLSPEC_ALIGN(64) static LONG NumBlockedWorkers;   // workers inside a BlockingHolder
+    static LONG NumBlockingCompensation;                // how far MaxWorking was raised for them, under ThreadAdjustmentLock
+    static BOOL EnableBlockingCompensation;
+
 public:
     static CrstStatic WorkerCriticalSection;
 
@@ -1303,14 +1586,41 @@ private:
 
     static TimerInfo *TimerInfosToBeRecycled;           // list of delegate infos associated with deleted timers
     static CrstStatic TimerQueueCriticalSection;        // critical section to synchronize timer queue access
-    SVAL_DECL(LIST_ENTRY,TimerQueue);                   // queue of timers
     static HANDLE TimerThread;                          // Currently we only have one timer thread
     static Thread*  pTimerThread;
-    DECLSPEC_ALIGN(64) static DWORD LastTickCount;      // the count just before timer thread goes to sleep
+    static CLREvent * TimerThreadWakeEvent;             // set when a new timer is due before the timer thread would wake up
+
+    // The timer wheel is only ever touched by the timer thread, so it needs no lock
+    static LIST_ENTRY TimerWheelRoot[TIMER_WHEEL_ROOT_SIZE];                            // one bucket per tick for the next 256 ticks
+    static LIST_ENTRY TimerWheelLevels[TIMER_WHEEL_LEVELS][TIMER_WHEEL_LEVEL_SIZE];    // later timers, cascaded down as the wheel turns
+    static DWORD TimerWheelTime;                        // the next tick the timer thread will process
+    static DWORD NumTimersInWheel;                      // number of active timers
+
+    static PendingTimerList* PendingTimerLists;         // new timers not yet in the wheel, one list per processor
+    static DWORD NumPendingTimerLists;
+    DECLSPEC_ALIGN(64) static DWORD TimerThreadWakeTime; // the count the timer thread is going to sleep until
 
     static BOOL InitCompletionPortThreadpool;           // flag indicating whether completion port threadpool has been initialized
     static HANDLE GlobalCompletionPort;                 // used for binding io completions on file handles
 
+#ifdef FEATURE_PAL
+    static PAL_IO_COMPLETION_PORT GlobalIoReadinessPort; // used for binding readiness callbacks on file descriptors
+    static CrstStatic IoReadinessBindingsLock;          // protects Fd and CallbacksRunning of bindings, and the free list
+    static IoReadinessBinding* FreeIoReadinessBindings;
+
+    DECLSPEC_ALIGN(64) static LONG IoReadinessCompletions; // number of readiness callbacks run, sampled by the gate thread
+    static LONG PriorIoReadinessCompletions;
+    static DWORD PriorIoReadinessSampleTime;
+    static double PriorIoReadinessThroughput;           // readiness callbacks per second over the last sample
+    static int IoReadinessLastMove;                     // last change made to the I/O thread limit: -1, 0 or +1
+    static int IoReadinessHoldSamples;                  // samples to wait before probing for a higher limit again
+
+    static PAL_IO_COMPLETION_PORT RegisteredWaitPort;   // serviced by the registered wait thread, NULL until it is started
+    static DWORD RegisteredWaitThreadId;
+    static BOOL RegisteredWaitPortDisabled;             // registered waits all go to wait threads
+    static LIST_ENTRY RegisteredTimedWaitsHead;         // waits with a timeout serviced through RegisteredWaitPort
+#endif // FEATURE_PAL
+
 public:
     SVAL_DECL(ThreadCounter,CPThreadCounter);
 
@@ -0,0 +1,311 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Checks the results of casts that go through the exact type checks the JIT expands inline
+// (JitExpandExactCastChecks) and through the runtime's cast cache. Every cast is repeated, so
+// that the later ones find the result the first one cached. Casts the cache must not record,
+// because their result does not depend on the two types alone, are checked with instances or
+// types that would get a wrong answer from a cached result.
+
+using System;
+using System.Collections.Generic;
+using System.Reflection;
+using System.Reflection.Emit;
+using System.Runtime.CompilerServices;
+using Console = Internal.Console;
+
+public class Base
+{
+}
+
+public class Derived : Base
+{
+}
+
+public class Other
+{
+}
+
+public interface IMarker
+{
+}
+
+public class ObjectComparer : IComparer<object>
+{
+    public int Compare(object x, object y) => 0;
+}
+
+public class MarkerImpl : IMarker
+{
+}
+
+// Implements IMarker or not depending on the instance rather than its type.
+public class Chameleon : ICastable
+{
+    bool _isMarker;
+
+    public Chameleon(bool isMarker)
+    {
+        _isMarker = isMarker;
+    }
+
+    public bool IsInstanceOfInterface(RuntimeTypeHandle interfaceType, out Exception castError)
+    {
+        castError = null;
+        return _isMarker && interfaceType.Equals(typeof(IMarker).TypeHandle);
+    }
+
+    public RuntimeTypeHandle GetImplType(RuntimeTypeHandle interfaceType)
+    {
+        return typeof(MarkerImpl).TypeHandle;
+    }
+}
+
+public static class CastCache
+{
+    const int Pass = 100;
+    const int Fail = -1;
+
+    // Enough for the first cast to populate the cache and the others to hit it.
+    const int Repeat = 3;
+
+    static bool s_passed = true;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsBase(object o) => o is Base;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static Base CastToBase(object o) => (Base)o;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsMarker(object o) => o is IMarker;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static IMarker CastToMarker(object o) => (IMarker)o;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsEnumerableOfObject(object o) => o is IEnumerable<object>;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsEnumerableOfString(object o) => o is IEnumerable<string>;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsListOfInt(object o) => o is IList<int>;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsComparerOfString(object o) => o is IComparer<string>;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static Func<object> CastToFuncOfObject(object o) => (Func<object>)o;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsActionOfString(object o) => o is Action<string>;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsObjectArray(object o) => o is object[];
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsStringArray(object o) => o is string[];
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsUIntArray(object o) => o is uint[];
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsNullableInt(object o) => o is int?;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static bool IsInstanceOf<T>(object o) => o is T;
+
+    static void Expect(string test, bool actual, bool expected)
+    {
+        if (actual != expected)
+        {
+            Console.WriteLine(test + ": got " + actual + ", expected " + expected);
+            s_passed = false;
+        }
+    }
+
+    static void ExpectCast(string test, Func<object> cast, bool expected)
+    {
+        bool succeeded;
+        try
+        {
+            cast();
+            succeeded = true;
+        }
+        catch (InvalidCastException)
+        {
+            succeeded = false;
+        }
+        Expect(test, succeeded, expected);
+    }
+
+    // Base is not sealed, so its exact type is checked inline and a mismatch goes to the helper.
+    static void TestUnsealedClass()
+    {
+        object exact = new Base();
+        object derived = new Derived();
+        object other = new Other();
+
+        for (int i = 0; i < Repeat; i++)
+        {
+            Expect("Base is Base", IsBase(exact), true);
+            Expect("Derived is Base", IsBase(derived), true);
+            Expect("Other is Base", IsBase(other), false);
+            Expect("null is Base", IsBase(null), false);
+            ExpectCast("(Base)Base", () => CastToBase(exact), true);
+            ExpectCast("(Base)Derived", () => CastToBase(derived), true);
+            ExpectCast("(Base)Other", () => CastToBase(other), false);
+        }
+    }
+
+    static void TestInterfaces()
+    {
+        object marker = new MarkerImpl();
+        object other = new Other();
+
+        for (int i = 0; i < Repeat; i++)
+        {
+            Expect("MarkerImpl is IMarker", IsMarker(marker), true);
+            Expect("Other is IMarker", IsMarker(other), false);
+            ExpectCast("(IMarker)MarkerImpl", () => CastToMarker(marker), true);
+            ExpectCast("(IMarker)Other", () => CastToMarker(other), false);
+        }
+    }
+
+    static void TestVariance()
+    {
+        object listOfString = new List<string>();
+        object listOfObject = new List<object>();
+        object comparer = new ObjectComparer();
+        Func<string> funcOfString = () => "";
+        Func<int> funcOfInt = () => 0;
+        Action<object> actionOfObject = o => { };
+        Action<Base> actionOfBase = o => { };
+
+        for (int i = 0; i < Repeat; i++)
+        {
+            Expect("List<string> is IEnumerable<object>", IsEnumerableOfObject(listOfString), true);
+            Expect("List<object> is IEnumerable<string>", IsEnumerableOfString(listOfObject), false);
+            Expect("ObjectComparer is IComparer<string>", IsComparerOfString(comparer), true);
+            Expect("Other is IComparer<string>", IsComparerOfString(new Other()), false);
+
+            // Func<object> is a sealed type, checked inline for an exact match in front of the helper.
+            ExpectCast("(Func<object>)Func<string>", () => CastToFuncOfObject(funcOfString), true);
+            ExpectCast("(Func<object>)Func<int>", () => CastToFuncOfObject(funcOfInt), false);
+            Expect("Action<object> is Action<string>", IsActionOfString(actionOfObject), true);
+            Expect("Action<Base> is Action<string>", IsActionOfString(actionOfBase), false);
+        }
+    }
+
+    // Arrays are cached as sources; as targets they are TypeDescs, which the cache leaves out.
+    static void TestArrays()
+    {
+        object strings = new string[1];
+        object objects = new object[1];
+        object ints = new int[1];
+        object longs = new long[1];
+
+        for (int i = 0; i < Repeat; i++)
+        {
+            Expect("string[] is IEnumerable<object>", IsEnumerableOfObject(strings), true);
+            Expect("object[] is IEnumerable<string>", IsEnumerableOfString(objects), false);
+            Expect("int[] is IEnumerable<object>", IsEnumerableOfObject(ints), false);
+            Expect("int[] is IList<int>", IsListOfInt(ints), true);
+            Expect("long[] is IList<int>", IsListOfInt(longs), false);
+
+            Expect("string[] is object[]", IsObjectArray(strings), true);
+            Expect("int[] is object[]", IsObjectArray(ints), false);
+            Expect("object[] is string[]", IsStringArray(objects), false);
+            Expect("string[] is string[]", IsStringArray(strings), true);
+            Expect("int[] is uint[]", IsUIntArray(ints), true);
+            Expect("long[] is uint[]", IsUIntArray(longs), false);
+            Expect("string[] is T[] with T = Base", IsInstanceOf<Base[]>(strings), false);
+            Expect("Derived[] is T[] with T = Base", IsInstanceOf<Base[]>(new Derived[1]), true);
+        }
+    }
+
+    static void TestNullable()
+    {
+        object boxedInt = 42;
+        object boxedLong = 42L;
+
+        for (int i = 0; i < Repeat; i++)
+        {
+            Expect("int is int?", IsNullableInt(boxedInt), true);
+            Expect("long is int?", IsNullableInt(boxedLong), false);
+            Expect("null is int?", IsNullableInt(null), false);
+            Expect("int is T with T = int?", IsInstanceOf<int?>(boxedInt), true);
+            Expect("long is T with T = long?", IsInstanceOf<long?>(boxedLong), true);
+            Expect("int is T with T = long?", IsInstanceOf<long?>(boxedInt), false);
+        }
+    }
+
+    // Instances of the same ICastable type answer differently, so a cached result would be wrong
+    // for one of them.
+    static void TestICastable()
+    {
+        object yes = new Chameleon(true);
+        object no = new Chameleon(false);
+
+        for (int i = 0; i < Repeat; i++)
+        {
+            Expect("Chameleon(true) is IMarker", IsMarker(yes), true);
+            Expect("Chameleon(false) is IMarker", IsMarker(no), false);
+            ExpectCast("(IMarker)Chameleon(true)", () => CastToMarker(yes), true);
+            ExpectCast("(IMarker)Chameleon(false)", () => CastToMarker(no), false);
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static WeakReference CastCollectibleInstance(int iteration)
+    {
+        // Every other type implements IMarker. Once a type is collected its MethodTable may be
+        // freed and its address reused by the next one, so a cached result would be stale.
+        bool isMarker = (iteration % 2) == 0;
+
+        AssemblyBuilder assembly = AssemblyBuilder.DefineDynamicAssembly(new AssemblyName("Collectible" + iteration),
+                                                                         AssemblyBuilderAccess.RunAndCollect);
+        ModuleBuilder module = assembly.DefineDynamicModule("Collectible" + iteration);
+        TypeBuilder type = module.DefineType("CollectibleType", TypeAttributes.Public | TypeAttributes.Class,
+                                             typeof(object), isMarker ? new Type[] { typeof(IMarker) } : new Type[0]);
+        type.DefineDefaultConstructor(MethodAttributes.Public);
+        object instance = Activator.CreateInstance(type.CreateTypeInfo().AsType());
+
+        for (int i = 0; i < Repeat; i++)
+        {
+            Expect("collectible type " + iteration + " is IMarker", IsMarker(instance), isMarker);
+            ExpectCast("(IMarker)collectible type " + iteration, () => CastToMarker(instance), isMarker);
+        }
+
+        return new WeakReference(assembly);
+    }
+
+    static void TestCollectible()
+    {
+        for (int iteration = 0; iteration < 8; iteration++)
+        {
+            WeakReference assembly = CastCollectibleInstance(iteration);
+            for (int i = 0; (i < 10) && assembly.IsAlive; i++)
+            {
+                GC.Collect();
+                GC.WaitForPendingFinalizers();
+            }
+        }
+    }
+
+    public static int Main()
+    {
+        TestUnsealedClass();
+        TestInterfaces();
+        TestVariance();
+        TestArrays();
+        TestNullable();
+        TestICastable();
+        TestCollectible();
+
+        Console.WriteLine(s_passed ? "PASSED" : "FAILED");
+        return s_passed ? Pass : Fail;
+    }
+}
@@ -0,0 +1,188 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Runs loops that COMPlus_JitVectorizeLoops turns into vector loops and checks
+// that they compute the same values as the scalar code, for every array length
+// up to a few vectors, so that the scalar loop that handles the remaining
+// elements is covered as well.
+
+using System;
+using System.Runtime.CompilerServices;
+
+public static class LoopVectorization
+{
+    const int Pass = 100;
+    const int Fail = -1;
+
+    // Longer than three vectors of the smallest element type with 32 byte vectors.
+    const int MaxLength = 3 * 8 + 7;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void AddInt(int[] a, int[] b, int[] c)
+    {
+        for (int i = 0; i < a.Length; i++)
+        {
+            a[i] = b[i] + c[i];
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void MulXorInt(int[] a, int[] b, int x, int n)
+    {
+        for (int i = 0; i < n; i++)
+        {
+            a[i] = (a[i] * b[i]) ^ x;
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void SubMulFloat(float[] a, float[] b, float[] c, int start, int n)
+    {
+        for (int i = start; i < n; i++)
+        {
+            a[i] = (b[i] - c[i]) * 3.0f;
+        }
+    }
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static void DivDouble(double[] a, double[] b, double[] c, double[] d)
+    {
+        for (int i = 0; i < a.Length; i++)
+        {
+            a[i] = b[i] / c[i];
+            d[i] = a[i] + b[i];
+        }
+    }
+
+    // The reference results, computed one element per call so that nothing is vectorized.
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int ScalarAddInt(int b, int c) => b + c;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int ScalarMulXorInt(int a, int b, int x) => (a * b) ^ x;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static float ScalarSubMulFloat(float b, float c) => (b - c) * 3.0f;
+
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static double ScalarDivDouble(double b, double c) => b / c;
+
+    static bool Check<T>(string test, int length, T[] actual, T[] expected)
+    {
+        for (int i = 0; i < actual.Length; i++)
+        {
+            if (!actual[i].Equals(expected[i]))
+            {
+                Console.WriteLine("{0}: length {1}, element {2} is {3}, expected {4}", test, length, i, actual[i],
+                                  expected[i]);
+                return false;
+            }
+        }
+        return true;
+    }
+
+    static bool TestAddInt(int length)
+    {
+        int[] a = new int[length];
+        int[] b = new int[length];
+        int[] c = new int[length];
+        int[] expected = new int[length];
+        for (int i = 0; i < length; i++)
+        {
+            b[i] = i * 7 - 13;
+            c[i] = int.MaxValue - i;
+            expected[i] = ScalarAddInt(b[i], c[i]);
+        }
+
+        AddInt(a, b, c);
+        return Check("AddInt", length, a, expected);
+    }
+
+    static bool TestMulXorInt(int length)
+    {
+        int[] a = new int[length + 3];
+        int[] b = new int[length + 3];
+        int[] expected = new int[length + 3];
+        for (int i = 0; i < a.Length; i++)
+        {
+            a[i] = i + 1;
+            b[i] = 65537 * i;
+            expected[i] = (i < length) ? ScalarMulXorInt(a[i], b[i], 0x5A5A) : a[i];
+        }
+
+        // The limit is shorter than the arrays, so the elements past it must be left alone.
+        MulXorInt(a, b, 0x5A5A, length);
+        if (!Check("MulXorInt", length, a, expected))
+        {
+            return false;
+        }
+
+        // The destination is also a source.
+        for (int i = 0; i < a.Length; i++)
+        {
+            a[i] = i - 5;
+            expected[i] = (i < length) ? ScalarMulXorInt(a[i], a[i], -1) : a[i];
+        }
+
+        MulXorInt(a, a, -1, length);
+        return Check("MulXorInt (aliased)", length, a, expected);
+    }
+
+    static bool TestSubMulFloat(int length)
+    {
+        float[] a = new float[length];
+        float[] b = new float[length];
+        float[] c = new float[length];
+        float[] expected = new float[length];
+
+        // Start after the first element, so that the vector loop starts at an odd index.
+        int start = Math.Min(1, length);
+        for (int i = 0; i < length; i++)
+        {
+            a[i] = -1.0f;
+            b[i] = i * 0.3f;
+            c[i] = 1.0f / (i + 1);
+            expected[i] = (i >= start) ? ScalarSubMulFloat(b[i], c[i]) : a[i];
+        }
+
+        SubMulFloat(a, b, c, start, length);
+        return Check("SubMulFloat", length, a, expected);
+    }
+
+    static bool TestDivDouble(int length)
+    {
+        double[] a = new double[length];
+        double[] b = new double[length];
+        double[] c = new double[length];
+        double[] d = new double[length];
+        double[] expectedA = new double[length];
+        double[] expectedD = new double[length];
+        for (int i = 0; i < length; i++)
+        {
+            b[i] = i * 1.5 - 4.0;
+            c[i] = (i % 3) - 1.0;
+            expectedA[i] = ScalarDivDouble(b[i], c[i]);
+            expectedD[i] = expectedA[i] + b[i];
+        }
+
+        DivDouble(a, b, c, d);
+        return Check("DivDouble", length, a, expectedA) && Check("DivDouble", length, d, expectedD);
+    }
+
+    public static int Main()
+    {
+        bool passed = true;
+        for (int length = 0; length <= MaxLength; length++)
+        {
+            passed &= TestAddInt(length);
+            passed &= TestMulXorInt(length);
+            passed &= TestSubMulFloat(length);
+            passed &= TestDivDouble(length);
+        }
+
+        Console.WriteLine(passed ? "PASSED" : "FAILED");
+        return passed ? Pass : Fail;
+    }
+}
@@ -0,0 +1,332 @@
+// Licensed to the .NET Foundation under one or more agreements.
+// The .NET Foundation licenses this file to you under the MIT license.
+// See the LICENSE file in the project root for more information.
+
+// Runs one method per kind of bounds check that RangeCheck removes using other bounds or
+// dominating length checks, and checks their results, including for the inputs that have to
+// throw. Then, when the JIT can disassemble (checked and debug builds), runs itself again with
+// COMPlus_JitDisasm set for those methods and counts the bounds checks left in each listing.
+
+using System;
+using System.Collections.Generic;
+using System.Diagnostics;
+using System.Reflection;
+using System.Runtime.CompilerServices;
+using System.Text.RegularExpressions;
+
+public static class RangeCheck
+{
+    const int Pass = 100;
+    const int Fail = -1;
+
+    // Passed to the process started with JitDisasm, which only has to compile the methods.
+    const string CompileOnly = "compileonly";
+
+    // The methods whose listings are checked, with the number of bounds checks each must keep.
+    static readonly Dictionary<string, int> ExpectedRangeChecks = new Dictionary<string, int>
+    {
+        { "ConstantIndexAfterLengthCheck", 0 },
+        { "LoopBoundedByAllocatedArray", 0 },
+        { "LoopBoundedByShorterArray", 0 },
+        // The check of a[start] stays; it gives start a lower bound of 0 for the loop.
+        { "StridedLoopFromCheckedStart", 1 },
+    };
+
+    // "if (a.Length > 2) ... a[2]": a constant index below a length that a dominating
+    // comparison proves large enough.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int ConstantIndexAfterLengthCheck(int[] a)
+    {
+        if (a.Length > 2)
+        {
+            return a[0] + a[1] * 3 + a[2] * 5;
+        }
+        return -1;
+    }
+
+    // "for (i = 0; i < b.Length; i++) a[i]", with b allocated shorter than a.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int LoopBoundedByAllocatedArray(int seed)
+    {
+        int[] a = new int[16];
+        int[] b = new int[12];
+        for (int i = 0; i < b.Length; i++)
+        {
+            b[i] = seed + i;
+        }
+        for (int i = 0; i < b.Length; i++)
+        {
+            a[i] = b[i] * 2;
+        }
+        int sum = 0;
+        for (int i = 0; i < a.Length; i++)
+        {
+            sum += a[i] * (i + 1);
+        }
+        return sum;
+    }
+
+    // "for (i = 0; i < b.Length; i++) a[i]", after a comparison of the two lengths.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int LoopBoundedByShorterArray(int[] a, int[] b)
+    {
+        if (a.Length < b.Length)
+        {
+            return -1;
+        }
+        for (int i = 0; i < b.Length; i++)
+        {
+            a[i] = b[i] + 1;
+        }
+        return 0;
+    }
+
+    // "for (i = start; i < a.Length; i += 2) a[i]", with start validated by indexing a.
+    [MethodImpl(MethodImplOptions.NoInlining)]
+    static int StridedLoopFromCheckedStart(int[] a, int start)
+    {
+        int sum = a[start];
+        for (int i = start; i < a.Length; i += 2)
+        {
+            sum += a[i];
+        }
+        return sum;
+    }
+
+    static int[] MakeArray(int length)
+    {
+        int[] a = new int[length];
+        for (int i = 0; i < length; i++)
+        {
+            a[i] = i * 7 - 3;
+        }
+        return a;
+    }
+
+    static bool Check(string test, int actual, int expected)
+    {
+        if (actual != expected)
+        {
+            Console.WriteLine("{0}: got {1}, expected {2}", test, actual, expected);
+            return false;
+        }
+        return true;
+    }
+
+    static bool ThrowsIndexOutOfRange(string test, Func<int> f)
+    {
+        try
+        {
+            f();
+        }
+        catch (IndexOutOfRangeException)
+        {
+            return true;
+        }
+        Console.WriteLine("{0}: did not throw IndexOutOfRangeException", test);
+        return false;
+    }
+
+    static bool TestConstantIndexAfterLengthCheck()
+    {
+        bool passed = true;
+        for (int length = 0; length <= 5; length++)
+        {
+            int[] a = MakeArray(length);
+            int expected = (length > 2) ? a[0] + a[1] * 3 + a[2] * 5 : -1;
+            passed &= Check("ConstantIndexAfterLengthCheck length " + length, ConstantIndexAfterLengthCheck(a), expected);
+        }
+        return passed;
+    }
+
+    static bool TestLoopBoundedByAllocatedArray()
+    {
+        bool passed = true;
+        for (int seed = -2; seed <= 2; seed++)
+        {
+            int expected = 0;
+            for (int i = 0; i < 12; i++)
+            {
+                expected += (seed + i) * 2 * (i + 1);
+            }
+            passed &= Check("LoopBoundedByAllocatedArray seed " + seed, LoopBoundedByAllocatedArray(seed), expected);
+        }
+        return passed;
+    }
+
+    static bool TestLoopBoundedByShorterArray()
+    {
+        bool passed = true;
+        for (int lengthA = 0; lengthA <= 4; lengthA++)
+        {
+            for (int lengthB = 0; lengthB <= 4; lengthB++)
+            {
+                int[] a = new int[lengthA];
+                int[] b = MakeArray(lengthB);
+                string test = "LoopBoundedByShorterArray lengths " + lengthA + ", " + lengthB;
+                if (!Check(test, LoopBoundedByShorterArray(a, b), (lengthA < lengthB) ? -1 : 0))
+                {
+                    passed = false;
+                    continue;
+                }
+                for (int i = 0; i < lengthA; i++)
+                {
+                    int expected = ((lengthA >= lengthB) && (i < lengthB)) ? b[i] + 1 : 0;
+                    passed &= Check(test + ", element " + i, a[i], expected);
+                }
+            }
+        }
+        return passed;
+    }
+
+    static bool TestStridedLoopFromCheckedStart()
+    {
+        bool passed = true;
+        for (int length = 0; length <= 7; length++)
+        {
+            int[] a = MakeArray(length);
+            for (int start = -1; start <= length; start++)
+            {
+                string test = "StridedLoopFromCheckedStart length " + length + ", start " + start;
+                if ((start < 0) || (start >= length))
+                {
+                    int s = start;
+                    passed &= ThrowsIndexOutOfRange(test, () => StridedLoopFromCheckedStart(a, s));
+                    continue;
+                }
+                int expected = a[start];
+                for (int i = start; i < length; i += 2)
+                {
+                    expected += a[i];
+                }
+                passed &= Check(test, StridedLoopFromCheckedStart(a, start), expected);
+            }
+        }
+        return passed;
+    }
+
+    // An instruction group label, which may be followed by a comment.
+    static readonly Regex LabelDefinition = new Regex(@"^(G_M\w+):");
+
+    // Counts the bounds checks in a listing: the jumps to the throw helper block that calls
+    // CORINFO_HELP_RNGCHKFAIL, or the calls themselves when they are not in such a block.
+    static int CountRangeChecks(string listing)
+    {
+        string[] lines = listing.Split('\n');
+        int checks = 0;
+        string label = null;
+        foreach (string rawLine in lines)
+        {
+            string line = rawLine.Trim();
+            if ((line.Length == 0) || line.StartsWith(";"))
+            {
+                continue;
+            }
+            Match labelMatch = LabelDefinition.Match(line);
+            if (labelMatch.Success)
+            {
+                label = labelMatch.Groups[1].Value;
+                continue;
+            }
+            if (line.Contains("CORINFO_HELP_RNGCHKFAIL"))
+            {
+                int jumps = 0;
+                if (label != null)
+                {
+                    Regex reference = new Regex(@"\b" + label + @"\b(?!:)");
+                    foreach (string other in lines)
+                    {
+                        if (reference.IsMatch(other))
+                        {
+                            jumps++;
+                        }
+                    }
+                }
+                checks += Math.Max(jumps, 1);
+            }
+            label = null;
+        }
+        return checks;
+    }
+
+    static bool CheckListings()
+    {
+        ProcessStartInfo startInfo = new ProcessStartInfo();
+        startInfo.FileName = Process.GetCurrentProcess().MainModule.FileName;
+        startInfo.Arguments = "\"" + typeof(RangeCheck).GetTypeInfo().Assembly.Location + "\" " + CompileOnly;
+        startInfo.UseShellExecute = false;
+        startInfo.RedirectStandardOutput = true;
+        List<string> methods = new List<string>();
+        foreach (string method in ExpectedRangeChecks.Keys)
+        {
+            methods.Add("RangeCheck:" + method);
+        }
+        startInfo.Environment["COMPlus_JitDisasm"] = string.Join(" ", methods);
+        startInfo.Environment["COMPlus_TieredCompilation"] = "0";
+
+        string output;
+        using (Process process = Process.Start(startInfo))
+        {
+            output = process.StandardOutput.ReadToEnd();
+            process.WaitForExit();
+            if (process.ExitCode != Pass)
+            {
+                Console.WriteLine("The process compiling the methods exited with {0}", process.ExitCode);
+                return false;
+            }
+        }
+
+        const string header = "; Assembly listing for method RangeCheck:";
+        string[] listings = output.Split(new string[] { header }, StringSplitOptions.None);
+        if (listings.Length == 1)
+        {
+            Console.WriteLine("JitDisasm is not available, bounds checks were not counted");
+            return true;
+        }
+
+        bool passed = true;
+        int found = 0;
+        for (int i = 1; i < listings.Length; i++)
+        {
+            string name = listings[i].Substring(0, listings[i].IndexOf('('));
+            int expected;
+            if (!ExpectedRangeChecks.TryGetValue(name, out expected))
+            {
+                continue;
+            }
+            int checks = CountRangeChecks(listings[i]);
+            Console.WriteLine("{0}: {1} bounds checks, expected {2}", name, checks, expected);
+            passed &= (checks == expected);
+            found++;
+        }
+
+        if (found != ExpectedRangeChecks.Count)
+        {
+            Console.WriteLine("Found {0} of {1} listings", found, ExpectedRangeChecks.Count);
+            passed = false;
+        }
+        return passed;
+    }
+
+    public static int Main(string[] args)
+    {
+        if ((args.Length > 0) && (args[0] == CompileOnly))
+        {
+            ConstantIndexAfterLengthCheck(MakeArray(3));
+            LoopBoundedByAllocatedArray(0);
+            LoopBoundedByShorterArray(new int[2], new int[1]);
+            StridedLoopFromCheckedStart(MakeArray(3), 1);
+            return Pass;
+        }
+
+        bool passed = true;
+        passed &= TestConstantIndexAfterLengthCheck();
+        passed &= TestLoopBoundedByAllocatedArray();
+        passed &= TestLoopBoundedByShorterArray();
+        passed &= TestStridedLoopFromCheckedStart();
+        passed &= CheckListings();
+
+        Console.WriteLine(passed ? "PASSED" : "FAILED");
+        return passed ? Pass : Fail;
+    }
+}